@@ -0,0 +1,40 @@
+/**
+ ******************************************************************************
+ * @file    assets.c
+ * @brief   游戏资源公共函数实现
+ * @author  老王
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "assets.h"
+#include <stddef.h>
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 解压关卡地图
+ */
+uint16_t assets_unpack_level(const asset_level_t *level, uint8_t *out, uint16_t out_size)
+{
+    uint16_t n = 0;
+
+    if (level == NULL || out == NULL)
+    {
+        return 0;
+    }
+
+    for (uint16_t i = 0; i < level->rle_size; i++)
+    {
+        uint8_t value = level->rle[i] & 0x0F;
+        uint8_t run = (level->rle[i] >> 4) + 1;
+
+        while (run > 0 && n < out_size)
+        {
+            out[n++] = value;
+            run--;
+        }
+    }
+
+    return n;
+}
@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @file    assets.h
+ * @brief   游戏资源公共定义
+ * @author  老王
+ * @note    *_assets.h由资源编译器(Tools/asset_compiler)从src/下的源文件生成,
+ *          这里定义生成的头文件用到的类型和关卡解压函数
+ *
+ *          关卡数据用RLE压缩:每个字节高4位是重复次数-1,低4位是格子值,
+ *          只在加载关卡时解压一次
+ ******************************************************************************
+ */
+
+#ifndef __ASSETS_H__
+#define __ASSETS_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 关卡中的一个格子坐标
+ */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+} asset_point_t;
+
+/**
+ * @brief 一个压缩关卡
+ */
+typedef struct {
+    const uint8_t *rle;      // RLE压缩的地图(行优先)
+    uint16_t rle_size;       // 压缩数据字节数
+    asset_point_t start;     // 起点(推箱子的玩家、吃豆人)
+} asset_level_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 解压关卡地图
+ * @param level 压缩关卡
+ * @param out 输出缓冲,每个格子一个字节
+ * @param out_size 输出缓冲大小(宽x高)
+ * @return 解压出的格子数,和out_size不一致说明数据和缓冲尺寸对不上
+ */
+uint16_t assets_unpack_level(const asset_level_t *level, uint8_t *out, uint16_t out_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ASSETS_H__ */
@@ -0,0 +1,124 @@
+/**
+ ******************************************************************************
+ * @file    dino_assets.h
+ * @brief   由资源编译器从src/dino.spr生成,不要手工修改
+ * @note    4 sprites, 572 bytes
+ *          修改源文件后运行: python Tools/asset_compiler/asset_compiler.py
+ ******************************************************************************
+ */
+
+#ifndef __DINO_ASSETS_H__
+#define __DINO_ASSETS_H__
+
+#include <stdint.h>
+#include "sprite.h"
+
+/* dino_run_frame1: 12x11, pre-shifted */
+/*   ............ */
+/*   ...####..... */
+/*   ..######.... */
+/*   .#######.... */
+/*   #######..... */
+/*   ########.... */
+/*   #######..... */
+/*   .######..... */
+/*   ..#####..... */
+/*   ...###...... */
+/*   ...##....... */
+static const uint8_t dino_run_frame1_data[24] = {
+    0x70, 0xF8, 0xFC, 0xFE, 0xFE, 0xFE, 0xFE, 0x2C, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x01, 0x07, 0x07, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+static const uint8_t dino_run_frame1_shifted[252] = {
+    0xE0, 0xF0, 0xF8, 0xFC, 0xFC, 0xFC, 0xFC, 0x58, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x03, 0x0F, 0x0F, 0x07, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xC0, 0xE0, 0xF0, 0xF8, 0xF8, 0xF8, 0xF8, 0xB0, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x03, 0x07, 0x1F, 0x1F, 0x0F, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0xC0, 0xE0, 0xF0, 0xF0, 0xF0, 0xF0, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x07, 0x0F, 0x3F, 0x3F, 0x1F, 0x0F, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x80, 0xC0, 0xE0, 0xE0, 0xE0, 0xE0, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x07, 0x0F, 0x1F, 0x7F, 0x7F, 0x3F, 0x1F, 0x02, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x80, 0xC0, 0xC0, 0xC0, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x0E, 0x1F, 0x3F, 0xFF, 0xFF, 0x7F, 0x3F, 0x05, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x1C, 0x3E, 0x7F, 0xFF, 0xFF, 0xFF, 0x7F, 0x0B, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x38, 0x7C, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0x16, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x03, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+static const sprite_t dino_run_frame1 = { 12, 11, dino_run_frame1_data, dino_run_frame1_shifted };
+
+/* dino_run_frame2: 12x11, pre-shifted */
+/*   ............ */
+/*   ...####..... */
+/*   ..######.... */
+/*   .#######.... */
+/*   #######..... */
+/*   ########.... */
+/*   #######..... */
+/*   .######..... */
+/*   ..#####..... */
+/*   ..###....... */
+/*   ..##........ */
+static const uint8_t dino_run_frame2_data[24] = {
+    0x70, 0xF8, 0xFC, 0xFE, 0xFE, 0xFE, 0xFE, 0x2C, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x07, 0x07, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+static const uint8_t dino_run_frame2_shifted[252] = {
+    0xE0, 0xF0, 0xF8, 0xFC, 0xFC, 0xFC, 0xFC, 0x58, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x0F, 0x0F, 0x07, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xC0, 0xE0, 0xF0, 0xF8, 0xF8, 0xF8, 0xF8, 0xB0, 0x00, 0x00, 0x00, 0x00,
+    0x01, 0x03, 0x1F, 0x1F, 0x0F, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0xC0, 0xE0, 0xF0, 0xF0, 0xF0, 0xF0, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x03, 0x07, 0x3F, 0x3F, 0x1F, 0x0F, 0x0F, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x80, 0xC0, 0xE0, 0xE0, 0xE0, 0xE0, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x07, 0x0F, 0x7F, 0x7F, 0x3F, 0x1F, 0x1F, 0x02, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x80, 0xC0, 0xC0, 0xC0, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x0E, 0x1F, 0xFF, 0xFF, 0x7F, 0x3F, 0x3F, 0x05, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x80, 0x80, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x1C, 0x3E, 0xFF, 0xFF, 0xFF, 0x7F, 0x7F, 0x0B, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x38, 0x7C, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0x16, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x03, 0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+static const sprite_t dino_run_frame2 = { 12, 11, dino_run_frame2_data, dino_run_frame2_shifted };
+
+/* sprite_cactus: 6x10 */
+/*   ..##.. */
+/*   ..##.. */
+/*   .####. */
+/*   .####. */
+/*   ###### */
+/*   ..##.. */
+/*   ..##.. */
+/*   ..##.. */
+/*   ..##.. */
+/*   ..##.. */
+static const uint8_t sprite_cactus_data[12] = {
+    0x10, 0x1C, 0xFF, 0xFF, 0x1C, 0x10, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00,
+};
+static const sprite_t sprite_cactus = { 6, 10, sprite_cactus_data, NULL };
+
+/* sprite_cloud: 8x4 */
+/*   .######. */
+/*   ######## */
+/*   ######## */
+/*   .######. */
+static const uint8_t sprite_cloud_data[8] = {
+    0x06, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x0F, 0x06,
+};
+static const sprite_t sprite_cloud = { 8, 4, sprite_cloud_data, NULL };
+
+#endif /* __DINO_ASSETS_H__ */
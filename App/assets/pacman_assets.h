@@ -0,0 +1,42 @@
+/**
+ ******************************************************************************
+ * @file    pacman_assets.h
+ * @brief   由资源编译器从src/pacman.lvl生成,不要手工修改
+ * @note    1 levels, 43 bytes (128 uncompressed)
+ *          修改源文件后运行: python Tools/asset_compiler/asset_compiler.py
+ ******************************************************************************
+ */
+
+#ifndef __PACMAN_ASSETS_H__
+#define __PACMAN_ASSETS_H__
+
+#include <stdint.h>
+#include "assets.h"
+
+#define PACMAN_LEVEL_COUNT 1
+#define PACMAN_LEVEL_WIDTH 16
+#define PACMAN_LEVEL_HEIGHT 8
+
+/* maze */
+/*   ################ */
+/*   #o.....##.....o# */
+/*   #.##.#....#.##.# */
+/*   #......##...GG.# */
+/*   #......##......# */
+/*   #.##.#....#.##.# */
+/*   #o.P...##.....o# */
+/*   ################ */
+static const uint8_t pacman_maze_rle[43] = {
+    0xF1, 0x01, 0x02, 0x40, 0x11, 0x40, 0x02, 0x11, 0x00, 0x11, 0x00, 0x01,
+    0x30, 0x01, 0x00, 0x11, 0x00, 0x11, 0x50, 0x11, 0x50, 0x11, 0x50, 0x11,
+    0x50, 0x11, 0x00, 0x11, 0x00, 0x01, 0x30, 0x01, 0x00, 0x11, 0x00, 0x11,
+    0x02, 0x40, 0x11, 0x40, 0x02, 0xF1, 0x01,
+};
+#define PACMAN_MAZE_GHOSTS_COUNT 2
+static const asset_point_t pacman_maze_ghosts[] = { { 12, 3 }, { 13, 3 } };
+
+static const asset_level_t pacman_levels[PACMAN_LEVEL_COUNT] = {
+    { pacman_maze_rle, sizeof(pacman_maze_rle), { 3, 6 } },
+};
+
+#endif /* __PACMAN_ASSETS_H__ */
@@ -0,0 +1,212 @@
+/**
+ ******************************************************************************
+ * @file    plane_assets.h
+ * @brief   由资源编译器从src/plane.spr生成,不要手工修改
+ * @note    13 sprites, 248 bytes
+ *          修改源文件后运行: python Tools/asset_compiler/asset_compiler.py
+ ******************************************************************************
+ */
+
+#ifndef __PLANE_ASSETS_H__
+#define __PLANE_ASSETS_H__
+
+#include <stdint.h>
+#include "sprite.h"
+
+/* sprite_player: 8x8, pre-shifted */
+/*   #....... */
+/*   ##...... */
+/*   ####.... */
+/*   ######## */
+/*   ######## */
+/*   ####.... */
+/*   ##...... */
+/*   #....... */
+static const uint8_t sprite_player_data[8] = {
+    0xFF, 0x7E, 0x3C, 0x3C, 0x18, 0x18, 0x18, 0x18,
+};
+static const uint8_t sprite_player_shifted[112] = {
+    0xFE, 0xFC, 0x78, 0x78, 0x30, 0x30, 0x30, 0x30, 0x01, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFC, 0xF8, 0xF0, 0xF0, 0x60, 0x60, 0x60, 0x60,
+    0x03, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0xF0, 0xE0, 0xE0,
+    0xC0, 0xC0, 0xC0, 0xC0, 0x07, 0x03, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0xF0, 0xE0, 0xC0, 0xC0, 0x80, 0x80, 0x80, 0x80, 0x0F, 0x07, 0x03, 0x03,
+    0x01, 0x01, 0x01, 0x01, 0xE0, 0xC0, 0x80, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x1F, 0x0F, 0x07, 0x07, 0x03, 0x03, 0x03, 0x03, 0xC0, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x3F, 0x1F, 0x0F, 0x0F, 0x06, 0x06, 0x06, 0x06,
+    0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0x3F, 0x1E, 0x1E,
+    0x0C, 0x0C, 0x0C, 0x0C,
+};
+static const sprite_t sprite_player = { 8, 8, sprite_player_data, sprite_player_shifted };
+
+/* sprite_player_bullet: 4x2 */
+/*   #### */
+/*   #### */
+static const uint8_t sprite_player_bullet_data[4] = {
+    0x03, 0x03, 0x03, 0x03,
+};
+static const sprite_t sprite_player_bullet = { 4, 2, sprite_player_bullet_data, NULL };
+
+/* sprite_enemy_small: 7x6 */
+/*   ..###.. */
+/*   .#####. */
+/*   ####### */
+/*   ####### */
+/*   .#####. */
+/*   ..###.. */
+static const uint8_t sprite_enemy_small_data[7] = {
+    0x0C, 0x1E, 0x3F, 0x3F, 0x3F, 0x1E, 0x0C,
+};
+static const sprite_t sprite_enemy_small = { 7, 6, sprite_enemy_small_data, NULL };
+
+/* sprite_enemy_medium: 9x8 */
+/*   ...###... */
+/*   ..#####.. */
+/*   .#######. */
+/*   ######### */
+/*   ######### */
+/*   .#######. */
+/*   ..#####.. */
+/*   ...###... */
+static const uint8_t sprite_enemy_medium_data[9] = {
+    0x18, 0x3C, 0x7E, 0xFF, 0xFF, 0xFF, 0x7E, 0x3C, 0x18,
+};
+static const sprite_t sprite_enemy_medium = { 9, 8, sprite_enemy_medium_data, NULL };
+
+/* sprite_enemy_heavy: 11x10 */
+/*   ....####... */
+/*   ...######.. */
+/*   ..########. */
+/*   .########## */
+/*   ########### */
+/*   ########### */
+/*   .########## */
+/*   ..########. */
+/*   ...######.. */
+/*   ....####... */
+static const uint8_t sprite_enemy_heavy_data[22] = {
+    0x30, 0x78, 0xFC, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFC, 0x78, 0x00,
+    0x00, 0x00, 0x01, 0x03, 0x03, 0x03, 0x03, 0x01, 0x00, 0x00,
+};
+static const sprite_t sprite_enemy_heavy = { 11, 10, sprite_enemy_heavy_data, NULL };
+
+/* sprite_enemy_fast: 6x5 */
+/*   .##... */
+/*   ####.. */
+/*   #####. */
+/*   ####.. */
+/*   .##... */
+static const uint8_t sprite_enemy_fast_data[6] = {
+    0x0E, 0x1F, 0x1F, 0x0E, 0x04, 0x00,
+};
+static const sprite_t sprite_enemy_fast = { 6, 5, sprite_enemy_fast_data, NULL };
+
+/* sprite_powerup_weapon: 8x8 */
+/*   ######## */
+/*   #......# */
+/*   #.####.# */
+/*   #.####.# */
+/*   #.####.# */
+/*   #.##...# */
+/*   #.##...# */
+/*   ######## */
+static const uint8_t sprite_powerup_weapon_data[8] = {
+    0xFF, 0x81, 0xFD, 0xFD, 0x9D, 0x9D, 0x81, 0xFF,
+};
+static const sprite_t sprite_powerup_weapon = { 8, 8, sprite_powerup_weapon_data, NULL };
+
+/* sprite_powerup_shield: 8x8 */
+/*   ######## */
+/*   #......# */
+/*   #.####.# */
+/*   #.##...# */
+/*   #....### */
+/*   #.####.# */
+/*   #......# */
+/*   ######## */
+static const uint8_t sprite_powerup_shield_data[8] = {
+    0xFF, 0x81, 0xAD, 0xAD, 0xA5, 0xB5, 0x91, 0xFF,
+};
+static const sprite_t sprite_powerup_shield = { 8, 8, sprite_powerup_shield_data, NULL };
+
+/* sprite_powerup_bomb: 8x8 */
+/*   ######## */
+/*   #......# */
+/*   #.####.# */
+/*   #.####.# */
+/*   #.###..# */
+/*   #.####.# */
+/*   #.####.# */
+/*   ######## */
+static const uint8_t sprite_powerup_bomb_data[8] = {
+    0xFF, 0x81, 0xFD, 0xFD, 0xFD, 0xED, 0x81, 0xFF,
+};
+static const sprite_t sprite_powerup_bomb = { 8, 8, sprite_powerup_bomb_data, NULL };
+
+/* sprite_explosion_frame1: 8x8 */
+/*   ...##... */
+/*   ..####.. */
+/*   .######. */
+/*   ######## */
+/*   ######## */
+/*   .######. */
+/*   ..####.. */
+/*   ...##... */
+static const uint8_t sprite_explosion_frame1_data[8] = {
+    0x18, 0x3C, 0x7E, 0xFF, 0xFF, 0x7E, 0x3C, 0x18,
+};
+static const sprite_t sprite_explosion_frame1 = { 8, 8, sprite_explosion_frame1_data, NULL };
+
+/* sprite_explosion_frame2: 8x8 */
+/*   ........ */
+/*   ..#..#.. */
+/*   .#.##.#. */
+/*   #.####.# */
+/*   #.####.# */
+/*   .#.##.#. */
+/*   ..#..#.. */
+/*   ........ */
+static const uint8_t sprite_explosion_frame2_data[8] = {
+    0x18, 0x24, 0x5A, 0x3C, 0x3C, 0x5A, 0x24, 0x18,
+};
+static const sprite_t sprite_explosion_frame2 = { 8, 8, sprite_explosion_frame2_data, NULL };
+
+/* sprite_explosion_frame3: 8x8 */
+/*   ........ */
+/*   ........ */
+/*   .#....#. */
+/*   ..#..#.. */
+/*   ..#..#.. */
+/*   .#....#. */
+/*   ........ */
+/*   ........ */
+static const uint8_t sprite_explosion_frame3_data[8] = {
+    0x00, 0x24, 0x18, 0x00, 0x00, 0x18, 0x24, 0x00,
+};
+static const sprite_t sprite_explosion_frame3 = { 8, 8, sprite_explosion_frame3_data, NULL };
+
+/* sprite_boss: 16x16 */
+/*   ......####...... */
+/*   .....######..... */
+/*   ....########.... */
+/*   ...##########... */
+/*   ..############.. */
+/*   .##############. */
+/*   ################ */
+/*   ################ */
+/*   ################ */
+/*   ################ */
+/*   .##############. */
+/*   ..############.. */
+/*   ...##########... */
+/*   ....########.... */
+/*   .....######..... */
+/*   ......####...... */
+static const uint8_t sprite_boss_data[32] = {
+    0xC0, 0xE0, 0xF0, 0xF8, 0xFC, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFC,
+    0xF8, 0xF0, 0xE0, 0xC0, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF, 0xFF,
+    0xFF, 0xFF, 0x7F, 0x3F, 0x1F, 0x0F, 0x07, 0x03,
+};
+static const sprite_t sprite_boss = { 16, 16, sprite_boss_data, NULL };
+
+#endif /* __PLANE_ASSETS_H__ */
@@ -0,0 +1,70 @@
+/**
+ ******************************************************************************
+ * @file    sokoban_assets.h
+ * @brief   由资源编译器从src/sokoban.lvl生成,不要手工修改
+ * @note    3 levels, 83 bytes (240 uncompressed)
+ *          修改源文件后运行: python Tools/asset_compiler/asset_compiler.py
+ ******************************************************************************
+ */
+
+#ifndef __SOKOBAN_ASSETS_H__
+#define __SOKOBAN_ASSETS_H__
+
+#include <stdint.h>
+#include "assets.h"
+
+#define SOKOBAN_LEVEL_COUNT 3
+#define SOKOBAN_LEVEL_WIDTH 10
+#define SOKOBAN_LEVEL_HEIGHT 8
+
+/* level1 */
+/*   ########## */
+/*   #        # */
+/*   #  . .   # */
+/*   #  $ $   # */
+/*   #  @     # */
+/*   #        # */
+/*   #        # */
+/*   ########## */
+static const uint8_t sokoban_level1_rle[21] = {
+    0xA2, 0x71, 0x12, 0x11, 0x03, 0x01, 0x03, 0x21, 0x12, 0x11, 0x04, 0x01,
+    0x04, 0x21, 0x12, 0x71, 0x12, 0x71, 0x12, 0x71, 0xA2,
+};
+
+/* level2 */
+/*   ########## */
+/*   #   .    # */
+/*   # .$. $  # */
+/*   #  $ #   # */
+/*   #  @ #   # */
+/*   #    #   # */
+/*   #        # */
+/*   ########## */
+static const uint8_t sokoban_level2_rle[29] = {
+    0xA2, 0x21, 0x03, 0x31, 0x12, 0x01, 0x03, 0x04, 0x03, 0x01, 0x04, 0x11,
+    0x12, 0x11, 0x04, 0x01, 0x02, 0x21, 0x12, 0x31, 0x02, 0x21, 0x12, 0x31,
+    0x02, 0x21, 0x12, 0x71, 0xA2,
+};
+
+/* level3 */
+/*   ########## */
+/*   # .  .   # */
+/*   #  ##    # */
+/*   # $  $ . # */
+/*   #  ##  . # */
+/*   # $  $   # */
+/*   #  @     # */
+/*   ########## */
+static const uint8_t sokoban_level3_rle[33] = {
+    0xA2, 0x01, 0x03, 0x11, 0x03, 0x21, 0x12, 0x11, 0x12, 0x31, 0x12, 0x01,
+    0x04, 0x11, 0x04, 0x01, 0x03, 0x01, 0x12, 0x11, 0x12, 0x11, 0x03, 0x01,
+    0x12, 0x01, 0x04, 0x11, 0x04, 0x21, 0x12, 0x71, 0xA2,
+};
+
+static const asset_level_t sokoban_levels[SOKOBAN_LEVEL_COUNT] = {
+    { sokoban_level1_rle, sizeof(sokoban_level1_rle), { 3, 4 } },
+    { sokoban_level2_rle, sizeof(sokoban_level2_rle), { 3, 4 } },
+    { sokoban_level3_rle, sizeof(sokoban_level3_rle), { 3, 6 } },
+};
+
+#endif /* __SOKOBAN_ASSETS_H__ */
@@ -0,0 +1,61 @@
+/**
+ ******************************************************************************
+ * @file    tetris_assets.h
+ * @brief   由资源编译器从src/tetris.shp生成,不要手工修改
+ * @note    7 shapes, 14 bytes
+ *          修改源文件后运行: python Tools/asset_compiler/asset_compiler.py
+ ******************************************************************************
+ */
+
+#ifndef __TETRIS_ASSETS_H__
+#define __TETRIS_ASSETS_H__
+
+#include <stdint.h>
+#define TETRIS_SHAPE_COUNT 7
+
+/* I: 0x00F0 */
+/*   .... */
+/*   #### */
+/*   .... */
+/*   .... */
+/* O: 0x0660 */
+/*   .... */
+/*   .##. */
+/*   .##. */
+/*   .... */
+/* T: 0x0720 */
+/*   .... */
+/*   .#.. */
+/*   ###. */
+/*   .... */
+/* S: 0x0360 */
+/*   .... */
+/*   .##. */
+/*   ##.. */
+/*   .... */
+/* Z: 0x0630 */
+/*   .... */
+/*   ##.. */
+/*   .##. */
+/*   .... */
+/* J: 0x0710 */
+/*   .... */
+/*   #... */
+/*   ###. */
+/*   .... */
+/* L: 0x0740 */
+/*   .... */
+/*   ..#. */
+/*   ###. */
+/*   .... */
+static const uint16_t tetris_shapes[TETRIS_SHAPE_COUNT] = {
+    0x00F0,  /* I */
+    0x0660,  /* O */
+    0x0720,  /* T */
+    0x0360,  /* S */
+    0x0630,  /* Z */
+    0x0710,  /* J */
+    0x0740,  /* L */
+};
+
+#endif /* __TETRIS_ASSETS_H__ */
@@ -276,7 +276,7 @@ static void check_brick_collision(breakout_game_t *game)
 
                 // 更新连击
                 game->combo++;
-                game->combo_timer = HAL_GetTick();
+                game->combo_timer = game_manager_get_tick();
 
                 // 得分（连击加成）
                 uint16_t base_score = (brick->type == BRICK_STRONG) ? 20 : 10;
@@ -290,7 +290,7 @@ static void check_brick_collision(breakout_game_t *game)
                     // 检查关卡完成
                     if (game->bricks_remaining == 0) {
                         game->game_state = BREAKOUT_STATE_LEVEL_CLEAR;
-                        game->level_clear_start_time = HAL_GetTick();
+                        game->level_clear_start_time = game_manager_get_tick();
                     }
                 }
 
@@ -338,6 +338,9 @@ void breakout_game_init(breakout_game_t *game)
 
     // 重置球
     reset_ball(game);
+
+    // 新的一局，整屏重绘
+    game->need_redraw = 1;
 }
 
 /**
@@ -347,6 +350,7 @@ void breakout_game_activate(breakout_game_t *game)
 {
     game->is_active = 1;
     game->game_state = BREAKOUT_STATE_AIMING;
+    game->need_redraw = 1;  // 从菜单回来，屏幕上是菜单画面
 }
 
 /**
@@ -386,6 +390,7 @@ void breakout_game_update_input(breakout_game_t *game)
     if (game->game_state == BREAKOUT_STATE_READY) {
         if (input_is_just_pressed(INPUT_BTN_A)) {
             game->game_state = BREAKOUT_STATE_AIMING;
+            game->need_redraw = 1;
         }
         return;
     }
@@ -411,6 +416,7 @@ void breakout_game_update_input(breakout_game_t *game)
                 reset_ball(game);
                 game->game_state = BREAKOUT_STATE_AIMING;
             }
+            game->need_redraw = 1;
         }
         return;
     }
@@ -422,6 +428,7 @@ void breakout_game_update_input(breakout_game_t *game)
         } else if (game->game_state == BREAKOUT_STATE_PAUSED) {
             game->game_state = BREAKOUT_STATE_PLAYING;
         }
+        game->need_redraw = 1;
         return;
     }
 
@@ -433,6 +440,7 @@ void breakout_game_update_input(breakout_game_t *game)
     // 挡板左右移动
     if (input_is_pressed(INPUT_BTN_LEFT)) {
         game->paddle_x -= BREAKOUT_PADDLE_SPEED;
+        game->need_redraw = 1;
         if (game->paddle_x < BREAKOUT_PADDLE_WIDTH / 2) {
             game->paddle_x = BREAKOUT_PADDLE_WIDTH / 2;
         }
@@ -445,6 +453,7 @@ void breakout_game_update_input(breakout_game_t *game)
 
     if (input_is_pressed(INPUT_BTN_RIGHT)) {
         game->paddle_x += BREAKOUT_PADDLE_SPEED;
+        game->need_redraw = 1;
         if (game->paddle_x > BREAKOUT_SCREEN_WIDTH - BREAKOUT_PADDLE_WIDTH / 2) {
             game->paddle_x = BREAKOUT_SCREEN_WIDTH - BREAKOUT_PADDLE_WIDTH / 2;
         }
@@ -459,6 +468,7 @@ void breakout_game_update_input(breakout_game_t *game)
     if (game->game_state == BREAKOUT_STATE_AIMING && input_is_just_pressed(INPUT_BTN_A)) {
         launch_ball(game);
         game->game_state = BREAKOUT_STATE_PLAYING;
+        game->need_redraw = 1;
     }
 }
 
@@ -479,6 +489,7 @@ void breakout_game_update_logic(breakout_game_t *game)
     // 更新球的位置
     if (!game->ball_attached) {
         ball_update(&game->ball);
+        game->need_redraw = 1;  // 球每帧都在移动
 
         // 碰撞检测
         check_wall_collision(game);
@@ -488,9 +499,10 @@ void breakout_game_update_logic(breakout_game_t *game)
 
     // 连击超时检测（1秒无击砖则清空连击）
     if (game->combo > 0) {
-        uint32_t now = HAL_GetTick();
+        uint32_t now = game_manager_get_tick();
         if (now - game->combo_timer > 1000) {
             game->combo = 0;
+            game->need_redraw = 1;
         }
     }
 }
@@ -587,7 +599,7 @@ void breakout_game_render(breakout_game_t *game)
         u8g2_DrawStr(u8g2, 28, 26, "BREAKOUT");
         u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
         u8g2_DrawStr(u8g2, 20, 40, "Press A Start");
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -606,7 +618,7 @@ void breakout_game_render(breakout_game_t *game)
 
         u8g2_DrawStr(u8g2, 10, 58, "START: Restart");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -622,7 +634,7 @@ void breakout_game_render(breakout_game_t *game)
 
         u8g2_DrawStr(u8g2, 10, 58, "START: Restart");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -638,7 +650,7 @@ void breakout_game_render(breakout_game_t *game)
 
         u8g2_DrawStr(u8g2, 22, 58, "Press A Next");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -652,7 +664,7 @@ void breakout_game_render(breakout_game_t *game)
         u8g2_SetFont(u8g2, u8g2_font_7x13_tf);
         u8g2_DrawStr(u8g2, 32, 35, "PAUSED");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -662,7 +674,7 @@ void breakout_game_render(breakout_game_t *game)
     render_ball(game, u8g2);
     render_ui(game, u8g2);
 
-    u8g2_SendBuffer(u8g2);
+    display_service_mark_ready();
 }
 
 /**
@@ -674,5 +686,5 @@ void breakout_game_task(breakout_game_t *game)
 
     breakout_game_update_input(game);
     breakout_game_update_logic(game);
-    breakout_game_render(game);
+    // 渲染由game_manager在need_redraw置位时调用
 }
@@ -99,6 +99,7 @@ typedef struct {
 typedef struct {
     // 活跃状态控制（场景切换）
     uint8_t is_active;                              // 活跃标志
+    uint8_t need_redraw;                            // 画面需要重绘（状态变化时置1，渲染后清零）
     void (*exit_callback)(void);                    // 退出回调
 
     // 游戏状态
@@ -166,6 +167,7 @@ void breakout_game_render(breakout_game_t *game);
 
 /**
  * @brief 游戏主任务
+ * @note  只处理输入和逻辑，渲染由game_manager在need_redraw置位时调用
  */
 void breakout_game_task(breakout_game_t *game);
 
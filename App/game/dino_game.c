@@ -5,60 +5,11 @@
 // =============================================================================
 
 // -----------------------------------------------------------------------------
-// 1. 像素画资源定义（Bitmap数据）
+// 1. 像素画资源定义（Sprite数据）
 // -----------------------------------------------------------------------------
 
-// Chrome T-Rex恐龙跑步动画帧1（12x11）- 完全复刻原版
-static const uint8_t dino_run_frame1[] = {
-    0x00, 0x00,  // ............  (第1行，两个字节)
-    0x1E, 0x00,  // ...####.....  头部上方
-    0x3F, 0x00,  // ..######....  头部
-    0x7F, 0x00,  // .#######....  头部+眼睛
-    0xFE, 0x00,  // #######.....  嘴巴
-    0xFF, 0x00,  // ########....  身体
-    0xFE, 0x00,  // #######.....  身体+尾巴
-    0x7E, 0x00,  // .######.....  腿部连接
-    0x3E, 0x00,  // ..#####.....  腿部
-    0x1C, 0x00,  // ...###......  左腿
-    0x18, 0x00,  // ...##.......  左脚
-};
-
-// Chrome T-Rex恐龙跑步动画帧2（12x11）- 跑步姿势
-static const uint8_t dino_run_frame2[] = {
-    0x00, 0x00,  // ............
-    0x1E, 0x00,  // ...####.....  头部上方
-    0x3F, 0x00,  // ..######....  头部
-    0x7F, 0x00,  // .#######....  头部+眼睛
-    0xFE, 0x00,  // #######.....  嘴巴
-    0xFF, 0x00,  // ########....  身体
-    0xFE, 0x00,  // #######.....  身体+尾巴
-    0x7E, 0x00,  // .######.....  腿部连接
-    0x3E, 0x00,  // ..#####.....  腿部
-    0x38, 0x00,  // ..###.......  右腿
-    0x30, 0x00,  // ..##........  右脚
-};
-
-// 仙人掌（6x10）- 降低高度
-static const uint8_t cactus_bitmap[] = {
-    0x30,  // ..##....
-    0x30,  // ..##....
-    0x78,  // .####...
-    0x78,  // .####...
-    0xFC,  // ######..
-    0x30,  // ..##....
-    0x30,  // ..##....
-    0x30,  // ..##....
-    0x30,  // ..##....
-    0x30,  // ..##....
-};
-
-// 云朵（8x4）
-static const uint8_t cloud_bitmap[] = {
-    0x7E,  // .######.
-    0xFF,  // ########
-    0xFF,  // ########
-    0x7E,  // .######.
-};
+// 由App/assets/src/dino.spr生成的页格式sprite（恐龙两帧带预移位数据）
+#include "dino_assets.h"
 
 // -----------------------------------------------------------------------------
 // 2. 内部辅助函数声明
@@ -79,8 +30,6 @@ static void draw_obstacles(dino_game_t *game, u8g2_t *u8g2);
 static void draw_clouds(dino_game_t *game, u8g2_t *u8g2);
 static void draw_ground(u8g2_t *u8g2);
 static void draw_game_over(dino_game_t *game, u8g2_t *u8g2);
-static void draw_bitmap(u8g2_t *u8g2, int16_t x, int16_t y, const uint8_t *bitmap,
-                        uint8_t w, uint8_t h);
 
 // -----------------------------------------------------------------------------
 // 3. API函数实现
@@ -118,7 +67,7 @@ void dino_game_init(dino_game_t *game)
     game->last_speed_up_score = 0;
 
     // 初始化时间戳
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
     game->last_frame_time = now;
     game->last_logic_update_time = now;
     game->last_score_time = now;
@@ -134,6 +83,9 @@ void dino_game_init(dino_game_t *game)
 
     // 初始化云朵
     init_clouds(game);
+
+    // 新的一局，整屏重绘
+    game->need_redraw = 1;
 }
 
 /**
@@ -157,10 +109,11 @@ void dino_game_update_input(dino_game_t *game)
         if (input_is_just_pressed(INPUT_BTN_A))
         {
             game->game_state = DINO_STATE_RUNNING;
+            game->need_redraw = 1;
             game->score = 0;
             game->speed = DINO_INITIAL_SPEED;
-            game->last_score_time = HAL_GetTick();
-            game->last_obstacle_time = HAL_GetTick();
+            game->last_score_time = game_manager_get_tick();
+            game->last_obstacle_time = game_manager_get_tick();
         }
     }
     else if (game->game_state == DINO_STATE_RUNNING)
@@ -171,8 +124,8 @@ void dino_game_update_input(dino_game_t *game)
             if (game->jump_state == DINO_JUMP_IDLE)
             {
                 game->jump_state = DINO_JUMP_RISING;
-                game->jump_start_time = HAL_GetTick();
-                game->jump_button_press_time = HAL_GetTick();
+                game->jump_start_time = game_manager_get_tick();
+                game->jump_button_press_time = game_manager_get_tick();
                 game->current_jump_height = DINO_JUMP_HEIGHT;  // 先设置为普通跳跃
             }
         }
@@ -180,7 +133,7 @@ void dino_game_update_input(dino_game_t *game)
         // 检测长按A键（跳得更高）
         if (game->jump_state == DINO_JUMP_RISING && input_is_pressed(INPUT_BTN_A))
         {
-            uint32_t hold_time = HAL_GetTick() - game->jump_button_press_time;
+            uint32_t hold_time = game_manager_get_tick() - game->jump_button_press_time;
             if (hold_time >= DINO_LONG_PRESS_TIME)
             {
                 game->current_jump_height = DINO_JUMP_HEIGHT_HIGH;  // 升级为高跳
@@ -194,8 +147,8 @@ void dino_game_update_input(dino_game_t *game)
         {
             dino_game_init(game);
             game->game_state = DINO_STATE_RUNNING;
-            game->last_score_time = HAL_GetTick();
-            game->last_obstacle_time = HAL_GetTick();
+            game->last_score_time = game_manager_get_tick();
+            game->last_obstacle_time = game_manager_get_tick();
         }
     }
 }
@@ -210,7 +163,10 @@ void dino_game_update_logic(dino_game_t *game)
         return;  // 只在运行状态更新逻辑
     }
 
-    uint32_t now = HAL_GetTick();
+    // 运行中地面和障碍物每帧都在滚动，画面必然变化
+    game->need_redraw = 1;
+
+    uint32_t now = game_manager_get_tick();
 
     // 1. 更新跳跃
     update_jump(game);
@@ -294,7 +250,8 @@ void dino_game_render(dino_game_t *game)
         draw_game_over(game, u8g2);
     }
 
-    u8g2_SendBuffer(u8g2);
+    // 标记一帧就绪，由显示服务发送
+    display_service_mark_ready();
 }
 
 /**
@@ -308,7 +265,7 @@ void dino_game_task(dino_game_t *game)
         return;
     }
 
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
 
     // 帧率控制：30fps（33ms一帧）
     if (now - game->last_frame_time < DINO_FRAME_TIME_MS)
@@ -321,10 +278,9 @@ void dino_game_task(dino_game_t *game)
     // 更新帧时间
     game->last_frame_time = now;
 
-    // 完整游戏循环（30fps）
+    // 完整游戏循环（30fps），渲染由game_manager在need_redraw置位时调用
     dino_game_update_input(game);
     dino_game_update_logic(game);
-    dino_game_render(game);
 }
 
 /**
@@ -333,6 +289,7 @@ void dino_game_task(dino_game_t *game)
 void dino_game_activate(dino_game_t *game)
 {
     game->is_active = 1;
+    game->need_redraw = 1;  // 从菜单回来，屏幕上是菜单画面
 }
 
 /**
@@ -378,7 +335,7 @@ static void update_jump(dino_game_t *game)
         return;  // 在地面上，无需更新
     }
 
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
     uint32_t elapsed = now - game->jump_start_time;
 
     if (game->jump_state == DINO_JUMP_RISING)
@@ -427,7 +384,7 @@ static void update_animation(dino_game_t *game)
         return;
     }
 
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
     if (now - game->last_anim_time >= DINO_RUN_ANIM_INTERVAL)
     {
         game->run_anim_frame = 1 - game->run_anim_frame;  // 0和1切换
@@ -454,7 +411,7 @@ static void spawn_obstacle(dino_game_t *game)
             // 随机下次生成延迟
             game->next_obstacle_delay = (uint16_t)rng_get_random_range(
                 DINO_OBSTACLE_MIN_DELAY, DINO_OBSTACLE_MAX_DELAY);
-            game->last_obstacle_time = HAL_GetTick();
+            game->last_obstacle_time = game_manager_get_tick();
             break;
         }
     }
@@ -548,7 +505,7 @@ static uint8_t check_collision(dino_game_t *game)
  */
 static void update_score(dino_game_t *game)
 {
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
 
     // 每100ms增加1分
     if (now - game->last_score_time >= DINO_SCORE_INTERVAL)
@@ -602,13 +559,12 @@ static void draw_ui(dino_game_t *game, u8g2_t *u8g2)
  */
 static void draw_dino(dino_game_t *game, u8g2_t *u8g2)
 {
-    // 根据动画帧选择bitmap
-    const uint8_t *bitmap = (game->run_anim_frame == 0) ?
-                            dino_run_frame1 : dino_run_frame2;
+    // 根据动画帧选择sprite
+    const sprite_t *sprite = (game->run_anim_frame == 0) ?
+                             &dino_run_frame1 : &dino_run_frame2;
 
     // 绘制恐龙
-    draw_bitmap(u8g2, DINO_X, game->dino_y - DINO_HEIGHT,
-                bitmap, DINO_WIDTH, DINO_HEIGHT);
+    sprite_blit(u8g2, DINO_X, game->dino_y - DINO_HEIGHT, sprite, SPRITE_MODE_OR);
 }
 
 /**
@@ -626,8 +582,7 @@ static void draw_obstacles(dino_game_t *game, u8g2_t *u8g2)
         dino_obstacle_t *obs = &game->obstacles[i];
 
         // 绘制仙人掌
-        draw_bitmap(u8g2, obs->x, DINO_GROUND_Y - obs->height,
-                    cactus_bitmap, obs->width, obs->height);
+        sprite_blit(u8g2, obs->x, DINO_GROUND_Y - obs->height, &sprite_cactus, SPRITE_MODE_OR);
     }
 }
 
@@ -644,8 +599,7 @@ static void draw_clouds(dino_game_t *game, u8g2_t *u8g2)
         }
 
         // 绘制云朵
-        draw_bitmap(u8g2, game->clouds[i].x, game->clouds[i].y,
-                    cloud_bitmap, 8, 4);
+        sprite_blit(u8g2, game->clouds[i].x, game->clouds[i].y, &sprite_cloud, SPRITE_MODE_OR);
     }
 }
 
@@ -682,30 +636,3 @@ static void draw_game_over(dino_game_t *game, u8g2_t *u8g2)
     u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
     u8g2_DrawStr(u8g2, 20, 40, "Press A to Retry");
 }
-
-/**
- * @brief 绘制Bitmap（像素画，支持多字节宽度）
- */
-static void draw_bitmap(u8g2_t *u8g2, int16_t x, int16_t y, const uint8_t *bitmap,
-                        uint8_t w, uint8_t h)
-{
-    // 计算每行需要多少字节（向上取整）
-    uint8_t bytes_per_row = (w + 7) / 8;
-
-    for (uint8_t row = 0; row < h; row++)
-    {
-        // 遍历当前行的所有像素
-        for (uint8_t col = 0; col < w; col++)
-        {
-            // 计算当前像素在bitmap中的位置
-            uint8_t byte_index = row * bytes_per_row + (col / 8);
-            uint8_t bit_index = 7 - (col % 8);
-
-            // 检查对应的bit是否为1
-            if (bitmap[byte_index] & (1 << bit_index))
-            {
-                u8g2_DrawPixel(u8g2, x + col, y + row);
-            }
-        }
-    }
-}
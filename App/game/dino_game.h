@@ -114,6 +114,7 @@ typedef struct {
     // 游戏状态
     dino_game_state_t game_state;       /*!< 游戏当前状态 */
     uint8_t is_active;                  /*!< 游戏是否活跃（1=活跃，0=停止）*/
+    uint8_t need_redraw;                /*!< 画面需要重绘（状态变化时置1，渲染后清零）*/
     void (*exit_callback)(void);        /*!< 退出回调函数（按B键返回菜单）*/
 
     // 恐龙状态
@@ -180,7 +181,8 @@ void dino_game_render(dino_game_t *game);
 /**
  * @brief 游戏主任务（周期调用）
  * @param game: 游戏状态结构体指针
- * @note  集成输入、逻辑、渲染的完整游戏循环，带帧率控制
+ * @note  集成输入、逻辑的游戏循环，带帧率控制
+ *        渲染由game_manager在need_redraw置位时调用dino_game_render
  */
 void dino_game_task(dino_game_t *game);
 
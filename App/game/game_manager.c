@@ -1,4 +1,6 @@
 #include "game_manager.h"
+#include "event_bus.h"
+#include "input_replay.h"
 
 // =============================================================================
 // 游戏管理器实现
@@ -17,6 +19,12 @@ typedef struct {
     const game_descriptor_t *registry[MAX_GAMES];  /*!< 游戏注册表 */
     uint8_t game_count;                            /*!< 已注册游戏数量 */
     const game_descriptor_t *current_game;         /*!< 当前运行的游戏 */
+    uint8_t current_index;                         /*!< 当前游戏在注册表中的下标 */
+    const game_descriptor_t *idle_games[MAX_GAMES];/*!< 有idle钩子的游戏（注册时筛选） */
+    uint8_t idle_count;                            /*!< 有idle钩子的游戏数量 */
+    game_render_stats_t render_stats[MAX_GAMES];   /*!< 各游戏的渲染统计（与注册表下标对应） */
+    uint8_t force_redraw;                          /*!< 强制每帧重绘（对比测试用） */
+    uint32_t frame_tick;                           /*!< 本帧的游戏时钟（每帧开始时锁存） */
 } game_manager_t;
 
 // 游戏管理器全局实例
@@ -35,6 +43,22 @@ static void game_exit_callback(void)
     game_manager_exit_current_game();
 }
 
+/**
+ * @brief 在事件总线上发布场景切换（后台服务用，没人订阅时直接丢弃）
+ * @param type: EVENT_SYSTEM_GAME_ENTER / EVENT_SYSTEM_GAME_EXIT
+ * @param index: 游戏在注册表中的下标
+ */
+static void game_manager_publish_system(event_system_type_t type, uint8_t index)
+{
+    app_event_t evt;
+
+    evt.source_id = EVENT_SOURCE_SYSTEM;
+    evt.event_type = (uint8_t)type;
+    evt.data = index;
+    evt.timestamp_us = scheduler_get_time_us();
+    event_bus_publish(EVENT_TOPIC_SYSTEM, evt);
+}
+
 // -----------------------------------------------------------------------------
 // 3. API函数实现
 // -----------------------------------------------------------------------------
@@ -66,6 +90,13 @@ int game_manager_register(const game_descriptor_t *descriptor)
     g_game_manager.registry[g_game_manager.game_count] = descriptor;
     g_game_manager.game_count++;
 
+    // 需要后台运行的游戏单独记下来，每个tick不用再遍历整个注册表
+    if (descriptor->interface.idle != NULL)
+    {
+        g_game_manager.idle_games[g_game_manager.idle_count] = descriptor;
+        g_game_manager.idle_count++;
+    }
+
     return 0;
 }
 
@@ -78,11 +109,13 @@ int game_manager_start_game(const char *game_name)
 {
     // 查找游戏
     const game_descriptor_t *game = NULL;
+    uint8_t index = 0;
     for (uint8_t i = 0; i < g_game_manager.game_count; i++)
     {
         if (strcmp(g_game_manager.registry[i]->name, game_name) == 0)
         {
             game = g_game_manager.registry[i];
+            index = i;
             break;
         }
     }
@@ -102,6 +135,9 @@ int game_manager_start_game(const char *game_name)
     input_manager_clear();
     event_queue_clear();
 
+    // 录制或回放从这里开始：随机数种子和游戏时钟要在游戏init之前定下来
+    g_game_manager.frame_tick = input_replay_game_start(index, HAL_GetTick());
+
     // 3. 初始化游戏
     if (game->interface.init != NULL)
     {
@@ -122,6 +158,10 @@ int game_manager_start_game(const char *game_name)
 
     // 6. 记录当前游戏
     g_game_manager.current_game = game;
+    g_game_manager.current_index = index;
+
+    // 7. 通知后台订阅者（事件总线）
+    game_manager_publish_system(EVENT_SYSTEM_GAME_ENTER, index);
 
     return 0;
 }
@@ -150,12 +190,16 @@ void game_manager_exit_current_game(void)
     // 2. 清空输入状态和事件队列（避免游戏残留事件影响菜单）
     input_manager_clear();
     event_queue_clear();
+    input_replay_game_exit(HAL_GetTick());
 
     // 3. 激活菜单
     main_menu_activate();
 
     // 4. 清除当前游戏记录
     g_game_manager.current_game = NULL;
+
+    // 5. 通知后台订阅者（事件总线）
+    game_manager_publish_system(EVENT_SYSTEM_GAME_EXIT, g_game_manager.current_index);
 }
 
 /**
@@ -168,19 +212,126 @@ const game_descriptor_t* game_manager_get_current_game(void)
 }
 
 /**
- * @brief 调用所有游戏的任务函数
+ * @brief 运行当前游戏的一帧：task，画面有变化再render
+ */
+static void game_manager_run_frame(const game_descriptor_t *game, uint8_t index)
+{
+    // 只调度当前游戏，注册表里其他游戏每个tick没有任何开销
+    if (game->interface.task != NULL)
+    {
+        uint32_t start = perf_hud_begin();
+        game->interface.task(game->instance);
+        perf_hud_end(PERF_PHASE_LOGIC, start);
+    }
+
+    // task里可能已经退出回菜单
+    if (game != g_game_manager.current_game || game->interface.render == NULL)
+    {
+        return;
+    }
+
+    // 画面没有变化：跳过渲染，也就不会标记新帧去刷屏
+    if (!g_game_manager.force_redraw &&
+        game->interface.needs_redraw != NULL &&
+        !game->interface.needs_redraw(game->instance))
+    {
+        g_game_manager.render_stats[index].skipped_frames++;
+        return;
+    }
+
+    uint32_t start = perf_hud_begin();
+    game->interface.render(game->instance);
+    perf_hud_end(PERF_PHASE_RENDER, start);
+    g_game_manager.render_stats[index].rendered_frames++;
+}
+
+/**
+ * @brief 游戏管理器任务（只调度当前游戏）
  * @note  在调度器中注册，10ms周期调用
  */
 void game_manager_task_all(void)
 {
-    // 遍历所有注册的游戏，调用它们的task函数
-    // 游戏内部会检查is_active标志，决定是否执行逻辑
+    const game_descriptor_t *game = g_game_manager.current_game;
+    uint32_t frame_start;
+
+    // 锁存本帧的游戏时钟；回放时同时把这一帧之前录下的输入送进input_manager
+    g_game_manager.frame_tick = input_replay_frame_begin(HAL_GetTick());
+
+    // 后台钩子：只遍历注册时筛选出来的游戏，不是当前游戏才调用
+    for (uint8_t i = 0; i < g_game_manager.idle_count; i++)
+    {
+        if (g_game_manager.idle_games[i] != game)
+        {
+            g_game_manager.idle_games[i]->interface.idle(g_game_manager.idle_games[i]->instance);
+        }
+    }
+
+    // 没有游戏在运行（菜单界面）
+    if (game == NULL)
+    {
+        return;
+    }
+
+    frame_start = scheduler_get_time_us();
+    game_manager_run_frame(game, g_game_manager.current_index);
+    input_replay_frame_end(scheduler_get_time_us() - frame_start);
+}
+
+/**
+ * @brief 获取游戏的渲染统计
+ * @param game_name: 游戏名称（如"Snake"）
+ * @param stats: 输出统计信息
+ * @return 0=成功，-1=游戏未找到
+ */
+int game_manager_get_render_stats(const char *game_name, game_render_stats_t *stats)
+{
     for (uint8_t i = 0; i < g_game_manager.game_count; i++)
     {
-        const game_descriptor_t *game = g_game_manager.registry[i];
-        if (game->interface.task != NULL)
+        if (strcmp(g_game_manager.registry[i]->name, game_name) == 0)
         {
-            game->interface.task(game->instance);
+            *stats = g_game_manager.render_stats[i];
+            return 0;
         }
     }
+
+    return -1;  // 游戏未找到
+}
+
+/**
+ * @brief 清零所有游戏的渲染统计
+ */
+void game_manager_reset_render_stats(void)
+{
+    memset(g_game_manager.render_stats, 0, sizeof(g_game_manager.render_stats));
+}
+
+/**
+ * @brief 强制每帧重绘
+ * @param enable: 1=每帧都渲染，0=只在画面变化时渲染
+ */
+void game_manager_set_force_redraw(uint8_t enable)
+{
+    g_game_manager.force_redraw = enable;
+}
+
+/**
+ * @brief 获取游戏时钟
+ */
+uint32_t game_manager_get_tick(void)
+{
+    return g_game_manager.frame_tick;
+}
+
+/**
+ * @brief 回放最近一次录制（或 input_replay_load 载入的录制）
+ */
+int game_manager_start_replay(void)
+{
+    int index = input_replay_arm_playback();
+
+    if (index < 0 || index >= g_game_manager.game_count)
+    {
+        return -1;
+    }
+    return game_manager_start_game(g_game_manager.registry[index]->name);
 }
@@ -45,10 +45,37 @@ typedef struct {
     /**
      * @brief 游戏任务函数
      * @param instance: 游戏实例指针
-     * @note  10ms周期调用，处理输入+逻辑+渲染
+     * @note  10ms周期调用，处理输入+逻辑
+     *        画面状态发生变化时置位need_redraw，渲染由game_manager负责
      */
     void (*task)(void *instance);
 
+    /**
+     * @brief 渲染游戏画面
+     * @param instance: 游戏实例指针
+     * @note  由game_manager在needs_redraw返回1时调用，渲染后清除need_redraw
+     *        为NULL表示游戏在task里自己渲染（不参与跳帧）
+     */
+    void (*render)(void *instance);
+
+    /**
+     * @brief 查询画面是否需要重绘
+     * @param instance: 游戏实例指针
+     * @return 1=画面状态有变化，0=和上一帧相同
+     * @note  与menu_core的need_refresh同理：游戏在输入/逻辑步骤里
+     *        改变了画面状态才置位，没有变化的帧跳过渲染和刷屏
+     */
+    uint8_t (*needs_redraw)(void *instance);
+
+    /**
+     * @brief 后台钩子（可选）
+     * @param instance: 游戏实例指针
+     * @note  游戏不是当前游戏时（在菜单里或运行别的游戏），10ms周期调用
+     *        只给确实需要在后台走时间的游戏使用（如计时、存档），
+     *        不需要的游戏保持NULL，game_manager不会为它产生任何开销
+     */
+    void (*idle)(void *instance);
+
     /**
      * @brief 设置退出回调
      * @param instance: 游戏实例指针
@@ -71,6 +98,14 @@ typedef struct {
     game_interface_t interface; /*!< 游戏接口实现（函数指针表）*/
 } game_descriptor_t;
 
+/**
+ * @brief 游戏渲染统计
+ */
+typedef struct {
+    uint32_t rendered_frames;   /*!< 实际渲染的帧数 */
+    uint32_t skipped_frames;    /*!< 画面没有变化而跳过的帧数 */
+} game_render_stats_t;
+
 // -----------------------------------------------------------------------------
 // 3. API函数声明
 // -----------------------------------------------------------------------------
@@ -118,12 +153,51 @@ void game_manager_exit_current_game(void);
 const game_descriptor_t* game_manager_get_current_game(void);
 
 /**
- * @brief 调用所有游戏的任务函数
+ * @brief 游戏管理器任务
  * @note  在调度器中注册，10ms周期调用
- *        内部会调用所有注册游戏的task函数，游戏自己检查is_active决定是否执行
+ *        只调用当前游戏的task，其他游戏只有设置了idle钩子才会被调用，
+ *        每个tick的开销和注册了多少游戏无关
+ *        当前游戏的画面有变化时再调用它的render，否则跳帧（计入skipped_frames）
  */
 void game_manager_task_all(void);
 
+/**
+ * @brief 获取游戏的渲染统计
+ * @param game_name: 游戏名称（如"Snake"）
+ * @param stats: 输出统计信息
+ * @return 0=成功，-1=游戏未找到
+ */
+int game_manager_get_render_stats(const char *game_name, game_render_stats_t *stats);
+
+/**
+ * @brief 清零所有游戏的渲染统计
+ */
+void game_manager_reset_render_stats(void);
+
+/**
+ * @brief 强制每帧重绘（忽略needs_redraw）
+ * @param enable: 1=每帧都渲染，0=只在画面变化时渲染（默认）
+ * @note  用于对比测试跳帧节省的CPU时间和I2C流量
+ */
+void game_manager_set_force_redraw(uint8_t enable);
+
+/**
+ * @brief 获取游戏时钟（毫秒）
+ * @return 本帧开始时锁存的时钟
+ * @note  游戏计时一律用它代替HAL_GetTick()：同一帧里的task/render看到同一个时刻，
+ *        回放时是录制时的时钟，游戏才能逐帧复现（见input_replay.h）
+ */
+uint32_t game_manager_get_tick(void);
+
+/**
+ * @brief 回放最近一局的录制
+ * @return 0=成功，-1=没有可回放的录制
+ * @note  在菜单里调用：用录制时的随机数种子和游戏时钟启动同一个游戏，
+ *        按帧送入录制的输入，录制结束后游戏继续接受实时输入；
+ *        统计（帧数、逻辑+渲染耗时、最慢一帧）用input_replay_get_stats获取
+ */
+int game_manager_start_replay(void);
+
 // -----------------------------------------------------------------------------
 // 4. 辅助宏定义（简化游戏注册代码）
 // -----------------------------------------------------------------------------
@@ -139,7 +213,10 @@ void game_manager_task_all(void);
  *        - snake_game_adapter_activate()
  *        - snake_game_adapter_deactivate()
  *        - snake_game_adapter_task()
+ *        - snake_game_adapter_render()
+ *        - snake_game_adapter_needs_redraw()
  *        - snake_game_adapter_set_exit_callback()
+ *        游戏状态结构体必须包含uint8_t need_redraw成员
  */
 #define GAME_ADAPTER(game_name, game_type)                                     \
     static void game_name##_adapter_init(void *instance)                       \
@@ -158,6 +235,15 @@ void game_manager_task_all(void);
     {                                                                          \
         game_name##_task((game_type *)instance);                               \
     }                                                                          \
+    static void game_name##_adapter_render(void *instance)                     \
+    {                                                                          \
+        game_name##_render((game_type *)instance);                             \
+        ((game_type *)instance)->need_redraw = 0;                              \
+    }                                                                          \
+    static uint8_t game_name##_adapter_needs_redraw(void *instance)            \
+    {                                                                          \
+        return ((game_type *)instance)->need_redraw;                           \
+    }                                                                          \
     static void game_name##_adapter_set_exit_callback(void *instance,          \
                                                        void (*callback)(void)) \
     {                                                                          \
@@ -185,6 +271,8 @@ void game_manager_task_all(void);
             .activate = game_prefix##_adapter_activate,                        \
             .deactivate = game_prefix##_adapter_deactivate,                    \
             .task = game_prefix##_adapter_task,                                \
+            .render = game_prefix##_adapter_render,                            \
+            .needs_redraw = game_prefix##_adapter_needs_redraw,                \
             .set_exit_callback = game_prefix##_adapter_set_exit_callback,      \
         }                                                                      \
     }
@@ -24,6 +24,9 @@ static uint8_t count_neighbor_mines(minesweeper_game_t *game, int8_t x, int8_t y
 
 // 渲染辅助
 static void render_grid(minesweeper_game_t *game, u8g2_t *u8g2);
+static void render_cell(minesweeper_game_t *game, u8g2_t *u8g2, int8_t x, int8_t y);
+static void update_cell(minesweeper_game_t *game, int8_t x, int8_t y);
+static void render_background(minesweeper_game_t *game, u8g2_t *u8g2);
 static void render_ui(minesweeper_game_t *game, u8g2_t *u8g2);
 static void render_cursor(minesweeper_game_t *game, u8g2_t *u8g2);
 
@@ -47,6 +50,10 @@ static void reset_game(minesweeper_game_t *game)
     game->first_click = 1;
     game->game_time = 0;
     game->game_start_time = 0;
+    game->need_redraw = 1;
+
+    // 所有格子恢复未翻开，背景缓存下一帧重建
+    layer_invalidate();
 
     // 设置地雷总数（根据难度）
     switch (game->difficulty) {
@@ -138,12 +145,13 @@ static void reveal_cell(minesweeper_game_t *game, int8_t x, int8_t y)
     if (game->first_click) {
         game->first_click = 0;
         generate_mines(game, x, y);
-        game->game_start_time = HAL_GetTick();
+        game->game_start_time = game_manager_get_tick();
     }
 
     // 翻开格子
     cell->is_revealed = 1;
     game->cells_revealed++;
+    update_cell(game, x, y);
 
     // 踩到地雷：游戏结束
     if (cell->has_mine) {
@@ -188,6 +196,7 @@ static void reveal_cell_recursive(minesweeper_game_t *game, int8_t x, int8_t y)
         // 翻开邻居格子
         neighbor->is_revealed = 1;
         game->cells_revealed++;
+        update_cell(game, nx, ny);
 
         // 如果邻居也是空白格子，继续递归
         if (neighbor->neighbor_mines == 0) {
@@ -224,6 +233,7 @@ static void toggle_flag(minesweeper_game_t *game, int8_t x, int8_t y)
             game->flags_placed++;
         }
     }
+    update_cell(game, x, y);
 }
 
 /**
@@ -305,6 +315,7 @@ void minesweeper_game_init(minesweeper_game_t *game)
 void minesweeper_game_activate(minesweeper_game_t *game)
 {
     game->is_active = 1;
+    game->need_redraw = 1;  // 从菜单回来，屏幕上是菜单画面
 }
 
 /**
@@ -358,6 +369,7 @@ void minesweeper_game_update_input(minesweeper_game_t *game)
         // A键：开始游戏
         if (input_is_just_pressed(INPUT_BTN_A)) {
             game->game_state = MINE_STATE_PLAYING;
+            game->need_redraw = 1;
         }
         return;
     }
@@ -379,6 +391,7 @@ void minesweeper_game_update_input(minesweeper_game_t *game)
         } else if (game->game_state == MINE_STATE_PAUSED) {
             game->game_state = MINE_STATE_PLAYING;
         }
+        game->need_redraw = 1;
         return;
     }
 
@@ -392,29 +405,35 @@ void minesweeper_game_update_input(minesweeper_game_t *game)
         if (input_is_just_pressed(INPUT_BTN_UP)) {
             if (game->cursor_y > 0) {
                 game->cursor_y--;
+                game->need_redraw = 1;
             }
         } else if (input_is_just_pressed(INPUT_BTN_DOWN)) {
             if (game->cursor_y < MINE_GRID_HEIGHT - 1) {
                 game->cursor_y++;
+                game->need_redraw = 1;
             }
         } else if (input_is_just_pressed(INPUT_BTN_LEFT)) {
             if (game->cursor_x > 0) {
                 game->cursor_x--;
+                game->need_redraw = 1;
             }
         } else if (input_is_just_pressed(INPUT_BTN_RIGHT)) {
             if (game->cursor_x < MINE_GRID_WIDTH - 1) {
                 game->cursor_x++;
+                game->need_redraw = 1;
             }
         }
 
         // A键：翻开格子
         if (input_is_just_pressed(INPUT_BTN_A)) {
             reveal_cell(game, game->cursor_x, game->cursor_y);
+            game->need_redraw = 1;
         }
 
         // Y键：标记/取消标记旗帜
         if (input_is_just_pressed(INPUT_BTN_Y)) {
             toggle_flag(game, game->cursor_x, game->cursor_y);
+            game->need_redraw = 1;
         }
     }
 }
@@ -430,8 +449,14 @@ void minesweeper_game_update_logic(minesweeper_game_t *game)
 
     // 只有PLAYING状态更新时间
     if (game->game_state == MINE_STATE_PLAYING && game->game_start_time > 0) {
-        uint32_t elapsed = HAL_GetTick() - game->game_start_time;
-        game->game_time = elapsed / 1000;  // 转换为秒
+        uint32_t elapsed = game_manager_get_tick() - game->game_start_time;
+        uint32_t seconds = elapsed / 1000;  // 转换为秒
+
+        // 计时显示到秒，秒数变了才需要重绘
+        if (seconds != game->game_time) {
+            game->game_time = seconds;
+            game->need_redraw = 1;
+        }
     }
 }
 
@@ -444,44 +469,84 @@ static void render_grid(minesweeper_game_t *game, u8g2_t *u8g2)
 {
     for (int8_t y = 0; y < MINE_GRID_HEIGHT; y++) {
         for (int8_t x = 0; x < MINE_GRID_WIDTH; x++) {
-            mine_cell_t *cell = &game->cells[y][x];
-
-            int16_t px = MINE_OFFSET_X + x * MINE_CELL_WIDTH;
-            int16_t py = MINE_OFFSET_Y + y * MINE_CELL_HEIGHT;
-
-            // 未翻开的格子
-            if (!cell->is_revealed) {
-                // 绘制空心方块
-                u8g2_DrawFrame(u8g2, px, py, MINE_CELL_WIDTH - 1, MINE_CELL_HEIGHT - 1);
-
-                // 如果有旗帜，绘制旗帜标记（小三角）
-                if (cell->is_flagged) {
-                    u8g2_DrawTriangle(u8g2,
-                                      px + 2, py + MINE_CELL_HEIGHT - 3,
-                                      px + MINE_CELL_WIDTH - 3, py + 2,
-                                      px + MINE_CELL_WIDTH - 3, py + MINE_CELL_HEIGHT - 3);
-                }
-            }
-            // 已翻开的格子
-            else {
-                // 显示地雷（失败状态）
-                if (cell->has_mine) {
-                    u8g2_DrawBox(u8g2, px + 2, py + 2, MINE_CELL_WIDTH - 4, MINE_CELL_HEIGHT - 4);
-                }
-                // 显示数字
-                else if (cell->neighbor_mines > 0) {
-                    u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
-                    char buf[2];
-                    buf[0] = '0' + cell->neighbor_mines;
-                    buf[1] = '\0';
-                    u8g2_DrawStr(u8g2, px + 3, py + 6, buf);
-                }
-                // 空白格子（neighbor_mines == 0）：什么都不画
-            }
+            render_cell(game, u8g2, x, y);
         }
     }
 }
 
+/**
+ * @brief 渲染一个格子
+ */
+static void render_cell(minesweeper_game_t *game, u8g2_t *u8g2, int8_t x, int8_t y)
+{
+    mine_cell_t *cell = &game->cells[y][x];
+
+    int16_t px = MINE_OFFSET_X + x * MINE_CELL_WIDTH;
+    int16_t py = MINE_OFFSET_Y + y * MINE_CELL_HEIGHT;
+
+    // 未翻开的格子
+    if (!cell->is_revealed) {
+        // 绘制空心方块
+        u8g2_DrawFrame(u8g2, px, py, MINE_CELL_WIDTH - 1, MINE_CELL_HEIGHT - 1);
+
+        // 如果有旗帜，绘制旗帜标记（小三角）
+        if (cell->is_flagged) {
+            u8g2_DrawTriangle(u8g2,
+                              px + 2, py + MINE_CELL_HEIGHT - 3,
+                              px + MINE_CELL_WIDTH - 3, py + 2,
+                              px + MINE_CELL_WIDTH - 3, py + MINE_CELL_HEIGHT - 3);
+        }
+    }
+    // 已翻开的格子
+    else {
+        // 显示地雷（失败状态）
+        if (cell->has_mine) {
+            u8g2_DrawBox(u8g2, px + 2, py + 2, MINE_CELL_WIDTH - 4, MINE_CELL_HEIGHT - 4);
+        }
+        // 显示数字
+        else if (cell->neighbor_mines > 0) {
+            u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
+            char buf[2];
+            buf[0] = '0' + cell->neighbor_mines;
+            buf[1] = '\0';
+            u8g2_DrawStr(u8g2, px + 3, py + 6, buf);
+        }
+        // 空白格子（neighbor_mines == 0）：什么都不画
+    }
+}
+
+/**
+ * @brief 格子变化后只重画背景缓存中的这一格
+ */
+static void update_cell(minesweeper_game_t *game, int8_t x, int8_t y)
+{
+    u8g2_t *u8g2 = u8g2_get_instance();
+
+    if (layer_begin_update(u8g2, game)) {
+        u8g2_SetDrawColor(u8g2, 0);
+        u8g2_DrawBox(u8g2, MINE_OFFSET_X + x * MINE_CELL_WIDTH, MINE_OFFSET_Y + y * MINE_CELL_HEIGHT,
+                     MINE_CELL_WIDTH, MINE_CELL_HEIGHT);
+        u8g2_SetDrawColor(u8g2, 1);
+        render_cell(game, u8g2, x, y);
+        layer_end(u8g2);
+    }
+}
+
+/**
+ * @brief 绘制背景（网格）
+ * @note  网格缓存在背景层里，每帧只复制一次，代替u8g2_ClearBuffer()
+ *        翻开和插旗时局部更新，重新开局后整块重建
+ */
+static void render_background(minesweeper_game_t *game, u8g2_t *u8g2)
+{
+    if (!layer_blit(u8g2, game)) {
+        layer_begin_rebuild(u8g2, game);
+        render_grid(game, u8g2);
+        layer_end(u8g2);
+        layer_blit(u8g2, game);
+    }
+}
+
 /**
  * @brief 渲染光标
  */
@@ -532,7 +597,13 @@ void minesweeper_game_render(minesweeper_game_t *game)
     if (!game->is_active) return;
 
     u8g2_t *u8g2 = u8g2_get_instance();
-    u8g2_ClearBuffer(u8g2);
+
+    // 有网格的画面用背景层代替清屏，之后只画光标和UI
+    if (game->game_state == MINE_STATE_READY) {
+        u8g2_ClearBuffer(u8g2);
+    } else {
+        render_background(game, u8g2);
+    }
 
     // READY状态：难度选择
     if (game->game_state == MINE_STATE_READY) {
@@ -548,13 +619,12 @@ void minesweeper_game_render(minesweeper_game_t *game)
 
         u8g2_DrawStr(u8g2, 20, 58, "Press A to Start");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // WIN状态
     if (game->game_state == MINE_STATE_WIN) {
-        render_grid(game, u8g2);
         render_ui(game, u8g2);
 
         u8g2_SetFont(u8g2, u8g2_font_7x13_tf);
@@ -563,14 +633,12 @@ void minesweeper_game_render(minesweeper_game_t *game)
         u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
         u8g2_DrawStr(u8g2, 10, 58, "START: Restart");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // LOSE状态
     if (game->game_state == MINE_STATE_LOSE) {
-        // 显示所有地雷
-        render_grid(game, u8g2);
         render_ui(game, u8g2);
 
         u8g2_SetFont(u8g2, u8g2_font_7x13_tf);
@@ -579,28 +647,26 @@ void minesweeper_game_render(minesweeper_game_t *game)
         u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
         u8g2_DrawStr(u8g2, 10, 58, "START: Restart");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // PAUSED状态
     if (game->game_state == MINE_STATE_PAUSED) {
-        render_grid(game, u8g2);
         render_ui(game, u8g2);
 
         u8g2_SetFont(u8g2, u8g2_font_7x13_tf);
         u8g2_DrawStr(u8g2, 35, 35, "PAUSED");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // PLAYING状态
-    render_grid(game, u8g2);
     render_cursor(game, u8g2);
     render_ui(game, u8g2);
 
-    u8g2_SendBuffer(u8g2);
+    display_service_mark_ready();
 }
 
 /**
@@ -612,5 +678,5 @@ void minesweeper_game_task(minesweeper_game_t *game)
 
     minesweeper_game_update_input(game);
     minesweeper_game_update_logic(game);
-    minesweeper_game_render(game);
+    // 渲染由game_manager在need_redraw置位时调用
 }
@@ -7,34 +7,21 @@
 
 /* ======================== 迷宫地图定义 ======================== */
 
-/**
- * @brief 经典迷宫布局（16×8）
- * @note  1=墙壁，0=通道（初始放置豆子），2=能量豆位置
- */
-static const uint8_t g_maze_layout[PACMAN_GRID_HEIGHT][PACMAN_GRID_WIDTH] = {
-    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},  // 顶部墙壁
-    {1, 2, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 2, 1},  // 能量豆在角落
-    {1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 1, 1, 0, 1},  // 内部墙壁
-    {1, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1},  // 中间通道
-    {1, 0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0, 1},  // 中间通道
-    {1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 1, 1, 0, 1},  // 内部墙壁
-    {1, 2, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 2, 1},  // 能量豆在角落
-    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}   // 底部墙壁
-};
-
-// 吃豆人初始位置（左下角通道）
-static const pacman_position_t g_pacman_start = {3, 6};
-
-// 幽灵初始位置（右侧通道）
-static const pacman_position_t g_ghost_starts[PACMAN_MAX_GHOSTS] = {
-    {12, 3},  // 幽灵1：右侧通道
-    {13, 3}   // 幽灵2：右侧通道
-};
+// 迷宫、吃豆人和幽灵初始位置由App/assets/src/pacman.lvl生成（RLE压缩）
+#include "pacman_assets.h"
+
+#if PACMAN_LEVEL_WIDTH != PACMAN_GRID_WIDTH || PACMAN_LEVEL_HEIGHT != PACMAN_GRID_HEIGHT
+#error "pacman.lvl的迷宫尺寸和PACMAN_GRID_WIDTH/PACMAN_GRID_HEIGHT不一致"
+#endif
+#if PACMAN_MAZE_GHOSTS_COUNT != PACMAN_MAX_GHOSTS
+#error "pacman.lvl中的幽灵数和PACMAN_MAX_GHOSTS不一致"
+#endif
 
 /* ======================== 内部函数声明 ======================== */
 
 // 地图初始化
 static void load_maze(pacman_game_t *game);
+static pacman_position_t start_position(asset_point_t point);
 static uint8_t count_dots(pacman_game_t *game);
 
 // 移动辅助
@@ -50,6 +37,9 @@ static void lose_life(pacman_game_t *game);
 
 // 渲染辅助
 static void render_maze(pacman_game_t *game, u8g2_t *u8g2);
+static void render_maze_cell(pacman_game_t *game, u8g2_t *u8g2, uint8_t x, uint8_t y);
+static void update_maze_cell(pacman_game_t *game, uint8_t x, uint8_t y);
+static void render_background(pacman_game_t *game, u8g2_t *u8g2);
 static void render_pacman(pacman_game_t *game, u8g2_t *u8g2);
 static void render_ghosts(pacman_game_t *game, u8g2_t *u8g2);
 static void render_ui(pacman_game_t *game, u8g2_t *u8g2);
@@ -61,9 +51,14 @@ static void render_ui(pacman_game_t *game, u8g2_t *u8g2);
  */
 static void load_maze(pacman_game_t *game)
 {
+    uint8_t tiles[PACMAN_GRID_HEIGHT * PACMAN_GRID_WIDTH];
+
+    // 解压迷宫：1=墙壁，0=通道（初始放置豆子），2=能量豆位置
+    assets_unpack_level(&pacman_levels[0], tiles, sizeof(tiles));
+
     for (uint8_t y = 0; y < PACMAN_GRID_HEIGHT; y++) {
         for (uint8_t x = 0; x < PACMAN_GRID_WIDTH; x++) {
-            uint8_t layout = g_maze_layout[y][x];
+            uint8_t layout = tiles[y * PACMAN_GRID_WIDTH + x];
 
             if (layout == 1) {
                 game->map[y][x] = PACMAN_TILE_WALL;
@@ -78,6 +73,21 @@ static void load_maze(pacman_game_t *game)
     // 统计豆子总数
     game->total_dots = count_dots(game);
     game->dots_remaining = game->total_dots;
+
+    // 地图整体变了，背景缓存下一帧重建
+    layer_invalidate();
+}
+
+/**
+ * @brief 资源中的坐标转换成游戏坐标
+ */
+static pacman_position_t start_position(asset_point_t point)
+{
+    pacman_position_t pos;
+
+    pos.x = (int8_t)point.x;
+    pos.y = (int8_t)point.y;
+    return pos;
 }
 
 /**
@@ -254,18 +264,20 @@ static void collect_item(pacman_game_t *game, int8_t x, int8_t y)
     if (tile == PACMAN_TILE_DOT) {
         // 吃掉小豆子
         game->map[y][x] = PACMAN_TILE_EMPTY;
+        update_maze_cell(game, x, y);
         game->score += PACMAN_SCORE_DOT;
         game->dots_remaining--;
         check_win(game);
     } else if (tile == PACMAN_TILE_POWER) {
         // 吃掉能量豆
         game->map[y][x] = PACMAN_TILE_EMPTY;
+        update_maze_cell(game, x, y);
         game->score += PACMAN_SCORE_POWER;
         game->dots_remaining--;
 
         // 激活能量豆效果
         game->power_active = 1;
-        game->power_start_time = HAL_GetTick();
+        game->power_start_time = game_manager_get_tick();
 
         // 所有幽灵进入惊吓模式
         for (uint8_t i = 0; i < PACMAN_MAX_GHOSTS; i++) {
@@ -291,7 +303,7 @@ static void check_ghost_collision(pacman_game_t *game)
                 game->score += PACMAN_SCORE_GHOST;
 
                 // 重置幽灵位置
-                ghost->pos = g_ghost_starts[i];
+                ghost->pos = start_position(pacman_maze_ghosts[i]);
                 ghost->is_frightened = 0;
             } else {
                 // 被幽灵吃掉
@@ -323,12 +335,12 @@ static void lose_life(pacman_game_t *game)
         game->game_state = PACMAN_STATE_LOSE;
     } else {
         // 重置位置
-        game->pacman_pos = g_pacman_start;
+        game->pacman_pos = start_position(pacman_levels[0].start);
         game->pacman_dir = PACMAN_DIR_NONE;
         game->pacman_next_dir = PACMAN_DIR_NONE;
 
         for (uint8_t i = 0; i < PACMAN_MAX_GHOSTS; i++) {
-            game->ghosts[i].pos = g_ghost_starts[i];
+            game->ghosts[i].pos = start_position(pacman_maze_ghosts[i]);
             game->ghosts[i].dir = PACMAN_DIR_NONE;
             game->ghosts[i].is_frightened = 0;
         }
@@ -365,14 +377,14 @@ void pacman_game_init(pacman_game_t *game)
     load_maze(game);
 
     // 初始化吃豆人
-    game->pacman_pos = g_pacman_start;
+    game->pacman_pos = start_position(pacman_levels[0].start);
     game->pacman_dir = PACMAN_DIR_NONE;
     game->pacman_next_dir = PACMAN_DIR_NONE;
     game->pacman_anim_frame = 0;
 
     // 初始化幽灵
     for (uint8_t i = 0; i < PACMAN_MAX_GHOSTS; i++) {
-        game->ghosts[i].pos = g_ghost_starts[i];
+        game->ghosts[i].pos = start_position(pacman_maze_ghosts[i]);
         game->ghosts[i].dir = PACMAN_DIR_NONE;
         game->ghosts[i].is_frightened = 0;
         game->ghosts[i].last_move_time = 0;
@@ -380,6 +392,9 @@ void pacman_game_init(pacman_game_t *game)
 
     // 清除能量豆效果
     game->power_active = 0;
+
+    // 整个画面都要重绘
+    game->need_redraw = 1;
 }
 
 /**
@@ -388,6 +403,7 @@ void pacman_game_init(pacman_game_t *game)
 void pacman_game_activate(pacman_game_t *game)
 {
     game->is_active = 1;
+    game->need_redraw = 1;  // 从菜单回来，屏幕上是菜单画面
 }
 
 /**
@@ -427,7 +443,8 @@ void pacman_game_update_input(pacman_game_t *game)
     if (game->game_state == PACMAN_STATE_READY) {
         if (input_is_just_pressed(INPUT_BTN_A)) {
             game->game_state = PACMAN_STATE_PLAYING;
-            game->pacman_last_move_time = HAL_GetTick();
+            game->pacman_last_move_time = game_manager_get_tick();
+            game->need_redraw = 1;
         }
         return;
     }
@@ -447,8 +464,9 @@ void pacman_game_update_input(pacman_game_t *game)
             game->game_state = PACMAN_STATE_PAUSED;
         } else if (game->game_state == PACMAN_STATE_PAUSED) {
             game->game_state = PACMAN_STATE_PLAYING;
-            game->pacman_last_move_time = HAL_GetTick();
+            game->pacman_last_move_time = game_manager_get_tick();
         }
+        game->need_redraw = 1;
         return;
     }
 
@@ -485,12 +503,13 @@ void pacman_game_update_logic(pacman_game_t *game)
         return;
     }
 
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
 
     // 更新吃豆人移动
     if (now - game->pacman_last_move_time >= PACMAN_SPEED) {
         game->pacman_last_move_time = now;
         try_move_pacman(game);
+        game->need_redraw = 1;  // 移动或张嘴动画
     }
 
     // 更新幽灵移动（幽灵比吃豆人慢）
@@ -500,6 +519,7 @@ void pacman_game_update_logic(pacman_game_t *game)
         if (now - ghost->last_move_time >= PACMAN_GHOST_SPEED) {
             ghost->last_move_time = now;
             try_move_ghost(game, ghost);
+            game->need_redraw = 1;
         }
     }
 
@@ -515,6 +535,7 @@ void pacman_game_update_logic(pacman_game_t *game)
             for (uint8_t i = 0; i < PACMAN_MAX_GHOSTS; i++) {
                 game->ghosts[i].is_frightened = 0;
             }
+            game->need_redraw = 1;
         }
     }
 }
@@ -528,36 +549,75 @@ static void render_maze(pacman_game_t *game, u8g2_t *u8g2)
 {
     for (uint8_t y = 0; y < PACMAN_GRID_HEIGHT; y++) {
         for (uint8_t x = 0; x < PACMAN_GRID_WIDTH; x++) {
-            int16_t px = x * PACMAN_CELL_SIZE;
-            int16_t py = y * PACMAN_CELL_SIZE;
-
-            pacman_tile_type_t tile = game->map[y][x];
-
-            switch (tile) {
-                case PACMAN_TILE_WALL:
-                    // 墙壁：实心方块
-                    u8g2_DrawBox(u8g2, px, py, PACMAN_CELL_SIZE, PACMAN_CELL_SIZE);
-                    break;
-
-                case PACMAN_TILE_DOT:
-                    // 小豆子：小点
-                    u8g2_DrawPixel(u8g2, px + PACMAN_CELL_SIZE / 2, py + PACMAN_CELL_SIZE / 2);
-                    break;
-
-                case PACMAN_TILE_POWER:
-                    // 能量豆：大圆点
-                    u8g2_DrawDisc(u8g2, px + PACMAN_CELL_SIZE / 2, py + PACMAN_CELL_SIZE / 2, 2, U8G2_DRAW_ALL);
-                    break;
-
-                case PACMAN_TILE_EMPTY:
-                default:
-                    // 空地：不绘制
-                    break;
-            }
+            render_maze_cell(game, u8g2, x, y);
         }
     }
 }
 
+/**
+ * @brief 渲染迷宫中的一格
+ */
+static void render_maze_cell(pacman_game_t *game, u8g2_t *u8g2, uint8_t x, uint8_t y)
+{
+    int16_t px = x * PACMAN_CELL_SIZE;
+    int16_t py = y * PACMAN_CELL_SIZE;
+
+    pacman_tile_type_t tile = game->map[y][x];
+
+    switch (tile) {
+        case PACMAN_TILE_WALL:
+            // 墙壁：实心方块
+            u8g2_DrawBox(u8g2, px, py, PACMAN_CELL_SIZE, PACMAN_CELL_SIZE);
+            break;
+
+        case PACMAN_TILE_DOT:
+            // 小豆子：小点
+            u8g2_DrawPixel(u8g2, px + PACMAN_CELL_SIZE / 2, py + PACMAN_CELL_SIZE / 2);
+            break;
+
+        case PACMAN_TILE_POWER:
+            // 能量豆：大圆点
+            u8g2_DrawDisc(u8g2, px + PACMAN_CELL_SIZE / 2, py + PACMAN_CELL_SIZE / 2, 2, U8G2_DRAW_ALL);
+            break;
+
+        case PACMAN_TILE_EMPTY:
+        default:
+            // 空地：不绘制
+            break;
+    }
+}
+
+/**
+ * @brief 格子变化后只重画背景缓存中的这一格
+ */
+static void update_maze_cell(pacman_game_t *game, uint8_t x, uint8_t y)
+{
+    u8g2_t *u8g2 = u8g2_get_instance();
+
+    if (layer_begin_update(u8g2, game)) {
+        u8g2_SetDrawColor(u8g2, 0);
+        u8g2_DrawBox(u8g2, x * PACMAN_CELL_SIZE, y * PACMAN_CELL_SIZE, PACMAN_CELL_SIZE, PACMAN_CELL_SIZE);
+        u8g2_SetDrawColor(u8g2, 1);
+        render_maze_cell(game, u8g2, x, y);
+        layer_end(u8g2);
+    }
+}
+
+/**
+ * @brief 绘制背景（迷宫）
+ * @note  迷宫缓存在背景层里，每帧只复制一次，缓存无效时整块重建
+ *        代替u8g2_ClearBuffer()
+ */
+static void render_background(pacman_game_t *game, u8g2_t *u8g2)
+{
+    if (!layer_blit(u8g2, game)) {
+        layer_begin_rebuild(u8g2, game);
+        render_maze(game, u8g2);
+        layer_end(u8g2);
+        layer_blit(u8g2, game);
+    }
+}
+
 /**
  * @brief 渲染吃豆人
  */
@@ -640,7 +700,13 @@ void pacman_game_render(pacman_game_t *game)
     if (!game->is_active) return;
 
     u8g2_t *u8g2 = u8g2_get_instance();
-    u8g2_ClearBuffer(u8g2);
+
+    // 有迷宫的画面用背景层代替清屏，之后只画吃豆人和幽灵
+    if (game->game_state == PACMAN_STATE_PLAYING || game->game_state == PACMAN_STATE_PAUSED) {
+        render_background(game, u8g2);
+    } else {
+        u8g2_ClearBuffer(u8g2);
+    }
 
     // READY状态
     if (game->game_state == PACMAN_STATE_READY) {
@@ -648,7 +714,7 @@ void pacman_game_render(pacman_game_t *game)
         u8g2_DrawStr(u8g2, 28, 26, "PAC-MAN");
         u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
         u8g2_DrawStr(u8g2, 20, 40, "Press A Start");
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -667,7 +733,7 @@ void pacman_game_render(pacman_game_t *game)
 
         u8g2_DrawStr(u8g2, 10, 58, "START: Restart");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -683,29 +749,27 @@ void pacman_game_render(pacman_game_t *game)
 
         u8g2_DrawStr(u8g2, 10, 58, "START: Restart");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // PAUSED状态
     if (game->game_state == PACMAN_STATE_PAUSED) {
-        render_maze(game, u8g2);
         render_pacman(game, u8g2);
         render_ghosts(game, u8g2);
 
         u8g2_SetFont(u8g2, u8g2_font_7x13_tf);
         u8g2_DrawStr(u8g2, 32, 35, "PAUSED");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // PLAYING状态
-    render_maze(game, u8g2);
     render_pacman(game, u8g2);
     render_ghosts(game, u8g2);
 
-    u8g2_SendBuffer(u8g2);
+    display_service_mark_ready();
 }
 
 /**
@@ -717,5 +781,5 @@ void pacman_game_task(pacman_game_t *game)
 
     pacman_game_update_input(game);
     pacman_game_update_logic(game);
-    pacman_game_render(game);
+    // 渲染由game_manager在need_redraw置位时调用
 }
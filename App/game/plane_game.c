@@ -56,204 +56,13 @@ static void draw_powerups(plane_game_t *game, u8g2_t *u8g2);
 static void draw_explosions(plane_game_t *game, u8g2_t *u8g2);
 static void draw_ui(plane_game_t *game, u8g2_t *u8g2);
 static void draw_game_over(plane_game_t *game, u8g2_t *u8g2);
-static void draw_bitmap(u8g2_t *u8g2, int16_t x, int16_t y, const uint8_t *bitmap,
-                        uint8_t w, uint8_t h);
 
 // -----------------------------------------------------------------------------
 // 2. Sprite数据定义
 // -----------------------------------------------------------------------------
 
-/**
- * @brief 玩家飞机sprite（8x8，机头朝右）
- */
-static const uint8_t sprite_player[] = {
-    0x80, // #.......
-    0xC0, // ##......
-    0xF0, // ####....
-    0xFF, // ########
-    0xFF, // ########
-    0xF0, // ####....
-    0xC0, // ##......
-    0x80, // #.......
-};
-
-/**
- * @brief 玩家子弹sprite（4x2，横向）
- */
-static const uint8_t sprite_player_bullet[] = {
-    0xF0, // ####
-    0xF0, // ####
-};
-
-/**
- * @brief 小型敌机sprite（7x6，战斗机，机头朝左）
- * 设计：小型战斗机，带机翼
- */
-static const uint8_t sprite_enemy_small[] = {
-    0x38, // ..###...
-    0x7C, // .#####..
-    0xFE, // #######.
-    0xFE, // #######.
-    0x7C, // .#####..
-    0x38, // ..###...
-};
-
-/**
- * @brief 中型敌机sprite（9x8，轰炸机，机头朝左）
- * 设计：中型轰炸机，带宽机翼和引擎
- */
-static const uint8_t sprite_enemy_medium[] = {
-    0x1C, 0x00, // ...###..  ........
-    0x3E, 0x00, // ..#####.  ........
-    0x7F, 0x00, // .#######  ........
-    0xFF, 0x80, // ########  #.......
-    0xFF, 0x80, // ########  #.......
-    0x7F, 0x00, // .#######  ........
-    0x3E, 0x00, // ..#####.  ........
-    0x1C, 0x00, // ...###..  ........
-};
-
-/**
- * @brief 重型敌机sprite（11x10，装甲机，机头朝左）
- * 设计：重型装甲机，厚实机身，双引擎
- */
-static const uint8_t sprite_enemy_heavy[] = {
-    0x0F, 0x00, // ....####  ........
-    0x1F, 0x80, // ...#####  #.......
-    0x3F, 0xC0, // ..######  ##......
-    0x7F, 0xE0, // .#######  ###.....
-    0xFF, 0xF0, // ########  ####....
-    0xFF, 0xF0, // ########  ####....
-    0x7F, 0xE0, // .#######  ###.....
-    0x3F, 0xC0, // ..######  ##......
-    0x1F, 0x80, // ...#####  #.......
-    0x0F, 0x00, // ....####  ........
-};
-
-/**
- * @brief 快速敌机sprite（6x5，箭型机，机头朝左）
- * 设计：超快速箭型机，尖锐机头
- */
-static const uint8_t sprite_enemy_fast[] = {
-    0x60, // .##.....
-    0xF0, // ####....
-    0xF8, // #####...
-    0xF0, // ####....
-    0x60, // .##.....
-};
-
-/**
- * @brief P道具sprite（8x8，武器升级）
- * 设计：方框内大写"P"
- */
-static const uint8_t sprite_powerup_weapon[] = {
-    0xFF, // ########
-    0x81, // #......#
-    0xBD, // #.####.#
-    0xBD, // #.####.#
-    0xBD, // #.####.#
-    0xB1, // #.##...#
-    0xB1, // #.##...#
-    0xFF, // ########
-};
-
-/**
- * @brief S道具sprite（8x8，护盾）
- * 设计：方框内大写"S"
- */
-static const uint8_t sprite_powerup_shield[] = {
-    0xFF, // ########
-    0x81, // #......#
-    0xBD, // #.####.#
-    0xB1, // #.##...#
-    0x87, // #....###
-    0xBD, // #.####.#
-    0x81, // #......#
-    0xFF, // ########
-};
-
-/**
- * @brief B道具sprite（8x8，炸弹）
- * 设计：方框内大写"B"
- */
-static const uint8_t sprite_powerup_bomb[] = {
-    0xFF, // ########
-    0x81, // #......#
-    0xBD, // #.####.#
-    0xBD, // #.####.#
-    0xB9, // #.###..#
-    0xBD, // #.####.#
-    0xBD, // #.####.#
-    0xFF, // ########
-};
-
-/**
- * @brief 爆炸动画帧1（8x8，初始爆炸）
- * 设计：完整的爆炸圆形
- */
-static const uint8_t sprite_explosion_frame1[] = {
-    0x18, // ...##...
-    0x3C, // ..####..
-    0x7E, // .######.
-    0xFF, // ########
-    0xFF, // ########
-    0x7E, // .######.
-    0x3C, // ..####..
-    0x18, // ...##...
-};
-
-/**
- * @brief 爆炸动画帧2（8x8，扩散）
- * 设计：爆炸扩散，出现空隙
- */
-static const uint8_t sprite_explosion_frame2[] = {
-    0x00, // ........
-    0x24, // ..#..#..
-    0x5A, // .#.##.#.
-    0xBD, // #.####.#
-    0xBD, // #.####.#
-    0x5A, // .#.##.#.
-    0x24, // ..#..#..
-    0x00, // ........
-};
-
-/**
- * @brief 爆炸动画帧3（8x8，消散）
- * 设计：稀疏的碎片
- */
-static const uint8_t sprite_explosion_frame3[] = {
-    0x00, // ........
-    0x00, // ........
-    0x42, // .#....#.
-    0x24, // ..#..#..
-    0x24, // ..#..#..
-    0x42, // .#....#.
-    0x00, // ........
-    0x00, // ........
-};
-
-/**
- * @brief Boss战舰sprite（16x16，超大型）
- * 设计：重型战舰，多层装甲，双引擎
- */
-static const uint8_t sprite_boss[] = {
-    0x03, 0xC0, // ......##  ##......
-    0x07, 0xE0, // .....###  ###.....
-    0x0F, 0xF0, // ....####  ####....
-    0x1F, 0xF8, // ...#####  #####...
-    0x3F, 0xFC, // ..######  ######..
-    0x7F, 0xFE, // .#######  #######.
-    0xFF, 0xFF, // ########  ########
-    0xFF, 0xFF, // ########  ########
-    0xFF, 0xFF, // ########  ########
-    0xFF, 0xFF, // ########  ########
-    0x7F, 0xFE, // .#######  #######.
-    0x3F, 0xFC, // ..######  ######..
-    0x1F, 0xF8, // ...#####  #####...
-    0x0F, 0xF0, // ....####  ####....
-    0x07, 0xE0, // .....###  ###.....
-    0x03, 0xC0, // ......##  ##......
-};
+// 由App/assets/src/plane.spr生成的页格式sprite（玩家飞机带预移位数据）
+#include "plane_assets.h"
 
 // -----------------------------------------------------------------------------
 // 3. API函数实现
@@ -294,7 +103,7 @@ void plane_game_init(plane_game_t *game)
     game->boss_count = 0;        // 未击败任何Boss
 
     // 初始化时间戳
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
     game->last_frame_time = now;
     game->last_shoot_time = now;
     game->last_enemy_spawn_time = now;
@@ -320,6 +129,9 @@ void plane_game_init(plane_game_t *game)
 
     // Boss初始化
     game->boss.active = 0;
+
+    // 新的一局，整屏重绘
+    game->need_redraw = 1;
 }
 
 /**
@@ -339,8 +151,9 @@ void plane_game_update_input(plane_game_t *game)
         // 按A键开始游戏
         if (input_is_just_pressed(INPUT_BTN_A)) {
             game->game_state = PLANE_STATE_RUNNING;
+            game->need_redraw = 1;
             game->score = 0;
-            game->last_enemy_spawn_time = HAL_GetTick();
+            game->last_enemy_spawn_time = game_manager_get_tick();
         }
     }
     else if (game->game_state == PLANE_STATE_RUNNING) {
@@ -357,7 +170,7 @@ void plane_game_update_input(plane_game_t *game)
         if (input_is_just_pressed(INPUT_BTN_A)) {
             plane_game_init(game);
             game->game_state = PLANE_STATE_RUNNING;
-            game->last_enemy_spawn_time = HAL_GetTick();
+            game->last_enemy_spawn_time = game_manager_get_tick();
         }
     }
 }
@@ -371,7 +184,10 @@ void plane_game_update_logic(plane_game_t *game)
         return;  // 只在运行状态更新逻辑
     }
 
-    uint32_t now = HAL_GetTick();
+    // 运行中子弹和敌机每帧都在移动，画面必然变化
+    game->need_redraw = 1;
+
+    uint32_t now = game_manager_get_tick();
 
     // 1. 更新子弹
     update_player_bullets(game);
@@ -462,7 +278,7 @@ void plane_game_render(plane_game_t *game)
 
         // 8. 绘制Boss警告（如果激活）
         if (game->boss_warning) {
-            uint32_t now = HAL_GetTick();
+            uint32_t now = game_manager_get_tick();
             uint32_t elapsed = now - game->boss_warning_start_time;
 
             // 警告显示2秒后自动关闭
@@ -492,7 +308,8 @@ void plane_game_render(plane_game_t *game)
         draw_game_over(game, u8g2);
     }
 
-    u8g2_SendBuffer(u8g2);
+    // 标记一帧就绪，由显示服务发送
+    display_service_mark_ready();
 }
 
 /**
@@ -505,7 +322,7 @@ void plane_game_task(plane_game_t *game)
         return;
     }
 
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
 
     // 帧率控制：30fps（33ms一帧）
     if (now - game->last_frame_time < PLANE_FRAME_TIME_MS) {
@@ -517,10 +334,9 @@ void plane_game_task(plane_game_t *game)
     // 更新帧时间
     game->last_frame_time = now;
 
-    // 完整游戏循环（30fps）
+    // 完整游戏循环（30fps），渲染由game_manager在need_redraw置位时调用
     plane_game_update_input(game);
     plane_game_update_logic(game);
-    plane_game_render(game);
 }
 
 /**
@@ -529,6 +345,7 @@ void plane_game_task(plane_game_t *game)
 void plane_game_activate(plane_game_t *game)
 {
     game->is_active = 1;
+    game->need_redraw = 1;  // 从菜单回来，屏幕上是菜单画面
 }
 
 /**
@@ -572,7 +389,7 @@ static void update_player_movement(plane_game_t *game)
 
 static void player_shoot(plane_game_t *game)
 {
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
 
     // 射击冷却检测
     if (now - game->last_shoot_time < PLANE_PLAYER_SHOOT_INTERVAL) {
@@ -746,8 +563,8 @@ static void spawn_enemy(plane_game_t *game)
     enemy->active = 1;
     enemy->type = type;
     enemy->x = PLANE_SCREEN_WIDTH;  // 从屏幕右侧生成
-    enemy->spawn_time = HAL_GetTick();
-    enemy->last_shoot_time = HAL_GetTick();
+    enemy->spawn_time = game_manager_get_tick();
+    enemy->last_shoot_time = game_manager_get_tick();
 
     // 计算难度速度倍率（每级难度+8%速度，最高+80%）
     float speed_multiplier = 1.0f + (game->difficulty_level * 0.08f);
@@ -798,7 +615,7 @@ static void spawn_enemy(plane_game_t *game)
     }
 
     // 更新生成时间和下次延迟（根据难度缩短间隔）
-    game->last_enemy_spawn_time = HAL_GetTick();
+    game->last_enemy_spawn_time = game_manager_get_tick();
 
     // 计算难度调整后的生成间隔（难度越高，生成越快）
     uint16_t min_delay = PLANE_ENEMY_SPAWN_MIN - (game->difficulty_level * 40);
@@ -824,7 +641,7 @@ static void update_enemies(plane_game_t *game)
 
         // FAST类型做波浪移动
         if (enemy->type == ENEMY_TYPE_FAST) {
-            uint32_t time_offset = HAL_GetTick() - enemy->spawn_time;
+            uint32_t time_offset = game_manager_get_tick() - enemy->spawn_time;
             float wave = sinf((float)time_offset * 0.01f) * 1.5f;
             enemy->y += (int16_t)wave;
 
@@ -848,7 +665,7 @@ static void update_enemies(plane_game_t *game)
 
 static void enemy_shoot(plane_game_t *game, enemy_t *enemy)
 {
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
 
     // 射击冷却检测（至少500ms间隔）
     if (now - enemy->last_shoot_time < 500) {
@@ -896,7 +713,7 @@ static void spawn_boss(plane_game_t *game)
 
     // 启动Boss警告（显示2秒）
     game->boss_warning = 1;
-    game->boss_warning_start_time = HAL_GetTick();
+    game->boss_warning_start_time = game_manager_get_tick();
 
     // 根据击败Boss数量提升HP（无尽模式难度递增）
     uint8_t boss_hp = PLANE_BOSS_HP + (game->boss_count * 5);  // 每次+5 HP
@@ -907,15 +724,15 @@ static void spawn_boss(plane_game_t *game)
     game->boss.hp = boss_hp;
     game->boss.max_hp = boss_hp;
     game->boss.phase = 1;  // 初始阶段1
-    game->boss.spawn_time = HAL_GetTick();
-    game->boss.last_attack_time = HAL_GetTick();
+    game->boss.spawn_time = game_manager_get_tick();
+    game->boss.last_attack_time = game_manager_get_tick();
 }
 
 static void update_boss(plane_game_t *game)
 {
     if (!game->boss.active) return;
 
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
     uint32_t alive_time = now - game->boss.spawn_time;
 
     // 阶段1：进场动画（前2秒）
@@ -959,7 +776,7 @@ static void update_boss(plane_game_t *game)
 
 static void boss_attack(plane_game_t *game)
 {
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
 
     // 根据阶段设置攻击间隔
     uint32_t attack_interval;
@@ -1100,7 +917,7 @@ static void spawn_explosion(plane_game_t *game, int16_t x, int16_t y, explosion_
             game->explosions[i].y = y;
             game->explosions[i].type = type;
             game->explosions[i].frame = 0;  // 从第0帧开始
-            game->explosions[i].last_frame_time = HAL_GetTick();
+            game->explosions[i].last_frame_time = game_manager_get_tick();
             return;
         }
     }
@@ -1109,7 +926,7 @@ static void spawn_explosion(plane_game_t *game, int16_t x, int16_t y, explosion_
 
 static void update_explosions(plane_game_t *game)
 {
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
 
     for (uint8_t i = 0; i < MAX_EXPLOSIONS; i++) {
         if (!game->explosions[i].active) continue;
@@ -1329,8 +1146,7 @@ static uint8_t aabb_collision(int16_t x1, int16_t y1, uint8_t w1, uint8_t h1,
 static void draw_player(plane_game_t *game, u8g2_t *u8g2)
 {
     // 绘制玩家飞机（8x8 sprite）
-    draw_bitmap(u8g2, game->player_x, game->player_y, sprite_player,
-                PLANE_PLAYER_WIDTH, PLANE_PLAYER_HEIGHT);
+    sprite_blit(u8g2, game->player_x, game->player_y, &sprite_player, SPRITE_MODE_OR);
 
     // 如果有护盾，绘制护盾框
     if (game->player_shield) {
@@ -1346,8 +1162,7 @@ static void draw_bullets(plane_game_t *game, u8g2_t *u8g2)
         if (!game->player_bullets[i].active) continue;
 
         bullet_t *bullet = &game->player_bullets[i];
-        draw_bitmap(u8g2, bullet->x, bullet->y, sprite_player_bullet,
-                    PLANE_BULLET_WIDTH, PLANE_BULLET_HEIGHT);
+        sprite_blit(u8g2, bullet->x, bullet->y, &sprite_player_bullet, SPRITE_MODE_OR);
     }
 
     // 绘制敌机子弹（阶段3实现）
@@ -1370,19 +1185,19 @@ static void draw_enemies(plane_game_t *game, u8g2_t *u8g2)
         // 根据类型绘制不同sprite
         switch (enemy->type) {
             case ENEMY_TYPE_SMALL:
-                draw_bitmap(u8g2, enemy->x, enemy->y, sprite_enemy_small, 7, 6);
+                sprite_blit(u8g2, enemy->x, enemy->y, &sprite_enemy_small, SPRITE_MODE_OR);
                 break;
 
             case ENEMY_TYPE_MEDIUM:
-                draw_bitmap(u8g2, enemy->x, enemy->y, sprite_enemy_medium, 9, 8);
+                sprite_blit(u8g2, enemy->x, enemy->y, &sprite_enemy_medium, SPRITE_MODE_OR);
                 break;
 
             case ENEMY_TYPE_HEAVY:
-                draw_bitmap(u8g2, enemy->x, enemy->y, sprite_enemy_heavy, 11, 10);
+                sprite_blit(u8g2, enemy->x, enemy->y, &sprite_enemy_heavy, SPRITE_MODE_OR);
                 break;
 
             case ENEMY_TYPE_FAST:
-                draw_bitmap(u8g2, enemy->x, enemy->y, sprite_enemy_fast, 6, 5);
+                sprite_blit(u8g2, enemy->x, enemy->y, &sprite_enemy_fast, SPRITE_MODE_OR);
                 break;
 
             default:
@@ -1406,7 +1221,7 @@ static void draw_boss(plane_game_t *game, u8g2_t *u8g2)
     }
 
     // 1. 绘制Boss sprite（16x16）
-    draw_bitmap(u8g2, game->boss.x, game->boss.y, sprite_boss, 16, 16);
+    sprite_blit(u8g2, game->boss.x, game->boss.y, &sprite_boss, SPRITE_MODE_OR);
 
     // 2. 绘制Boss血条（屏幕顶部）
     // 血条位置：屏幕顶部居中
@@ -1441,15 +1256,15 @@ static void draw_powerups(plane_game_t *game, u8g2_t *u8g2)
         // 根据类型绘制不同sprite
         switch (powerup->type) {
             case POWERUP_WEAPON:
-                draw_bitmap(u8g2, powerup->x, powerup->y, sprite_powerup_weapon, 8, 8);
+                sprite_blit(u8g2, powerup->x, powerup->y, &sprite_powerup_weapon, SPRITE_MODE_OR);
                 break;
 
             case POWERUP_SHIELD:
-                draw_bitmap(u8g2, powerup->x, powerup->y, sprite_powerup_shield, 8, 8);
+                sprite_blit(u8g2, powerup->x, powerup->y, &sprite_powerup_shield, SPRITE_MODE_OR);
                 break;
 
             case POWERUP_BOMB:
-                draw_bitmap(u8g2, powerup->x, powerup->y, sprite_powerup_bomb, 8, 8);
+                sprite_blit(u8g2, powerup->x, powerup->y, &sprite_powerup_bomb, SPRITE_MODE_OR);
                 break;
 
             default:
@@ -1466,16 +1281,16 @@ static void draw_explosions(plane_game_t *game, u8g2_t *u8g2)
         explosion_t *exp = &game->explosions[i];
 
         // 根据当前帧绘制不同sprite
-        const uint8_t *sprite = NULL;
+        const sprite_t *sprite = NULL;
         switch (exp->frame) {
             case 0:
-                sprite = sprite_explosion_frame1;
+                sprite = &sprite_explosion_frame1;
                 break;
             case 1:
-                sprite = sprite_explosion_frame2;
+                sprite = &sprite_explosion_frame2;
                 break;
             case 2:
-                sprite = sprite_explosion_frame3;
+                sprite = &sprite_explosion_frame3;
                 break;
             default:
                 continue;  // 无效帧，跳过
@@ -1483,7 +1298,7 @@ static void draw_explosions(plane_game_t *game, u8g2_t *u8g2)
 
         // 绘制爆炸（8x8）
         if (sprite != NULL) {
-            draw_bitmap(u8g2, exp->x, exp->y, sprite, 8, 8);
+            sprite_blit(u8g2, exp->x, exp->y, sprite, SPRITE_MODE_OR);
         }
     }
 }
@@ -1544,24 +1359,3 @@ static void draw_game_over(plane_game_t *game, u8g2_t *u8g2)
     // 绘制重新开始提示
     u8g2_DrawStr(u8g2, 20, 58, "Press A to Retry");
 }
-
-static void draw_bitmap(u8g2_t *u8g2, int16_t x, int16_t y, const uint8_t *bitmap,
-                        uint8_t w, uint8_t h)
-{
-    // 计算每行需要多少字节（向上取整）
-    uint8_t bytes_per_row = (w + 7) / 8;
-
-    for (uint8_t row = 0; row < h; row++) {
-        // 遍历当前行的所有像素
-        for (uint8_t col = 0; col < w; col++) {
-            // 计算当前像素在bitmap中的位置
-            uint8_t byte_index = row * bytes_per_row + (col / 8);
-            uint8_t bit_index = 7 - (col % 8);
-
-            // 检查对应的bit是否为1
-            if (bitmap[byte_index] & (1 << bit_index)) {
-                u8g2_DrawPixel(u8g2, x + col, y + row);
-            }
-        }
-    }
-}
@@ -177,6 +177,7 @@ typedef struct {
     // ========== 核心状态管理 ==========
     plane_game_state_t game_state;      /*!< 游戏当前状态 */
     uint8_t is_active;                  /*!< 游戏是否活跃（1=活跃，0=停止）*/
+    uint8_t need_redraw;                /*!< 画面需要重绘（状态变化时置1，渲染后清零）*/
     void (*exit_callback)(void);        /*!< 退出回调函数（按B键返回菜单）*/
 
     // ========== 玩家 ==========
@@ -247,7 +248,8 @@ void plane_game_render(plane_game_t *game);
 /**
  * @brief 游戏主任务（周期调用）
  * @param game: 游戏状态结构体指针
- * @note  集成输入、逻辑、渲染的完整游戏循环，带帧率控制
+ * @note  集成输入、逻辑的游戏循环，带帧率控制
+ *        渲染由game_manager在need_redraw置位时调用plane_game_render
  */
 void plane_game_task(plane_game_t *game);
 
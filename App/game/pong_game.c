@@ -91,6 +91,7 @@ static void update_player_paddle(pong_game_t *game)
     // 上下键移动
     if (input_is_pressed(INPUT_BTN_UP)) {
         game->player_y -= PONG_PADDLE_SPEED;
+        game->need_redraw = 1;
         if (game->player_y < PONG_PADDLE_HEIGHT / 2) {
             game->player_y = PONG_PADDLE_HEIGHT / 2;
         }
@@ -98,6 +99,7 @@ static void update_player_paddle(pong_game_t *game)
 
     if (input_is_pressed(INPUT_BTN_DOWN)) {
         game->player_y += PONG_PADDLE_SPEED;
+        game->need_redraw = 1;
         if (game->player_y > PONG_SCREEN_HEIGHT - PONG_PADDLE_HEIGHT / 2) {
             game->player_y = PONG_SCREEN_HEIGHT - PONG_PADDLE_HEIGHT / 2;
         }
@@ -244,6 +246,9 @@ void pong_game_init(pong_game_t *game)
 
     // 初始化球
     reset_ball(game);
+
+    // 新的一局，整屏重绘
+    game->need_redraw = 1;
 }
 
 /**
@@ -252,6 +257,7 @@ void pong_game_init(pong_game_t *game)
 void pong_game_activate(pong_game_t *game)
 {
     game->is_active = 1;
+    game->need_redraw = 1;  // 从菜单回来，屏幕上是菜单画面
 }
 
 /**
@@ -291,6 +297,7 @@ void pong_game_update_input(pong_game_t *game)
     if (game->game_state == PONG_STATE_READY) {
         if (input_is_just_pressed(INPUT_BTN_A)) {
             game->game_state = PONG_STATE_SERVE;
+            game->need_redraw = 1;
         }
         return;
     }
@@ -311,6 +318,7 @@ void pong_game_update_input(pong_game_t *game)
         } else if (game->game_state == PONG_STATE_PAUSED) {
             game->game_state = PONG_STATE_PLAYING;
         }
+        game->need_redraw = 1;
         return;
     }
 
@@ -319,6 +327,7 @@ void pong_game_update_input(pong_game_t *game)
         if (input_is_just_pressed(INPUT_BTN_A)) {
             serve_ball(game);
             game->game_state = PONG_STATE_PLAYING;
+            game->need_redraw = 1;
         }
     }
 
@@ -347,8 +356,9 @@ void pong_game_update_logic(pong_game_t *game)
         return;
     }
 
-    // 更新球位置
+    // 更新球位置（球每帧都在移动，画面必然变化）
     ball_update(&game->ball);
+    game->need_redraw = 1;
 
     // 碰撞检测
     check_wall_collision(game);
@@ -429,7 +439,7 @@ void pong_game_render(pong_game_t *game)
         u8g2_DrawStr(u8g2, 44, 26, "PONG");
         u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
         u8g2_DrawStr(u8g2, 20, 40, "Press A Start");
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -445,7 +455,7 @@ void pong_game_render(pong_game_t *game)
 
         u8g2_DrawStr(u8g2, 10, 58, "START: Restart");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -461,7 +471,7 @@ void pong_game_render(pong_game_t *game)
 
         u8g2_DrawStr(u8g2, 10, 58, "START: Restart");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -475,7 +485,7 @@ void pong_game_render(pong_game_t *game)
         u8g2_SetFont(u8g2, u8g2_font_7x13_tf);
         u8g2_DrawStr(u8g2, 32, 35, "PAUSED");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -491,7 +501,7 @@ void pong_game_render(pong_game_t *game)
         u8g2_DrawStr(u8g2, 34, 58, "Press A");
     }
 
-    u8g2_SendBuffer(u8g2);
+    display_service_mark_ready();
 }
 
 /**
@@ -503,5 +513,5 @@ void pong_game_task(pong_game_t *game)
 
     pong_game_update_input(game);
     pong_game_update_logic(game);
-    pong_game_render(game);
+    // 渲染由game_manager在need_redraw置位时调用
 }
@@ -50,7 +50,10 @@ void snake_game_init(snake_game_t *game)
 
 	// 初始化动态速度系统
 	game->update_interval = SNAKE_SPEED_INITIAL;  // 初始速度：250ms
-	game->last_update_time = HAL_GetTick();
+	game->last_update_time = game_manager_get_tick();
+
+	// 新的一局，整屏重绘
+	game->need_redraw = 1;
 }
 
 /**
@@ -85,6 +88,7 @@ void snake_game_update_input(snake_game_t *game)
 			if (input_is_just_pressed(INPUT_BTN_START))
 			{
 				game->game_state = GAME_STATE_RUNNING;  // 恢复运行
+				game->need_redraw = 1;
 			}
 		}
 		return;
@@ -130,6 +134,7 @@ void snake_game_update_input(snake_game_t *game)
 	if (input_is_just_pressed(INPUT_BTN_START))
 	{
 		game->game_state = GAME_STATE_PAUSED;
+		game->need_redraw = 1;
 	}
 }
 
@@ -144,6 +149,9 @@ void snake_game_update_logic(snake_game_t *game)
 		return;
 	}
 
+	// 每一步蛇都会移动（或者撞上结束游戏），画面必然变化
+	game->need_redraw = 1;
+
 	// ============ 关键！应用next_direction ============
 	// 在移动前，将next_direction应用为当前direction
 	game->direction = game->next_direction;
@@ -320,8 +328,8 @@ void snake_game_render(snake_game_t *game)
 		break;
 	}
 
-	// 发送缓冲区到屏幕
-	u8g2_SendBuffer(u8g2);
+	// 标记一帧就绪，由显示服务发送
+	display_service_mark_ready();
 }
 
 /**
@@ -335,7 +343,7 @@ void snake_game_task(snake_game_t *game)
 		return;
 	}
 
-	uint32_t current_time = HAL_GetTick();
+	uint32_t current_time = game_manager_get_tick();
 
 	// 1. 输入处理（每次调用都执行，实时响应）
 	snake_game_update_input(game);
@@ -347,8 +355,7 @@ void snake_game_task(snake_game_t *game)
 		snake_game_update_logic(game);
 	}
 
-	// 3. 渲染输出（每次调用都执行）
-	snake_game_render(game);
+	// 3. 渲染由game_manager负责：只有need_redraw置位时才渲染
 }
 
 // -----------------------------------------------------------------------------
@@ -410,6 +417,7 @@ void snake_game_activate(snake_game_t *game)
 	}
 
 	game->is_active = 1;
+	game->need_redraw = 1;  // 从菜单回来，屏幕上是菜单画面
 }
 
 /**
@@ -84,6 +84,7 @@ typedef struct {
 
     // 活动状态控制（菜单集成所需）
     uint8_t is_active;                  /*!< 游戏是否活跃（1=活跃，0=停止）*/
+    uint8_t need_redraw;                /*!< 画面需要重绘（状态变化时置1，渲染后清零）*/
     snake_exit_callback_t exit_callback; /*!< 退出回调函数（按SELECT键返回菜单）*/
 } snake_game_t;
 
@@ -123,7 +124,8 @@ void snake_game_render(snake_game_t *game);
 /**
  * @brief 游戏主任务（周期调用）
  * @param game: 游戏状态结构体指针
- * @note  集成输入、逻辑、渲染的完整游戏循环
+ * @note  集成输入、逻辑的游戏循环，画面变化时置位need_redraw
+ *        渲染由game_manager在需要重绘时调用snake_game_render
  */
 void snake_game_task(snake_game_t *game);
 
@@ -7,80 +7,15 @@
 
 /* ======================== 关卡数据定义 ======================== */
 
-/**
- * @brief 关卡1：教学关（2个箱子）
- * @note  简单布局，便于新手熟悉规则
- *
- * ##########
- * #        #
- * #  . .   #
- * #  $ $   #
- * #   @    #
- * #        #
- * #        #
- * ##########
- */
-static const tile_type_t level1_layout[SOKOBAN_HEIGHT][SOKOBAN_WIDTH] = {
-    {TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_TARGET, TILE_FLOOR, TILE_TARGET, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_BOX, TILE_FLOOR, TILE_BOX, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL}
-};
-static const position_t level1_player = {3, 4};
-
-/**
- * @brief 关卡2：中等难度（3个箱子）
- * @note  增加墙壁障碍，需要规划路线
- *
- * ##########
- * #   .    #
- * # .$. $  #
- * #  $ #   #
- * #  @ #   #
- * #    #   #
- * #        #
- * ##########
- */
-static const tile_type_t level2_layout[SOKOBAN_HEIGHT][SOKOBAN_WIDTH] = {
-    {TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_TARGET, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_TARGET, TILE_BOX, TILE_TARGET, TILE_FLOOR, TILE_BOX, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_BOX, TILE_FLOOR, TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL}
-};
-static const position_t level2_player = {3, 4};
+// 关卡地图由App/assets/src/sokoban.lvl生成（RLE压缩，加载关卡时解压）
+#include "sokoban_assets.h"
 
-/**
- * @brief 关卡3：困难关卡（4个箱子）
- * @note  复杂布局，需要精心规划每一步
- *
- * ##########
- * # .  .   #
- * #  ##    #
- * # $  $ . #
- * #  ##  . #
- * # $  $   #
- * #  @     #
- * ##########
- */
-static const tile_type_t level3_layout[SOKOBAN_HEIGHT][SOKOBAN_WIDTH] = {
-    {TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_TARGET, TILE_FLOOR, TILE_FLOOR, TILE_TARGET, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_WALL, TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_BOX, TILE_FLOOR, TILE_FLOOR, TILE_BOX, TILE_FLOOR, TILE_TARGET, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_WALL, TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_TARGET, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_BOX, TILE_FLOOR, TILE_FLOOR, TILE_BOX, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_FLOOR, TILE_WALL},
-    {TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL, TILE_WALL}
-};
-static const position_t level3_player = {3, 6};
+#if SOKOBAN_LEVEL_WIDTH != SOKOBAN_WIDTH || SOKOBAN_LEVEL_HEIGHT != SOKOBAN_HEIGHT
+#error "sokoban.lvl的地图尺寸和SOKOBAN_WIDTH/SOKOBAN_HEIGHT不一致"
+#endif
+#if SOKOBAN_LEVEL_COUNT < SOKOBAN_MAX_LEVELS
+#error "sokoban.lvl中的关卡数少于SOKOBAN_MAX_LEVELS"
+#endif
 
 /* ======================== 内部函数声明 ======================== */
 
@@ -96,6 +31,10 @@ static void check_level_complete(sokoban_game_t *game);
 
 // 渲染辅助
 static void render_map(sokoban_game_t *game, u8g2_t *u8g2);
+static void render_tile(sokoban_game_t *game, u8g2_t *u8g2, uint8_t col, uint8_t row);
+static void update_tile(sokoban_game_t *game, uint8_t col, uint8_t row);
+static void render_background(sokoban_game_t *game, u8g2_t *u8g2);
+static void render_player(sokoban_game_t *game, u8g2_t *u8g2);
 static void render_ui(sokoban_game_t *game, u8g2_t *u8g2);
 
 /* ======================== 关卡管理函数 ======================== */
@@ -105,38 +44,29 @@ static void render_ui(sokoban_game_t *game, u8g2_t *u8g2);
  */
 static void load_level(sokoban_game_t *game, uint8_t level)
 {
-    const tile_type_t (*layout)[SOKOBAN_WIDTH] = NULL;
-    position_t player_pos = {0, 0};
-
-    // 选择关卡布局
-    switch (level) {
-        case 1:
-            layout = level1_layout;
-            player_pos = level1_player;
-            break;
-        case 2:
-            layout = level2_layout;
-            player_pos = level2_player;
-            break;
-        case 3:
-            layout = level3_layout;
-            player_pos = level3_player;
-            break;
-        default:
-            layout = level1_layout;
-            player_pos = level1_player;
-            break;
+    const asset_level_t *data;
+    uint8_t tiles[SOKOBAN_HEIGHT * SOKOBAN_WIDTH];
+
+    // 选择关卡（超出范围时回到第1关）
+    if (level < 1 || level > SOKOBAN_LEVEL_COUNT) {
+        level = 1;
     }
+    data = &sokoban_levels[level - 1];
 
-    // 复制关卡数据到游戏状态
+    // 解压关卡数据到游戏状态
+    assets_unpack_level(data, tiles, sizeof(tiles));
     for (uint8_t row = 0; row < SOKOBAN_HEIGHT; row++) {
         for (uint8_t col = 0; col < SOKOBAN_WIDTH; col++) {
-            game->map[row][col] = layout[row][col];
+            game->map[row][col] = (tile_type_t)tiles[row * SOKOBAN_WIDTH + col];
         }
     }
 
     // 设置玩家初始位置
-    game->player = player_pos;
+    game->player.x = (int8_t)data->start.x;
+    game->player.y = (int8_t)data->start.y;
+
+    // 新关卡，背景缓存下一帧重建
+    layer_invalidate();
 
     // 统计箱子和目标点数量
     game->total_boxes = count_boxes_and_targets(game);
@@ -153,6 +83,9 @@ static void load_level(sokoban_game_t *game, uint8_t level)
 
     // 重置步数
     game->steps = 0;
+
+    // 整张地图换了，整屏重绘
+    game->need_redraw = 1;
 }
 
 /**
@@ -256,6 +189,7 @@ static void move_player(sokoban_game_t *game, int8_t dir_x, int8_t dir_y)
         game->player.x = target_x;
         game->player.y = target_y;
         game->steps++;
+        game->need_redraw = 1;
         return;
     }
 
@@ -278,6 +212,7 @@ static void move_player(sokoban_game_t *game, int8_t dir_x, int8_t dir_y)
             game->map[target_y][target_x] = TILE_TARGET;  // 箱子原来在目标点上
             game->boxes_on_target--;  // 箱子离开目标点
         }
+        update_tile(game, target_x, target_y);
 
         // 更新箱子的新位置
         if (box_new_tile == TILE_TARGET) {
@@ -286,11 +221,13 @@ static void move_player(sokoban_game_t *game, int8_t dir_x, int8_t dir_y)
         } else {  // TILE_FLOOR
             game->map[box_new_y][box_new_x] = TILE_BOX;  // 箱子推到地板上
         }
+        update_tile(game, box_new_x, box_new_y);
 
         // 玩家移动到箱子原来的位置
         game->player.x = target_x;
         game->player.y = target_y;
         game->steps++;
+        game->need_redraw = 1;
 
         // 检查过关
         check_level_complete(game);
@@ -304,7 +241,7 @@ static void check_level_complete(sokoban_game_t *game)
 {
     if (game->boxes_on_target == game->total_boxes) {
         game->game_state = SOKOBAN_STATE_LEVEL_CLEAR;
-        game->level_clear_start_time = HAL_GetTick();
+        game->level_clear_start_time = game_manager_get_tick();
     }
 }
 
@@ -340,6 +277,7 @@ void sokoban_game_activate(sokoban_game_t *game)
 {
     game->is_active = 1;
     game->game_state = SOKOBAN_STATE_PLAYING;
+    game->need_redraw = 1;  // 从菜单回来，屏幕上是菜单画面
 }
 
 /**
@@ -379,6 +317,7 @@ void sokoban_game_update_input(sokoban_game_t *game)
     if (game->game_state == SOKOBAN_STATE_READY) {
         if (input_is_just_pressed(INPUT_BTN_A)) {
             game->game_state = SOKOBAN_STATE_PLAYING;
+            game->need_redraw = 1;
         }
         return;
     }
@@ -398,6 +337,7 @@ void sokoban_game_update_input(sokoban_game_t *game)
             game->current_level++;
             if (game->current_level > SOKOBAN_MAX_LEVELS) {
                 game->game_state = SOKOBAN_STATE_WIN;
+                game->need_redraw = 1;
             } else {
                 load_level(game, game->current_level);
                 game->game_state = SOKOBAN_STATE_PLAYING;
@@ -413,6 +353,7 @@ void sokoban_game_update_input(sokoban_game_t *game)
         } else if (game->game_state == SOKOBAN_STATE_PAUSED) {
             game->game_state = SOKOBAN_STATE_PLAYING;
         }
+        game->need_redraw = 1;
         return;
     }
 
@@ -461,48 +402,94 @@ static void render_map(sokoban_game_t *game, u8g2_t *u8g2)
 {
     for (uint8_t row = 0; row < SOKOBAN_HEIGHT; row++) {
         for (uint8_t col = 0; col < SOKOBAN_WIDTH; col++) {
-            int16_t x = SOKOBAN_OFFSET_X + col * SOKOBAN_CELL_WIDTH;
-            int16_t y = SOKOBAN_OFFSET_Y + row * SOKOBAN_CELL_HEIGHT;
+            render_tile(game, u8g2, col, row);
+        }
+    }
+}
 
-            tile_type_t tile = game->map[row][col];
+/**
+ * @brief 渲染地图中的一格（不含玩家）
+ */
+static void render_tile(sokoban_game_t *game, u8g2_t *u8g2, uint8_t col, uint8_t row)
+{
+    int16_t x = SOKOBAN_OFFSET_X + col * SOKOBAN_CELL_WIDTH;
+    int16_t y = SOKOBAN_OFFSET_Y + row * SOKOBAN_CELL_HEIGHT;
 
-            switch (tile) {
-                case TILE_WALL:
-                    // 墙壁：实心方块
-                    u8g2_DrawBox(u8g2, x, y, SOKOBAN_CELL_WIDTH, SOKOBAN_CELL_HEIGHT);
-                    break;
-
-                case TILE_TARGET:
-                    // 目标点：小圆圈
-                    u8g2_DrawCircle(u8g2, x + SOKOBAN_CELL_WIDTH/2, y + SOKOBAN_CELL_HEIGHT/2, 2, U8G2_DRAW_ALL);
-                    break;
-
-                case TILE_BOX:
-                    // 箱子：空心方块
-                    u8g2_DrawFrame(u8g2, x + 1, y + 1, SOKOBAN_CELL_WIDTH - 2, SOKOBAN_CELL_HEIGHT - 2);
-                    break;
-
-                case TILE_BOX_ON_TARGET:
-                    // 箱子在目标点上：实心方块（表示已到位）
-                    u8g2_DrawBox(u8g2, x + 1, y + 1, SOKOBAN_CELL_WIDTH - 2, SOKOBAN_CELL_HEIGHT - 2);
-                    break;
-
-                case TILE_FLOOR:
-                case TILE_EMPTY:
-                default:
-                    // 地板和空地：不绘制
-                    break;
-            }
+    tile_type_t tile = game->map[row][col];
 
-            // 绘制玩家（在玩家位置上层）
-            if (game->player.x == col && game->player.y == row) {
-                // 玩家：小实心圆
-                u8g2_DrawDisc(u8g2, x + SOKOBAN_CELL_WIDTH/2, y + SOKOBAN_CELL_HEIGHT/2, 3, U8G2_DRAW_ALL);
-            }
-        }
+    switch (tile) {
+        case TILE_WALL:
+            // 墙壁：实心方块
+            u8g2_DrawBox(u8g2, x, y, SOKOBAN_CELL_WIDTH, SOKOBAN_CELL_HEIGHT);
+            break;
+
+        case TILE_TARGET:
+            // 目标点：小圆圈
+            u8g2_DrawCircle(u8g2, x + SOKOBAN_CELL_WIDTH/2, y + SOKOBAN_CELL_HEIGHT/2, 2, U8G2_DRAW_ALL);
+            break;
+
+        case TILE_BOX:
+            // 箱子：空心方块
+            u8g2_DrawFrame(u8g2, x + 1, y + 1, SOKOBAN_CELL_WIDTH - 2, SOKOBAN_CELL_HEIGHT - 2);
+            break;
+
+        case TILE_BOX_ON_TARGET:
+            // 箱子在目标点上：实心方块（表示已到位）
+            u8g2_DrawBox(u8g2, x + 1, y + 1, SOKOBAN_CELL_WIDTH - 2, SOKOBAN_CELL_HEIGHT - 2);
+            break;
+
+        case TILE_FLOOR:
+        case TILE_EMPTY:
+        default:
+            // 地板和空地：不绘制
+            break;
+    }
+}
+
+/**
+ * @brief 格子变化后只重画背景缓存中的这一格
+ */
+static void update_tile(sokoban_game_t *game, uint8_t col, uint8_t row)
+{
+    u8g2_t *u8g2 = u8g2_get_instance();
+
+    if (layer_begin_update(u8g2, game)) {
+        u8g2_SetDrawColor(u8g2, 0);
+        u8g2_DrawBox(u8g2, SOKOBAN_OFFSET_X + col * SOKOBAN_CELL_WIDTH, SOKOBAN_OFFSET_Y + row * SOKOBAN_CELL_HEIGHT,
+                     SOKOBAN_CELL_WIDTH, SOKOBAN_CELL_HEIGHT);
+        u8g2_SetDrawColor(u8g2, 1);
+        render_tile(game, u8g2, col, row);
+        layer_end(u8g2);
+    }
+}
+
+/**
+ * @brief 绘制背景（地图）
+ * @note  地图缓存在背景层里，每帧只复制一次，代替u8g2_ClearBuffer()
+ *        推箱子时局部更新，加载关卡后整块重建
+ */
+static void render_background(sokoban_game_t *game, u8g2_t *u8g2)
+{
+    if (!layer_blit(u8g2, game)) {
+        layer_begin_rebuild(u8g2, game);
+        render_map(game, u8g2);
+        layer_end(u8g2);
+        layer_blit(u8g2, game);
     }
 }
 
+/**
+ * @brief 渲染玩家（在地图上层）
+ */
+static void render_player(sokoban_game_t *game, u8g2_t *u8g2)
+{
+    int16_t x = SOKOBAN_OFFSET_X + game->player.x * SOKOBAN_CELL_WIDTH;
+    int16_t y = SOKOBAN_OFFSET_Y + game->player.y * SOKOBAN_CELL_HEIGHT;
+
+    // 玩家：小实心圆
+    u8g2_DrawDisc(u8g2, x + SOKOBAN_CELL_WIDTH/2, y + SOKOBAN_CELL_HEIGHT/2, 3, U8G2_DRAW_ALL);
+}
+
 /**
  * @brief 渲染UI信息
  */
@@ -533,7 +520,13 @@ void sokoban_game_render(sokoban_game_t *game)
     if (!game->is_active) return;
 
     u8g2_t *u8g2 = u8g2_get_instance();
-    u8g2_ClearBuffer(u8g2);
+
+    // 有地图的画面用背景层代替清屏，之后只画玩家
+    if (game->game_state == SOKOBAN_STATE_READY || game->game_state == SOKOBAN_STATE_WIN) {
+        u8g2_ClearBuffer(u8g2);
+    } else {
+        render_background(game, u8g2);
+    }
 
     // READY状态
     if (game->game_state == SOKOBAN_STATE_READY) {
@@ -541,7 +534,7 @@ void sokoban_game_render(sokoban_game_t *game)
         u8g2_DrawStr(u8g2, 30, 26, "SOKOBAN");
         u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
         u8g2_DrawStr(u8g2, 20, 40, "Press A Start");
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
@@ -557,13 +550,13 @@ void sokoban_game_render(sokoban_game_t *game)
 
         u8g2_DrawStr(u8g2, 10, 58, "START: Restart");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // LEVEL_CLEAR状态
     if (game->game_state == SOKOBAN_STATE_LEVEL_CLEAR) {
-        render_map(game, u8g2);
+        render_player(game, u8g2);
         render_ui(game, u8g2);
 
         u8g2_SetFont(u8g2, u8g2_font_7x13_tf);
@@ -572,27 +565,27 @@ void sokoban_game_render(sokoban_game_t *game)
         u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
         u8g2_DrawStr(u8g2, 22, 50, "Press A Next");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // PAUSED状态
     if (game->game_state == SOKOBAN_STATE_PAUSED) {
-        render_map(game, u8g2);
+        render_player(game, u8g2);
         render_ui(game, u8g2);
 
         u8g2_SetFont(u8g2, u8g2_font_7x13_tf);
         u8g2_DrawStr(u8g2, 32, 35, "PAUSED");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // PLAYING状态
-    render_map(game, u8g2);
+    render_player(game, u8g2);
     render_ui(game, u8g2);
 
-    u8g2_SendBuffer(u8g2);
+    display_service_mark_ready();
 }
 
 /**
@@ -604,5 +597,5 @@ void sokoban_game_task(sokoban_game_t *game)
 
     sokoban_game_update_input(game);
     sokoban_game_update_logic(game);
-    sokoban_game_render(game);
+    // 渲染由game_manager在need_redraw置位时调用
 }
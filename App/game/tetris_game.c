@@ -7,67 +7,9 @@
 
 /* ======================== 方块形状数据定义（4×4矩阵）======================== */
 
-/**
- * @brief 7种方块的初始形状（旋转状态0）
- * @note 使用4×4矩阵存储，1表示有方块，0表示空
- */
-static const uint8_t g_tetromino_shapes[TETROMINO_COUNT][TETROMINO_SIZE][TETROMINO_SIZE] = {
-    // I型（一字长条）- 青色
-    {
-        {0, 0, 0, 0},
-        {1, 1, 1, 1},
-        {0, 0, 0, 0},
-        {0, 0, 0, 0}
-    },
-
-    // O型（正方形）- 黄色
-    {
-        {0, 0, 0, 0},
-        {0, 1, 1, 0},
-        {0, 1, 1, 0},
-        {0, 0, 0, 0}
-    },
-
-    // T型（T字形）- 紫色
-    {
-        {0, 0, 0, 0},
-        {0, 1, 0, 0},
-        {1, 1, 1, 0},
-        {0, 0, 0, 0}
-    },
-
-    // S型（S字形）- 绿色
-    {
-        {0, 0, 0, 0},
-        {0, 1, 1, 0},
-        {1, 1, 0, 0},
-        {0, 0, 0, 0}
-    },
-
-    // Z型（Z字形）- 红色
-    {
-        {0, 0, 0, 0},
-        {1, 1, 0, 0},
-        {0, 1, 1, 0},
-        {0, 0, 0, 0}
-    },
-
-    // J型（J字形）- 蓝色
-    {
-        {0, 0, 0, 0},
-        {1, 0, 0, 0},
-        {1, 1, 1, 0},
-        {0, 0, 0, 0}
-    },
-
-    // L型（L字形）- 橙色
-    {
-        {0, 0, 0, 0},
-        {0, 0, 1, 0},
-        {1, 1, 1, 0},
-        {0, 0, 0, 0}
-    }
-};
+// 形状由App/assets/src/tetris.shp生成，每种方块一个uint16_t，bit(y*4+x)对应shape[y][x]
+// 顺序必须和tetromino_type_t一致（I O T S Z J L）
+#include "tetris_assets.h"
 
 /* ======================== 内部函数声明 ======================== */
 
@@ -90,6 +32,8 @@ static void calculate_drop_interval(tetris_game_t *game);
 
 // 渲染辅助
 static void render_grid(tetris_game_t *game, u8g2_t *u8g2);
+static void render_cell(u8g2_t *u8g2, int16_t x, int16_t y);
+static void render_background(tetris_game_t *game, u8g2_t *u8g2);
 static void render_current_piece(tetris_game_t *game, u8g2_t *u8g2);
 static void render_next_piece(tetris_game_t *game, u8g2_t *u8g2);
 static void render_info(tetris_game_t *game, u8g2_t *u8g2);
@@ -109,7 +53,7 @@ static void load_tetromino(tetromino_t *tetromino, tetromino_type_t type)
     // 复制形状数据
     for (uint8_t y = 0; y < TETROMINO_SIZE; y++) {
         for (uint8_t x = 0; x < TETROMINO_SIZE; x++) {
-            tetromino->shape[y][x] = g_tetromino_shapes[type][y][x];
+            tetromino->shape[y][x] = (tetris_shapes[type] >> (y * TETROMINO_SIZE + x)) & 1;
         }
     }
 }
@@ -193,6 +137,8 @@ static uint8_t check_collision(tetris_game_t *game, tetromino_t *tetromino, int1
  */
 static void lock_piece(tetris_game_t *game)
 {
+    u8g2_t *u8g2 = u8g2_get_instance();
+
     for (uint8_t ty = 0; ty < TETROMINO_SIZE; ty++) {
         for (uint8_t tx = 0; tx < TETROMINO_SIZE; tx++) {
             if (game->current_piece.tetromino.shape[ty][tx] != 0) {
@@ -204,6 +150,12 @@ static void lock_piece(tetris_game_t *game)
                     grid_y >= 0 && grid_y < TETRIS_GRID_HEIGHT) {
                     // 存储方块类型（1-7）
                     game->grid[grid_y][grid_x] = game->current_piece.tetromino.type + 1;
+
+                    // 背景缓存中只补画这一格（原来是空格，不需要先擦除）
+                    if (layer_begin_update(u8g2, game)) {
+                        render_cell(u8g2, grid_x, grid_y);
+                        layer_end(u8g2);
+                    }
                 }
             }
         }
@@ -279,6 +231,9 @@ static void apply_gravity(tetris_game_t *game)
 
     // 清除标记
     memset(game->clearing_lines, 0, sizeof(game->clearing_lines));
+
+    // 整块网格下移，背景缓存下一帧重建
+    layer_invalidate();
 }
 
 /* ======================== 游戏控制函数 ======================== */
@@ -353,6 +308,10 @@ void tetris_game_init(tetris_game_t *game)
     // 生成第一个和下一个方块
     game->next_piece_type = get_random_tetromino_type();
     spawn_new_piece(game);
+
+    // 新的一局，整屏重绘
+    game->need_redraw = 1;
+    layer_invalidate();
 }
 
 /**
@@ -362,7 +321,8 @@ void tetris_game_activate(tetris_game_t *game)
 {
     game->is_active = 1;
     game->game_state = TETRIS_STATE_RUNNING;
-    game->last_drop_time = HAL_GetTick();
+    game->last_drop_time = game_manager_get_tick();
+    game->need_redraw = 1;  // 从菜单回来，屏幕上是菜单画面
 }
 
 /**
@@ -402,7 +362,8 @@ void tetris_game_update_input(tetris_game_t *game)
     if (game->game_state == TETRIS_STATE_READY) {
         if (input_any_button_pressed() || input_any_direction_pressed()) {
             game->game_state = TETRIS_STATE_RUNNING;
-            game->last_drop_time = HAL_GetTick();
+            game->last_drop_time = game_manager_get_tick();
+            game->need_redraw = 1;
         }
         return;
     }
@@ -422,8 +383,9 @@ void tetris_game_update_input(tetris_game_t *game)
             game->game_state = TETRIS_STATE_PAUSED;
         } else if (game->game_state == TETRIS_STATE_PAUSED) {
             game->game_state = TETRIS_STATE_RUNNING;
-            game->last_drop_time = HAL_GetTick();  // 重置时间，避免暂停后瞬间下落
+            game->last_drop_time = game_manager_get_tick();  // 重置时间，避免暂停后瞬间下落
         }
+        game->need_redraw = 1;
         return;
     }
 
@@ -432,7 +394,7 @@ void tetris_game_update_input(tetris_game_t *game)
         return;
     }
 
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
 
     // === DAS (Delayed Auto Shift) 系统 - 连续移动机制 ===
 
@@ -442,6 +404,7 @@ void tetris_game_update_input(tetris_game_t *game)
         int16_t new_x = game->current_piece.x - 1;
         if (!check_collision(game, &game->current_piece.tetromino, new_x, game->current_piece.y)) {
             game->current_piece.x = new_x;
+            game->need_redraw = 1;
         }
 
         // 启动DAS
@@ -460,6 +423,7 @@ void tetris_game_update_input(tetris_game_t *game)
                 int16_t new_x = game->current_piece.x - 1;
                 if (!check_collision(game, &game->current_piece.tetromino, new_x, game->current_piece.y)) {
                     game->current_piece.x = new_x;
+                    game->need_redraw = 1;
                 }
                 game->das_last_move_time = now;
             }
@@ -475,6 +439,7 @@ void tetris_game_update_input(tetris_game_t *game)
         int16_t new_x = game->current_piece.x + 1;
         if (!check_collision(game, &game->current_piece.tetromino, new_x, game->current_piece.y)) {
             game->current_piece.x = new_x;
+            game->need_redraw = 1;
         }
 
         // 启动DAS
@@ -493,6 +458,7 @@ void tetris_game_update_input(tetris_game_t *game)
                 int16_t new_x = game->current_piece.x + 1;
                 if (!check_collision(game, &game->current_piece.tetromino, new_x, game->current_piece.y)) {
                     game->current_piece.x = new_x;
+                    game->need_redraw = 1;
                 }
                 game->das_last_move_time = now;
             }
@@ -525,6 +491,7 @@ void tetris_game_update_input(tetris_game_t *game)
             if (!check_collision(game, &game->current_piece.tetromino, test_x, test_y)) {
                 game->current_piece.x = test_x;
                 game->current_piece.y = test_y;
+                game->need_redraw = 1;
                 success = 1;
                 break;
             }
@@ -551,10 +518,17 @@ void tetris_game_update_logic(tetris_game_t *game)
         return;
     }
 
-    uint32_t now = HAL_GetTick();
+    uint32_t now = game_manager_get_tick();
 
     // 消行动画处理
     if (game->clearing_animation) {
+        // 闪烁在渲染时按经过时间决定显示/隐藏，相位变了要重绘，否则画面停在第一相位
+        uint8_t phase = (uint8_t)((now - game->clearing_start_time) / 100);
+        if (phase != game->clearing_phase) {
+            game->clearing_phase = phase;
+            game->need_redraw = 1;
+        }
+
         // 动画持续200ms
         if (now - game->clearing_start_time >= 200) {
             // 应用重力（消除满行）
@@ -565,6 +539,7 @@ void tetris_game_update_logic(tetris_game_t *game)
 
             // 结束动画
             game->clearing_animation = 0;
+            game->need_redraw = 1;
         }
         return;
     }
@@ -574,6 +549,7 @@ void tetris_game_update_logic(tetris_game_t *game)
 
     if (now - game->last_drop_time >= current_interval) {
         game->last_drop_time = now;
+        game->need_redraw = 1;  // 下落、固定、消行都会改变画面
 
         // 尝试下落
         int16_t new_y = game->current_piece.y + 1;
@@ -597,6 +573,7 @@ void tetris_game_update_logic(tetris_game_t *game)
                 // 启动消行动画
                 game->clearing_animation = 1;
                 game->clearing_start_time = now;
+                game->clearing_phase = 0;
 
                 // 更新统计
                 game->lines_cleared += lines;
@@ -623,25 +600,59 @@ void tetris_game_update_logic(tetris_game_t *game)
  */
 static void render_grid(tetris_game_t *game, u8g2_t *u8g2)
 {
+    // 绘制游戏区域边框
+    u8g2_DrawFrame(u8g2, TETRIS_GRID_OFFSET_X - 1, TETRIS_GRID_OFFSET_Y - 1,
+                   TETRIS_GRID_WIDTH * TETRIS_CELL_SIZE + 1,
+                   TETRIS_GRID_HEIGHT * TETRIS_CELL_SIZE + 1);
+
     for (uint8_t y = 0; y < TETRIS_GRID_HEIGHT; y++) {
         for (uint8_t x = 0; x < TETRIS_GRID_WIDTH; x++) {
             if (game->grid[y][x] != 0) {
-                // 计算像素坐标
-                uint8_t px = TETRIS_GRID_OFFSET_X + x * TETRIS_CELL_SIZE;
-                uint8_t py = TETRIS_GRID_OFFSET_Y + y * TETRIS_CELL_SIZE;
-
-                // 消行动画：闪烁效果
-                if (game->clearing_animation && game->clearing_lines[y]) {
-                    // 每100ms切换一次显示/隐藏
-                    uint32_t elapsed = HAL_GetTick() - game->clearing_start_time;
-                    if ((elapsed / 100) % 2 == 0) {
-                        continue;  // 隐藏
-                    }
-                }
+                render_cell(u8g2, x, y);
+            }
+        }
+    }
+}
 
-                // 绘制实心方块（5×5，留1像素边距）
-                u8g2_DrawBox(u8g2, px, py, TETRIS_CELL_SIZE - 1, TETRIS_CELL_SIZE - 1);
+/**
+ * @brief 绘制一个已固定的格子
+ */
+static void render_cell(u8g2_t *u8g2, int16_t x, int16_t y)
+{
+    // 计算像素坐标
+    uint8_t px = TETRIS_GRID_OFFSET_X + x * TETRIS_CELL_SIZE;
+    uint8_t py = TETRIS_GRID_OFFSET_Y + y * TETRIS_CELL_SIZE;
+
+    // 绘制实心方块（留1像素边距）
+    u8g2_DrawBox(u8g2, px, py, TETRIS_CELL_SIZE - 1, TETRIS_CELL_SIZE - 1);
+}
+
+/**
+ * @brief 绘制背景（边框和已固定的方块）
+ * @note  背景缓存在背景层里，每帧只复制一次，代替u8g2_ClearBuffer()
+ *        固定方块时局部更新，消行后整块重建
+ */
+static void render_background(tetris_game_t *game, u8g2_t *u8g2)
+{
+    if (!layer_blit(u8g2, game)) {
+        layer_begin_rebuild(u8g2, game);
+        render_grid(game, u8g2);
+        layer_end(u8g2);
+        layer_blit(u8g2, game);
+    }
+
+    // 消行动画：闪烁效果，每100ms切换一次显示/隐藏
+    if (game->clearing_animation) {
+        uint32_t elapsed = game_manager_get_tick() - game->clearing_start_time;
+        if ((elapsed / 100) % 2 == 0) {
+            u8g2_SetDrawColor(u8g2, 0);
+            for (uint8_t y = 0; y < TETRIS_GRID_HEIGHT; y++) {
+                if (game->clearing_lines[y]) {
+                    u8g2_DrawBox(u8g2, TETRIS_GRID_OFFSET_X, TETRIS_GRID_OFFSET_Y + y * TETRIS_CELL_SIZE,
+                                 TETRIS_GRID_WIDTH * TETRIS_CELL_SIZE, TETRIS_CELL_SIZE);
+                }
             }
+            u8g2_SetDrawColor(u8g2, 1);
         }
     }
 }
@@ -717,7 +728,7 @@ static void render_info(tetris_game_t *game, u8g2_t *u8g2)
 
     // 分数
     u8g2_DrawStr(u8g2, TETRIS_INFO_OFFSET_X + 2, 40, "SCORE");
-    snprintf(buf, sizeof(buf), "%lu", game->score);
+    snprintf(buf, sizeof(buf), "%lu", (unsigned long)game->score);
     u8g2_DrawStr(u8g2, TETRIS_INFO_OFFSET_X + 2, 48, buf);
 
     // 等级
@@ -735,12 +746,8 @@ void tetris_game_render(tetris_game_t *game)
 
     u8g2_t *u8g2 = u8g2_get_instance();
 
-    u8g2_ClearBuffer(u8g2);
-
-    // 绘制游戏区域边框
-    u8g2_DrawFrame(u8g2, TETRIS_GRID_OFFSET_X - 1, TETRIS_GRID_OFFSET_Y - 1,
-                   TETRIS_GRID_WIDTH * TETRIS_CELL_SIZE + 1,
-                   TETRIS_GRID_HEIGHT * TETRIS_CELL_SIZE + 1);
+    // 背景层代替清屏：边框和已固定的方块
+    render_background(game, u8g2);
 
     // READY状态
     if (game->game_state == TETRIS_STATE_READY) {
@@ -748,47 +755,43 @@ void tetris_game_render(tetris_game_t *game)
         u8g2_DrawStr(u8g2, 20, 32, "TETRIS");
         u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
         u8g2_DrawStr(u8g2, 10, 48, "Press Any Key");
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // GAME_OVER状态
     if (game->game_state == TETRIS_STATE_GAME_OVER) {
-        render_grid(game, u8g2);
-
         u8g2_SetFont(u8g2, u8g2_font_7x13_tf);
         u8g2_DrawStr(u8g2, 12, 28, "GAME OVER");
 
         u8g2_SetFont(u8g2, u8g2_font_5x7_tf);
         char buf[20];
-        snprintf(buf, sizeof(buf), "Score: %lu", game->score);
+        snprintf(buf, sizeof(buf), "Score: %lu", (unsigned long)game->score);
         u8g2_DrawStr(u8g2, 18, 40, buf);
 
         u8g2_DrawStr(u8g2, 8, 56, "START: Restart");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // PAUSED状态
     if (game->game_state == TETRIS_STATE_PAUSED) {
-        render_grid(game, u8g2);
         render_current_piece(game, u8g2);
 
         u8g2_SetFont(u8g2, u8g2_font_7x13_tf);
         u8g2_DrawStr(u8g2, 20, 32, "PAUSED");
 
-        u8g2_SendBuffer(u8g2);
+        display_service_mark_ready();
         return;
     }
 
     // RUNNING状态
-    render_grid(game, u8g2);
     render_current_piece(game, u8g2);
     render_next_piece(game, u8g2);
     render_info(game, u8g2);
 
-    u8g2_SendBuffer(u8g2);
+    display_service_mark_ready();
 }
 
 /**
@@ -804,6 +807,5 @@ void tetris_game_task(tetris_game_t *game)
     // 更新逻辑
     tetris_game_update_logic(game);
 
-    // 渲染画面
-    tetris_game_render(game);
+    // 渲染由game_manager在need_redraw置位时调用
 }
@@ -127,6 +127,7 @@ typedef struct {
 typedef struct {
     // 活跃状态控制（场景切换）
     uint8_t is_active;                              // 活跃标志（1=前台运行，0=后台停止）
+    uint8_t need_redraw;                            // 画面需要重绘（状态变化时置1，渲染后清零）
     void (*exit_callback)(void);                    // 退出回调（返回菜单）
 
     // 游戏状态
@@ -159,6 +160,7 @@ typedef struct {
     uint8_t clearing_lines[TETRIS_GRID_HEIGHT];    // 待清除行标记（1=待清除，0=正常）
     uint8_t clearing_animation;                     // 消行动画标志
     uint32_t clearing_start_time;                   // 消行动画开始时间
+    uint8_t clearing_phase;                         // 消行动画已经画到的闪烁相位（每100ms加1）
 
 } tetris_game_t;
 
@@ -208,7 +210,7 @@ void tetris_game_update_logic(tetris_game_t *game);
 void tetris_game_render(tetris_game_t *game);
 
 /**
- * @brief 游戏主任务（10ms周期调用，集成输入+逻辑+渲染）
+ * @brief 游戏主任务（10ms周期调用，集成输入+逻辑，画面变化时置位need_redraw）
  * @param game 游戏实例指针
  */
 void tetris_game_task(tetris_game_t *game);
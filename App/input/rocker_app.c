@@ -10,7 +10,14 @@ void rocker_app_init(void)
 	rocker_adc_driver_init();
 
 	// 2. 初始化摇杆组件（Components层）
-	rocker_init(NULL);           // 使用默认配置
+	//    驱动已经把每 64 个采样点平均成一个值，组件不再做滑动平均（多平均只会增加延迟）
+	static const rocker_config_t config = {
+		ROCKER_DEFAULT_DEADZONE,
+		1,
+		ROCKER_DEFAULT_OUTPUT_MIN,
+		ROCKER_DEFAULT_OUTPUT_MAX,
+	};
+	rocker_init(&config);
 
 	// 3. 启用事件推送（关键！没有这个就不会推送事件到event_queue）
 	rocker_event_enable(true);
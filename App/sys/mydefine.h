@@ -24,6 +24,8 @@
 /* ========== 驱动层头文件 ========== */
 #include "key_driver.h"
 #include "ebtn_driver.h"       //easy-button驱动层头文件
+#include "key_sampler.h"       //按键DMA采样
+#include "key_exti.h"          //按键EXTI边沿捕获
 #include "uart_driver.h"       //串口驱动层头文件
 #include "rocker_adc_driver.h" //摇杆adc驱动层头文件
 #include "ssd1306.h"  // oled驱动核心
@@ -40,6 +42,10 @@
 #include "ball_physics.h"  //通用球物理模块（打砖块、乒乓球等游戏复用）
 #include "u8g2.h"					 //u8g2图形组件库头文件
 #include "u8g2_stm32_hal.h" //u8g2的STM32 HAL适配层
+#include "display_service.h" //显示服务（统一限速刷新OLED）
+#include "sprite.h"         //1bpp精灵图快速绘制
+#include "layer.h"          //静态背景层缓存（网格类游戏）
+#include "perf_hud.h"       //性能浮层（DWT计时，帧率/耗时/负载）
 #include "menu_core.h"     //菜单控制器核心模块
 #include "menu_builder.h"  //菜单构建器辅助工具
 #include "menu_render.h"   //菜单渲染模块
@@ -80,6 +86,7 @@
 //#include "test_menu.h"         //菜单系统测试头文件
 #include "test_littlefs.h"     //LittleFS文件系统测试头文件
 #include "test_sdcard.h"       //SD卡(FATFS)测试头文件
+//#include "test_display.h"      //显示刷新链路测试头文件
 
 /* ========== 句柄 ========== */
 
@@ -1,4 +1,6 @@
 #include "system_assembly.h"
+#include "event_bus.h"
+#include "input_replay.h"
 // #include "test_menu.h"  // 测试菜单（已禁用）
 
 // -----------------------------------------------------------------------------
@@ -87,13 +89,22 @@ GAME_ADAPTER(pong_game, pong_game_t)
 GAME_DESCRIPTOR(g_pong_game, "Pong", pong_game);
 
 
-   void test_flash(void)
+/**
+ * @brief Flash功能测试（协程版本）。
+ * 擦除/写页只发命令，用PT_WAIT_UNTIL轮询WIP标志，等待期间调度器照常运行其它任务。
+ * 跨让出点使用的变量必须是static。
+ */
+static uint8_t test_flash_pt(scheduler_pt_t *pt)
   {
-      uint8_t write_buf[32] = "Hello W25Q64 Flash!";
-      uint8_t read_buf[32] = {0};
+      static uint8_t write_buf[32] = "Hello W25Q64 Flash!";
+      static uint8_t read_buf[32] = {0};
+      static uint8_t test_data[] = {0x12, 0x34, 0x56, 0x78, 0xAB, 0xCD, 0xEF};
+      static uint8_t test_passed;
       uint16_t id;
-      uint8_t test_passed = 1;
 
+      PT_BEGIN(pt);
+
+      test_passed = 1;
       my_printf(&huart1, "\r\n========= Flash功能测试 =========\r\n");
 
       // 1. 初始化
@@ -112,9 +123,10 @@ GAME_DESCRIPTOR(g_pong_game, "Pong", pong_game);
           test_passed = 0;
       }
 
-      // 3. 擦除扇区0
+      // 3. 擦除扇区0（几十到几百毫秒，不阻塞）
       my_printf(&huart1, "[3] 擦除扇区0...");
-      spi_flash_sector_erase(0);
+      spi_flash_sector_erase_start(0);
+      PT_WAIT_UNTIL(pt, !spi_flash_is_busy());
       my_printf(&huart1, "完成\r\n");
 
       // 4. 读取擦除后的数据（应该全是0xFF）
@@ -136,7 +148,8 @@ GAME_DESCRIPTOR(g_pong_game, "Pong", pong_game);
 
       // 5. 写入数据
       my_printf(&huart1, "[5] 写入数据: \"%s\"...", write_buf);
-      spi_flash_page_write(write_buf, 0, sizeof(write_buf));
+      spi_flash_page_write_start(write_buf, 0, sizeof(write_buf));
+      PT_WAIT_UNTIL(pt, !spi_flash_is_busy());
       my_printf(&huart1, "完成\r\n");
 
       // 6. 读取数据
@@ -157,8 +170,8 @@ GAME_DESCRIPTOR(g_pong_game, "Pong", pong_game);
 
       // 8. 测试不同地址写入
       my_printf(&huart1, "[8] 测试地址0x100写入...");
-      uint8_t test_data[] = {0x12, 0x34, 0x56, 0x78, 0xAB, 0xCD, 0xEF};
-      spi_flash_page_write(test_data, 0x100, sizeof(test_data));
+      spi_flash_page_write_start(test_data, 0x100, sizeof(test_data));
+      PT_WAIT_UNTIL(pt, !spi_flash_is_busy());
       memset(read_buf, 0, sizeof(read_buf));
       spi_flash_buffer_read(read_buf, 0x100, sizeof(test_data));
 
@@ -178,7 +191,8 @@ GAME_DESCRIPTOR(g_pong_game, "Pong", pong_game);
 
       // 9. 清理测试数据
       my_printf(&huart1, "[9] 清理测试数据(擦除扇区0)...");
-      spi_flash_sector_erase(0);
+      spi_flash_sector_erase_start(0);
+      PT_WAIT_UNTIL(pt, !spi_flash_is_busy());
       my_printf(&huart1, "完成\r\n");
 
       // 总结
@@ -189,7 +203,40 @@ GAME_DESCRIPTOR(g_pong_game, "Pong", pong_game);
           my_printf(&huart1, ">>> 测试失败! <<<\r\n");
       }
       my_printf(&huart1, "==================================\r\n\r\n");
+
+      PT_END(pt);
   }
+
+// 存储自检协程状态
+static scheduler_pt_t s_storage_selftest_pt;
+static scheduler_pt_t s_flash_test_pt;
+
+/**
+ * @brief 存储自检后台任务（协程）。
+ * 只有Flash测试在这里跑：擦除/写页等待WIP时让出，游戏和菜单照常响应。
+ * LittleFS/SD卡的块设备回调是同步的，一组测试中间没有可以让出的地方，
+ * 放到调度器里也会在某一帧卡住几百毫秒，所以仍在system_assembly_init里开机时执行。
+ */
+static uint8_t storage_selftest_task(scheduler_pt_t *pt)
+{
+	PT_BEGIN(pt);
+
+	PT_SPAWN(pt, &s_flash_test_pt, test_flash_pt(&s_flash_test_pt));
+
+	// 通知后台订阅者存储自检结束（事件总线，没人订阅时直接丢弃）
+	{
+		app_event_t evt;
+
+		evt.source_id = EVENT_SOURCE_STORAGE;
+		evt.event_type = EVENT_STORAGE_SELFTEST_DONE;
+		evt.data = 0;
+		evt.timestamp_us = scheduler_get_time_us();
+		event_bus_publish(EVENT_TOPIC_STORAGE, evt);
+	}
+
+	PT_END(pt);
+}
+
 /**
  * @brief 系统的主要初始化函数。
  */
@@ -199,12 +246,19 @@ void system_assembly_init(void)
 	scheduler_init();
 	ebtn_driver_init();
 	event_queue_init();
+	event_bus_init();
 	rocker_app_init();           // 摇杆应用层初始化（包含ADC驱动+组件+事件使能）
 //	test_rocker_adc_init();
 
 	// 初始化u8g2显示组件
 	u8g2_component_init();
 
+	// 初始化显示服务（游戏和菜单的帧统一由它发送）
+	display_service_init(&g_u8g2);
+
+	// 初始化性能浮层（打开DWT计数器，缓存浮层字形）
+	perf_hud_init(&g_u8g2);
+
 	// 初始化u8g2测试
 //	test_u8g2_init();
 
@@ -214,6 +268,9 @@ void system_assembly_init(void)
 	// 初始化输入管理器
 	input_manager_init();
 
+	// 初始化输入录制回放（默认每局游戏自动录制，可以随时回放最近一局）
+	input_replay_init();
+
 	// 初始化游戏管理器
 	game_manager_init();
 
@@ -265,27 +322,50 @@ void system_assembly_init(void)
 
 	// 初始化主菜单
 	main_menu_init();
-	test_flash();  // Temporarily disabled - conflicts with LittleFS
 
+	// LittleFS/SD卡自检在开机时阻塞执行（块设备回调是同步的，没有让出点）
+	// Flash测试改成协程，见storage_selftest_task；它在这之后才擦扇区0，
+	// 和原来一样下次开机LittleFS会重新格式化
+	spi_flash_init();            // 原来由先跑的Flash测试初始化（拉高片选）
 	test_littlefs_init();
 	test_littlefs_run_all();
-	
+
 	test_sdcard_init();
-  test_sdcard_run_all();
-  test_sdcard_run_advanced();
+	test_sdcard_run_all();
+	test_sdcard_run_advanced();
 }
 
+// 10ms周期任务的相位（毫秒）
+#define TASK_PHASE_INPUT_MS  0   // 输入采集：按键、摇杆、输入管理器
+#define TASK_PHASE_FRAME_MS  2   // 一帧：游戏/菜单逻辑和渲染、显示发送
+
 /**
  * @brief 应用任务注册函数。
  * 职责：将所有应用层任务注册到调度器中。
  */
 void system_assembly_register_tasks(void)
 {
-	scheduler_add_task(ebtn_process_task, 10);       // ebtn按键处理任务
-	scheduler_add_task(rocker_process_task, 10);     // 摇杆处理任务
-	scheduler_add_task(input_manager_task, 10);      // 输入管理器任务
-	scheduler_add_task(game_manager_task_all, 10);   // 游戏管理器任务（调用所有注册游戏的task）
-	scheduler_add_task(main_menu_task, 10);          // 主菜单任务
+	// 相位：输入采集在第0ms，使用输入的逻辑/渲染/发送错开到第2ms，
+	// 两组不在同一个tick里运行；输入的边沿标志保持到下一次input_manager_task，
+	// 所以错开不到一个周期不会丢按键
+	// 优先级：同一tick到期时输入先于逻辑，显示服务最后（画好的帧马上发送）
+	scheduler_add_task_ex(ebtn_process_task, 10, SCHEDULER_PRIORITY_HIGH, TASK_PHASE_INPUT_MS, "ebtn");       // ebtn按键处理任务
+	scheduler_add_task_ex(rocker_process_task, 10, SCHEDULER_PRIORITY_HIGH, TASK_PHASE_INPUT_MS, "rocker");     // 摇杆处理任务
+	scheduler_add_task_ex(input_manager_task, 10, SCHEDULER_PRIORITY_HIGH, TASK_PHASE_INPUT_MS, "input");      // 输入管理器任务
+	scheduler_add_task_ex(perf_hud_task, PERF_HUD_TASK_PERIOD_MS, SCHEDULER_PRIORITY_NORMAL, TASK_PHASE_FRAME_MS, "perf_hud"); // 性能浮层任务（X键双击切换）
+	scheduler_add_task_ex(game_manager_task_all, 10, SCHEDULER_PRIORITY_NORMAL, TASK_PHASE_FRAME_MS, "game"); // 游戏管理器任务（只调度当前游戏）
+	scheduler_add_task_ex(main_menu_task, 10, SCHEDULER_PRIORITY_NORMAL, TASK_PHASE_FRAME_MS, "menu");        // 主菜单任务
+	scheduler_add_task_ex(display_service_task, DISPLAY_SERVICE_TASK_PERIOD_MS, SCHEDULER_PRIORITY_LOW, TASK_PHASE_FRAME_MS, "display"); // 显示服务任务（在绘制任务之后）
+	scheduler_add_pt_task(storage_selftest_task, &s_storage_selftest_pt, 1, SCHEDULER_PRIORITY_LOW, 0, "storage"); // Flash自检（协程，等待擦写时让出，结束后不再调度）
+
+	// 事件唤醒：按键/摇杆事件投递后，输入管理器和所有读按键边沿的任务立即运行一次，
+	// 不用等到下一个10ms；它们一起订阅，按优先级在同一轮里先处理事件再读边沿，
+	// 显示服务优先级最低，跟在后面把这一帧发出去（仍受目标帧率限制）
+	scheduler_set_event_wakeup(input_manager_task, true);
+	scheduler_set_event_wakeup(perf_hud_task, true);
+	scheduler_set_event_wakeup(game_manager_task_all, true);
+	scheduler_set_event_wakeup(main_menu_task, true);
+	scheduler_set_event_wakeup(display_service_task, true);
 }
 
  
\ No newline at end of file
@@ -13,17 +13,73 @@ extern ADC_HandleTypeDef hadc2;
 // -----------------------------------------------------------------------------
 // 2. 静态数据存储定义
 // -----------------------------------------------------------------------------
-// 必须与 rocker_adc_driver.h 中的宏定义一致
-#define ROCKER_DMA_BUFFER_SIZE 128
+// 半个缓冲区就是一块
+#if ROCKER_DMA_BUFFER_SIZE != 2 * ROCKER_ADC_BLOCK_SIZE
+#error "ROCKER_DMA_BUFFER_SIZE must be two blocks"
+#endif
+
+// 打包累加的分组：每组 16 个采样点，12 位值累加 16 次最多 65520，不会溢出 16 位
+#define ROCKER_ADC_GROUP_SIZE 16
+
+#if ROCKER_ADC_BLOCK_SIZE % ROCKER_ADC_GROUP_SIZE != 0
+#error "ROCKER_ADC_BLOCK_SIZE must be a multiple of ROCKER_ADC_GROUP_SIZE"
+#endif
 
 // DMA 缓冲区：存储 X/Y 轴原始数据
 static uint32_t s_rocker_dma_buffer[ROCKER_DMA_BUFFER_SIZE];
 
-// 最新数据存储：使用 rocker_data_t (已在头文件中定义)
-static rocker_data_t s_latest_rocker_data;
+// 最新一块的过采样结果：低16位=X，高16位=Y。一个字写入，任务读到的 X/Y 总是同一块的
+static volatile uint32_t s_latest_hires;
+
+static rocker_adc_stats_t s_stats;
 
 // -----------------------------------------------------------------------------
-// 3. 驱动 API 实现
+// 3. 内部函数
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 一块采样点的过采样抽取。
+ * 每个字是一对 12 位值（低16位=X，高16位=Y），直接按 32 位相加就是两个 16 位通道同时累加
+ * （和 UADD16 结果相同：每组 16 个点，低16位不会进位到高16位），每个采样点一次加法。
+ * @param block: 半个 DMA 缓冲区。
+ */
+static void rocker_adc_process_block(const uint32_t *block)
+{
+    uint32_t start = SCHEDULER_GET_CYCLES();
+    uint32_t sum_x = 0;
+    uint32_t sum_y = 0;
+    uint32_t hires_x, hires_y, cycles;
+
+    for (uint32_t i = 0; i < ROCKER_ADC_BLOCK_SIZE; i += ROCKER_ADC_GROUP_SIZE)
+    {
+        const uint32_t *p = &block[i];
+        uint32_t acc;
+
+        acc = p[0] + p[1] + p[2] + p[3];
+        acc += p[4] + p[5] + p[6] + p[7];
+        acc += p[8] + p[9] + p[10] + p[11];
+        acc += p[12] + p[13] + p[14] + p[15];
+
+        sum_x += acc & 0xFFFF;
+        sum_y += acc >> 16;
+    }
+
+    // 64 个点的和右移 3 位（四舍五入），得到 15 位的值
+    hires_x = (sum_x + (1u << (ROCKER_ADC_OVERSAMPLE_BITS - 1))) >> ROCKER_ADC_OVERSAMPLE_BITS;
+    hires_y = (sum_y + (1u << (ROCKER_ADC_OVERSAMPLE_BITS - 1))) >> ROCKER_ADC_OVERSAMPLE_BITS;
+    s_latest_hires = hires_x | (hires_y << 16);
+
+    cycles = SCHEDULER_GET_CYCLES() - start;
+    s_stats.blocks++;
+    s_stats.last_cycles = cycles;
+    if (cycles > s_stats.max_cycles)
+    {
+        s_stats.max_cycles = cycles;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// 4. 驱动 API 实现
 // -----------------------------------------------------------------------------
 
 /**
@@ -31,6 +87,9 @@ static rocker_data_t s_latest_rocker_data;
  */
 void rocker_adc_driver_init(void)
 {
+    s_latest_hires = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+
     // 步骤 1: 启动触发源 (TIM3)
     HAL_TIM_Base_Start(&htim3);
 
@@ -40,6 +99,7 @@ void rocker_adc_driver_init(void)
 
     // 步骤 3: 启动 Master ADC (ADC1) 的多模式DMA传输
     // 使用 HAL_ADCEx_MultiModeStart_DMA 从CDR寄存器读取组合数据（高16位=ADC2，低16位=ADC1）
+    // 半满/全满中断（DMA2_Stream0）里处理刚写完的那一半
     HAL_ADCEx_MultiModeStart_DMA(&hadc1, s_rocker_dma_buffer, ROCKER_DMA_BUFFER_SIZE);
 }
 
@@ -48,36 +108,56 @@ void rocker_adc_driver_init(void)
  */
 rocker_data_t rocker_adc_get_raw_value(void)
 {
-    // 1. 获取 DMA 剩余传输次数 (Remaining Transfers)
-    // 修正：使用正确的 DMA 宏替换未声明的函数 HAL_DMA_GetCounter
-    uint16_t remaining_transfers = (uint16_t)__HAL_DMA_GET_COUNTER(hadc1.DMA_Handle);
+    rocker_data_t data = rocker_adc_get_hires_value();
 
-    // 2. 计算 DMA 下一个要写入的数组索引 (Next Write Index)
-    uint16_t next_write_index = ROCKER_DMA_BUFFER_SIZE - remaining_transfers;
+    // 15 位四舍五入回 12 位，和原来的接口一致
+    data.x_raw_value = (data.x_raw_value + (1u << (ROCKER_ADC_OVERSAMPLE_BITS - 1))) >> ROCKER_ADC_OVERSAMPLE_BITS;
+    data.y_raw_value = (data.y_raw_value + (1u << (ROCKER_ADC_OVERSAMPLE_BITS - 1))) >> ROCKER_ADC_OVERSAMPLE_BITS;
+    return data;
+}
+
+/**
+ * @brief 获取最新的高分辨率摇杆值。
+ */
+rocker_data_t rocker_adc_get_hires_value(void)
+{
+    uint32_t hires = s_latest_hires;
+    rocker_data_t data;
 
-    // 3. 计算最新完成数据的索引 (Read Index)
-    uint16_t read_index;
+    data.x_raw_value = hires & 0xFFFF;
+    data.y_raw_value = hires >> 16;
+    return data;
+}
 
-    // 处理数组头部的回绕情况 (wrap-around)
-    if (next_write_index >= 1)
+/**
+ * @brief 获取过采样统计。
+ */
+void rocker_adc_get_stats(rocker_adc_stats_t *stats)
+{
+    if (stats != NULL)
     {
-        // 正常情况：读取最新的一个数据
-        read_index = next_write_index - 1;
+        *stats = s_stats;
     }
-    else
+}
+
+/**
+ * @brief ADC DMA 半满回调：前一半刚写完，DMA 正在写后一半。
+ */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1)
     {
-        // 回绕情况：最新数据在缓冲区的末尾
-        read_index = ROCKER_DMA_BUFFER_SIZE - 1;
+        rocker_adc_process_block(&s_rocker_dma_buffer[0]);
     }
+}
 
-    // 4. 从32位组合数据中提取 X/Y 轴数据
-    // 在双ADC模式(ADC_DMAACCESSMODE_2)下，DMA从CDR寄存器读取32位数据：
-    // 低16位 (bits 0-15)  = ADC1数据 (X轴)
-    // 高16位 (bits 16-31) = ADC2数据 (Y轴)
-    uint32_t combined_data = s_rocker_dma_buffer[read_index];
-    s_latest_rocker_data.x_raw_value = combined_data & 0xFFFF;         // 提取低16位 (X轴)
-    s_latest_rocker_data.y_raw_value = (combined_data >> 16) & 0xFFFF; // 提取高16位 (Y轴)
-
-    // 5. 返回最新数据
-    return s_latest_rocker_data;
+/**
+ * @brief ADC DMA 全满回调：后一半刚写完，DMA 回到开头写前一半。
+ */
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1)
+    {
+        rocker_adc_process_block(&s_rocker_dma_buffer[ROCKER_ADC_BLOCK_SIZE]);
+    }
 }
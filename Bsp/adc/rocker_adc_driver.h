@@ -15,6 +15,16 @@
  */
 #define ROCKER_DMA_BUFFER_SIZE 128
 
+/**
+ * @brief ȡDMA ÿд64  X/Y 㣩ڰ/ȫжƽһֵ
+ * TIM3 10kHz ÿ 6.4ms һֵ64 = 4^3  3 λֱʣ12 λ -> 15 λ
+ *  1/8
+ */
+#define ROCKER_ADC_BLOCK_SHIFT     6
+#define ROCKER_ADC_BLOCK_SIZE      (1u << ROCKER_ADC_BLOCK_SHIFT)
+#define ROCKER_ADC_OVERSAMPLE_BITS (ROCKER_ADC_BLOCK_SHIFT / 2)
+#define ROCKER_ADC_HIRES_MAX       (4095u << ROCKER_ADC_OVERSAMPLE_BITS)
+
 
 // -----------------------------------------------------------------------------
 // 2. ݽṹ
@@ -30,6 +40,16 @@ typedef struct
     uint32_t y_raw_value; /*!< Y ᣨADC2ԭʼֵ (0-4095) */
 } rocker_data_t;
 
+/**
+ * @brief ͳơ
+ */
+typedef struct
+{
+    uint32_t blocks;      /*!< İ뻺 */
+    uint32_t last_cycles; /*!< һĴʱCPU ڣ */
+    uint32_t max_cycles;  /*!< һĴʱCPU ڣ */
+} rocker_adc_stats_t;
+
 
 // -----------------------------------------------------------------------------
 // 3.  API 
@@ -43,11 +63,22 @@ void rocker_adc_driver_init(void);
 
 /**
  * @brief ȡµҡԭʼ ADC ֵ
- * ְ𣺴 DMA ȡµ X/Y ԭʼ
- * @return rocker_data_t:  X  Y ԭʼֵĽṹ塣
+ * ְ𣺷һƽĽ 12 λɨ DMA 
+ * @return rocker_data_t:  X  Y ԭʼֵĽṹ (0-4095)
  */
 rocker_data_t rocker_adc_get_raw_value(void);
 
+/**
+ * @brief ȡµĸ߷ֱҡֵ
+ * @return rocker_data_t: X/Y ֵ (0-ROCKER_ADC_HIRES_MAX) 12 λֵ 2^ROCKER_ADC_OVERSAMPLE_BITS
+ */
+rocker_data_t rocker_adc_get_hires_value(void);
+
+/**
+ * @brief ȡͳơ
+ */
+void rocker_adc_get_stats(rocker_adc_stats_t *stats);
+
 
 #endif // __ROCKER_ADC_DRIVER_H__
 
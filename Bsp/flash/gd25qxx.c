@@ -39,6 +39,18 @@ void spi_flash_init(void)
 }
 
 void spi_flash_sector_erase(uint32_t sector_addr)
+{
+    spi_flash_sector_erase_start(sector_addr);
+    spi_flash_wait_for_write_end();
+}
+
+/**
+ * @brief Starts erasing a sector and returns immediately.
+ * @note A sector erase takes tens to hundreds of milliseconds. Poll
+ *       spi_flash_is_busy() (e.g. from a scheduler coroutine) instead of
+ *       blocking in spi_flash_wait_for_write_end().
+ */
+void spi_flash_sector_erase_start(uint32_t sector_addr)
 {
     spi_flash_write_enable();
 
@@ -48,8 +60,6 @@ void spi_flash_sector_erase(uint32_t sector_addr)
     spi_flash_send_byte((sector_addr & 0xFF00) >> 8);
     spi_flash_send_byte(sector_addr & 0xFF);
     SPI_FLASH_CS_HIGH();
-
-    spi_flash_wait_for_write_end();
 }
 
 void spi_flash_bulk_erase(void)
@@ -64,6 +74,16 @@ void spi_flash_bulk_erase(void)
 }
 
 void spi_flash_page_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write)
+{
+    spi_flash_page_write_start(pbuffer, write_addr, num_byte_to_write);
+    spi_flash_wait_for_write_end();
+}
+
+/**
+ * @brief Starts programming a page and returns immediately.
+ * @note Poll spi_flash_is_busy() before the next flash command.
+ */
+void spi_flash_page_write_start(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write)
 {
     spi_flash_write_enable();
 
@@ -80,7 +100,6 @@ void spi_flash_page_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_by
     }
 
     SPI_FLASH_CS_HIGH();
-    spi_flash_wait_for_write_end();
 }
 
 void spi_flash_buffer_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write)
@@ -234,6 +253,18 @@ void spi_flash_write_enable(void)
     SPI_FLASH_CS_HIGH();
 }
 
+uint8_t spi_flash_is_busy(void)
+{
+    uint8_t flash_status;
+
+    SPI_FLASH_CS_LOW();
+    spi_flash_send_byte(RDSR);
+    flash_status = spi_flash_send_byte(DUMMY_BYTE);
+    SPI_FLASH_CS_HIGH();
+
+    return (flash_status & WIP_FLAG) ? 1 : 0;
+}
+
 void spi_flash_wait_for_write_end(void)
 {
     uint8_t flash_status = 0;
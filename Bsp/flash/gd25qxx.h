@@ -12,10 +12,14 @@
 void spi_flash_init(void);
 /* erase the specified flash sector */
 void spi_flash_sector_erase(uint32_t sector_addr);
+/* start erasing the specified flash sector, return without waiting */
+void spi_flash_sector_erase_start(uint32_t sector_addr);
 /* erase the entire flash */
 void spi_flash_bulk_erase(void);
 /* write more than one byte to the flash */
 void spi_flash_page_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write);
+/* start writing a page, return without waiting */
+void spi_flash_page_write_start(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write);
 /* write block of data to the flash */
 void spi_flash_buffer_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write);
 /* read a block of data from the flash */
@@ -32,6 +36,8 @@ uint8_t spi_flash_send_byte(uint8_t byte);
 uint16_t spi_flash_send_halfword(uint16_t half_word);
 /* enable the write access to the flash */
 void spi_flash_write_enable(void);
+/* read the write in progress (wip) flag once: 1 = erase/program still running */
+uint8_t spi_flash_is_busy(void);
 /* poll the status of the write in progress (wip) flag in the flash's status register */
 void spi_flash_wait_for_write_end(void);
 
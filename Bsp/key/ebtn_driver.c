@@ -14,14 +14,30 @@ static void prv_btn_event_callback(struct ebtn_btn *btn, ebtn_evt_t evt);
 // 1. 静态参数与按键列表
 // -----------------------------------------------------------------------------
 
+// 按键来源：EXTI 边沿中断 > DMA 采样 > ebtn 每 10ms 直接读 GPIO
+#if KEY_EXTI_ENABLE
+#define EBTN_DRIVER_POLL()       key_exti_poll()
+#define EBTN_DRIVER_EDGE_US(pin) key_exti_get_edge_us(pin)
+#elif KEY_SAMPLER_ENABLE
+#define EBTN_DRIVER_POLL()       key_sampler_poll()
+#define EBTN_DRIVER_EDGE_US(pin) key_sampler_get_edge_us(pin)
+#endif
+
+// EXTI 和 DMA 采样都已经消抖（5ms 时间戳锁定 / 4ms 采样计数），ebtn 不再二次消抖
+#ifdef EBTN_DRIVER_POLL
+#define EBTN_DRIVER_DEBOUNCE_MS 0
+#else
+#define EBTN_DRIVER_DEBOUNCE_MS 20
+#endif
+
 /**
  * @brief 默认按键参数配置实例。
  * 所有的静态按键都将使用此配置。
  */
 // 参数宏: EBTN_PARAMS_INIT(按下消抖, 释放消抖, 单击最短按下, 单击最长按下, 多次单击最大间隔, 长按周期, 最大连击数)
 const ebtn_btn_param_t default_ebtn_param = EBTN_PARAMS_INIT(
-    20,  // time_debounce: 按下稳定 20ms (去抖时间)
-    20,  // time_debounce_release: 释放稳定 20ms (释放去抖时间)
+    EBTN_DRIVER_DEBOUNCE_MS, // time_debounce: 按下稳定时间 (去抖时间)
+    EBTN_DRIVER_DEBOUNCE_MS, // time_debounce_release: 释放稳定时间 (释放去抖时间)
     50,  // time_click_pressed_min: 有效单击最短按下时间
     500, // time_click_pressed_max: 有效单击最长按下时间 (超过则视为长按或无效)
     300, // time_click_multi_max: 多次单击之间的最大间隔时间
@@ -40,6 +56,11 @@ static ebtn_btn_t btns[] = {
     EBTN_BUTTON_INIT(BTN_SK, &default_ebtn_param),
 };
 
+/**
+ * @brief 物理按键对应的 GPIOE 引脚，下标和 btns[] 一致（即按键 ID）。
+ */
+static const uint16_t s_btn_pins[BTN_MAX_COUNT] = {SW1_Pin, SW2_Pin, SW3_Pin, SW4_Pin, SK_Pin};
+
 /**
  * @brief 静态组合按键列表。
  */
@@ -103,10 +124,31 @@ static void prv_btn_event_callback(struct ebtn_btn *btn, ebtn_evt_t evt)
         ebtn_event_t.data = 0;
     }
 
+    // 采集时间，用于测量按键到屏幕的延迟
+#ifdef EBTN_DRIVER_EDGE_US
+    // 按下/松开用中断或采样到的边沿时刻，而不是这次任务运行的时刻
+    if ((evt == EBTN_EVT_ONPRESS || evt == EBTN_EVT_ONRELEASE) && btn->key_id < BTN_MAX_COUNT)
+    {
+        ebtn_event_t.timestamp_us = EBTN_DRIVER_EDGE_US(s_btn_pins[btn->key_id]);
+    }
+    else
+#endif
+    {
+        ebtn_event_t.timestamp_us = scheduler_get_time_us();
+    }
+
     // 2. 推入队列 (Push to Channel)
 
     // 将打包好的事件发送到队列，完成事件从驱动层到组件层的转发。
-    event_queue_push(ebtn_event_t);
+    // KEEPALIVE 是长按期间的重复事件，队列里还有没取走的就合并，不占新槽
+    if (evt == EBTN_EVT_KEEPALIVE)
+    {
+        event_queue_push_repeat(ebtn_event_t);
+    }
+    else
+    {
+        event_queue_push(ebtn_event_t);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -162,6 +204,14 @@ void ebtn_driver_init(void)
         prv_btn_event_callback);
     // 2. 绑定组合键
     btn_combos_init();
+
+#if KEY_EXTI_ENABLE
+    // 3. 打开按键 EXTI，有边沿时立即唤醒按键任务
+    key_exti_init(ebtn_process_task);
+#elif KEY_SAMPLER_ENABLE
+    // 3. 启动定时器触发的 DMA 采样
+    key_sampler_init();
+#endif
 }
 
 /**
@@ -169,6 +219,31 @@ void ebtn_driver_init(void)
  */
 void ebtn_process_task(void)
 {
+#ifdef EBTN_DRIVER_POLL
+    // 已消抖的引脚位图换成 ebtn 的按键状态位数组（下标 = btns[] 下标）
+    BIT_ARRAY_DEFINE(curr_state, EBTN_MAX_KEYNUM) = {0};
+    uint16_t pressed;
+
+#if KEY_EXTI_ENABLE
+    // 没有边沿、没有在消抖，ebtn 也没有在等单击/连击/长按计时：这一帧什么都不用做
+    if (key_exti_is_idle() && !ebtn_is_in_process())
+    {
+        return;
+    }
+#endif
+
+    pressed = EBTN_DRIVER_POLL();
+
+    for (uint8_t i = 0; i < BTN_MAX_COUNT; i++)
+    {
+        if (pressed & s_btn_pins[i])
+        {
+            bit_array_set(curr_state, i);
+        }
+    }
+    ebtn_process_with_curr_state(curr_state, HAL_GetTick());
+#else
     // 传入当前毫秒系统时间 (HAL_GetTick())
     ebtn_process(HAL_GetTick());
+#endif
 }
@@ -0,0 +1,326 @@
+#include "key_exti.h"
+
+#if (KEY_EXTI_QUEUE_SIZE & KEY_EXTI_QUEUE_MASK) != 0
+#error "KEY_EXTI_QUEUE_SIZE must be a power of two"
+#endif
+
+// -----------------------------------------------------------------------------
+// 0. 移植层（主机测试可以覆盖）
+// -----------------------------------------------------------------------------
+
+// 下标的读写顺序，和 event_queue 一样：写方先写记录再发布下标，读方先读下标再读记录
+#ifndef KEY_EXTI_LOAD_ACQUIRE
+#define KEY_EXTI_LOAD_ACQUIRE(p)        key_exti_load_acquire(p)
+#endif
+#ifndef KEY_EXTI_STORE_RELEASE
+#define KEY_EXTI_STORE_RELEASE(p, v)    key_exti_store_release((p), (v))
+#endif
+
+// 挂起的按键中断线、清挂起、读按下的引脚
+#ifndef KEY_EXTI_GET_PENDING
+#define KEY_EXTI_GET_PENDING()          ((uint16_t)__HAL_GPIO_EXTI_GET_IT(KEY_EXTI_PIN_MASK))
+#endif
+#ifndef KEY_EXTI_CLEAR_PENDING
+#define KEY_EXTI_CLEAR_PENDING(pins)    __HAL_GPIO_EXTI_CLEAR_IT(pins)
+#endif
+#ifndef KEY_EXTI_READ_PRESSED
+#define KEY_EXTI_READ_PRESSED()         ((uint16_t)~KEY_EXTI_PORT->IDR & KEY_EXTI_PIN_MASK)
+#endif
+
+static inline uint32_t key_exti_load_acquire(volatile const uint32_t *p)
+{
+    uint32_t v = *p;
+    __DMB();
+    return v;
+}
+
+static inline void key_exti_store_release(volatile uint32_t *p, uint32_t v)
+{
+    __DMB();
+    *p = v;
+}
+
+// -----------------------------------------------------------------------------
+// 1. 静态数据
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 一次中断的记录
+ */
+typedef struct
+{
+    uint32_t us;      /*!< 中断时刻 */
+    uint16_t pins;    /*!< 这次触发的引脚 */
+    uint16_t pressed; /*!< 中断时按下的引脚 */
+} key_exti_edge_t;
+
+static key_exti_edge_t s_ring[KEY_EXTI_QUEUE_SIZE];
+static volatile uint32_t s_head; // 只有中断写
+static volatile uint32_t s_tail; // 只有按键任务写
+static void (*s_wake_task)(void);
+
+// 消抖状态（按引脚位图）
+static uint16_t s_state;         // 消抖后的按下位图
+static uint16_t s_level;         // 每个引脚最后一次中断读到的电平
+static uint16_t s_locked;        // 在消抖锁定期内的引脚
+static uint16_t s_tapped;        // 这次 poll 里新按下的引脚
+static uint32_t s_lock_us[16];   // 锁定开始的时刻
+static uint32_t s_last_us[16];   // 最后一次中断的时刻
+static uint32_t s_edge_us[16];   // 最后一次消抖后边沿的时刻
+
+static uint32_t s_resynced;      // 已经按实际电平重新同步过的丢失数
+static key_exti_stats_t s_stats;
+
+// -----------------------------------------------------------------------------
+// 2. 内部函数
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 改变一个引脚的消抖后状态
+ */
+static void key_exti_set(uint8_t pin, uint16_t level, uint32_t t)
+{
+    uint16_t bit = (uint16_t)(1u << pin);
+
+    if ((s_state & bit) == level)
+    {
+        return;
+    }
+    s_state ^= bit;
+    s_tapped |= level;
+    s_edge_us[pin] = t;
+    s_stats.edges++;
+}
+
+/**
+ * @brief 到 now_us 为止锁定到期的引脚：抖动已经过去，按最后一次中断的电平修正
+ * @note  锁定期内松开（短按）或者最后停在另一边，修正也是一个边沿，
+ *        从最后一次中断起重新锁定，后面还有抖动也不算
+ */
+static void key_exti_expire(uint32_t now_us)
+{
+    for (uint8_t pin = 0; pin < 16; pin++)
+    {
+        uint16_t bit = (uint16_t)(1u << pin);
+
+        if ((s_locked & bit) == 0 || (int32_t)(now_us - s_lock_us[pin]) < KEY_EXTI_DEBOUNCE_US)
+        {
+            continue;
+        }
+
+        s_locked &= ~bit;
+        if ((s_level & bit) != (s_state & bit))
+        {
+            key_exti_set(pin, s_level & bit, s_last_us[pin]);
+            if ((int32_t)(now_us - s_last_us[pin]) < KEY_EXTI_DEBOUNCE_US)
+            {
+                s_locked |= bit;
+                s_lock_us[pin] = s_last_us[pin];
+            }
+        }
+    }
+}
+
+/**
+ * @brief 处理一次中断记录
+ */
+static void key_exti_apply(const key_exti_edge_t *e)
+{
+    key_exti_expire(e->us);
+
+    for (uint8_t pin = 0; pin < 16; pin++)
+    {
+        uint16_t bit = (uint16_t)(1u << pin);
+
+        if ((e->pins & bit) == 0)
+        {
+            continue;
+        }
+
+        s_level = (s_level & ~bit) | (e->pressed & bit);
+        s_last_us[pin] = e->us;
+
+        // 不在锁定期：这个边沿立即生效，并开始锁定
+        if ((s_locked & bit) == 0)
+        {
+            s_locked |= bit;
+            s_lock_us[pin] = e->us;
+            key_exti_set(pin, e->pressed & bit, e->us);
+        }
+    }
+}
+
+/**
+ * @brief 中断记录丢过：按实际电平重新同步，全部引脚锁定一个消抖期
+ */
+static void key_exti_resync(uint32_t now_us)
+{
+    s_level = KEY_EXTI_READ_PRESSED();
+    s_locked = KEY_EXTI_PIN_MASK;
+    for (uint8_t pin = 0; pin < 16; pin++)
+    {
+        s_lock_us[pin] = now_us;
+        s_last_us[pin] = now_us;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// 3. API 实现
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 切到双边沿中断
+ */
+void key_exti_init(void (*wake_task)(void))
+{
+    static const IRQn_Type irqs[] = {EXTI0_IRQn, EXTI1_IRQn, EXTI2_IRQn, EXTI3_IRQn, EXTI4_IRQn};
+    GPIO_InitTypeDef gpio = {0};
+
+    s_head = 0;
+    s_tail = 0;
+    s_wake_task = wake_task;
+    s_state = KEY_EXTI_READ_PRESSED();
+    s_level = s_state;
+    s_locked = 0;
+    s_resynced = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+
+    // CubeMX 里是普通输入，这里改成双边沿中断（上下拉不变）
+    gpio.Pin = KEY_EXTI_PIN_MASK;
+    gpio.Mode = GPIO_MODE_IT_RISING_FALLING;
+    gpio.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(KEY_EXTI_PORT, &gpio);
+    KEY_EXTI_CLEAR_PENDING(KEY_EXTI_PIN_MASK);
+
+    for (uint8_t i = 0; i < sizeof(irqs) / sizeof(irqs[0]); i++)
+    {
+        HAL_NVIC_SetPriority(irqs[i], KEY_EXTI_IRQ_PRIORITY, 0);
+        HAL_NVIC_EnableIRQ(irqs[i]);
+    }
+}
+
+/**
+ * @brief 是否空闲
+ */
+uint8_t key_exti_is_idle(void)
+{
+    return s_locked == 0 && KEY_EXTI_LOAD_ACQUIRE(&s_head) == s_tail &&
+           s_stats.dropped == s_resynced;
+}
+
+/**
+ * @brief 处理中断记录的边沿
+ */
+uint16_t key_exti_poll(void)
+{
+    uint32_t head = KEY_EXTI_LOAD_ACQUIRE(&s_head);
+    uint32_t tail = s_tail;
+    uint32_t dropped = s_stats.dropped;
+
+    s_tapped = 0;
+    for (; tail != head; tail++)
+    {
+        key_exti_apply(&s_ring[tail & KEY_EXTI_QUEUE_MASK]);
+        KEY_EXTI_STORE_RELEASE(&s_tail, tail + 1);
+    }
+
+    if (dropped != s_resynced)
+    {
+        s_resynced = dropped;
+        key_exti_resync(scheduler_get_time_us());
+    }
+    key_exti_expire(scheduler_get_time_us());
+
+    // 这次新按下的键即使已经松开也报告一次按下
+    return s_state | s_tapped;
+}
+
+/**
+ * @brief 获取某个引脚最后一次边沿的时刻
+ */
+uint32_t key_exti_get_edge_us(uint16_t pin)
+{
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        if (pin & (1u << i))
+        {
+            return s_edge_us[i];
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 获取统计
+ */
+void key_exti_get_stats(key_exti_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = s_stats;
+    }
+}
+
+/**
+ * @brief EXTI 中断处理
+ * @note  先清挂起再读电平：清掉之后再来的边沿会再进一次中断，最后一条记录的电平总是最新的
+ */
+void key_exti_irq_handler(void)
+{
+    uint16_t pins = KEY_EXTI_GET_PENDING();
+    uint32_t head = s_head;
+    key_exti_edge_t *e;
+
+    if (pins == 0)
+    {
+        return;
+    }
+    KEY_EXTI_CLEAR_PENDING(pins);
+    s_stats.irqs++;
+
+    if (head - KEY_EXTI_LOAD_ACQUIRE(&s_tail) >= KEY_EXTI_QUEUE_SIZE)
+    {
+        s_stats.dropped++;
+    }
+    else
+    {
+        e = &s_ring[head & KEY_EXTI_QUEUE_MASK];
+        e->us = scheduler_get_time_us();
+        e->pins = pins;
+        e->pressed = KEY_EXTI_READ_PRESSED();
+        KEY_EXTI_STORE_RELEASE(&s_head, head + 1);
+    }
+
+    if (s_wake_task != NULL)
+    {
+        scheduler_wake_task(s_wake_task);
+    }
+}
+
+#if KEY_EXTI_ENABLE
+// CubeMX 里这几个引脚不是 EXTI 模式，中断服务函数放在这里
+void EXTI0_IRQHandler(void)
+{
+    key_exti_irq_handler();
+}
+
+void EXTI1_IRQHandler(void)
+{
+    key_exti_irq_handler();
+}
+
+void EXTI2_IRQHandler(void)
+{
+    key_exti_irq_handler();
+}
+
+void EXTI3_IRQHandler(void)
+{
+    key_exti_irq_handler();
+}
+
+void EXTI4_IRQHandler(void)
+{
+    key_exti_irq_handler();
+}
+#endif
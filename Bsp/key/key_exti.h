@@ -0,0 +1,95 @@
+#ifndef __KEY_EXTI_H__
+#define __KEY_EXTI_H__
+
+#include "mydefine.h"
+
+// =============================================================================
+// 按键 EXTI 边沿捕获 - 中断记录边沿时刻，按时间戳消抖，按需唤醒按键任务
+// 职责：
+// 1. PE0~PE4 双边沿中断：记录时刻和端口电平到无锁环形缓冲区，只唤醒 ebtn 任务
+// 2. 按键任务取走边沿，用时间戳消抖：第一个边沿立即生效，之后 DEBOUNCE_US 内的抖动不算，
+//    到期时按最后一次中断读到的电平修正（不用反复读 GPIO）
+// 3. 没有边沿、没有在消抖时报告空闲，按键任务这一帧什么都不做
+//
+// 缓冲区是单生产者/单消费者：五个 EXTI 中断优先级相同、互不抢占，算一个生产者；
+// 只有按键任务取。中断不碰 event_queue，ebtn 事件仍然由按键任务推入。
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// 1. 配置
+// -----------------------------------------------------------------------------
+
+// 1=EXTI 边沿中断（优先于 KEY_SAMPLER_ENABLE），0=不用
+#ifndef KEY_EXTI_ENABLE
+#define KEY_EXTI_ENABLE 0
+#endif
+
+// 一个边沿生效后，这段时间里的抖动不算（微秒）
+#define KEY_EXTI_DEBOUNCE_US 5000
+
+// 边沿缓冲区的记录数，必须是 2 的幂
+#define KEY_EXTI_QUEUE_SIZE 32
+#define KEY_EXTI_QUEUE_MASK (KEY_EXTI_QUEUE_SIZE - 1)
+
+// EXTI 中断优先级（五个按键必须相同）
+#define KEY_EXTI_IRQ_PRIORITY 5
+
+// 按键端口和引脚（低电平按下，PE0~PE4 各自对应 EXTI0~EXTI4）
+#define KEY_EXTI_PORT     GPIOE
+#define KEY_EXTI_PIN_MASK (SW1_Pin | SW2_Pin | SW3_Pin | SW4_Pin | SK_Pin)
+
+// -----------------------------------------------------------------------------
+// 2. 数据结构
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief EXTI 统计
+ */
+typedef struct
+{
+    uint32_t irqs;    /*!< 中断次数（含抖动） */
+    uint32_t edges;   /*!< 消抖后的边沿数 */
+    uint32_t dropped; /*!< 缓冲区满丢掉的中断记录数（丢了之后按实际电平重新同步） */
+} key_exti_stats_t;
+
+// -----------------------------------------------------------------------------
+// 3. API 声明
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 把按键引脚切到双边沿中断并打开 EXTI0~EXTI4
+ * @param wake_task: 有边沿时唤醒的任务（ebtn_process_task），可以为NULL
+ */
+void key_exti_init(void (*wake_task)(void));
+
+/**
+ * @brief 是否空闲：没有未处理的边沿，也没有按键在消抖
+ * @note  空闲时不用调用 key_exti_poll，状态不会变
+ */
+uint8_t key_exti_is_idle(void);
+
+/**
+ * @brief 处理中断记录的边沿
+ * @retval 消抖后按下的引脚位图（KEY_EXTI_PIN_MASK 里的位）
+ * @note  两次调用之间按下又松开的短按，这次仍报告按下、下次报告松开，不会丢
+ */
+uint16_t key_exti_poll(void);
+
+/**
+ * @brief 获取某个引脚最后一次消抖后边沿的时刻
+ * @param pin: 引脚位（如 SW1_Pin）
+ * @retval 边沿时刻（scheduler_get_time_us 时基），即中断发生的时刻
+ */
+uint32_t key_exti_get_edge_us(uint16_t pin);
+
+/**
+ * @brief 获取统计
+ */
+void key_exti_get_stats(key_exti_stats_t *stats);
+
+/**
+ * @brief EXTI 中断处理（EXTI0~EXTI4 的中断服务函数调用）
+ */
+void key_exti_irq_handler(void);
+
+#endif // __KEY_EXTI_H__
@@ -0,0 +1,175 @@
+#include "key_sampler.h"
+#include "tim.h"
+
+// -----------------------------------------------------------------------------
+// 1. 移植层（主机测试可以覆盖）
+// -----------------------------------------------------------------------------
+
+// DMA 剩余传输数（循环模式下从 BUFFER_SIZE 递减，到 0 时重装）
+#ifndef KEY_SAMPLER_DMA_REMAINING
+#define KEY_SAMPLER_DMA_REMAINING() __HAL_DMA_GET_COUNTER(htim8.hdma[TIM_DMA_ID_UPDATE])
+#endif
+
+// 距上一次更新事件（上一个采样点）的微秒数，TIM8 计数器就是 1MHz
+#ifndef KEY_SAMPLER_TIMER_COUNT
+#define KEY_SAMPLER_TIMER_COUNT() __HAL_TIM_GET_COUNTER(&htim8)
+#endif
+
+// -----------------------------------------------------------------------------
+// 2. 静态数据
+// -----------------------------------------------------------------------------
+
+// DMA 目标：每个元素是一次 IDR 快照
+static volatile uint16_t s_dma_buf[KEY_SAMPLER_BUFFER_SIZE];
+static uint32_t s_read;        // 下一个要处理的采样点
+static uint32_t s_newest_us;   // 上次处理的最后一个采样点的时刻
+
+// 垂直计数器：每个位是一个按键的两位计数器，所有按键一起计数
+static uint16_t s_state;       // 消抖后的按下位图
+static uint16_t s_ct0;
+static uint16_t s_ct1;
+
+static uint32_t s_edge_us[16]; // 每个引脚最后一次边沿的时刻
+static key_sampler_stats_t s_stats;
+
+// -----------------------------------------------------------------------------
+// 3. 内部函数
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 一个采样点的按位并行消抖
+ * @param raw: 这个采样点按下的位图
+ * @retval 这个采样点翻转的位
+ * @note  和当前状态不同的位计数，相同的位计数器复位；
+ *        计数器 11 -> 10 -> 01 -> 00 -> 11，连续4次不同时翻转
+ */
+static uint16_t key_sampler_debounce(uint16_t raw)
+{
+    uint16_t delta = raw ^ s_state;
+
+    s_ct0 = (uint16_t)~(s_ct0 & delta);
+    s_ct1 = (uint16_t)(s_ct0 ^ (s_ct1 & delta));
+    delta &= s_ct0 & s_ct1;
+    s_state ^= delta;
+    return delta;
+}
+
+/**
+ * @brief 软件状态复位：全部松开，计数器置满
+ */
+static void key_sampler_reset(void)
+{
+    memset((void *)s_dma_buf, 0xFF, sizeof(s_dma_buf));
+    s_read = 0;
+    s_newest_us = scheduler_get_time_us();
+    s_state = 0;
+    s_ct0 = 0xFFFF;
+    s_ct1 = 0xFFFF;
+    memset(s_edge_us, 0, sizeof(s_edge_us));
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+// -----------------------------------------------------------------------------
+// 4. API 实现
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 启动采样
+ */
+void key_sampler_init(void)
+{
+    key_sampler_reset();
+
+    // DMA 不开中断：poll 直接读 NDTR 得到写位置
+    HAL_DMA_Start(htim8.hdma[TIM_DMA_ID_UPDATE], (uint32_t)(uintptr_t)&KEY_SAMPLER_PORT->IDR,
+                  (uint32_t)(uintptr_t)s_dma_buf, KEY_SAMPLER_BUFFER_SIZE);
+    __HAL_TIM_ENABLE_DMA(&htim8, TIM_DMA_UPDATE);
+    HAL_TIM_Base_Start(&htim8);
+}
+
+/**
+ * @brief 处理上次以来的采样点
+ */
+uint16_t key_sampler_poll(void)
+{
+    uint32_t remaining, elapsed_us, now_us, newest_us;
+    uint32_t write, count, t;
+    uint16_t raw, toggled;
+    uint16_t tapped = 0;
+
+    // 1. 读 DMA 写位置和最新采样点的时刻；前后两次 NDTR 相同说明中间没有新的采样点
+    do
+    {
+        remaining = KEY_SAMPLER_DMA_REMAINING();
+        elapsed_us = KEY_SAMPLER_TIMER_COUNT();
+        now_us = scheduler_get_time_us();
+    } while (remaining != KEY_SAMPLER_DMA_REMAINING());
+
+    write = (KEY_SAMPLER_BUFFER_SIZE - remaining) % KEY_SAMPLER_BUFFER_SIZE;
+    newest_us = now_us - elapsed_us;
+
+    // 2. 新采样点数；按时间算超过一圈说明被覆盖了，只能从最老的一个开始
+    count = (write + KEY_SAMPLER_BUFFER_SIZE - s_read) % KEY_SAMPLER_BUFFER_SIZE;
+    if ((newest_us - s_newest_us + KEY_SAMPLER_PERIOD_US / 2) / KEY_SAMPLER_PERIOD_US >= KEY_SAMPLER_BUFFER_SIZE)
+    {
+        s_read = write;
+        count = KEY_SAMPLER_BUFFER_SIZE;
+        s_stats.overruns++;
+    }
+    s_stats.samples += count;
+    s_newest_us = newest_us;
+
+    // 3. 逐个采样点消抖，第 count 个就是最新的那个
+    for (; count != 0; count--)
+    {
+        raw = (uint16_t)~s_dma_buf[s_read] & KEY_SAMPLER_PIN_MASK;
+        s_read = (s_read + 1) % KEY_SAMPLER_BUFFER_SIZE;
+
+        toggled = key_sampler_debounce(raw);
+        if (toggled == 0)
+        {
+            continue;
+        }
+
+        // 边沿时刻是新状态的第一个采样点
+        t = newest_us - (count - 1 + KEY_SAMPLER_DEBOUNCE_SAMPLES - 1) * KEY_SAMPLER_PERIOD_US;
+        for (uint8_t pin = 0; pin < 16; pin++)
+        {
+            if (toggled & (1u << pin))
+            {
+                s_edge_us[pin] = t;
+                s_stats.edges++;
+            }
+        }
+        tapped |= toggled & s_state;
+    }
+
+    // 这次新按下的键即使已经松开也报告一次按下
+    return s_state | tapped;
+}
+
+/**
+ * @brief 获取某个引脚最后一次边沿的时刻
+ */
+uint32_t key_sampler_get_edge_us(uint16_t pin)
+{
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        if (pin & (1u << i))
+        {
+            return s_edge_us[i];
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 获取采样统计
+ */
+void key_sampler_get_stats(key_sampler_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = s_stats;
+    }
+}
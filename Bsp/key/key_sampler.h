@@ -0,0 +1,79 @@
+#ifndef __KEY_SAMPLER_H__
+#define __KEY_SAMPLER_H__
+
+#include "mydefine.h"
+
+// =============================================================================
+// 按键 DMA 采样 - 定时器触发 DMA 抓拍按键端口，按位并行消抖
+// 职责：
+// 1. TIM8 更新事件每 1ms 触发一次 DMA2_Stream1，把 GPIOE->IDR 搬进环形缓冲区，不占 CPU
+// 2. ebtn_process_task 取走新的采样点，用垂直计数器一次字操作给五个按键同时消抖
+// 3. 给出按下位图（交给 ebtn）和每个按键最后一次边沿的时刻（精确到采样点）
+//
+// 注意：GPIO 挂在 AHB1 上，只有 DMA2 能访问；DMA 缓冲区不能放在 CCM RAM。
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// 1. 配置
+// -----------------------------------------------------------------------------
+
+// 1=用 DMA 采样（ebtn 不再二次消抖），0=ebtn 每 10ms 直接读 GPIO（原来的方式）
+#define KEY_SAMPLER_ENABLE 1
+
+// 采样周期（微秒），必须和 MX_TIM8_Init 的更新周期一致（168MHz / 168 / 1000）
+#define KEY_SAMPLER_PERIOD_US 1000
+
+// 环形缓冲区的采样点数，两次 key_sampler_poll 的间隔不能超过这么多个周期
+#define KEY_SAMPLER_BUFFER_SIZE 64
+
+// 连续这么多个采样点不同才翻转（两位垂直计数器，固定为4）
+#define KEY_SAMPLER_DEBOUNCE_SAMPLES 4
+
+// 采样的端口和按键引脚（低电平按下）
+#define KEY_SAMPLER_PORT     GPIOE
+#define KEY_SAMPLER_PIN_MASK (SW1_Pin | SW2_Pin | SW3_Pin | SW4_Pin | SK_Pin)
+
+// -----------------------------------------------------------------------------
+// 2. 数据结构
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 采样统计
+ */
+typedef struct
+{
+    uint32_t samples;  /*!< 处理过的采样点数 */
+    uint32_t edges;    /*!< 消抖后的边沿数 */
+    uint32_t overruns; /*!< poll 间隔太长，DMA 覆盖了没处理的采样点的次数 */
+} key_sampler_stats_t;
+
+// -----------------------------------------------------------------------------
+// 3. API 声明
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 启动采样：DMA 循环模式 + TIM8 更新请求
+ * @note  在 MX_TIM8_Init 之后调用（ebtn_driver_init 里调用）
+ */
+void key_sampler_init(void);
+
+/**
+ * @brief 处理上次以来 DMA 写入的采样点
+ * @retval 消抖后按下的引脚位图（KEY_SAMPLER_PIN_MASK 里的位）
+ * @note  两次调用之间按下又松开的短按，这次仍报告按下、下次报告松开，不会丢
+ */
+uint16_t key_sampler_poll(void);
+
+/**
+ * @brief 获取某个引脚最后一次消抖后边沿的时刻
+ * @param pin: 引脚位（如 SW1_Pin）
+ * @retval 边沿时刻（scheduler_get_time_us 时基），即新状态第一个采样点的时刻
+ */
+uint32_t key_sampler_get_edge_us(uint16_t pin);
+
+/**
+ * @brief 获取采样统计
+ */
+void key_sampler_get_stats(key_sampler_stats_t *stats);
+
+#endif // __KEY_SAMPLER_H__
@@ -5,6 +5,25 @@
 // 私有变量
 // -----------------------------------------------------------------------------
 static uint8_t rng_initialized = 0; // RNG初始化标志
+static uint32_t rng_seed_state = 0;  // 伪随机数状态，0=使用硬件随机数
+
+// -----------------------------------------------------------------------------
+// 私有函数
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief xorshift32 伪随机数，状态永远不为0
+ */
+static uint32_t rng_next_seeded(void)
+{
+    uint32_t x = rng_seed_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng_seed_state = x;
+    return x;
+}
 
 // -----------------------------------------------------------------------------
 // 公共函数实现
@@ -29,7 +48,19 @@ int8_t rng_init(void)
  */
 int8_t rng_get_random(uint32_t *random)
 {
-    if (!rng_initialized || random == NULL)
+    if (random == NULL)
+    {
+        return -1;
+    }
+
+    // 录制/回放时用伪随机数，结果只取决于种子
+    if (rng_seed_state != 0)
+    {
+        *random = rng_next_seeded();
+        return 0;
+    }
+
+    if (!rng_initialized)
     {
         return -1;
     }
@@ -127,3 +158,19 @@ uint8_t rng_get_random_probability(uint8_t probability)
 
     return (rand_value < probability) ? 1 : 0;
 }
+
+/**
+ * @brief 切换到可复现的伪随机数
+ */
+void rng_set_seed(uint32_t seed)
+{
+    rng_seed_state = (seed != 0) ? seed : 0x2545F491u;
+}
+
+/**
+ * @brief 切回硬件随机数
+ */
+void rng_use_hardware(void)
+{
+    rng_seed_state = 0;
+}
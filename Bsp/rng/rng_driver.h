@@ -54,5 +54,18 @@ uint8_t rng_get_random_bool(void);
  */
 uint8_t rng_get_random_probability(uint8_t probability);
 
+/**
+ * @brief 切换到可复现的伪随机数（xorshift32）
+ * @note  录制/回放游戏时使用：同一个种子得到完全相同的随机数序列，
+ *        之后所有 rng_get_random* 接口都从伪随机数发生器取数，直到 rng_use_hardware()
+ * @param seed: 种子，0 会被替换成固定的非零值
+ */
+void rng_set_seed(uint32_t seed);
+
+/**
+ * @brief 切回硬件随机数
+ */
+void rng_use_hardware(void);
+
 
 #endif // __RNG_DRIVER_H__
@@ -0,0 +1,172 @@
+/**
+ ******************************************************************************
+ * @file    display_service.c
+ * @brief   显示服务实现
+ * @author  老王
+ * @note    所有对OLED的发送都经过这里,方便统一限速和统计I2C带宽
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "display_service.h"
+#include "perf_hud.h"
+#include "input_manager.h"
+#include "u8g2_stm32_hal.h"
+#include <string.h>
+
+/* Private variables ---------------------------------------------------------*/
+static u8g2_t *s_u8g2 = NULL;                     // 负责刷新的u8g2实例
+static uint8_t s_target_fps = DISPLAY_SERVICE_DEFAULT_FPS;
+static uint32_t s_frame_period_ms = 1000 / DISPLAY_SERVICE_DEFAULT_FPS;
+static uint32_t s_last_flush_tick = 0;            // 上一次发送的时间
+static uint32_t s_ready_count = 0;                // 上一次发送之后标记就绪的帧数
+static display_service_stats_t s_stats;
+static volatile uint8_t s_flush_done = 0;         // 有一帧发送完成,还没报告给输入管理器
+static volatile uint32_t s_flush_done_us = 0;     // 发送完成的时间
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 发送队列排空回调(DMA完成中断上下文),只记录时间
+ */
+static void display_service_on_flush_done(void)
+{
+    s_flush_done_us = scheduler_get_time_us();
+    s_flush_done = 1;
+}
+
+/**
+ * @brief 上一帧已经上屏:报告给输入管理器计算输入延迟
+ */
+static void display_service_report_presented(void)
+{
+    if (s_flush_done)
+    {
+        s_flush_done = 0;
+        input_manager_frame_presented(s_flush_done_us);
+    }
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 初始化显示服务
+ */
+void display_service_init(u8g2_t *u8g2)
+{
+    s_u8g2 = u8g2;
+    s_ready_count = 0;
+    s_last_flush_tick = HAL_GetTick();
+    display_service_set_target_fps(DISPLAY_SERVICE_DEFAULT_FPS);
+    display_service_reset_stats();
+    u8g2_set_flush_done_callback(display_service_on_flush_done);
+
+    /* 屏幕当前内容未知,第一帧必须整帧发送 */
+    u8g2_invalidate_diff_shadow();
+}
+
+/**
+ * @brief 显示服务任务
+ */
+void display_service_task(void)
+{
+    uint32_t now;
+    uint32_t start;
+    uint16_t bytes;
+
+    display_service_report_presented();
+
+    if (s_u8g2 == NULL || s_ready_count == 0)
+    {
+        return;
+    }
+
+    /* 限速:距离上一次发送不到一个帧周期 */
+    now = HAL_GetTick();
+    if (now - s_last_flush_tick < s_frame_period_ms)
+    {
+        return;
+    }
+
+    /* 上一帧还在总线上:不排队,等它发完再发最新的帧 */
+    if (u8g2_flush_is_busy())
+    {
+        return;
+    }
+
+    /* 检查忙之后上一帧才可能刚刚完成,先报告掉,不和这一帧混在一起 */
+    display_service_report_presented();
+
+    /* 性能浮层只在发送期间盖在绘制缓冲上 */
+    perf_hud_overlay_begin(s_u8g2);
+    start = perf_hud_begin();
+    bytes = u8g2_send_buffer_diff(s_u8g2);
+    perf_hud_end(PERF_PHASE_FLUSH, start);
+    perf_hud_overlay_end(s_u8g2);
+    s_last_flush_tick = now;
+
+    /* 这一帧带上了之前处理过的输入;画面有变化时等发送完成回调再算延迟 */
+    input_manager_frame_sent(bytes != 0);
+#if !U8G2_I2C_USE_DMA
+    input_manager_frame_presented(scheduler_get_time_us());
+#endif
+
+    /* 这次只发送了最新一帧,之前标记的帧都被覆盖了 */
+    s_stats.frames_dropped += s_ready_count - 1;
+    s_ready_count = 0;
+
+    if (bytes == 0)
+    {
+        s_stats.frames_unchanged++;
+    }
+    else
+    {
+        s_stats.frames_flushed++;
+        s_stats.bytes_sent += bytes;
+    }
+}
+
+/**
+ * @brief 标记一帧绘制完成
+ */
+void display_service_mark_ready(void)
+{
+    s_ready_count++;
+    s_stats.frames_ready++;
+}
+
+/**
+ * @brief 设置目标帧率
+ */
+void display_service_set_target_fps(uint8_t fps)
+{
+    s_target_fps = fps;
+    s_frame_period_ms = (fps == 0) ? 0 : (1000 / fps);
+}
+
+/**
+ * @brief 获取目标帧率
+ */
+uint8_t display_service_get_target_fps(void)
+{
+    return s_target_fps;
+}
+
+/**
+ * @brief 获取统计信息
+ */
+void display_service_get_stats(display_service_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = s_stats;
+    }
+}
+
+/**
+ * @brief 清零统计信息
+ */
+void display_service_reset_stats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
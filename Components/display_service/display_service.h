@@ -0,0 +1,104 @@
+/**
+ ******************************************************************************
+ * @file    display_service.h
+ * @brief   显示服务头文件
+ * @author  老王
+ * @note    显示服务独占OLED的刷新:游戏和菜单只往u8g2缓冲里画,
+ *          画完调用display_service_mark_ready()标记一帧就绪,
+ *          由display_service_task()按目标帧率统一发送
+ *
+ *          - 两次发送之间标记的多帧只发送最新的一帧(旧帧被覆盖丢弃)
+ *          - 内容没有变化的帧不会重复发送(差分刷新只发送变化的tile)
+ *          - 上一帧还在I2C总线上时不排队,等发送完再发最新的一帧
+ ******************************************************************************
+ */
+
+#ifndef __DISPLAY_SERVICE_H__
+#define __DISPLAY_SERVICE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "u8g2.h"
+
+/* Exported defines ----------------------------------------------------------*/
+/**
+ * @brief 显示服务任务的调度周期(ms)
+ * @note  需要比帧周期短,否则实际帧率达不到目标帧率
+ */
+#define DISPLAY_SERVICE_TASK_PERIOD_MS   5
+
+/**
+ * @brief 默认目标帧率
+ * @note  30帧时一整帧1024字节约占400kHz I2C总线的80%,
+ *        差分刷新下实际占用远低于此
+ */
+#define DISPLAY_SERVICE_DEFAULT_FPS      30
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 显示服务统计信息
+ */
+typedef struct {
+    uint32_t frames_ready;       // 标记就绪的帧数
+    uint32_t frames_flushed;     // 实际发送到屏幕的帧数
+    uint32_t frames_dropped;     // 被后续帧覆盖、没有发送的帧数
+    uint32_t frames_unchanged;   // 内容没有变化、跳过发送的帧数
+    uint32_t bytes_sent;         // 发送的GDRAM数据字节数
+} display_service_stats_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 初始化显示服务
+ * @param u8g2 显示服务负责刷新的u8g2实例
+ * @note  必须在u8g2_component_init()之后调用
+ */
+void display_service_init(u8g2_t *u8g2);
+
+/**
+ * @brief 显示服务任务
+ * @note  注册到调度器,周期DISPLAY_SERVICE_TASK_PERIOD_MS
+ *        应该排在所有绘制任务之后(相位相同、优先级更低),
+ *        这样同一轮里画好的帧能马上发送
+ */
+void display_service_task(void);
+
+/**
+ * @brief 标记一帧绘制完成,等待显示服务发送
+ * @note  代替直接调用u8g2_SendBuffer()
+ *        调用之后到下一次发送之前,仍然可以继续往缓冲里画,发送的是最新内容
+ */
+void display_service_mark_ready(void);
+
+/**
+ * @brief 设置目标帧率
+ * @param fps 每秒最多发送的帧数,0表示不限速(每个任务周期都可以发送)
+ */
+void display_service_set_target_fps(uint8_t fps);
+
+/**
+ * @brief 获取目标帧率
+ * @return 当前目标帧率
+ */
+uint8_t display_service_get_target_fps(void);
+
+/**
+ * @brief 获取统计信息
+ * @param stats 输出统计信息
+ */
+void display_service_get_stats(display_service_stats_t *stats);
+
+/**
+ * @brief 清零统计信息
+ */
+void display_service_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DISPLAY_SERVICE_H__ */
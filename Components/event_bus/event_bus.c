@@ -0,0 +1,242 @@
+#include "event_bus.h"
+
+#if (EVENT_BUS_CAPACITY_SLOTS & EVENT_BUS_INDEX_MASK) != 0
+#error "EVENT_BUS_CAPACITY_SLOTS must be a power of two"
+#endif
+
+// 下标的原子读写，和 event_queue 一样可以在主机测试里替换
+#ifndef EVENT_BUS_LOAD_ACQUIRE
+#define EVENT_BUS_LOAD_ACQUIRE(p)        event_bus_load_acquire(p)
+#endif
+#ifndef EVENT_BUS_STORE_RELEASE
+#define EVENT_BUS_STORE_RELEASE(p, v)    event_bus_store_release((p), (v))
+#endif
+
+static inline uint32_t event_bus_load_acquire(volatile const uint32_t *p)
+{
+    uint32_t v = *p;
+    __DMB();
+    return v;
+}
+
+static inline void event_bus_store_release(volatile uint32_t *p, uint32_t v)
+{
+    __DMB();
+    *p = v;
+}
+
+// -----------------------------------------------------------------------------
+// 1. 静态数据结构定义
+// -----------------------------------------------------------------------------
+
+// 总线上的一个槽：事件 + 主题
+typedef struct
+{
+    app_event_t evt;
+    uint8_t topic;
+} event_bus_slot_t;
+
+static event_bus_slot_t event_bus_slots[EVENT_BUS_CAPACITY_SLOTS];
+
+// 自由递增的发布序号，只有发布者写
+static volatile uint32_t event_bus_head;
+
+// 订阅者列表和所有订阅主题的并集（发布时过滤用）
+static event_bus_sub_t *event_bus_subs[EVENT_BUS_MAX_SUBSCRIBERS];
+static uint32_t event_bus_topic_union;
+
+// 统计
+static uint32_t event_bus_published;
+static uint32_t event_bus_filtered;
+
+/**
+ * @brief 重新计算所有订阅主题的并集
+ */
+static void event_bus_update_union(void)
+{
+    uint32_t mask = 0;
+
+    for (uint8_t i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++)
+    {
+        if (event_bus_subs[i] != NULL)
+        {
+            mask |= event_bus_subs[i]->topic_mask;
+        }
+    }
+    event_bus_topic_union = mask;
+}
+
+// -----------------------------------------------------------------------------
+// 2. API 实现
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 初始化事件总线。
+ */
+void event_bus_init(void)
+{
+    event_bus_head = 0;
+    for (uint8_t i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++)
+    {
+        event_bus_subs[i] = NULL;
+    }
+    event_bus_topic_union = 0;
+    event_bus_published = 0;
+    event_bus_filtered = 0;
+}
+
+/**
+ * @brief 订阅主题。
+ */
+bool event_bus_subscribe(event_bus_sub_t *sub, uint32_t topic_mask, const char *name)
+{
+    for (uint8_t i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++)
+    {
+        if (event_bus_subs[i] == NULL || event_bus_subs[i] == sub)
+        {
+            sub->cursor = EVENT_BUS_LOAD_ACQUIRE(&event_bus_head);
+            sub->topic_mask = topic_mask;
+            sub->lost = 0;
+            sub->name = name;
+            event_bus_subs[i] = sub;
+            event_bus_update_union();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 取消订阅。
+ */
+void event_bus_unsubscribe(event_bus_sub_t *sub)
+{
+    for (uint8_t i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++)
+    {
+        if (event_bus_subs[i] == sub)
+        {
+            event_bus_subs[i] = NULL;
+        }
+    }
+    event_bus_update_union();
+}
+
+/**
+ * @brief 发布一个事件。
+ */
+bool event_bus_publish(event_topic_t topic, app_event_t evt)
+{
+    uint32_t head;
+    event_bus_slot_t *slot;
+
+    // 发布时过滤：没人订阅的主题不占槽，也不会把别的订阅者的事件挤掉
+    if ((event_bus_topic_union & EVENT_TOPIC_MASK(topic)) == 0)
+    {
+        event_bus_filtered++;
+        return false;
+    }
+
+    // 不等读者：覆盖最老的槽，落后太多的读者在读取时发现并记入 lost
+    head = event_bus_head;
+    slot = &event_bus_slots[head & EVENT_BUS_INDEX_MASK];
+    slot->evt = evt;
+    slot->topic = (uint8_t)topic;
+    EVENT_BUS_STORE_RELEASE(&event_bus_head, head + 1);
+    event_bus_published++;
+
+    scheduler_notify_event();
+    return true;
+}
+
+/**
+ * @brief 读取订阅者的下一个事件。
+ * 可读范围是 [head - CAPACITY + 1, head)：序号 head - CAPACITY 的槽
+ * 可能正在被发布者写入序号 head 的事件。
+ */
+bool event_bus_read(event_bus_sub_t *sub, app_event_t *evt_out, event_topic_t *topic_out)
+{
+    event_bus_slot_t slot;
+    uint32_t head;
+
+    for (;;)
+    {
+        head = EVENT_BUS_LOAD_ACQUIRE(&event_bus_head);
+        if (sub->cursor == head)
+        {
+            return false;
+        }
+
+        // 落后太多：跳到最老的可读事件
+        if ((uint32_t)(head - sub->cursor) >= EVENT_BUS_CAPACITY_SLOTS)
+        {
+            uint32_t oldest = head - (EVENT_BUS_CAPACITY_SLOTS - 1);
+
+            sub->lost += oldest - sub->cursor;
+            sub->cursor = oldest;
+        }
+
+        slot = event_bus_slots[sub->cursor & EVENT_BUS_INDEX_MASK];
+
+        // 拷贝期间发布者追上来覆盖了这个槽：丢弃，重新来
+        __DMB();
+        head = EVENT_BUS_LOAD_ACQUIRE(&event_bus_head);
+        if ((uint32_t)(head - sub->cursor) >= EVENT_BUS_CAPACITY_SLOTS)
+        {
+            continue;
+        }
+
+        sub->cursor++;
+        if (sub->topic_mask & EVENT_TOPIC_MASK(slot.topic))
+        {
+            *evt_out = slot.evt;
+            if (topic_out != NULL)
+            {
+                *topic_out = (event_topic_t)slot.topic;
+            }
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief 丢弃订阅者还没读的所有事件。
+ */
+void event_bus_skip_all(event_bus_sub_t *sub)
+{
+    sub->cursor = EVENT_BUS_LOAD_ACQUIRE(&event_bus_head);
+}
+
+/**
+ * @brief 按来源 ID 得到主题。
+ */
+event_topic_t event_bus_topic_of(uint16_t source_id)
+{
+    if (source_id < ROCKER_SOURCE_ID)
+    {
+        return EVENT_TOPIC_BUTTON;
+    }
+    if (source_id == ROCKER_SOURCE_ID)
+    {
+        return EVENT_TOPIC_ROCKER;
+    }
+    if (source_id == EVENT_SOURCE_STORAGE)
+    {
+        return EVENT_TOPIC_STORAGE;
+    }
+    return EVENT_TOPIC_SYSTEM;
+}
+
+/**
+ * @brief 获取发布统计。
+ */
+void event_bus_get_stats(uint32_t *published, uint32_t *filtered)
+{
+    if (published != NULL)
+    {
+        *published = event_bus_published;
+    }
+    if (filtered != NULL)
+    {
+        *filtered = event_bus_filtered;
+    }
+}
@@ -0,0 +1,150 @@
+#ifndef __EVENT_BUS_H__
+#define __EVENT_BUS_H__
+
+#include "event_queue.h" // app_event_t
+
+// =============================================================================
+// 事件总线 - 多订阅者发布/订阅
+// 职责：
+// 1. 所有事件写进一个共享环形缓冲，每个订阅者只有一个读游标，不复制队列
+// 2. 订阅者按主题（按键、摇杆、系统、存储）过滤，没人订阅的主题发布时直接丢弃
+// 3. 后台服务（音效、遥测、存档）可以看到输入事件，不会从前台游戏手里抢走
+//
+// 和 event_queue 的分工：
+// - event_queue 是前台（input_manager）专用的队列，不丢边沿事件，场景切换时清空；
+// - event_bus 是广播：event_queue 推入的按键/摇杆事件同时发布到这里，
+//   读得慢的订阅者被覆盖时记入 lost，不会挡住发布者，也不影响别的订阅者。
+//
+// 并发约定和 event_queue 相同：所有发布来自同一个执行上下文（主循环），
+// 订阅者在主循环里读取。发布者先写槽再发布 head，读者拷贝完再检查槽有没有被覆盖。
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// 1. 配置
+// -----------------------------------------------------------------------------
+
+// 共享环形缓冲的槽数，必须是 2 的幂
+// 读者最多落后 EVENT_BUS_CAPACITY_SLOTS - 1 个事件，再落后就会丢
+#define EVENT_BUS_CAPACITY_SLOTS 32
+#define EVENT_BUS_INDEX_MASK (EVENT_BUS_CAPACITY_SLOTS - 1)
+
+// 最多同时订阅的数量（只用于发布时过滤，订阅者本身由调用者分配）
+#define EVENT_BUS_MAX_SUBSCRIBERS 8
+
+// 系统和存储事件的来源 ID（按键 0~255，摇杆 ROCKER_SOURCE_ID）
+#define EVENT_SOURCE_SYSTEM  0x0200
+#define EVENT_SOURCE_STORAGE 0x0300
+
+// -----------------------------------------------------------------------------
+// 2. 主题和事件类型
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 事件主题
+ */
+typedef enum
+{
+    EVENT_TOPIC_BUTTON = 0, /*!< 按键事件（ebtn） */
+    EVENT_TOPIC_ROCKER,     /*!< 摇杆事件 */
+    EVENT_TOPIC_SYSTEM,     /*!< 系统事件（场景切换等） */
+    EVENT_TOPIC_STORAGE,    /*!< 存储操作完成 */
+    EVENT_TOPIC_COUNT
+} event_topic_t;
+
+#define EVENT_TOPIC_MASK(topic) (1u << (topic))
+#define EVENT_TOPIC_MASK_INPUT (EVENT_TOPIC_MASK(EVENT_TOPIC_BUTTON) | EVENT_TOPIC_MASK(EVENT_TOPIC_ROCKER))
+#define EVENT_TOPIC_MASK_ALL ((1u << EVENT_TOPIC_COUNT) - 1)
+
+/**
+ * @brief 系统事件类型（source_id = EVENT_SOURCE_SYSTEM）
+ */
+typedef enum
+{
+    EVENT_SYSTEM_GAME_ENTER = 0, /*!< 进入游戏，data = 游戏索引 */
+    EVENT_SYSTEM_GAME_EXIT,      /*!< 退出游戏回到菜单，data = 游戏索引 */
+} event_system_type_t;
+
+/**
+ * @brief 存储事件类型（source_id = EVENT_SOURCE_STORAGE）
+ */
+typedef enum
+{
+    EVENT_STORAGE_SELFTEST_DONE = 0, /*!< 存储自检（Flash/LittleFS/SD卡）运行完毕 */
+} event_storage_type_t;
+
+/**
+ * @brief 订阅者
+ * @note  由调用者静态分配，总线只保存指针；每个订阅者只占一个游标
+ */
+typedef struct
+{
+    uint32_t cursor;      /*!< 下一个要读的事件序号 */
+    uint32_t topic_mask;  /*!< 订阅的主题（EVENT_TOPIC_MASK 的组合） */
+    uint32_t lost;        /*!< 读得太慢被覆盖掉的事件数 */
+    const char *name;     /*!< 名称，用于调试输出 */
+} event_bus_sub_t;
+
+// -----------------------------------------------------------------------------
+// 3. API 声明
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 初始化事件总线，清空所有订阅。
+ */
+void event_bus_init(void);
+
+/**
+ * @brief 订阅主题。
+ * @param sub: 订阅者（静态分配，订阅期间必须一直有效）。
+ * @param topic_mask: 订阅的主题掩码。
+ * @param name: 订阅者名称（可以为NULL）。
+ * @return bool: 成功返回 true，订阅者已满返回 false。
+ * @note 只收到订阅之后发布的事件。
+ */
+bool event_bus_subscribe(event_bus_sub_t *sub, uint32_t topic_mask, const char *name);
+
+/**
+ * @brief 取消订阅。
+ * @param sub: 订阅者。
+ */
+void event_bus_unsubscribe(event_bus_sub_t *sub);
+
+/**
+ * @brief 发布一个事件。
+ * @param topic: 事件主题。
+ * @param evt: 事件。
+ * @return bool: 写入总线返回 true；没有订阅者订阅这个主题时不写入，返回 false。
+ * @note 只在发布者上下文调用。写入后通知调度器，订阅了事件唤醒的任务会尽快运行。
+ */
+bool event_bus_publish(event_topic_t topic, app_event_t evt);
+
+/**
+ * @brief 读取订阅者的下一个事件（跳过没订阅的主题）。
+ * @param sub: 订阅者。
+ * @param evt_out: 输出事件。
+ * @param topic_out: 输出事件主题（可以为NULL）。
+ * @return bool: 读到返回 true，没有新事件返回 false。
+ */
+bool event_bus_read(event_bus_sub_t *sub, app_event_t *evt_out, event_topic_t *topic_out);
+
+/**
+ * @brief 丢弃订阅者还没读的所有事件（只影响这个订阅者）。
+ * @param sub: 订阅者。
+ */
+void event_bus_skip_all(event_bus_sub_t *sub);
+
+/**
+ * @brief 按来源 ID 得到主题（按键、摇杆、系统、存储）。
+ * @param source_id: 事件来源 ID。
+ * @return event_topic_t: 主题。
+ */
+event_topic_t event_bus_topic_of(uint16_t source_id);
+
+/**
+ * @brief 获取发布统计。
+ * @param published: 输出写入总线的事件数（可以为NULL）。
+ * @param filtered: 输出没人订阅、发布时丢弃的事件数（可以为NULL）。
+ */
+void event_bus_get_stats(uint32_t *published, uint32_t *filtered);
+
+#endif // __EVENT_BUS_H__
@@ -1,29 +1,99 @@
 #include "event_queue.h"
+#include "event_bus.h"
+
+#if (EVENT_QUEUE_CAPACITY_SLOTS & EVENT_QUEUE_INDEX_MASK) != 0
+#error "EVENT_QUEUE_CAPACITY_SLOTS must be a power of two"
+#endif
+#if EVENT_QUEUE_EDGE_RESERVE >= EVENT_QUEUE_CAPACITY_SLOTS
+#error "EVENT_QUEUE_EDGE_RESERVE must leave room for repeat events"
+#endif
 
 // -----------------------------------------------------------------------------
-// 1. 静态数据结构定义 (基于 RT-Thread Ring Buffer 实现)
+// 0. 下标的原子读写（可移植层）
 // -----------------------------------------------------------------------------
 
-// 静态分配的内存
-static rt_uint8_t event_queue_buffer[EVENT_QUEUE_BUFFER_SIZE];
+// Cortex-M4 单核上对齐的 32 位读写本身是原子的，只需要保证顺序：
+// 写方先写槽再发布下标（release），读方先读下标再读槽（acquire）。
+// 主机测试可以在包含本文件前换成 __atomic 内建函数。
+#ifndef EVENT_QUEUE_LOAD_ACQUIRE
+#define EVENT_QUEUE_LOAD_ACQUIRE(p)        event_queue_load_acquire(p)
+#endif
+#ifndef EVENT_QUEUE_STORE_RELEASE
+#define EVENT_QUEUE_STORE_RELEASE(p, v)    event_queue_store_release((p), (v))
+#endif
+
+static inline uint32_t event_queue_load_acquire(volatile const uint32_t *p)
+{
+    uint32_t v = *p;
+    __DMB();
+    return v;
+}
+
+static inline void event_queue_store_release(volatile uint32_t *p, uint32_t v)
+{
+    __DMB();
+    *p = v;
+}
 
-// 环形缓冲区控制块
-static struct rt_ringbuffer rb_event_queue;
+// -----------------------------------------------------------------------------
+// 1. 静态数据结构定义 (SPSC 环形队列)
+// -----------------------------------------------------------------------------
+
+// 事件槽，整个结构体一次拷贝，不再按字节搬运
+static app_event_t event_queue_slots[EVENT_QUEUE_CAPACITY_SLOTS];
+
+// 自由递增的读写下标，head - tail 就是队列里的事件数（32 位回绕也成立）
+static volatile uint32_t event_queue_head;  // 下一个写入位置，只有生产者写
+static volatile uint32_t event_queue_tail;  // 下一个读出位置，只有消费者写
+
+// 统计，只有生产者写
+static volatile event_queue_stats_t event_queue_stats;
 
 
 // -----------------------------------------------------------------------------
-// 2. 队列 API 实现 (封装 RT-Thread API)
+// 2. 队列 API 实现
 // -----------------------------------------------------------------------------
 
 /**
  * @brief 初始化事件队列组件。
- * 职责：初始化 RT-Thread 环形缓冲区控制块。
+ * 职责：清零读写下标，须在生产者开始推入之前调用。
  */
 void event_queue_init(void)
 {
-    // 调用 RT-Thread 的初始化函数
-    // 注意：这里将 size 参数设为缓冲区字节大小
-    rt_ringbuffer_init(&rb_event_queue, event_queue_buffer, EVENT_QUEUE_BUFFER_SIZE);
+    event_queue_head = 0;
+    event_queue_tail = 0;
+    event_queue_reset_stats();
+}
+
+/**
+ * @brief 占用一个新槽写入事件并发布。
+ * @param limit: 允许占用到的槽数（重复事件不能用保留槽）。
+ * @return bool: 占用成功返回 true。
+ */
+static bool event_queue_put(const app_event_t *evt, uint32_t limit)
+{
+    uint32_t head = event_queue_head;  // 自己写的下标，直接读
+    uint32_t tail = EVENT_QUEUE_LOAD_ACQUIRE(&event_queue_tail);
+    uint32_t used = head - tail;
+
+    if (used >= limit)
+    {
+        return false;
+    }
+
+    // 先写槽，再发布 head，消费者看到新 head 时槽里的数据一定已经写好
+    event_queue_slots[head & EVENT_QUEUE_INDEX_MASK] = *evt;
+    EVENT_QUEUE_STORE_RELEASE(&event_queue_head, head + 1);
+
+    event_queue_stats.pushed++;
+    if (used + 1 > event_queue_stats.high_water)
+    {
+        event_queue_stats.high_water = used + 1;
+    }
+
+    // 唤醒订阅了事件的任务（输入管理器、游戏、菜单），不用等到下一个周期
+    scheduler_notify_event();
+    return true;
 }
 
 /**
@@ -34,19 +104,65 @@ void event_queue_init(void)
  */
 bool event_queue_push(app_event_t evt)
 {
-    rt_size_t put_len;
+    // 同时广播给总线上的后台订阅者（没人订阅时只是一次掩码判断）
+    event_bus_publish(event_bus_topic_of(evt.source_id), evt);
+
+    if (!event_queue_put(&evt, EVENT_QUEUE_CAPACITY_SLOTS))
+    {
+        event_queue_stats.dropped++;
+        return false;
+    }
+    return true;
+}
 
-    // **关键：中断保护，防止竞态条件**
-    // 生产者和消费者在不同任务或中断中，需要保护环形缓冲区的读写指针
-    __disable_irq();
+/**
+ * @brief 推入一个重复事件，能合并就不占新槽。
+ * 槽只有生产者写，所以生产者可以放心读已经发布的槽；
+ * 合并时只改 data 这一个对齐的 32 位字，消费者同时拷贝这个槽也只会读到旧值或新值。
+ */
+bool event_queue_push_repeat(app_event_t evt)
+{
+    uint32_t head = event_queue_head;
+    uint32_t tail = EVENT_QUEUE_LOAD_ACQUIRE(&event_queue_tail);
+    uint32_t idx = head;
 
-    // 调用 RT-Thread 的 put 函数，注意长度是结构体的大小
-    put_len = rt_ringbuffer_put(&rb_event_queue, (const rt_uint8_t *)&evt, sizeof(app_event_t));
+    event_bus_publish(event_bus_topic_of(evt.source_id), evt);
 
-    __enable_irq();
+    // 从最新往回找同一来源最近的一个事件
+    while (idx != tail)
+    {
+        app_event_t *pending;
+
+        idx--;
+        pending = &event_queue_slots[idx & EVENT_QUEUE_INDEX_MASK];
+        if (pending->source_id != evt.source_id)
+        {
+            continue;
+        }
+
+        // 最近的是边沿事件就不能合并，否则顺序会乱
+        if (pending->event_type == evt.event_type)
+        {
+            pending->data = evt.data;
+            __DMB();
+
+            // 写完再确认它还没被取走；已经取走了就按新事件入队
+            tail = EVENT_QUEUE_LOAD_ACQUIRE(&event_queue_tail);
+            if ((uint32_t)(idx - tail) < (uint32_t)(head - tail))
+            {
+                event_queue_stats.coalesced++;
+                return true;
+            }
+        }
+        break;
+    }
 
-    // 如果实际放入的字节数等于结构体大小，视为成功
-    return put_len == sizeof(app_event_t);
+    if (!event_queue_put(&evt, EVENT_QUEUE_CAPACITY_SLOTS - EVENT_QUEUE_EDGE_RESERVE))
+    {
+        event_queue_stats.dropped_repeat++;
+        return false;
+    }
+    return true;
 }
 
 /**
@@ -57,34 +173,69 @@ bool event_queue_push(app_event_t evt)
  */
 bool event_queue_pop(app_event_t *evt_out)
 {
-    rt_size_t get_len;
-
-    // **关键：中断保护，防止竞态条件**
-    __disable_irq();
+    uint32_t tail = event_queue_tail;  // 自己写的下标，直接读
+    uint32_t head = EVENT_QUEUE_LOAD_ACQUIRE(&event_queue_head);
 
-    // 检查是否有足够的空间来取出一个完整的事件结构体
-    if (rt_ringbuffer_data_len(&rb_event_queue) < sizeof(app_event_t))
+    if (head == tail)
     {
-        __enable_irq();
         return false;
     }
 
-    // 调用 RT-Thread 的 get 函数
-    get_len = rt_ringbuffer_get(&rb_event_queue, (rt_uint8_t *)evt_out, sizeof(app_event_t));
+    // 先读槽，再发布 tail，生产者看到新 tail 之前不会覆盖这个槽
+    *evt_out = event_queue_slots[tail & EVENT_QUEUE_INDEX_MASK];
+    EVENT_QUEUE_STORE_RELEASE(&event_queue_tail, tail + 1);
+    return true;
+}
 
-    __enable_irq();
+/**
+ * @brief 查看队列里最早的事件，不取出 (Peek)。
+ */
+bool event_queue_peek(app_event_t *evt_out)
+{
+    uint32_t tail = event_queue_tail;
+    uint32_t head = EVENT_QUEUE_LOAD_ACQUIRE(&event_queue_head);
 
-    // 如果实际读取的字节数等于结构体大小，视为成功
-    return get_len == sizeof(app_event_t);
+    if (head == tail)
+    {
+        return false;
+    }
+
+    *evt_out = event_queue_slots[tail & EVENT_QUEUE_INDEX_MASK];
+    return true;
 }
 
 /**
  * @brief 清空事件队列中的所有事件
  * @note  用于场景切换时清除残留事件，避免新场景处理旧事件
+ * @note  消费者把 tail 追到当前 head；清空的同时生产者推入的新事件保留
  */
 void event_queue_clear(void)
 {
-    __disable_irq();
-    rt_ringbuffer_reset(&rb_event_queue);  // 重置环形缓冲区
-    __enable_irq();
+    uint32_t head = EVENT_QUEUE_LOAD_ACQUIRE(&event_queue_head);
+
+    EVENT_QUEUE_STORE_RELEASE(&event_queue_tail, head);
+}
+
+/**
+ * @brief 读取事件队列统计。
+ */
+void event_queue_get_stats(event_queue_stats_t *out)
+{
+    out->pushed = event_queue_stats.pushed;
+    out->coalesced = event_queue_stats.coalesced;
+    out->dropped = event_queue_stats.dropped;
+    out->dropped_repeat = event_queue_stats.dropped_repeat;
+    out->high_water = event_queue_stats.high_water;
+}
+
+/**
+ * @brief 清零事件队列统计。
+ */
+void event_queue_reset_stats(void)
+{
+    event_queue_stats.pushed = 0;
+    event_queue_stats.coalesced = 0;
+    event_queue_stats.dropped = 0;
+    event_queue_stats.dropped_repeat = 0;
+    event_queue_stats.high_water = 0;
 }
@@ -3,10 +3,14 @@
 
 #include "mydefine.h"
 
-// 环形事件队列的容量由两个参数构成：
-// 槽数存储 16 个事件，每个事件 8 字节（结构体大小）
+// 环形事件队列的槽数，每个槽存一个 app_event_t
+// 必须是 2 的幂：读写下标自由递增，用掩码取槽号
 #define EVENT_QUEUE_CAPACITY_SLOTS 16
-#define EVENT_QUEUE_BUFFER_SIZE (EVENT_QUEUE_CAPACITY_SLOTS * sizeof(app_event_t))
+#define EVENT_QUEUE_INDEX_MASK (EVENT_QUEUE_CAPACITY_SLOTS - 1)
+
+// 留给边沿事件（按下/松开/方向进入离开等）的槽数：
+// 重复事件（摇杆HOLD、按键KEEPALIVE）最多占到 CAPACITY - RESERVE，不会把边沿事件挤掉
+#define EVENT_QUEUE_EDGE_RESERVE 4
 
 
 // -----------------------------------------------------------------------------
@@ -17,18 +21,41 @@
  * @brief 统一应用层事件结构体。
  * 职责：封装各个输入源 (按键, 摇杆) 的信息。
  */
-typedef struct
+typedef struct app_event
 {
     uint16_t source_id;     /*!< 事件来源 ID (BTN_SW1, ROCKER_UP 等) */
     uint8_t event_type;     /*!< 事件类型 (EBTN_EVT_ONCLICK, DIRECTION_MOVE 等) */
     uint32_t data;          /*!< 附加数据，用于传递额外信息 (如按键次数, 摇杆原始值) */
+    uint32_t timestamp_us;  /*!< 采集时间 (scheduler_get_time_us())，由生产者填写，用于测量输入延迟 */
 } app_event_t;
 
+/**
+ * @brief 事件队列统计。
+ * 只有生产者更新，消费者随时读快照。
+ */
+typedef struct
+{
+    uint32_t pushed;         /*!< 成功占用新槽的事件数 */
+    uint32_t coalesced;      /*!< 合并进未取走事件的重复事件数 */
+    uint32_t dropped;        /*!< 队列满丢掉的边沿事件数（正常应该一直是 0） */
+    uint32_t dropped_repeat; /*!< 丢掉的重复事件数（没有可合并的事件且只剩保留槽） */
+    uint32_t high_water;     /*!< 最多同时占用的槽数 */
+} event_queue_stats_t;
+
 
 // -----------------------------------------------------------------------------
 // 2. 事件队列 API 声明
 // -----------------------------------------------------------------------------
 
+// 单生产者/单消费者（SPSC）无锁队列，不关中断：
+// - 生产者只写 head，消费者只写 tail，下标都是 32 位、对齐，读写本身是原子的；
+// - 所有 push 必须来自同一个执行上下文（现在是主循环里的 ebtn/摇杆任务；
+//   也可以是唯一的一个中断），pop 和 clear 必须来自另一个（主循环）；
+// - 主循环里的任务不会互相抢占，所以主循环里多个任务 push 仍算一个生产者。
+//   如果以后中断和主循环都要 push，需要分成两个队列。
+// - 这是前台（input_manager）专用的队列；推入的事件同时发布到 event_bus，
+//   后台服务订阅总线，不从这里取事件。
+
 /**
  * @brief 初始化事件队列组件。
  */
@@ -36,25 +63,58 @@ void event_queue_init(void);
 
 /**
  * @brief 向队列中推入一个事件 (Push)。
- * 职责：供底层驱动层 (如 ebtn_driver) 调用。
+ * 职责：供底层驱动层 (如 ebtn_driver) 调用，只在生产者上下文调用。
+ * 推入成功后通知调度器，订阅了事件唤醒的任务会尽快运行。
  * @param evt: 要推入的事件实例。
  * @return bool: 成功返回 true，队列已满返回 false。
  */
 bool event_queue_push(app_event_t evt);
 
+/**
+ * @brief 推入一个重复事件（摇杆HOLD、按键KEEPALIVE）。
+ * 职责：同一来源最近一个未取走的事件如果是同类型的重复事件，只把它的 data 换成新的，
+ * 不占新槽；否则按普通事件推入，但不能使用 EVENT_QUEUE_EDGE_RESERVE 个保留槽。
+ * 只在生产者上下文调用。
+ * @note 替换时消费者刚好取走了旧事件，则新事件照常入队，消费者会多看到一次重复事件。
+ * @param evt: 要推入的事件实例。
+ * @return bool: 合并或推入成功返回 true，被丢弃返回 false。
+ */
+bool event_queue_push_repeat(app_event_t evt);
+
 /**
  * @brief 从队列中取出一个事件 (Pop)。
- * 职责：供应用层调用 (如 menu_task, game_task) 读取并处理。
+ * 职责：供应用层调用 (如 menu_task, game_task) 读取并处理，只在消费者上下文调用。
  * @param evt_out: 指向存储返回事件的缓冲区指针。
  * @return bool: 队列非空且成功取出一个事件返回 true，队列为空返回 false。
  */
 bool event_queue_pop(app_event_t *evt_out);
 
+/**
+ * @brief 查看队列里最早的事件，不取出 (Peek)。
+ * 职责：供消费者查询积压情况（如最早事件已经等了多久），只在消费者上下文调用。
+ * @param evt_out: 指向存储返回事件的缓冲区指针。
+ * @return bool: 队列非空返回 true，队列为空返回 false。
+ */
+bool event_queue_peek(app_event_t *evt_out);
+
 /**
  * @brief 清空事件队列中的所有事件
  * @note  用于场景切换时清除残留事件，避免新场景处理旧事件
+ * @note  只在消费者上下文调用（把 tail 追到 head）
  */
 void event_queue_clear(void);
 
+/**
+ * @brief 读取事件队列统计（丢弃次数、合并次数、最高占用）。
+ * @param out: 输出统计快照。
+ */
+void event_queue_get_stats(event_queue_stats_t *out);
+
+/**
+ * @brief 清零事件队列统计。
+ * @note 在消费者上下文调用；与生产者同时更新的那一次计数可能丢失，只影响统计。
+ */
+void event_queue_reset_stats(void);
+
 
 #endif // __EVENT_QUEUE_H__
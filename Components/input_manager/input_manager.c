@@ -2,6 +2,7 @@
 #include "event_queue.h"
 #include "ebtn_driver.h"
 #include "rocker.h"
+#include "input_replay.h"
 
 // -----------------------------------------------------------------------------
 // 事件源ID分配规则
@@ -23,6 +24,14 @@ static uint8_t btn_just_pressed[INPUT_BTN_MAX] = {0};  // 刚刚按下标志
 static uint8_t btn_just_released[INPUT_BTN_MAX] = {0}; // 刚刚释放标志
 static uint8_t btn_double_click[INPUT_BTN_MAX] = {0};  // 双击标志
 
+// 输入延迟测量
+static uint8_t s_input_pending = 0;      // 已处理、还没有画面发出去的输入
+static uint32_t s_input_pending_us = 0;  // 其中最早一个的采集时间
+static uint8_t s_input_inflight = 0;     // 已发出、等待发送完成的帧里带着输入
+static uint32_t s_input_inflight_us = 0; // 这一帧里最早输入的采集时间
+static uint64_t s_latency_total_us = 0;  // 延迟累计，用于求平均
+static input_latency_stats_t s_latency;
+
 // -----------------------------------------------------------------------------
 // 私有函数
 // -----------------------------------------------------------------------------
@@ -30,15 +39,33 @@ static uint8_t btn_double_click[INPUT_BTN_MAX] = {0};  // 双击标志
 /**
  * @brief 清除所有"刚刚"状态标志
  * @note  每帧开始时调用，确保边缘触发只维持一帧
+ * @retval 1: 清除前有标志置位, 0: 本来就全是0
  */
-static void clear_edge_flags(void)
+static uint8_t clear_edge_flags(void)
 {
+    uint8_t had_edges = 0;
+
     for (uint8_t i = 0; i < INPUT_BTN_MAX; i++)
     {
+        had_edges |= btn_just_pressed[i] | btn_just_released[i] | btn_double_click[i];
         btn_just_pressed[i] = 0;
         btn_just_released[i] = 0;
         btn_double_click[i] = 0;  // 清除双击标志
     }
+    return had_edges;
+}
+
+/**
+ * @brief 记录一次改变了按键状态的输入，等待画面反映
+ * @param timestamp_us: 事件采集时间
+ */
+static void mark_input(uint32_t timestamp_us)
+{
+    if (!s_input_pending)
+    {
+        s_input_pending = 1;
+        s_input_pending_us = timestamp_us;
+    }
 }
 
 /**
@@ -102,12 +129,14 @@ static input_button_t map_rocker_direction(rocker_direction_t direction)
  * @brief 处理按键事件
  * @param btn: 按键枚举
  * @param is_press: 1=按下, 0=释放
+ * @param timestamp_us: 事件采集时间
+ * @retval 1: 按键状态改变, 0: 没有变化
  */
-static void handle_button_event(input_button_t btn, uint8_t is_press)
+static uint8_t handle_button_event(input_button_t btn, uint8_t is_press, uint32_t timestamp_us)
 {
     if (btn >= INPUT_BTN_MAX)
     {
-        return; // 无效按键，忽略
+        return 0; // 无效按键，忽略
     }
 
     if (is_press)
@@ -117,6 +146,8 @@ static void handle_button_event(input_button_t btn, uint8_t is_press)
         {
             btn_pressed[btn] = 1;
             btn_just_pressed[btn] = 1;
+            mark_input(timestamp_us);
+            return 1;
         }
     }
     else
@@ -126,33 +157,35 @@ static void handle_button_event(input_button_t btn, uint8_t is_press)
         {
             btn_pressed[btn] = 0;
             btn_just_released[btn] = 1;
+            mark_input(timestamp_us);
+            return 1;
         }
     }
+    return 0;
 }
 
 /**
  * @brief 处理ebtn按键事件
  * @param evt: 事件结构体指针
+ * @retval 1: 按键状态改变, 0: 没有变化
  */
-static void process_ebtn_event(app_event_t *evt)
+static uint8_t process_ebtn_event(const app_event_t *evt)
 {
     input_button_t btn = map_button_id(evt->source_id);
 
     if (btn >= INPUT_BTN_MAX)
     {
-        return; // 无效按键
+        return 0; // 无效按键
     }
 
     // 根据事件类型处理
     switch (evt->event_type)
     {
     case EBTN_EVT_ONPRESS:
-        handle_button_event(btn, 1);
-        break;
+        return handle_button_event(btn, 1, evt->timestamp_us);
 
     case EBTN_EVT_ONRELEASE:
-        handle_button_event(btn, 0);
-        break;
+        return handle_button_event(btn, 0, evt->timestamp_us);
 
     case EBTN_EVT_ONCLICK:
         // 处理单击/双击事件
@@ -163,21 +196,24 @@ static void process_ebtn_event(app_event_t *evt)
             {
                 // 检测到双击
                 btn_double_click[btn] = 1;
+                mark_input(evt->timestamp_us);
+                return 1;
             }
         }
-        break;
+        return 0;
 
     // KEEPALIVE事件不需要处理
     default:
-        break;
+        return 0;
     }
 }
 
 /**
  * @brief 处理摇杆事件
  * @param evt: 事件结构体指针
+ * @retval 1: 按键状态改变, 0: 没有变化
  */
-static void process_rocker_event(app_event_t *evt)
+static uint8_t process_rocker_event(const app_event_t *evt)
 {
     // 解包摇杆事件数据
     rocker_direction_t dir = ROCKER_EVT_UNPACK_DIR(evt->data);
@@ -185,26 +221,46 @@ static void process_rocker_event(app_event_t *evt)
 
     if (btn >= INPUT_BTN_MAX)
     {
-        return; // 中心位置，不处理
+        return 0; // 中心位置，不处理
     }
 
     // 根据事件类型处理
     switch (evt->event_type)
     {
     case ROCKER_EVT_DIR_ENTER:
-        handle_button_event(btn, 1);
-        break;
+        return handle_button_event(btn, 1, evt->timestamp_us);
 
     case ROCKER_EVT_DIR_LEAVE:
-        handle_button_event(btn, 0);
-        break;
+        return handle_button_event(btn, 0, evt->timestamp_us);
 
     // HOLD事件不需要特殊处理，状态已经是按下
     default:
-        break;
+        return 0;
     }
 }
 
+/**
+ * @brief 处理一个事件
+ * @param evt: 事件结构体指针
+ * @retval 1: 按键状态改变, 0: 没有变化（无效按键、HOLD/KEEPALIVE等）
+ */
+static uint8_t process_event(const app_event_t *evt)
+{
+    // 判断事件来源（根据ID范围区分）
+    if (evt->source_id < ROCKER_SOURCE_ID)
+    {
+        // 来自ebtn（按键）：ID < 256
+        return process_ebtn_event(evt);
+    }
+    else if (evt->source_id == ROCKER_SOURCE_ID)
+    {
+        // 来自rocker（摇杆）：ID = 256
+        return process_rocker_event(evt);
+    }
+    // 其他事件源忽略
+    return 0;
+}
+
 // -----------------------------------------------------------------------------
 // 公共函数实现
 // -----------------------------------------------------------------------------
@@ -222,6 +278,10 @@ void input_manager_init(void)
         btn_just_released[i] = 0;
         btn_double_click[i] = 0;
     }
+
+    s_input_pending = 0;
+    s_input_inflight = 0;
+    input_manager_reset_latency_stats();
 }
 
 /**
@@ -231,6 +291,7 @@ void input_manager_init(void)
 void input_manager_clear(void)
 {
     // 清空所有状态（与init相同）
+    // 延迟测量保留：触发场景切换的那次输入，反映在新场景的第一帧上
     for (uint8_t i = 0; i < INPUT_BTN_MAX; i++)
     {
         btn_pressed[i] = 0;
@@ -245,26 +306,47 @@ void input_manager_clear(void)
  */
 void input_manager_task(void)
 {
+    app_event_t evt;
+    uint8_t had_edges;
+
+    // 回放时输入来自录制数据，由游戏帧驱动，实时按键直接丢弃
+    if (input_replay_is_playing())
+    {
+        event_queue_clear();
+        return;
+    }
+
     // 清除上一帧的边缘触发标志
-    clear_edge_flags();
+    had_edges = clear_edge_flags();
 
     // 处理事件队列中的所有事件
-    app_event_t evt;
     while (event_queue_pop(&evt))
     {
-        // 判断事件来源（根据ID范围区分）
-        if (evt.source_id < ROCKER_SOURCE_ID)
-        {
-            // 来自ebtn（按键）：ID < 256
-            process_ebtn_event(&evt);
-        }
-        else if (evt.source_id == ROCKER_SOURCE_ID)
+        // 只有改变了按键状态的事件才需要录制（没在录制时直接返回）
+        if (process_event(&evt))
         {
-            // 来自rocker（摇杆）：ID = 256
-            process_rocker_event(&evt);
+            input_replay_record_event(&evt);
         }
-        // 其他事件源忽略
     }
+
+    // 这次调用清掉了边沿标志或者改变了状态，作为一批录下来
+    input_replay_record_batch(had_edges);
+}
+
+/**
+ * @brief 回放：开始一批录制的事件
+ */
+void input_manager_replay_begin(void)
+{
+    clear_edge_flags();
+}
+
+/**
+ * @brief 回放：处理一个录制的事件
+ */
+void input_manager_replay_event(const app_event_t *evt)
+{
+    process_event(evt);
 }
 
 /**
@@ -365,3 +447,87 @@ uint8_t input_is_double_click(input_button_t btn)
     }
     return btn_double_click[btn];
 }
+
+/**
+ * @brief 获取最早一个未处理事件的等待时间
+ */
+uint32_t input_manager_get_oldest_event_age_us(void)
+{
+    app_event_t evt;
+
+    if (!event_queue_peek(&evt))
+    {
+        return 0;
+    }
+    return scheduler_get_time_us() - evt.timestamp_us;
+}
+
+/**
+ * @brief 显示服务发出一帧
+ */
+void input_manager_frame_sent(uint8_t changed)
+{
+    if (!s_input_pending)
+    {
+        return;
+    }
+    s_input_pending = 0;
+
+    if (!changed)
+    {
+        // 输入没有让画面变化，没有可测的“上屏”时刻
+        s_latency.unchanged++;
+        return;
+    }
+
+    // 上一帧还没报告完成时保留更早的输入，它也在这次发送之后上屏
+    if (!s_input_inflight)
+    {
+        s_input_inflight = 1;
+        s_input_inflight_us = s_input_pending_us;
+    }
+}
+
+/**
+ * @brief 发出的帧发送完成
+ */
+void input_manager_frame_presented(uint32_t done_us)
+{
+    uint32_t latency;
+
+    if (!s_input_inflight)
+    {
+        return;
+    }
+    s_input_inflight = 0;
+
+    latency = done_us - s_input_inflight_us;
+    s_latency.count++;
+    s_latency.last_us = latency;
+    if (latency > s_latency.max_us)
+    {
+        s_latency.max_us = latency;
+    }
+    s_latency_total_us += latency;
+    s_latency.avg_us = (uint32_t)(s_latency_total_us / s_latency.count);
+}
+
+/**
+ * @brief 获取输入延迟统计
+ */
+void input_manager_get_latency_stats(input_latency_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = s_latency;
+    }
+}
+
+/**
+ * @brief 清零输入延迟统计
+ */
+void input_manager_reset_latency_stats(void)
+{
+    s_latency_total_us = 0;
+    memset(&s_latency, 0, sizeof(s_latency));
+}
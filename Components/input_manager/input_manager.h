@@ -55,6 +55,19 @@ typedef enum
     INPUT_STATE_JUST_RELEASED, /*!< 刚刚释放（边缘触发，只在释放瞬间为真） */
 } input_state_t;
 
+/**
+ * @brief 输入到屏幕的延迟统计
+ * @note  从生产者采集事件（app_event_t.timestamp_us）到第一帧反映它的画面发送完成
+ */
+typedef struct
+{
+    uint32_t count;     /*!< 测到的次数 */
+    uint32_t last_us;   /*!< 最近一次延迟（微秒） */
+    uint32_t max_us;    /*!< 最大延迟（微秒） */
+    uint32_t avg_us;    /*!< 平均延迟（微秒） */
+    uint32_t unchanged; /*!< 输入之后发送的第一帧画面没有变化的次数（不计入延迟） */
+} input_latency_stats_t;
+
 // -----------------------------------------------------------------------------
 // 3. API声明
 // -----------------------------------------------------------------------------
@@ -136,4 +149,59 @@ uint8_t input_any_button_pressed(void);
  */
 uint8_t input_is_double_click(input_button_t btn);
 
+// -----------------------------------------------------------------------------
+// 4. 输入延迟测量
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 获取事件队列里最早一个还没处理的事件已经等了多久
+ * @retval 等待时间（微秒），队列为空返回0
+ */
+uint32_t input_manager_get_oldest_event_age_us(void);
+
+/**
+ * @brief 显示服务发出一帧时调用
+ * @param changed: 1=这一帧画面有变化（有数据发送到屏幕）, 0=画面没变
+ * @note  这一帧包含了之前处理过的所有输入，画面有变化时等它发送完成再计算延迟
+ */
+void input_manager_frame_sent(uint8_t changed);
+
+/**
+ * @brief 发出的帧已经完整发送到屏幕时调用
+ * @param done_us: 发送完成的时间（scheduler_get_time_us()）
+ */
+void input_manager_frame_presented(uint32_t done_us);
+
+/**
+ * @brief 获取输入到屏幕的延迟统计
+ * @param stats: 输出统计信息
+ */
+void input_manager_get_latency_stats(input_latency_stats_t *stats);
+
+/**
+ * @brief 清零输入延迟统计
+ */
+void input_manager_reset_latency_stats(void);
+
+// -----------------------------------------------------------------------------
+// 5. 录制回放（input_replay 使用）
+// -----------------------------------------------------------------------------
+
+// app_event_t 的前向声明：从 event_queue.h 开始包含时，它先包含 mydefine.h（进而包含本文件）
+// 再定义 app_event_t，这里还看不到完整类型
+struct app_event;
+
+/**
+ * @brief 回放：开始一批录制的事件（清除边沿标志）
+ * @note  begin 加上这一批的 input_manager_replay_event，效果和录制时那次
+ *        input_manager_task 调用相同；回放期间 input_manager_task 不处理实时事件
+ */
+void input_manager_replay_begin(void);
+
+/**
+ * @brief 回放：处理一个录制的事件
+ * @param evt: 录制时改变了按键状态的事件
+ */
+void input_manager_replay_event(const struct app_event *evt);
+
 #endif // __INPUT_MANAGER_H__
@@ -0,0 +1,618 @@
+#include "input_replay.h"
+#include "input_manager.h"
+
+// -----------------------------------------------------------------------------
+// 1. 录制格式常量
+// -----------------------------------------------------------------------------
+
+#define INPUT_REPLAY_MAGIC0      'I'
+#define INPUT_REPLAY_MAGIC1      'R'
+#define INPUT_REPLAY_VERSION     1
+#define INPUT_REPLAY_HEADER_SIZE 12
+
+// 头部各字段的位置
+#define INPUT_REPLAY_HDR_VERSION 2
+#define INPUT_REPLAY_HDR_GAME    3
+#define INPUT_REPLAY_HDR_SEED    4
+#define INPUT_REPLAY_HDR_TICK    8
+
+// 一批最多的事件数（事件数放在标签字节的低4位），超过时接一个不清边沿标志的续批
+#define INPUT_REPLAY_BATCH_MAX   15
+// 一个短游程最多的帧数（帧数-1放在标签字节的低7位）
+#define INPUT_REPLAY_RUN_MAX     128
+
+/**
+ * @brief 录制条目的标签字节
+ */
+typedef enum
+{
+    INPUT_REPLAY_TAG_END = 0x00,    /*!< 录制结束 */
+    INPUT_REPLAY_TAG_FRAMES = 0x01, /*!< 若干帧：后跟增量ms和帧数 */
+    INPUT_REPLAY_TAG_BATCH = 0x10,  /*!< 一次 input_manager_task：清边沿标志 + 低4位个事件 */
+    INPUT_REPLAY_TAG_MORE = 0x20,   /*!< 上一批的续批：只有低4位个事件 */
+    INPUT_REPLAY_TAG_RUN = 0x80,    /*!< 低7位+1 帧，增量和上一个 FRAMES 相同 */
+} input_replay_tag_t;
+
+// -----------------------------------------------------------------------------
+// 2. 静态数据
+// -----------------------------------------------------------------------------
+
+static uint8_t s_buf[INPUT_REPLAY_BUFFER_SIZE];
+static uint32_t s_len;          // 录制时的写位置
+static uint32_t s_commit;       // 最后一个完整条目的结尾，写满时回退到这里
+static uint32_t s_record_len;   // 完整录制的长度，0=没有可回放的录制
+
+static input_replay_mode_t s_mode;
+static uint8_t s_auto_record;
+static uint8_t s_armed;         // 已准备回放，等游戏启动
+
+static uint32_t s_batch_pos;    // 正在写的批次的标签位置，0=没有打开的批次
+static uint8_t s_batch_count;
+
+static uint32_t s_run_delta;    // 帧时钟游程：录制时是还没写出的，回放时是还没用完的
+static uint32_t s_run_count;
+static uint32_t s_frames_delta; // 最近一个 FRAMES 条目的增量，短游程沿用它
+
+static uint32_t s_clock;        // 上一帧的游戏时钟
+static uint32_t s_clock_offset; // 不在回放时，游戏时钟 = HAL_GetTick() + offset
+static uint32_t s_event_us;     // 上一个事件的时间戳（时间戳按增量录制）
+static uint32_t s_pos;          // 回放读位置
+
+static input_replay_stats_t s_stats;
+
+// -----------------------------------------------------------------------------
+// 3. 编解码
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 写一个字节，最后一个字节留给 END
+ */
+static uint8_t replay_put_byte(uint8_t b)
+{
+    if (s_len >= INPUT_REPLAY_BUFFER_SIZE - 1)
+    {
+        return 0;
+    }
+    s_buf[s_len++] = b;
+    return 1;
+}
+
+/**
+ * @brief 写一个 LEB128 变长整数：每字节7位，最高位表示后面还有
+ */
+static uint8_t replay_put_varint(uint32_t v)
+{
+    do
+    {
+        uint8_t b = (uint8_t)(v & 0x7F);
+
+        v >>= 7;
+        if (v != 0)
+        {
+            b |= 0x80;
+        }
+        if (!replay_put_byte(b))
+        {
+            return 0;
+        }
+    } while (v != 0);
+    return 1;
+}
+
+static void replay_put_u32(uint32_t pos, uint32_t v)
+{
+    s_buf[pos] = (uint8_t)v;
+    s_buf[pos + 1] = (uint8_t)(v >> 8);
+    s_buf[pos + 2] = (uint8_t)(v >> 16);
+    s_buf[pos + 3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t replay_get_u32(uint32_t pos)
+{
+    return (uint32_t)s_buf[pos] | ((uint32_t)s_buf[pos + 1] << 8) |
+           ((uint32_t)s_buf[pos + 2] << 16) | ((uint32_t)s_buf[pos + 3] << 24);
+}
+
+/**
+ * @brief 回放时读一个字节
+ */
+static uint8_t replay_get_byte(uint8_t *b)
+{
+    if (s_pos >= s_record_len)
+    {
+        return 0;
+    }
+    *b = s_buf[s_pos++];
+    return 1;
+}
+
+/**
+ * @brief 回放时读一个 LEB128 变长整数
+ */
+static uint8_t replay_get_varint(uint32_t *v)
+{
+    uint32_t value = 0;
+    uint8_t b;
+
+    for (uint8_t shift = 0; shift < 35; shift += 7)
+    {
+        if (!replay_get_byte(&b))
+        {
+            return 0;
+        }
+        value |= (uint32_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+        {
+            *v = value;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 检查缓冲区开头是不是一个有效的录制头部
+ */
+static uint8_t replay_header_valid(uint32_t len)
+{
+    return len > INPUT_REPLAY_HEADER_SIZE &&
+           s_buf[0] == INPUT_REPLAY_MAGIC0 &&
+           s_buf[1] == INPUT_REPLAY_MAGIC1 &&
+           s_buf[INPUT_REPLAY_HDR_VERSION] == INPUT_REPLAY_VERSION;
+}
+
+// -----------------------------------------------------------------------------
+// 4. 录制
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 结束录制：写 END，切回硬件随机数
+ * @param truncated: 1=缓冲区写满提前结束
+ */
+static void replay_record_stop(uint8_t truncated)
+{
+    if (truncated)
+    {
+        // 回退掉写了一半的条目
+        s_len = s_commit;
+        s_stats.truncated = 1;
+    }
+    s_buf[s_len++] = INPUT_REPLAY_TAG_END; // replay_put_byte 一直留着这个字节
+    s_record_len = s_len;
+    s_stats.bytes = s_len;
+    s_batch_pos = 0;
+    s_mode = INPUT_REPLAY_IDLE;
+    rng_use_hardware();
+}
+
+/**
+ * @brief 写出攒着的帧时钟游程
+ * @note  增量和上一个 FRAMES 相同时每128帧只占1个字节
+ */
+static uint8_t replay_flush_run(void)
+{
+    uint32_t n;
+
+    if (s_run_count == 0)
+    {
+        return 1;
+    }
+
+    if (s_run_delta != s_frames_delta)
+    {
+        if (!replay_put_byte(INPUT_REPLAY_TAG_FRAMES) ||
+            !replay_put_varint(s_run_delta) ||
+            !replay_put_varint(s_run_count))
+        {
+            return 0;
+        }
+        s_frames_delta = s_run_delta;
+    }
+    else
+    {
+        for (; s_run_count != 0; s_run_count -= n)
+        {
+            n = (s_run_count < INPUT_REPLAY_RUN_MAX) ? s_run_count : INPUT_REPLAY_RUN_MAX;
+            if (!replay_put_byte((uint8_t)(INPUT_REPLAY_TAG_RUN | (n - 1))))
+            {
+                return 0;
+            }
+        }
+    }
+    s_run_count = 0;
+    s_commit = s_len;
+    return 1;
+}
+
+/**
+ * @brief 打开一个批次，事件数在关闭时填进标签的低4位
+ */
+static uint8_t replay_open_batch(input_replay_tag_t tag)
+{
+    if (!replay_put_byte((uint8_t)tag))
+    {
+        return 0;
+    }
+    s_batch_pos = s_len - 1;
+    s_batch_count = 0;
+    return 1;
+}
+
+static void replay_close_batch(void)
+{
+    s_buf[s_batch_pos] |= s_batch_count;
+    s_batch_pos = 0;
+    s_commit = s_len;
+}
+
+/**
+ * @brief 开始录制：写头部，用硬件随机数做种子
+ */
+static void replay_record_start(uint8_t game_index, uint32_t clock)
+{
+    uint32_t seed;
+
+    if (rng_get_random(&seed) != 0)
+    {
+        seed = scheduler_get_time_us();
+    }
+    rng_set_seed(seed);
+
+    s_buf[0] = INPUT_REPLAY_MAGIC0;
+    s_buf[1] = INPUT_REPLAY_MAGIC1;
+    s_buf[INPUT_REPLAY_HDR_VERSION] = INPUT_REPLAY_VERSION;
+    s_buf[INPUT_REPLAY_HDR_GAME] = game_index;
+    replay_put_u32(INPUT_REPLAY_HDR_SEED, seed);
+    replay_put_u32(INPUT_REPLAY_HDR_TICK, clock);
+    s_len = INPUT_REPLAY_HEADER_SIZE;
+    s_commit = s_len;
+    s_record_len = 0; // 录制中的缓冲区不能回放
+    s_batch_pos = 0;
+    s_run_count = 0;
+    s_frames_delta = 0xFFFFFFFFu; // 第一个游程总是写完整的 FRAMES
+    s_event_us = scheduler_get_time_us();
+    s_mode = INPUT_REPLAY_RECORDING;
+}
+
+// -----------------------------------------------------------------------------
+// 5. 回放
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 结束回放，游戏时钟从回放的时钟接着走
+ */
+static void replay_play_stop(uint32_t live_tick)
+{
+    s_clock_offset = s_clock - live_tick;
+    s_mode = INPUT_REPLAY_IDLE;
+    rng_use_hardware();
+}
+
+/**
+ * @brief 读一批事件送进 input_manager
+ * @param tag: BATCH/MORE 标签字节（低4位是事件数）
+ */
+static uint8_t replay_play_batch(uint8_t tag)
+{
+    app_event_t evt;
+    uint32_t source, type, data, delta;
+    uint8_t count = tag & 0x0F;
+
+    if ((tag & 0xF0) == INPUT_REPLAY_TAG_BATCH)
+    {
+        input_manager_replay_begin();
+    }
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (!replay_get_varint(&source) || !replay_get_varint(&type) ||
+            !replay_get_varint(&data) || !replay_get_varint(&delta))
+        {
+            return 0;
+        }
+        s_event_us += delta;
+        evt.source_id = (uint16_t)source;
+        evt.event_type = (uint8_t)type;
+        evt.data = data;
+        evt.timestamp_us = s_event_us;
+        input_manager_replay_event(&evt);
+        s_stats.events++;
+    }
+    return 1;
+}
+
+/**
+ * @brief 回放下一帧：先送这一帧之前的事件批次，再取一帧时钟
+ */
+static uint32_t replay_play_frame(uint32_t live_tick)
+{
+    uint8_t tag;
+    uint8_t ok;
+
+    while (s_run_count == 0)
+    {
+        ok = replay_get_byte(&tag);
+        if (ok && (tag & INPUT_REPLAY_TAG_RUN))
+        {
+            s_run_delta = s_frames_delta;
+            s_run_count = (tag & 0x7F) + 1u;
+        }
+        else if (ok && tag == INPUT_REPLAY_TAG_FRAMES)
+        {
+            ok = replay_get_varint(&s_run_delta) && replay_get_varint(&s_run_count);
+            s_frames_delta = s_run_delta;
+        }
+        else if (ok && ((tag & 0xF0) == INPUT_REPLAY_TAG_BATCH || (tag & 0xF0) == INPUT_REPLAY_TAG_MORE))
+        {
+            ok = replay_play_batch(tag);
+        }
+        else
+        {
+            ok = 0; // END 或者数据损坏
+        }
+
+        if (!ok)
+        {
+            // 录制到这里结束（写满截断），游戏继续用实时输入，
+            // 回放里按着的键不能一直按着
+            replay_play_stop(live_tick);
+            input_manager_clear();
+            return live_tick + s_clock_offset;
+        }
+    }
+
+    s_run_count--;
+    s_clock += s_run_delta;
+    return s_clock;
+}
+
+// -----------------------------------------------------------------------------
+// 6. API 实现
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 初始化录制回放模块
+ */
+void input_replay_init(void)
+{
+    s_mode = INPUT_REPLAY_IDLE;
+    s_auto_record = INPUT_REPLAY_AUTO_RECORD;
+    s_armed = 0;
+    s_len = 0;
+    s_record_len = 0;
+    s_batch_pos = 0;
+    s_run_count = 0;
+    s_clock_offset = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+/**
+ * @brief 获取当前状态
+ */
+input_replay_mode_t input_replay_get_mode(void)
+{
+    return s_mode;
+}
+
+/**
+ * @brief 是否正在回放
+ */
+uint8_t input_replay_is_playing(void)
+{
+    return s_mode == INPUT_REPLAY_PLAYING;
+}
+
+/**
+ * @brief 开关自动录制
+ */
+void input_replay_set_auto_record(uint8_t enable)
+{
+    s_auto_record = enable;
+}
+
+/**
+ * @brief 准备回放
+ */
+int input_replay_arm_playback(void)
+{
+    if (s_mode != INPUT_REPLAY_IDLE || !replay_header_valid(s_record_len))
+    {
+        return -1;
+    }
+    s_armed = 1;
+    return s_buf[INPUT_REPLAY_HDR_GAME];
+}
+
+/**
+ * @brief 载入外部保存的录制
+ */
+int input_replay_load(const uint8_t *data, uint32_t len)
+{
+    if (s_mode != INPUT_REPLAY_IDLE || len > INPUT_REPLAY_BUFFER_SIZE)
+    {
+        return -1;
+    }
+    memcpy(s_buf, data, len);
+    s_record_len = replay_header_valid(len) ? len : 0;
+    return s_record_len ? 0 : -1;
+}
+
+/**
+ * @brief 获取最近一次录制的数据
+ */
+void input_replay_get_record(const uint8_t **data, uint32_t *len)
+{
+    *data = s_buf;
+    *len = (s_mode == INPUT_REPLAY_RECORDING) ? 0 : s_record_len;
+}
+
+/**
+ * @brief 获取最近一局的统计
+ */
+void input_replay_get_stats(input_replay_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = s_stats;
+    }
+}
+
+/**
+ * @brief 游戏开始
+ */
+uint32_t input_replay_game_start(uint8_t game_index, uint32_t live_tick)
+{
+    uint8_t armed = s_armed;
+
+    s_armed = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+
+    // 回放：随机数种子和游戏时钟都用录制时的
+    if (armed && s_buf[INPUT_REPLAY_HDR_GAME] == game_index)
+    {
+        rng_set_seed(replay_get_u32(INPUT_REPLAY_HDR_SEED));
+        s_clock = replay_get_u32(INPUT_REPLAY_HDR_TICK);
+        s_pos = INPUT_REPLAY_HEADER_SIZE;
+        s_run_count = 0;
+        s_frames_delta = 0;
+        s_event_us = scheduler_get_time_us();
+        s_stats.bytes = s_record_len;
+        s_mode = INPUT_REPLAY_PLAYING;
+        return s_clock;
+    }
+
+    s_clock = live_tick + s_clock_offset;
+    if (s_auto_record)
+    {
+        replay_record_start(game_index, s_clock);
+    }
+    return s_clock;
+}
+
+/**
+ * @brief 游戏退出
+ */
+void input_replay_game_exit(uint32_t live_tick)
+{
+    if (s_mode == INPUT_REPLAY_RECORDING)
+    {
+        replay_record_stop(!replay_flush_run());
+    }
+    else if (s_mode == INPUT_REPLAY_PLAYING)
+    {
+        replay_play_stop(live_tick);
+    }
+}
+
+/**
+ * @brief 游戏帧开始
+ */
+uint32_t input_replay_frame_begin(uint32_t live_tick)
+{
+    uint32_t clock;
+    uint32_t delta;
+
+    if (s_mode == INPUT_REPLAY_PLAYING)
+    {
+        return replay_play_frame(live_tick);
+    }
+
+    clock = live_tick + s_clock_offset;
+    if (s_mode == INPUT_REPLAY_RECORDING)
+    {
+        // 和上一帧的增量相同就并进游程，否则先把攒着的写出去
+        delta = clock - s_clock;
+        if (s_run_count == 0 || delta != s_run_delta)
+        {
+            if (!replay_flush_run())
+            {
+                replay_record_stop(1);
+                return clock;
+            }
+            s_run_delta = delta;
+        }
+        s_run_count++;
+    }
+    s_clock = clock;
+    return clock;
+}
+
+/**
+ * @brief 游戏帧结束
+ */
+void input_replay_frame_end(uint32_t busy_us)
+{
+    if (busy_us > s_stats.max_frame_us)
+    {
+        s_stats.max_frame_us = busy_us;
+        s_stats.max_frame = s_stats.frames;
+    }
+    s_stats.busy_us += busy_us;
+    s_stats.frames++;
+    if (s_mode == INPUT_REPLAY_RECORDING)
+    {
+        s_stats.bytes = s_len;
+    }
+}
+
+/**
+ * @brief 录制一个改变了按键状态的事件
+ */
+void input_replay_record_event(const app_event_t *evt)
+{
+    uint8_t ok = 1;
+
+    if (s_mode != INPUT_REPLAY_RECORDING)
+    {
+        return;
+    }
+
+    // 一次调用里的第一个事件：先写出前面的帧，再打开批次
+    if (s_batch_pos == 0)
+    {
+        ok = replay_flush_run() && replay_open_batch(INPUT_REPLAY_TAG_BATCH);
+    }
+    else if (s_batch_count == INPUT_REPLAY_BATCH_MAX)
+    {
+        replay_close_batch();
+        ok = replay_open_batch(INPUT_REPLAY_TAG_MORE);
+    }
+
+    ok = ok && replay_put_varint(evt->source_id) &&
+         replay_put_varint(evt->event_type) &&
+         replay_put_varint(evt->data) &&
+         replay_put_varint(evt->timestamp_us - s_event_us);
+    if (!ok)
+    {
+        replay_record_stop(1);
+        return;
+    }
+    s_event_us = evt->timestamp_us;
+    s_batch_count++;
+    s_stats.events++;
+}
+
+/**
+ * @brief 一次 input_manager_task 调用结束
+ */
+void input_replay_record_batch(uint8_t had_edges)
+{
+    if (s_mode != INPUT_REPLAY_RECORDING)
+    {
+        return;
+    }
+
+    if (s_batch_pos != 0)
+    {
+        replay_close_batch();
+    }
+    else if (had_edges)
+    {
+        // 没有事件但清掉了边沿标志：游戏下一帧看到的状态不同，也要录
+        if (!replay_flush_run() || !replay_open_batch(INPUT_REPLAY_TAG_BATCH))
+        {
+            replay_record_stop(1);
+            return;
+        }
+        replay_close_batch();
+    }
+}
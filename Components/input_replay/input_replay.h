@@ -0,0 +1,167 @@
+#ifndef __INPUT_REPLAY_H__
+#define __INPUT_REPLAY_H__
+
+#include "event_queue.h" // app_event_t
+
+// =============================================================================
+// 输入录制回放 - 让一局游戏逐帧可复现
+// 职责：
+// 1. 游戏运行时录下 input_manager 处理过的输入事件、随机数种子和每帧的游戏时钟
+// 2. 回放时按游戏帧把录下的事件重新送进 input_manager，随机数和时钟也用录制的
+// 3. 统计每局的帧数和逻辑+渲染耗时，回放同一段录制就是可重复的性能基准
+//
+// 确定性来源（游戏只要遵守这三点，回放就逐帧相同）：
+// - 输入：只通过 input_manager 查询；
+// - 随机数：只通过 rng_driver（录制/回放时切到种子伪随机数）；
+// - 时间：只通过 game_manager_get_tick()（每帧开始时锁存的游戏时钟）。
+//
+// 录制格式（字节流，多字节整数都是 LEB128 变长编码）：
+//   头部     'I' 'R' 版本 游戏索引 种子(4字节小端) 开始时刻(4字节小端)
+//   0x01 d n  FRAMES：连续 n 帧，游戏时钟每帧前进 d 毫秒
+//   0x80|n-1  RUN：连续 n 帧（1~128），增量和上一个 FRAMES 相同
+//   0x10|n    BATCH：一次 input_manager_task 调用，先清边沿标志再处理 n 个事件（0~15）
+//   0x20|n    MORE：上一批的续批，一次调用超过15个事件时使用
+//             每个事件：来源ID 类型 数据 时间戳增量us
+//   0x00      END
+// 只录改变了按键状态的事件（HOLD/KEEPALIVE 不录）；正常 10ms 一帧时，
+// 两次输入之间的帧只占1个字节，一次按下大约10个字节。
+// =============================================================================
+
+// -----------------------------------------------------------------------------
+// 1. 配置
+// -----------------------------------------------------------------------------
+
+// 录制缓冲区大小（字节），写满后停止录制，已录的部分仍然可以回放
+#define INPUT_REPLAY_BUFFER_SIZE 4096
+
+// 每局游戏自动录制（像飞行记录仪一样，总是保留最近一局）
+#define INPUT_REPLAY_AUTO_RECORD 1
+
+// -----------------------------------------------------------------------------
+// 2. 数据结构
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 录制回放状态
+ */
+typedef enum
+{
+    INPUT_REPLAY_IDLE = 0,  /*!< 实时输入，没有录制 */
+    INPUT_REPLAY_RECORDING, /*!< 正在录制当前这局 */
+    INPUT_REPLAY_PLAYING,   /*!< 正在回放 */
+} input_replay_mode_t;
+
+/**
+ * @brief 一局游戏的统计（录制、回放和普通游戏都会统计，开始新的一局时清零）
+ */
+typedef struct
+{
+    uint32_t frames;       /*!< 游戏帧数 */
+    uint32_t events;       /*!< 录制/回放的事件数 */
+    uint32_t bytes;        /*!< 录制数据长度（字节，含头部） */
+    uint32_t busy_us;      /*!< 逻辑+渲染累计耗时（微秒） */
+    uint32_t max_frame_us; /*!< 最长一帧的耗时（微秒） */
+    uint32_t max_frame;    /*!< 最长一帧是第几帧（从0开始），用来定位卡顿 */
+    uint8_t truncated;     /*!< 录制缓冲区写满，后面的部分没有录下来 */
+} input_replay_stats_t;
+
+// -----------------------------------------------------------------------------
+// 3. API 声明
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 初始化录制回放模块
+ */
+void input_replay_init(void);
+
+/**
+ * @brief 获取当前状态
+ */
+input_replay_mode_t input_replay_get_mode(void);
+
+/**
+ * @brief 是否正在回放
+ * @note  回放时 input_manager_task 丢弃实时事件
+ */
+uint8_t input_replay_is_playing(void);
+
+/**
+ * @brief 开关自动录制
+ * @param enable: 1=每局游戏自动录制（默认 INPUT_REPLAY_AUTO_RECORD）, 0=不录制
+ */
+void input_replay_set_auto_record(uint8_t enable);
+
+/**
+ * @brief 准备回放缓冲区里的录制
+ * @retval 录制的游戏索引，录制无效或正在录制返回-1
+ * @note  调用者接着启动这个游戏（见 game_manager_start_replay），
+ *        游戏启动时 input_replay_game_start 进入回放
+ */
+int input_replay_arm_playback(void);
+
+/**
+ * @brief 载入外部保存的录制（如从 LittleFS 读回来的）
+ * @param data: 录制数据
+ * @param len: 长度
+ * @retval 0: 成功, -1: 格式错误或太长
+ */
+int input_replay_load(const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 获取最近一次录制的数据，用于保存
+ * @param data: 输出数据指针
+ * @param len: 输出长度，没有完整录制时为0
+ */
+void input_replay_get_record(const uint8_t **data, uint32_t *len);
+
+/**
+ * @brief 获取最近一局的统计
+ */
+void input_replay_get_stats(input_replay_stats_t *stats);
+
+// -----------------------------------------------------------------------------
+// 4. 钩子（game_manager / input_manager 调用）
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief 游戏开始（在游戏 init 之前调用）
+ * @param game_index: 游戏在注册表中的下标
+ * @param live_tick: 当前 HAL_GetTick()
+ * @retval 游戏时钟的起点：回放时是录制时的起点，否则接着实时时钟走
+ * @note  已准备回放时进入回放，否则按自动录制设置开始录制；两者都会设置随机数种子
+ */
+uint32_t input_replay_game_start(uint8_t game_index, uint32_t live_tick);
+
+/**
+ * @brief 游戏退出，结束录制或回放
+ * @param live_tick: 当前 HAL_GetTick()
+ */
+void input_replay_game_exit(uint32_t live_tick);
+
+/**
+ * @brief 游戏帧开始
+ * @param live_tick: 当前 HAL_GetTick()
+ * @retval 这一帧的游戏时钟
+ * @note  回放时先把这一帧之前录下的事件批次送进 input_manager
+ */
+uint32_t input_replay_frame_begin(uint32_t live_tick);
+
+/**
+ * @brief 游戏帧结束
+ * @param busy_us: 这一帧逻辑+渲染耗时
+ */
+void input_replay_frame_end(uint32_t busy_us);
+
+/**
+ * @brief 录制一个改变了按键状态的事件（input_manager_task 调用）
+ */
+void input_replay_record_event(const app_event_t *evt);
+
+/**
+ * @brief 一次 input_manager_task 调用结束（input_manager_task 调用）
+ * @param had_edges: 这次调用开始时清掉了边沿标志
+ * @note  清掉了边沿标志或者录了事件才写一批，否则这次调用对游戏没有影响
+ */
+void input_replay_record_batch(uint8_t had_edges);
+
+#endif // __INPUT_REPLAY_H__
@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file    layer.c
+ * @brief   静态背景层缓存组件实现
+ * @author  老王
+ * @note    缓存用uint32_t数组保证4字节对齐,memcpy可以按字复制
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "layer.h"
+#include <string.h>
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t s_cache[LAYER_BUF_SIZE / 4];  // 背景缓存
+static const void *s_owner = NULL;             // 缓存持有者,NULL表示缓存无效
+static uint8_t *s_saved_buf = NULL;            // 重定向期间保存的绘制缓冲
+static layer_stats_t s_stats;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t layer_size_ok(u8g2_t *u8g2);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 把缓存复制到绘制缓冲
+ */
+uint8_t layer_blit(u8g2_t *u8g2, const void *owner)
+{
+    if (owner == NULL || s_owner != owner || !layer_size_ok(u8g2))
+    {
+        return 0;
+    }
+
+    memcpy(u8g2_GetBufferPtr(u8g2), s_cache, LAYER_BUF_SIZE);
+    s_stats.blits++;
+    return 1;
+}
+
+/**
+ * @brief 开始整块重建缓存
+ */
+void layer_begin_rebuild(u8g2_t *u8g2, const void *owner)
+{
+    s_owner = NULL;
+    s_saved_buf = NULL;
+
+    if (layer_size_ok(u8g2))
+    {
+        s_saved_buf = u8g2->tile_buf_ptr;
+        u8g2->tile_buf_ptr = (uint8_t *)s_cache;
+        s_owner = owner;
+        s_stats.rebuilds++;
+    }
+
+    u8g2_ClearBuffer(u8g2);
+}
+
+/**
+ * @brief 开始局部更新缓存
+ */
+uint8_t layer_begin_update(u8g2_t *u8g2, const void *owner)
+{
+    if (owner == NULL || s_owner != owner || !layer_size_ok(u8g2))
+    {
+        return 0;
+    }
+
+    s_saved_buf = u8g2->tile_buf_ptr;
+    u8g2->tile_buf_ptr = (uint8_t *)s_cache;
+    s_stats.updates++;
+    return 1;
+}
+
+/**
+ * @brief 结束重建/更新,恢复绘制缓冲
+ */
+void layer_end(u8g2_t *u8g2)
+{
+    if (s_saved_buf != NULL)
+    {
+        u8g2->tile_buf_ptr = s_saved_buf;
+        s_saved_buf = NULL;
+    }
+}
+
+/**
+ * @brief 作废缓存
+ */
+void layer_invalidate(void)
+{
+    s_owner = NULL;
+}
+
+/**
+ * @brief 获取统计信息
+ */
+void layer_get_stats(layer_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = s_stats;
+    }
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 判断u8g2实例的缓冲大小和缓存是否一致
+ */
+static uint8_t layer_size_ok(u8g2_t *u8g2)
+{
+    return ((uint16_t)u8g2_GetBufferTileWidth(u8g2) * 8 * u8g2->tile_buf_height == LAYER_BUF_SIZE) ? 1 : 0;
+}
@@ -0,0 +1,110 @@
+/**
+ ******************************************************************************
+ * @file    layer.h
+ * @brief   静态背景层缓存组件头文件
+ * @author  老王
+ * @note    网格类游戏(吃豆人、俄罗斯方块、推箱子、扫雷)的地图每帧都要
+ *          逐格重画一遍,而大部分格子并没有变化
+ *          这个组件把背景画进一块缓存帧缓冲,每帧开头整块复制到绘制缓冲,
+ *          游戏只需要再画移动的角色
+ *
+ *          - 缓存只有一块,同一时间只属于一个游戏(owner),换游戏自动重建
+ *          - 画缓存的方法是把u8g2的tile_buf_ptr临时指向缓存,
+ *            所以背景仍然用u8g2的绘图函数画,和原来的代码一样
+ *          - 格子变化时用layer_begin_update()只重画这一格
+ *          - 加载关卡、消行等大范围变化调用layer_invalidate(),下一帧整块重建
+ *
+ *          典型用法:
+ *          @code
+ *          if (!layer_blit(u8g2, game)) {
+ *              layer_begin_rebuild(u8g2, game);
+ *              render_map(game, u8g2);
+ *              layer_end(u8g2);
+ *              layer_blit(u8g2, game);
+ *          }
+ *          render_player(game, u8g2);
+ *          @endcode
+ ******************************************************************************
+ */
+
+#ifndef __LAYER_H__
+#define __LAYER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "u8g2.h"
+
+/* Exported defines ----------------------------------------------------------*/
+/**
+ * @brief 缓存大小(字节)
+ * @note  和u8g2全缓冲一样大(128x64单色),缓冲大小不同的实例不使用缓存
+ */
+#define LAYER_BUF_SIZE      (128 * 64 / 8)
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 背景层统计信息
+ */
+typedef struct {
+    uint32_t rebuilds;      // 整块重建次数
+    uint32_t updates;       // 局部更新次数
+    uint32_t blits;         // 复制到绘制缓冲的次数
+} layer_stats_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 把缓存复制到绘制缓冲
+ * @param u8g2 u8g2实例
+ * @param owner 缓存持有者(一般传游戏实例指针)
+ * @return 1=已复制,代替了u8g2_ClearBuffer();0=缓存无效或不属于owner,需要重建
+ */
+uint8_t layer_blit(u8g2_t *u8g2, const void *owner);
+
+/**
+ * @brief 开始整块重建缓存
+ * @param u8g2 u8g2实例
+ * @param owner 缓存的新持有者
+ * @note  清空缓存并把绘制重定向到缓存,之后画的内容都进缓存,
+ *        画完必须调用layer_end()
+ *        缓冲大小不符时不重定向,直接清空并画到绘制缓冲,调用方的写法不用变
+ */
+void layer_begin_rebuild(u8g2_t *u8g2, const void *owner);
+
+/**
+ * @brief 开始局部更新缓存
+ * @param u8g2 u8g2实例
+ * @param owner 缓存持有者
+ * @return 1=已重定向到缓存,画完必须调用layer_end();
+ *         0=缓存无效或不属于owner,什么都不用画(下次blit时会整块重建)
+ * @note  更新前要先用背景色擦掉变化的区域
+ */
+uint8_t layer_begin_update(u8g2_t *u8g2, const void *owner);
+
+/**
+ * @brief 结束重建/更新,恢复绘制缓冲
+ * @param u8g2 u8g2实例
+ */
+void layer_end(u8g2_t *u8g2);
+
+/**
+ * @brief 作废缓存
+ * @note  加载关卡、消行等大范围变化后调用,下一次layer_blit()返回0
+ */
+void layer_invalidate(void);
+
+/**
+ * @brief 获取统计信息
+ * @param stats 输出统计信息
+ */
+void layer_get_stats(layer_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LAYER_H__ */
@@ -1,4 +1,5 @@
 #include "menu_render.h"
+#include "display_service.h"
 #include <string.h>
 
 // =============================================================================
@@ -84,8 +85,8 @@ void menu_render_u8g2_default(menu_instance_t *menu)
         render_scrollbar(menu);
     }
 
-    // 发送到屏幕
-    u8g2_SendBuffer(g_u8g2);
+    // 交给显示服务发送
+    display_service_mark_ready();
 }
 
 /**
@@ -0,0 +1,387 @@
+/**
+ ******************************************************************************
+ * @file    perf_hud.c
+ * @brief   性能浮层(HUD)组件实现
+ * @author  老王
+ * @note    计时只是读两次DWT->CYCCNT再累加,浮层打开与否都在统计,
+ *          可以一直开着
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "perf_hud.h"
+#include "display_service.h"
+#include "event_queue.h"
+#include "input_manager.h"
+#include "scheduler.h"
+#include "uart_driver.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define PERF_HUD_CHARSET        " .%0123456789CFLRS"  /* 浮层用到的全部字符 */
+#define PERF_HUD_GLYPH_COUNT    (sizeof(PERF_HUD_CHARSET) - 1)
+#define PERF_HUD_GLYPH_W        4                       /* u8g2_font_4x6是等宽字体 */
+#define PERF_HUD_GLYPH_BASELINE 5
+#define PERF_HUD_STRIP_W        128                     /* 一页的字节数(屏幕宽度) */
+
+/* Private types -------------------------------------------------------------*/
+/**
+ * @brief 一个阶段在当前窗口里的累加值
+ */
+typedef struct {
+    uint32_t calls;
+    uint32_t cycles;
+    uint32_t max_cycles;
+} perf_acc_t;
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t s_glyph[PERF_HUD_GLYPH_COUNT][PERF_HUD_GLYPH_W];  // 字形缓存(页格式)
+static uint8_t s_strip[PERF_HUD_STRIP_W];     // 拼好的浮层(一页)
+static uint8_t s_saved[PERF_HUD_STRIP_W];     // 发送期间被浮层盖住的原内容
+static uint8_t s_overlaid = 0;                // 当前绘制缓冲里是否放着浮层
+static uint8_t s_enabled = 0;
+static uint8_t s_uart_dump = 0;
+
+static perf_acc_t s_acc[PERF_PHASE_COUNT];    // 当前窗口的累加值
+static uint32_t s_window_start_tick = 0;
+static uint32_t s_window_start_us = 0;       // 窗口开始时间(调度器时基,休眠时也走)
+static uint32_t s_window_start_busy = 0;
+static uint32_t s_window_start_idle = 0;
+static uint32_t s_window_start_frames = 0;
+static perf_hud_stats_t s_stats;              // 上一个窗口的统计
+
+/* Private function prototypes -----------------------------------------------*/
+static void perf_hud_cache_glyphs(u8g2_t *u8g2);
+static void perf_hud_close_window(void);
+static void perf_hud_compose(void);
+static uint32_t perf_hud_presented_frames(void);
+static uint32_t perf_hud_cycles_to_us(uint32_t cycles);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 初始化性能浮层
+ */
+void perf_hud_init(u8g2_t *u8g2)
+{
+    /* 打开DWT周期计数器 */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    memset(s_acc, 0, sizeof(s_acc));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_enabled = 0;
+    s_uart_dump = 0;
+    s_overlaid = 0;
+
+    s_window_start_tick = HAL_GetTick();
+    s_window_start_us = scheduler_get_time_us();
+    s_window_start_busy = scheduler_get_busy_cycles();
+    s_window_start_idle = scheduler_get_idle_us();
+    s_window_start_frames = perf_hud_presented_frames();
+
+    perf_hud_cache_glyphs(u8g2);
+    perf_hud_compose();
+}
+
+/**
+ * @brief 性能浮层任务
+ */
+void perf_hud_task(void)
+{
+    if (input_is_double_click(INPUT_BTN_X))
+    {
+        perf_hud_set_enabled(!s_enabled);
+    }
+
+    if (HAL_GetTick() - s_window_start_tick < PERF_HUD_WINDOW_MS)
+    {
+        return;
+    }
+
+    perf_hud_close_window();
+
+    if (s_enabled)
+    {
+        /* 数字变了:重新拼一行,并让显示服务发一帧(画面本身可能没有变化) */
+        perf_hud_compose();
+        display_service_mark_ready();
+    }
+
+    if (s_uart_dump)
+    {
+        perf_hud_dump();
+        perf_hud_dump_tasks();
+    }
+}
+
+/**
+ * @brief 结束计时,累加到阶段统计
+ */
+void perf_hud_end(perf_phase_t phase, uint32_t start)
+{
+    uint32_t cycles = DWT->CYCCNT - start;
+    perf_acc_t *acc = &s_acc[phase];
+
+    acc->calls++;
+    acc->cycles += cycles;
+    if (cycles > acc->max_cycles)
+    {
+        acc->max_cycles = cycles;
+    }
+}
+
+/**
+ * @brief 把浮层放进绘制缓冲
+ */
+void perf_hud_overlay_begin(u8g2_t *u8g2)
+{
+    uint8_t *page;
+
+    if (!s_enabled || u8g2_GetBufferTileWidth(u8g2) * 8 != PERF_HUD_STRIP_W ||
+        u8g2->tile_buf_height <= PERF_HUD_PAGE)
+    {
+        return;
+    }
+
+    page = u8g2_GetBufferPtr(u8g2) + PERF_HUD_PAGE * PERF_HUD_STRIP_W;
+    memcpy(s_saved, page, PERF_HUD_STRIP_W);
+    memcpy(page, s_strip, PERF_HUD_STRIP_W);
+    s_overlaid = 1;
+}
+
+/**
+ * @brief 恢复被浮层盖住的一页
+ */
+void perf_hud_overlay_end(u8g2_t *u8g2)
+{
+    if (!s_overlaid)
+    {
+        return;
+    }
+
+    memcpy(u8g2_GetBufferPtr(u8g2) + PERF_HUD_PAGE * PERF_HUD_STRIP_W, s_saved, PERF_HUD_STRIP_W);
+    s_overlaid = 0;
+}
+
+/**
+ * @brief 打开/关闭浮层
+ */
+void perf_hud_set_enabled(uint8_t enable)
+{
+    enable = enable ? 1 : 0;
+    if (enable == s_enabled)
+    {
+        return;
+    }
+
+    s_enabled = enable;
+    perf_hud_compose();
+
+    /* 浮层不在绘制缓冲里,重新发一帧才能显示/擦掉 */
+    display_service_mark_ready();
+}
+
+/**
+ * @brief 浮层是否打开
+ */
+uint8_t perf_hud_is_enabled(void)
+{
+    return s_enabled;
+}
+
+/**
+ * @brief 打开/关闭每个窗口的串口输出
+ */
+void perf_hud_set_uart_dump(uint8_t enable)
+{
+    s_uart_dump = enable ? 1 : 0;
+}
+
+/**
+ * @brief 从USART1输出上一个窗口的统计
+ */
+void perf_hud_dump(void)
+{
+    static const char *const names[PERF_PHASE_COUNT] = { "logic", "render", "flush" };
+    char line[320];
+    event_queue_stats_t evq;
+    input_latency_stats_t lat;
+    int len;
+
+    event_queue_get_stats(&evq);
+    input_manager_get_latency_stats(&lat);
+    len = snprintf(line, sizeof(line), "[PERF] fps=%u load=%u idle=%u evq_hw=%lu evq_drop=%lu evq_drop_rep=%lu evq_coal=%lu"
+                   " in_lat_avg=%lu in_lat_max=%lu in_lat_n=%lu",
+                   s_stats.fps, s_stats.load_permille, s_stats.idle_permille,
+                   evq.high_water, evq.dropped, evq.dropped_repeat, evq.coalesced,
+                   lat.avg_us, lat.max_us, lat.count);
+    for (uint8_t i = 0; i < PERF_PHASE_COUNT && len > 0 && len < (int)sizeof(line); i++)
+    {
+        len += snprintf(line + len, sizeof(line) - len, " %s_avg=%lu %s_max=%lu %s_n=%lu",
+                        names[i], s_stats.phase[i].avg_us,
+                        names[i], s_stats.phase[i].max_us,
+                        names[i], s_stats.phase[i].calls);
+    }
+
+    my_printf(&huart1, "%s\r\n", line);
+}
+
+/**
+ * @brief 从USART1输出每个调度器任务的统计
+ */
+void perf_hud_dump_tasks(void)
+{
+    uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    scheduler_task_stats_t stats;
+
+    for (uint8_t i = 0; i < scheduler_get_task_count(); i++)
+    {
+        char hist[SCHEDULER_HIST_BINS * 11 + 1];
+        int len = 0;
+
+        if (!scheduler_get_task_stats(i, &stats) || stats.runs == 0)
+        {
+            continue;
+        }
+
+        for (uint8_t b = 0; b < SCHEDULER_HIST_BINS && len < (int)sizeof(hist); b++)
+        {
+            len += snprintf(hist + len, sizeof(hist) - len, b ? ",%lu" : "%lu", stats.hist[b]);
+        }
+
+        my_printf(&huart1, "[TASK] name=%s rate=%lu runs=%lu min=%lu avg=%lu max=%lu "
+                  "late_avg=%lu late_max=%lu missed=%lu load=%u hist=%s\r\n",
+                  stats.name != NULL ? stats.name : "?", stats.rate_ms, stats.runs,
+                  stats.min_cycles / cycles_per_us,
+                  (uint32_t)(stats.total_cycles / stats.runs / cycles_per_us),
+                  stats.max_cycles / cycles_per_us,
+                  stats.total_late_ms / stats.runs, stats.max_late_ms, stats.missed,
+                  scheduler_get_task_load_permille(i), hist);
+    }
+}
+
+/**
+ * @brief 获取上一个窗口的统计
+ */
+void perf_hud_get_stats(perf_hud_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = s_stats;
+    }
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 光栅化并缓存字形
+ * @note  把绘制缓冲临时指向s_strip,裁剪窗口限制在第一页里,
+ *        整个字符集一次画出来,每个字形正好占PERF_HUD_GLYPH_W列
+ */
+static void perf_hud_cache_glyphs(u8g2_t *u8g2)
+{
+    uint8_t *saved_buf = u8g2->tile_buf_ptr;
+
+    memset(s_strip, 0, sizeof(s_strip));
+    u8g2->tile_buf_ptr = s_strip;
+    u8g2_SetClipWindow(u8g2, 0, 0, PERF_HUD_STRIP_W, 8);
+    u8g2_SetFont(u8g2, u8g2_font_4x6_tf);
+    u8g2_SetFontMode(u8g2, 1);
+    u8g2_SetDrawColor(u8g2, 1);
+    u8g2_DrawStr(u8g2, 0, PERF_HUD_GLYPH_BASELINE, PERF_HUD_CHARSET);
+    u8g2_SetMaxClipWindow(u8g2);
+    u8g2->tile_buf_ptr = saved_buf;
+
+    for (uint8_t i = 0; i < PERF_HUD_GLYPH_COUNT; i++)
+    {
+        memcpy(s_glyph[i], s_strip + i * PERF_HUD_GLYPH_W, PERF_HUD_GLYPH_W);
+    }
+}
+
+/**
+ * @brief 结束一个统计窗口
+ */
+static void perf_hud_close_window(void)
+{
+    uint32_t now_tick = HAL_GetTick();
+    uint32_t now_us = scheduler_get_time_us();
+    uint32_t now_busy = scheduler_get_busy_cycles();
+    uint32_t now_idle = scheduler_get_idle_us();
+    uint32_t now_frames = perf_hud_presented_frames();
+    uint32_t elapsed_ms = now_tick - s_window_start_tick;
+    uint32_t window_us = now_us - s_window_start_us;
+
+    /* DWT在WFI休眠时停止计数,窗口长度用调度器的微秒时基换算成周期 */
+    s_stats.fps = (uint16_t)((now_frames - s_window_start_frames) * 1000 / elapsed_ms);
+    s_stats.load_permille = (window_us == 0) ? 0 :
+        (uint16_t)((uint64_t)(now_busy - s_window_start_busy) * 1000 /
+                   ((uint64_t)window_us * (SystemCoreClock / 1000000)));
+    s_stats.idle_permille = (window_us == 0) ? 0 :
+        (uint16_t)((uint64_t)(now_idle - s_window_start_idle) * 1000 / window_us);
+
+    for (uint8_t i = 0; i < PERF_PHASE_COUNT; i++)
+    {
+        perf_phase_stats_t *out = &s_stats.phase[i];
+
+        out->calls = s_acc[i].calls;
+        out->avg_us = (s_acc[i].calls == 0) ? 0 : perf_hud_cycles_to_us(s_acc[i].cycles / s_acc[i].calls);
+        out->max_us = perf_hud_cycles_to_us(s_acc[i].max_cycles);
+    }
+
+    memset(s_acc, 0, sizeof(s_acc));
+    s_window_start_tick = now_tick;
+    s_window_start_us = now_us;
+    s_window_start_busy = now_busy;
+    s_window_start_idle = now_idle;
+    s_window_start_frames = now_frames;
+}
+
+/**
+ * @brief 用缓存的字形拼出浮层的一行
+ * @note  时间显示为ms,两位小数;负载显示为整数百分比
+ */
+static void perf_hud_compose(void)
+{
+    char text[PERF_HUD_STRIP_W / PERF_HUD_GLYPH_W + 1];
+    uint8_t x = 0;
+
+    snprintf(text, sizeof(text), "F%u L%lu.%02lu R%lu.%02lu S%lu.%02lu C%u%%",
+             s_stats.fps,
+             s_stats.phase[PERF_PHASE_LOGIC].avg_us / 1000, (s_stats.phase[PERF_PHASE_LOGIC].avg_us / 10) % 100,
+             s_stats.phase[PERF_PHASE_RENDER].avg_us / 1000, (s_stats.phase[PERF_PHASE_RENDER].avg_us / 10) % 100,
+             s_stats.phase[PERF_PHASE_FLUSH].avg_us / 1000, (s_stats.phase[PERF_PHASE_FLUSH].avg_us / 10) % 100,
+             (s_stats.load_permille + 5) / 10);
+
+    memset(s_strip, 0, sizeof(s_strip));
+    for (const char *c = text; *c != '\0' && x + PERF_HUD_GLYPH_W <= PERF_HUD_STRIP_W; c++)
+    {
+        const char *g = strchr(PERF_HUD_CHARSET, *c);
+
+        if (g != NULL)
+        {
+            memcpy(s_strip + x, s_glyph[g - PERF_HUD_CHARSET], PERF_HUD_GLYPH_W);
+        }
+        x += PERF_HUD_GLYPH_W;
+    }
+}
+
+/**
+ * @brief 显示服务处理过的帧数(发送的和内容没变化跳过的)
+ */
+static uint32_t perf_hud_presented_frames(void)
+{
+    display_service_stats_t stats;
+
+    display_service_get_stats(&stats);
+    return stats.frames_flushed + stats.frames_unchanged;
+}
+
+/**
+ * @brief CPU周期换算成us
+ */
+static uint32_t perf_hud_cycles_to_us(uint32_t cycles)
+{
+    return cycles / (SystemCoreClock / 1000000);
+}
@@ -0,0 +1,172 @@
+/**
+ ******************************************************************************
+ * @file    perf_hud.h
+ * @brief   性能浮层(HUD)组件头文件
+ * @author  老王
+ * @note    用Cortex-M4的DWT周期计数器统计游戏逻辑、渲染和发送的耗时,
+ *          叠加显示在屏幕顶部一行,游戏和菜单下都可以打开
+ *
+ *          F30 L0.41 R1.20 S0.35 C23%
+ *          F=帧率 L=游戏逻辑 R=渲染 S=发送(ms/次) C=调度器负载
+ *
+ *          - 统计按PERF_HUD_WINDOW_MS为一个窗口,每个窗口更新一次显示
+ *          - 字形在初始化时用u8g2字体光栅化一次缓存起来,
+ *            之后每个窗口只是按字节拼一行,每帧只复制一页128字节
+ *          - 浮层只在发送期间放进绘制缓冲,发完恢复原内容,
+ *            不会留在游戏或菜单的画面里
+ *          - 每个窗口的统计也可以按key=value格式从USART1输出,
+ *            同时输出每个调度器任务的执行时间统计
+ ******************************************************************************
+ */
+
+#ifndef __PERF_HUD_H__
+#define __PERF_HUD_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "main.h"
+#include "u8g2.h"
+
+/* Exported defines ----------------------------------------------------------*/
+/**
+ * @brief 统计窗口长度(ms)
+ */
+#define PERF_HUD_WINDOW_MS          1000
+
+/**
+ * @brief 浮层所在的页(0=最上面8行,7=最下面8行)
+ */
+#define PERF_HUD_PAGE               0
+
+/**
+ * @brief 性能浮层任务的调度周期(ms)
+ * @note  需要和input_manager_task相同,才能收到切换浮层的按键
+ */
+#define PERF_HUD_TASK_PERIOD_MS     10
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 计时的阶段
+ */
+typedef enum {
+    PERF_PHASE_LOGIC = 0,   // 游戏task(输入+逻辑)
+    PERF_PHASE_RENDER,      // 游戏render
+    PERF_PHASE_FLUSH,       // 显示服务发送一帧
+    PERF_PHASE_COUNT
+} perf_phase_t;
+
+/**
+ * @brief 一个阶段在一个窗口里的统计
+ */
+typedef struct {
+    uint32_t calls;         // 调用次数
+    uint32_t avg_us;        // 平均每次耗时(us)
+    uint32_t max_us;        // 最长一次耗时(us)
+} perf_phase_stats_t;
+
+/**
+ * @brief 上一个窗口的统计
+ */
+typedef struct {
+    uint16_t fps;                                   // 显示服务每秒处理的帧数(含内容没变化的帧)
+    uint16_t load_permille;                         // 调度器负载(千分比,任务执行时间)
+    uint16_t idle_permille;                         // CPU空闲率(千分比,WFI休眠时间)
+    perf_phase_stats_t phase[PERF_PHASE_COUNT];     // 各阶段耗时
+} perf_hud_stats_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 初始化性能浮层
+ * @param u8g2 用来光栅化字形的u8g2实例
+ * @note  打开DWT周期计数器,必须在u8g2_component_init()之后调用
+ */
+void perf_hud_init(u8g2_t *u8g2);
+
+/**
+ * @brief 性能浮层任务
+ * @note  注册到调度器,周期PERF_HUD_TASK_PERIOD_MS
+ *        X键双击切换浮层;窗口结束时更新统计、刷新浮层、按需从串口输出
+ */
+void perf_hud_task(void);
+
+/**
+ * @brief 开始计时
+ * @return 当前DWT周期计数,传给perf_hud_end()
+ */
+static inline uint32_t perf_hud_begin(void)
+{
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief 结束计时,累加到阶段统计
+ * @param phase 阶段
+ * @param start perf_hud_begin()的返回值
+ */
+void perf_hud_end(perf_phase_t phase, uint32_t start);
+
+/**
+ * @brief 把浮层放进绘制缓冲
+ * @param u8g2 u8g2实例
+ * @note  由显示服务在发送前调用,被盖住的一页先保存起来
+ */
+void perf_hud_overlay_begin(u8g2_t *u8g2);
+
+/**
+ * @brief 恢复被浮层盖住的一页
+ * @param u8g2 u8g2实例
+ * @note  由显示服务在发送后调用
+ */
+void perf_hud_overlay_end(u8g2_t *u8g2);
+
+/**
+ * @brief 打开/关闭浮层
+ * @param enable 1=显示,0=隐藏
+ * @note  统计一直在进行,关闭浮层只是不显示
+ */
+void perf_hud_set_enabled(uint8_t enable);
+
+/**
+ * @brief 浮层是否打开
+ */
+uint8_t perf_hud_is_enabled(void);
+
+/**
+ * @brief 打开/关闭每个窗口的串口输出
+ * @param enable 1=每个窗口结束时调用一次perf_hud_dump()
+ */
+void perf_hud_set_uart_dump(uint8_t enable);
+
+/**
+ * @brief 从USART1输出上一个窗口的统计
+ * @note  一行key=value,方便脚本解析,时间单位us,load和idle单位千分比:
+ *        [PERF] fps=30 load=234 idle=752 logic_avg=41 logic_max=98 logic_n=100 render_avg=1203 ...
+ *        每个阶段输出平均耗时(_avg)、最长耗时(_max)和调用次数(_n)
+ */
+void perf_hud_dump(void);
+
+/**
+ * @brief 从USART1输出每个调度器任务的统计
+ * @note  每个任务一行,时间单位us,load单位千分比(上次scheduler_reset_stats()以来):
+ *        [TASK] name=game rate=10 runs=100 min=35 avg=410 max=2210 late_avg=0 late_max=1
+ *               missed=0 load=41 hist=0,0,0,0,0,0,12,40,...
+ *        hist是log2分桶的执行时间直方图,见SCHEDULER_HIST_BINS
+ */
+void perf_hud_dump_tasks(void);
+
+/**
+ * @brief 获取上一个窗口的统计
+ * @param stats 输出统计信息
+ */
+void perf_hud_get_stats(perf_hud_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PERF_HUD_H__ */
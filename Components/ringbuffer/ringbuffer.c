@@ -36,7 +36,7 @@ static rt_inline enum rt_ringbuffer_state rt_ringbuffer_status(struct rt_ringbuf
  */
 void rt_ringbuffer_init(struct rt_ringbuffer *rb,
                         rt_uint8_t           *pool,
-                        rt_int16_t            size)
+                        rt_int32_t            size)
 {
     RT_ASSERT(rb != NULL);
     RT_ASSERT(size > 0);
@@ -62,9 +62,9 @@ void rt_ringbuffer_init(struct rt_ringbuffer *rb,
  */
 rt_size_t rt_ringbuffer_put(struct rt_ringbuffer *rb,
                             const rt_uint8_t     *ptr,
-                            rt_uint16_t           length)
+                            rt_uint32_t           length)
 {
-    rt_uint16_t size;
+    rt_uint32_t size;
 
     RT_ASSERT(rb != RT_NULL);
 
@@ -79,7 +79,7 @@ rt_size_t rt_ringbuffer_put(struct rt_ringbuffer *rb,
     if (size < length)
         length = size;
 
-    if (rb->buffer_size - rb->write_index > length)
+    if ((rt_uint32_t)rb->buffer_size - rb->write_index > length)
     {
         /* read_index - write_index = empty space */
         rt_memcpy(&rb->buffer_ptr[rb->write_index], ptr, length);
@@ -115,21 +115,21 @@ rt_size_t rt_ringbuffer_put(struct rt_ringbuffer *rb,
  */
 rt_size_t rt_ringbuffer_put_force(struct rt_ringbuffer *rb,
                                   const rt_uint8_t     *ptr,
-                                  rt_uint16_t           length)
+                                  rt_uint32_t           length)
 {
-    rt_uint16_t space_length;
+    rt_uint32_t space_length;
 
     RT_ASSERT(rb != RT_NULL);
 
     space_length = rt_ringbuffer_space_len(rb);
 
-    if (length > rb->buffer_size)
+    if (length > (rt_uint32_t)rb->buffer_size)
     {
         ptr = &ptr[length - rb->buffer_size];
         length = rb->buffer_size;
     }
 
-    if (rb->buffer_size - rb->write_index > length)
+    if ((rt_uint32_t)rb->buffer_size - rb->write_index > length)
     {
         /* read_index - write_index = empty space */
         rt_memcpy(&rb->buffer_ptr[rb->write_index], ptr, length);
@@ -176,7 +176,7 @@ rt_size_t rt_ringbuffer_put_force(struct rt_ringbuffer *rb,
  */
 rt_size_t rt_ringbuffer_get(struct rt_ringbuffer *rb,
                             rt_uint8_t           *ptr,
-                            rt_uint16_t           length)
+                            rt_uint32_t           length)
 {
     rt_size_t size;
 
@@ -193,7 +193,7 @@ rt_size_t rt_ringbuffer_get(struct rt_ringbuffer *rb,
     if (size < length)
         length = size;
 
-    if (rb->buffer_size - rb->read_index > length)
+    if ((rt_uint32_t)rb->buffer_size - rb->read_index > length)
     {
         /* copy all of data */
         rt_memcpy(ptr, &rb->buffer_ptr[rb->read_index], length);
@@ -261,6 +261,123 @@ rt_size_t rt_ringbuffer_peek(struct rt_ringbuffer *rb, rt_uint8_t **ptr)
 }
 //RTM_EXPORT(rt_ringbuffer_peek);
 
+/**
+ * @brief Get the free space of the ring buffer as up to two contiguous regions, without copying.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param span      When this function return, span describes the free space: span->ptr[0]/len[0]
+ *                  starts at the write index, span->ptr[1]/len[1] is the part that wraps to the
+ *                  start of the pool (len[1] is 0 if it does not wrap).
+ *
+ * @note Write into the regions in order, then call rt_ringbuffer_commit() with the number of
+ *       bytes written. Nothing is visible to the reader before the commit.
+ *
+ * @return Return the total free space in bytes (len[0] + len[1]).
+ */
+rt_size_t rt_ringbuffer_reserve(struct rt_ringbuffer *rb, struct rt_ringbuffer_span *span)
+{
+    rt_uint32_t size;
+    rt_uint32_t first;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(span != RT_NULL);
+
+    size = rt_ringbuffer_space_len(rb);
+    first = rb->buffer_size - rb->write_index;
+    if (first > size)
+        first = size;
+
+    span->ptr[0] = &rb->buffer_ptr[rb->write_index];
+    span->len[0] = first;
+    span->ptr[1] = &rb->buffer_ptr[0];
+    span->len[1] = size - first;
+
+    return size;
+}
+//RTM_EXPORT(rt_ringbuffer_reserve);
+
+/**
+ * @brief Publish bytes written into the regions returned by rt_ringbuffer_reserve().
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param length    The number of bytes written, at most the size returned by rt_ringbuffer_reserve().
+ */
+void rt_ringbuffer_commit(struct rt_ringbuffer *rb, rt_uint32_t length)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(length <= rt_ringbuffer_space_len(rb));
+
+    if ((rt_uint32_t)rb->buffer_size - rb->write_index > length)
+    {
+        rb->write_index += length;
+        return;
+    }
+
+    /* we are going into the other side of the mirror */
+    rb->write_mirror = ~rb->write_mirror;
+    rb->write_index = length - (rb->buffer_size - rb->write_index);
+}
+//RTM_EXPORT(rt_ringbuffer_commit);
+
+/**
+ * @brief Get the readable data of the ring buffer as up to two contiguous regions, without copying.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param span      When this function return, span describes the data: span->ptr[0]/len[0]
+ *                  starts at the read index, span->ptr[1]/len[1] is the part that wraps to the
+ *                  start of the pool (len[1] is 0 if it does not wrap).
+ *
+ * @note Unlike rt_ringbuffer_peek() this does not move the read index. Call
+ *       rt_ringbuffer_consume() once the data (or part of it) is no longer needed, e.g. when
+ *       a DMA transfer started from span->ptr[0] has completed.
+ *
+ * @return Return the total data size in bytes (len[0] + len[1]).
+ */
+rt_size_t rt_ringbuffer_span(struct rt_ringbuffer *rb, struct rt_ringbuffer_span *span)
+{
+    rt_uint32_t size;
+    rt_uint32_t first;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(span != RT_NULL);
+
+    size = rt_ringbuffer_data_len(rb);
+    first = rb->buffer_size - rb->read_index;
+    if (first > size)
+        first = size;
+
+    span->ptr[0] = &rb->buffer_ptr[rb->read_index];
+    span->len[0] = first;
+    span->ptr[1] = &rb->buffer_ptr[0];
+    span->len[1] = size - first;
+
+    return size;
+}
+//RTM_EXPORT(rt_ringbuffer_span);
+
+/**
+ * @brief Release bytes read from the regions returned by rt_ringbuffer_span().
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param length    The number of bytes consumed, at most the size returned by rt_ringbuffer_span().
+ */
+void rt_ringbuffer_consume(struct rt_ringbuffer *rb, rt_uint32_t length)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(length <= rt_ringbuffer_data_len(rb));
+
+    if ((rt_uint32_t)rb->buffer_size - rb->read_index > length)
+    {
+        rb->read_index += length;
+        return;
+    }
+
+    /* we are going into the other side of the mirror */
+    rb->read_mirror = ~rb->read_mirror;
+    rb->read_index = length - (rb->buffer_size - rb->read_index);
+}
+//RTM_EXPORT(rt_ringbuffer_consume);
+
 /**
  * @brief Put a byte into the ring buffer. If ring buffer is full, this operation will fail.
  *
@@ -422,7 +539,7 @@ void rt_ringbuffer_reset(struct rt_ringbuffer *rb)
  *
  * @return Return a pointer to ring buffer object. When the return value is RT_NULL, it means this creation failed.
  */
-struct rt_ringbuffer *rt_ringbuffer_create(rt_uint16_t size)
+struct rt_ringbuffer *rt_ringbuffer_create(rt_uint32_t size)
 {
     struct rt_ringbuffer *rb;
     rt_uint8_t *pool;
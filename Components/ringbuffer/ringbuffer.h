@@ -21,6 +21,8 @@ extern "C" {
 typedef uint8_t     rt_uint8_t;
 typedef uint16_t    rt_uint16_t;
 typedef int16_t     rt_int16_t;
+typedef uint32_t    rt_uint32_t;
+typedef int32_t     rt_int32_t;
 typedef size_t      rt_size_t;
 
 #define RT_ASSERT   assert
@@ -52,17 +54,30 @@ struct rt_ringbuffer
      * +---+---+---+---+---+---+---+|+~~~+~~~+~~~+~~~+~~~+~~~+~~~+
      * read_idx-^ ^-write_idx
      *
-     * The tradeoff is we could only use 32KiB of buffer for 16 bit of index.
-     * But it should be enough for most of the cases.
+     * The tradeoff is we could only use 2GiB of buffer for 32 bit of index.
+     * The read side and the write side each live in their own 32 bit word,
+     * so a producer and a consumer never read-modify-write each other's
+     * index.
      *
      * Ref: http://en.wikipedia.org/wiki/Circular_buffer#Mirroring */
-    rt_uint16_t read_mirror : 1;
-    rt_uint16_t read_index : 15;
-    rt_uint16_t write_mirror : 1;
-    rt_uint16_t write_index : 15;
+    rt_uint32_t read_mirror : 1;
+    rt_uint32_t read_index : 31;
+    rt_uint32_t write_mirror : 1;
+    rt_uint32_t write_index : 31;
     /* as we use msb of index as mirror bit, the size should be signed and
      * could only be positive. */
-    rt_int16_t buffer_size;
+    rt_int32_t buffer_size;
+};
+
+/*
+ * Up to two contiguous regions of a ring buffer. When the region wraps
+ * around the end of the pool, ptr[1]/len[1] is the part at the start of
+ * the pool; otherwise len[1] is 0.
+ */
+struct rt_ringbuffer_span
+{
+    rt_uint8_t *ptr[2];
+    rt_uint32_t len[2];
 };
 
 enum rt_ringbuffer_state
@@ -79,19 +94,25 @@ enum rt_ringbuffer_state
  * Please note that the ring buffer implementation of RT-Thread
  * has no thread wait or resume feature.
  */
-void rt_ringbuffer_init(struct rt_ringbuffer *rb, rt_uint8_t *pool, rt_int16_t size);
+void rt_ringbuffer_init(struct rt_ringbuffer *rb, rt_uint8_t *pool, rt_int32_t size);
 void rt_ringbuffer_reset(struct rt_ringbuffer *rb);
-rt_size_t rt_ringbuffer_put(struct rt_ringbuffer *rb, const rt_uint8_t *ptr, rt_uint16_t length);
-rt_size_t rt_ringbuffer_put_force(struct rt_ringbuffer *rb, const rt_uint8_t *ptr, rt_uint16_t length);
+rt_size_t rt_ringbuffer_put(struct rt_ringbuffer *rb, const rt_uint8_t *ptr, rt_uint32_t length);
+rt_size_t rt_ringbuffer_put_force(struct rt_ringbuffer *rb, const rt_uint8_t *ptr, rt_uint32_t length);
 rt_size_t rt_ringbuffer_putchar(struct rt_ringbuffer *rb, const rt_uint8_t ch);
 rt_size_t rt_ringbuffer_putchar_force(struct rt_ringbuffer *rb, const rt_uint8_t ch);
-rt_size_t rt_ringbuffer_get(struct rt_ringbuffer *rb, rt_uint8_t *ptr, rt_uint16_t length);
+rt_size_t rt_ringbuffer_get(struct rt_ringbuffer *rb, rt_uint8_t *ptr, rt_uint32_t length);
 rt_size_t rt_ringbuffer_peek(struct rt_ringbuffer *rb, rt_uint8_t **ptr);
 rt_size_t rt_ringbuffer_getchar(struct rt_ringbuffer *rb, rt_uint8_t *ch);
 rt_size_t rt_ringbuffer_data_len(struct rt_ringbuffer *rb);
 
+/* zero-copy access: fill/drain the pool in place (e.g. by DMA), then commit/consume */
+rt_size_t rt_ringbuffer_reserve(struct rt_ringbuffer *rb, struct rt_ringbuffer_span *span);
+void rt_ringbuffer_commit(struct rt_ringbuffer *rb, rt_uint32_t length);
+rt_size_t rt_ringbuffer_span(struct rt_ringbuffer *rb, struct rt_ringbuffer_span *span);
+void rt_ringbuffer_consume(struct rt_ringbuffer *rb, rt_uint32_t length);
+
 #ifdef RT_USING_HEAP
-struct rt_ringbuffer* rt_ringbuffer_create(rt_uint16_t length);
+struct rt_ringbuffer* rt_ringbuffer_create(rt_uint32_t length);
 void rt_ringbuffer_destroy(struct rt_ringbuffer *rb);
 #endif
 
@@ -102,7 +123,7 @@ void rt_ringbuffer_destroy(struct rt_ringbuffer *rb);
  *
  * @return  Buffer size.
  */
-rt_inline rt_uint16_t rt_ringbuffer_get_size(struct rt_ringbuffer *rb)
+rt_inline rt_uint32_t rt_ringbuffer_get_size(struct rt_ringbuffer *rb)
 {
     RT_ASSERT(rb != RT_NULL);
     return rb->buffer_size;
@@ -512,7 +512,17 @@ static void push_rocker_event(rocker_event_type_t evt_type, rocker_direction_t d
     evt.source_id = ROCKER_SOURCE_ID;
     evt.event_type = (uint8_t)evt_type;
     evt.data = ROCKER_EVT_PACK_DATA(dir, mag);
-    event_queue_push(evt);
+    evt.timestamp_us = scheduler_get_time_us();
+
+    // HOLD 是重复事件：队列里还有没取走的 HOLD 就只更新幅度，不占新槽
+    if (evt_type == ROCKER_EVT_DIR_HOLD)
+    {
+        event_queue_push_repeat(evt);
+    }
+    else
+    {
+        event_queue_push(evt);
+    }
 }
 
 /**
@@ -3,11 +3,23 @@
 // ֵ֧
 #define MAX_TASKS 20 
 
+// еһuint32_tλ¼
+#if MAX_TASKS > 32
+#error "MAX_TASKS must not exceed 32"
+#endif
+
 // ṹ嶨
 typedef struct {
-    void (*task_func)(void); // ָ
+    void (*task_func)(void); // ָ루ͨ
+    scheduler_pt_func_t pt_func; // Э̺Э
+    scheduler_pt_t *pt;      // Э
+    uint8_t ended;           // 1=Эѽ
     uint32_t rate_ms;        // ִڣ룩
-    uint32_t last_run;       // ϴʱϵͳʱ䣨룩
+    uint32_t next_run;       // һεĽֹʱ䣨ϵͳʱ䣬룩
+    uint8_t priority;        // ȼֵԽСԽȣ
+    uint8_t wake_on_event;   // 1=¼
+    volatile uint8_t woken;  // 1=ѱ¼ѣȴУscheduler_wake_task жλ
+    scheduler_task_stats_t stats; // ͳ
 } task_t;
 
 
@@ -15,6 +27,19 @@ typedef struct {
 static task_t scheduler_task[MAX_TASKS];
 // ǰע
 static uint8_t task_num = 0;
+// ۼִеCPUڣDWTڼأ
+static uint32_t busy_cycles = 0;
+// ۼƿʱ䣨΢룩
+static uint32_t idle_us = 0;
+// ϴͳƵʱ䣨΢룩
+static uint32_t stats_start_us = 0;
+// ¼Ͷݡûַ񣨿жλ
+static volatile uint8_t event_pending = 0;
+
+static void scheduler_idle(void);
+static void scheduler_clear_stats(task_t *task);
+static void scheduler_account(task_t *task, uint32_t cycles);
+static void scheduler_dispatch_event(void);
 
 
 /**
@@ -25,16 +50,33 @@ void scheduler_init(void)
 {
     // 㣬Ϊע׼
     task_num = 0;
+    stats_start_us = SCHEDULER_GET_TIME_US();
 }
 
 /**
  * @brief һ
  * úӦòãעҪִе
+ * ʹͨȼһһ֮С
  * @param task_func: ָ롣
  * @param rate_ms: ִڣ룩
  * @return bool: ɹ trueʧܷ false
  */
 bool scheduler_add_task(void (*task_func)(void), uint32_t rate_ms)
+{
+    return scheduler_add_task_ex(task_func, rate_ms, SCHEDULER_PRIORITY_NORMAL, rate_ms, NULL);
+}
+
+/**
+ * @brief һ񣬲ָȼλ
+ * @param task_func: ָ롣
+ * @param rate_ms: ִڣ룩
+ * @param priority: ȼSCHEDULER_PRIORITY_xxxֵԽСԽȣ
+ * @param phase_ms: һڵʱ룩֮ڶ롣
+ * @param name: ƣͳΪNULL
+ * @return bool: ɹ trueʧܷ false
+ */
+bool scheduler_add_task_ex(void (*task_func)(void), uint32_t rate_ms, uint8_t priority, uint32_t phase_ms,
+                           const char *name)
 {
     // Ƿ㹻Ŀռ䡢ָǷЧԼǷ
     if (task_num >= MAX_TASKS || task_func == NULL || rate_ms == 0)
@@ -44,34 +86,422 @@ bool scheduler_add_task(void (*task_func)(void), uint32_t rate_ms)
 
     // Ϣ
     scheduler_task[task_num].task_func = task_func;
+    scheduler_task[task_num].pt_func = NULL;
+    scheduler_task[task_num].pt = NULL;
+    scheduler_task[task_num].ended = 0;
     scheduler_task[task_num].rate_ms = rate_ms;
-    // ʹõǰϵͳʱʼϴʱ
-    scheduler_task[task_num].last_run = HAL_GetTick(); 
+    scheduler_task[task_num].priority = priority;
+    scheduler_task[task_num].wake_on_event = 0;
+    scheduler_task[task_num].woken = 0;
+    // һνֹʱ = ǰϵͳʱ + λ
+    scheduler_task[task_num].next_run = SCHEDULER_GET_TICK() + phase_ms;
+    scheduler_task[task_num].stats.name = name;
+    scheduler_task[task_num].stats.rate_ms = rate_ms;
+    scheduler_clear_stats(&scheduler_task[task_num]);
     task_num++;
 
     return true;
 }
 
+/**
+ * @brief һЭ
+ * ȰͨռһλãգٹЭ̡
+ * @param pt_func: Э̺
+ * @param pt: Эġ
+ * @param rate_ms: ڣ룩
+ * @param priority: ȼ
+ * @param phase_ms: һеʱ룩
+ * @param name: ƣΪNULL
+ * @return bool: ɹ trueʧܷ false
+ */
+bool scheduler_add_pt_task(scheduler_pt_func_t pt_func, scheduler_pt_t *pt, uint32_t rate_ms,
+                           uint8_t priority, uint32_t phase_ms, const char *name)
+{
+    if (task_num >= MAX_TASKS || pt_func == NULL || pt == NULL || rate_ms == 0)
+    {
+        return false;
+    }
+
+    PT_INIT(pt);
+    scheduler_task[task_num].task_func = NULL;
+    scheduler_task[task_num].pt_func = pt_func;
+    scheduler_task[task_num].pt = pt;
+    scheduler_task[task_num].ended = 0;
+    scheduler_task[task_num].rate_ms = rate_ms;
+    scheduler_task[task_num].priority = priority;
+    scheduler_task[task_num].wake_on_event = 0;
+    scheduler_task[task_num].woken = 0;
+    scheduler_task[task_num].next_run = SCHEDULER_GET_TICK() + phase_ms;
+    scheduler_task[task_num].stats.name = name;
+    scheduler_task[task_num].stats.rate_ms = rate_ms;
+    scheduler_clear_stats(&scheduler_task[task_num]);
+    task_num++;
+
+    return true;
+}
 
 /**
  * @brief к
- * 飬ǷﵽִڲС
+ * ÿΰȼӸߵѵڵÿһΡ
+ * ֹʱ䰴̶ƽʱƯƣòֵȽϣtickҲӰ졣
+ * ¼ѵ¼ͶʱȽֹʱ䣬ڴ
+ * ûʱߵһжϣSCHEDULER_IDLE_SLEEP
  */
 void scheduler_run(void)
 {
-    // ע
+    uint32_t done = 0; // Ѿй񣨰λ
+
+    while (1)
+    {
+        uint32_t now_time = SCHEDULER_GET_TICK();
+        int8_t best = -1;
+
+        // ǰе簴ɨ裩ܸͶ¼
+        if (event_pending)
+        {
+            scheduler_dispatch_event();
+        }
+
+        // ҳѵڡûйȼߵͬȼע˳
+        for (uint8_t i = 0; i < task_num; i++)
+        {
+            if ((done & (1UL << i)) != 0 || scheduler_task[i].ended ||
+                (!scheduler_task[i].woken && (int32_t)(now_time - scheduler_task[i].next_run) < 0))
+            {
+                continue;
+            }
+
+            if (best < 0 || scheduler_task[i].priority < scheduler_task[best].priority)
+            {
+                best = i;
+            }
+        }
+
+        if (best < 0)
+        {
+            // һûУһֹʱ仹ʱ䣬
+            if (done == 0)
+            {
+                scheduler_idle();
+            }
+            break;
+        }
+
+        task_t *task = &scheduler_task[best];
+        uint32_t late = now_time - task->next_run;
+
+        if ((int32_t)late < 0)
+        {
+            // ¼ѣֹʱ仹ûǰУһֹʱ
+            task->next_run = now_time + task->rate_ms;
+            task->stats.event_runs++;
+        }
+        else
+        {
+            // ¼ٵʱ䣻ٵһ˵мнֹʱ䱻
+            if (late > task->stats.max_late_ms)
+            {
+                task->stats.max_late_ms = late;
+            }
+            task->stats.total_late_ms += late;
+            if (late >= task->rate_ms)
+            {
+                uint32_t missed = late / task->rate_ms;
+
+                task->stats.missed += missed;
+                task->next_run += missed * task->rate_ms;
+            }
+            // ƽһֹʱ䣨λ
+            task->next_run += task->rate_ms;
+        }
+        task->woken = 0;
+        done |= 1UL << best;
+
+        // ִͳִʱ
+        uint32_t start_cycles = SCHEDULER_GET_CYCLES();
+        if (task->pt_func != NULL)
+        {
+            // Э̣еһó㣬ٵ
+            task->ended = (task->pt_func(task->pt) == PT_ENDED);
+        }
+        else
+        {
+            task->task_func();
+        }
+        scheduler_account(task, SCHEDULER_GET_CYCLES() - start_cycles);
+    }
+}
+
+/**
+ * @brief Ƿ¼ѡ
+ * @param task_func: עָ롣
+ * @param enable: true=¼ѣfalse=ֻС
+ * @return bool: ɹ trueδע᷵ false
+ */
+bool scheduler_set_event_wakeup(void (*task_func)(void), bool enable)
+{
+    for (uint8_t i = 0; i < task_num; i++)
+    {
+        if (task_func != NULL && scheduler_task[i].task_func == task_func)
+        {
+            scheduler_task[i].wake_on_event = enable ? 1 : 0;
+            scheduler_task[i].woken = 0;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief ֪ͨ¼Ͷݡ
+ * ֻһ־жҲԵãַscheduler_run
+ */
+void scheduler_notify_event(void)
+{
+    event_pending = 1;
+}
+
+/**
+ * @brief ֻһ񣬲ûж¼ѡ
+ * ֻдwokenֽдԭӵģжҲԵã
+ * ǰwokenڼֱѵĻһһΡ
+ * @param task_func: עָ롣
+ * @return bool: ɹ trueδע᷵ false
+ */
+bool scheduler_wake_task(void (*task_func)(void))
+{
+    for (uint8_t i = 0; i < task_num; i++)
+    {
+        if (task_func != NULL && scheduler_task[i].task_func == task_func)
+        {
+            scheduler_task[i].woken = 1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief ȡۼִеCPUڡ
+ * ƣ÷ӦʹζĲֵ
+ * @return uint32_t: ۼ
+ */
+uint32_t scheduler_get_busy_cycles(void)
+{
+    return busy_cycles;
+}
+
+/**
+ * @brief ȡۼƵĿʱ䣨΢룩
+ * @return uint32_t: ۼƿʱ䣬ơ
+ */
+uint32_t scheduler_get_idle_us(void)
+{
+    return idle_us;
+}
+
+/**
+ * @brief ȡ΢ʱ
+ * @return uint32_t: ʱ΢룩ơ
+ */
+uint32_t scheduler_get_time_us(void)
+{
+    return SCHEDULER_GET_TIME_US();
+}
+
+#ifdef SCHEDULER_USE_SYSTICK_US
+/**
+ * @brief SysTick΢ʱ
+ * HALtick1msټSysTickһѾĲ֡
+ * SysTickݼ;ʱtick䣬¶һΡ
+ * @return uint32_t: ʱ΢룩
+ */
+uint32_t scheduler_systick_us(void)
+{
+    uint32_t load = SysTick->LOAD;
+    uint32_t tick;
+    uint32_t val;
+    uint32_t pending;
+
+    do
+    {
+        tick = HAL_GetTick();
+        val = SysTick->VAL;
+        pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+    } while (tick != HAL_GetTick());
+
+    // ȼSysTickߵж簴EXTIʱSysTickѾtickûӣ
+    // VALѾװһǰΣһ
+    if (pending && val > load / 2)
+    {
+        tick++;
+    }
+
+    return tick * 1000 + (load - val) * 1000 / (load + 1);
+}
+#endif
+
+/**
+ * @brief ȡע
+ * @return uint8_t: 
+ */
+uint8_t scheduler_get_task_count(void)
+{
+    return task_num;
+}
+
+/**
+ * @brief ȡһͳƿա
+ * @param index: ţע˳򣬴0ʼ
+ * @param stats: ͳϢ
+ * @return bool: ɹ trueЧ false
+ */
+bool scheduler_get_task_stats(uint8_t index, scheduler_task_stats_t *stats)
+{
+    if (index >= task_num || stats == NULL)
+    {
+        return false;
+    }
+
+    *stats = scheduler_task[index].stats;
+    return true;
+}
+
+/**
+ * @brief ȡһռõCPU
+ * @param index: ţע˳򣬴0ʼ
+ * @return uint16_t: ǧֱȣЧ0
+ */
+uint16_t scheduler_get_task_load_permille(uint8_t index)
+{
+    uint64_t elapsed_cycles = (uint64_t)scheduler_get_stats_elapsed_us() * SCHEDULER_CYCLES_PER_US();
+
+    if (index >= task_num || elapsed_cycles == 0)
+    {
+        return 0;
+    }
+
+    return (uint16_t)(scheduler_task[index].stats.total_cycles * 1000 / elapsed_cycles);
+}
+
+/**
+ * @brief ȡϴͳƵʱ䣨΢룩
+ * @return uint32_t: ͳʱ
+ */
+uint32_t scheduler_get_stats_elapsed_us(void)
+{
+    return SCHEDULER_GET_TIME_US() - stats_start_us;
+}
+
+/**
+ * @brief ͳơ
+ */
+void scheduler_reset_stats(void)
+{
     for (uint8_t i = 0; i < task_num; i++)
     {
-        uint32_t now_time = HAL_GetTick();
+        scheduler_clear_stats(&scheduler_task[i]);
+    }
+    stats_start_us = SCHEDULER_GET_TIME_US();
+}
 
-        // ʹ "ϴʱ + "  "ǰʱ" бȽϣжǷӦ
-        if (now_time >= scheduler_task[i].rate_ms + scheduler_task[i].last_run)
+/**
+ * @brief ߡ
+ * жϺȷһûڣȻWFI
+ * жڼ䵽жϻᱣֹWFIأSysTick˯һ롣
+ * жϺжϷִУٶʱжϷʱҲ˿С
+ */
+static void scheduler_idle(void)
+{
+#if SCHEDULER_IDLE_SLEEP
+    uint32_t start_us = SCHEDULER_GET_TIME_US();
+    uint32_t now_time;
+
+    SCHEDULER_DISABLE_IRQ();
+    if (event_pending)
+    {
+        SCHEDULER_ENABLE_IRQ();
+        return;
+    }
+    now_time = SCHEDULER_GET_TICK();
+    for (uint8_t i = 0; i < task_num; i++)
+    {
+        if (!scheduler_task[i].ended &&
+            (scheduler_task[i].woken || (int32_t)(now_time - scheduler_task[i].next_run) >= 0))
         {
-            // ϴʱΪǰʱ
-            scheduler_task[i].last_run = now_time;
+            SCHEDULER_ENABLE_IRQ();
+            return;
+        }
+    }
+    SCHEDULER_WAIT_FOR_INTERRUPT();
+    SCHEDULER_ENABLE_IRQ();
+
+    idle_us += SCHEDULER_GET_TIME_US() - start_us;
+#endif
+}
+
+/**
+ * @brief һͳƣƺڣ
+ * @param task: 
+ */
+static void scheduler_clear_stats(task_t *task)
+{
+    const char *name = task->stats.name;
+    uint32_t rate_ms = task->stats.rate_ms;
+
+    memset(&task->stats, 0, sizeof(scheduler_task_stats_t));
+    task->stats.name = name;
+    task->stats.rate_ms = rate_ms;
+    task->stats.min_cycles = UINT32_MAX;
+}
+
+/**
+ * @brief ¼һִеĺʱ
+ * @param task: 
+ * @param cycles: ִеCPUڡ
+ */
+static void scheduler_account(task_t *task, uint32_t cycles)
+{
+    uint32_t us = cycles / SCHEDULER_CYCLES_PER_US();
+    uint8_t bin = 0;
+
+    busy_cycles += cycles;
+
+    task->stats.runs++;
+    task->stats.total_cycles += cycles;
+    if (cycles < task->stats.min_cycles)
+    {
+        task->stats.min_cycles = cycles;
+    }
+    if (cycles > task->stats.max_cycles)
+    {
+        task->stats.max_cycles = cycles;
+    }
 
-            // ִ
-            scheduler_task[i].task_func();
+    // log2Ͱusλλ
+    while (us != 0 && bin < SCHEDULER_HIST_BINS - 1)
+    {
+        us >>= 1;
+        bin++;
+    }
+    task->stats.hist[bin]++;
+}
+
+/**
+ * @brief Ͷݵ¼ַĵ
+ * ־ٱ񣺷ַڼжͶݵ¼һηַ
+ */
+static void scheduler_dispatch_event(void)
+{
+    event_pending = 0;
+
+    for (uint8_t i = 0; i < task_num; i++)
+    {
+        if (scheduler_task[i].wake_on_event)
+        {
+            scheduler_task[i].woken = 1;
         }
     }
 }
@@ -4,6 +4,144 @@
 // ȫͷļҪı׼ͺHAL
 #include "mydefine.h" 
 
+// -----------------------------------------------------------------------------
+// ȼֵԽСԽȣ
+// ͬһжʱȼߵУͬȼע˳С
+// -----------------------------------------------------------------------------
+#define SCHEDULER_PRIORITY_HIGH     0
+#define SCHEDULER_PRIORITY_NORMAL   1
+#define SCHEDULER_PRIORITY_LOW      2
+
+// -----------------------------------------------------------------------------
+// 
+// һꡢһֹʱ仹ûʱWFIںߵһSysTickжϣ
+// ټֹʱ䡣ߵʱۼΪʱ䣬CPUʡ
+// -----------------------------------------------------------------------------
+#ifndef SCHEDULER_IDLE_SLEEP
+#define SCHEDULER_IDLE_SLEEP        1   // 1=ʱWFIߣ0=תѯã
+#endif
+
+// -----------------------------------------------------------------------------
+// ֲӿ
+// ĬʹHAL/CMSISPCϲԵʱڱѡǶʱӣ
+//  -DSCHEDULER_GET_TICK()=sim_tick() -DSCHEDULER_WAIT_FOR_INTERRUPT()=sim_advance()
+// -----------------------------------------------------------------------------
+#ifndef SCHEDULER_GET_TICK
+#define SCHEDULER_GET_TICK()            HAL_GetTick()           // ʱֹʱ䣩
+#endif
+#ifndef SCHEDULER_GET_TIME_US
+#define SCHEDULER_GET_TIME_US()         scheduler_systick_us()  // ΢ʱʱҲߣ
+#define SCHEDULER_USE_SYSTICK_US        1
+#endif
+#ifndef SCHEDULER_GET_CYCLES
+#define SCHEDULER_GET_CYCLES()          (DWT->CYCCNT)           // CPUڣʱ
+#endif
+#ifndef SCHEDULER_DISABLE_IRQ
+#define SCHEDULER_DISABLE_IRQ()         __disable_irq()
+#endif
+#ifndef SCHEDULER_ENABLE_IRQ
+#define SCHEDULER_ENABLE_IRQ()          __enable_irq()
+#endif
+#ifndef SCHEDULER_WAIT_FOR_INTERRUPT
+#define SCHEDULER_WAIT_FOR_INTERRUPT()  __WFI()
+#endif
+#ifndef SCHEDULER_CYCLES_PER_US
+#define SCHEDULER_CYCLES_PER_US()       (SystemCoreClock / 1000000) // ڻ΢
+#endif
+
+// -----------------------------------------------------------------------------
+// ִʱֱͼ
+// log2ͰͰ0 = 1usͰk = [2^(k-1), 2^k) usһͰиġ
+// 16Ͱǵ16msϣ10msڵԤһ۾ܿ
+// -----------------------------------------------------------------------------
+#define SCHEDULER_HIST_BINS         16
+
+// -----------------------------------------------------------------------------
+// Эprotothreadջ
+// ʱĲFlashļϵͳ洢ԼȣдЭ̣ڵȴó
+// һεȣȴʱóĵطῨסѭ
+//
+// Э̺ľֲó󲻱ҪóıstaticŽĽṹ塣
+// ЭﲻswitchPT_BEGINһswitch
+//
+//   static uint8_t erase_task(scheduler_pt_t *pt)
+//   {
+//       PT_BEGIN(pt);
+//       spi_flash_sector_erase_start(0);
+//       PT_WAIT_UNTIL(pt, !spi_flash_is_busy());
+//       PT_DELAY(pt, 100);
+//       PT_END(pt);
+//   }
+//   scheduler_add_pt_task(erase_task, &s_erase_pt, 1, SCHEDULER_PRIORITY_LOW, 0, "erase");
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Эġ
+ */
+typedef struct {
+    uint16_t line;        // һδһм0=ͷʼ
+    uint32_t wake_tick;   // PT_DELAYĻʱ䣨룩
+} scheduler_pt_t;
+
+/**
+ * @brief Э̺ķֵ
+ */
+#define PT_WAITING  0     // óһεȼ
+#define PT_ENDED    1     // н
+
+/**
+ * @brief Э̺͡
+ */
+typedef uint8_t (*scheduler_pt_func_t)(scheduler_pt_t *pt);
+
+#define PT_INIT(pt)             do { (pt)->line = 0; } while (0)
+#define PT_BEGIN(pt)            switch ((pt)->line) { case 0:
+#define PT_END(pt)              } (pt)->line = 0; return PT_ENDED
+
+// óһΣһεȴ
+#define PT_YIELD(pt)                                                        \
+    do {                                                                    \
+        (pt)->line = __LINE__; return PT_WAITING; case __LINE__:;           \
+    } while (0)
+
+// óÿε¼
+#define PT_WAIT_UNTIL(pt, cond)                                             \
+    do {                                                                    \
+        (pt)->line = __LINE__; case __LINE__:                               \
+        if (!(cond)) { return PT_WAITING; }                                 \
+    } while (0)
+
+// óms
+#define PT_DELAY(pt, ms)                                                    \
+    do {                                                                    \
+        (pt)->wake_tick = SCHEDULER_GET_TICK() + (ms);                      \
+        PT_WAIT_UNTIL(pt, (int32_t)(SCHEDULER_GET_TICK() - (pt)->wake_tick) >= 0); \
+    } while (0)
+
+// ЭֱЭ̵ɵ÷ṩ
+#define PT_SPAWN(pt, child, thread)                                         \
+    do {                                                                    \
+        PT_INIT(child);                                                     \
+        PT_WAIT_UNTIL(pt, (thread) == PT_ENDED);                            \
+    } while (0)
+
+/**
+ * @brief ͳơ
+ */
+typedef struct {
+    const char *name;       // ƣעʱΪNULL
+    uint32_t rate_ms;       // ִڣ룩
+    uint32_t runs;          // д¼ѣ
+    uint32_t event_runs;    // ¼ǰеĴ
+    uint32_t missed;        // ĽֹʱٵһڣЩûУ
+    uint32_t max_late_ms;   // ٵʱ䣨룬ʱ - ֹʱ䣩
+    uint32_t total_late_ms; // ۼƳٵʱ䣨룩runsõƽٵ
+    uint32_t min_cycles;    // һִеCPU
+    uint32_t max_cycles;    // һִеCPU
+    uint64_t total_cycles;  // ۼִеCPUڣrunsõƽֵ
+    uint32_t hist[SCHEDULER_HIST_BINS]; // ִʱֱͼlog2΢Ͱ
+} scheduler_task_stats_t;
+
 // -----------------------------------------------------------------------------
 //  API
 // -----------------------------------------------------------------------------
@@ -23,7 +161,128 @@ void scheduler_run(void);
  * @param task_func: ָ롣
  * @param rate_ms: ִڣλ룩
  * @return bool: ӳɹ trueʧܣ false
+ * @note ͨȼһһ֮С
  */
 bool scheduler_add_task(void (*task_func)(void), uint32_t rate_ms);
 
+/**
+ * @brief һ񣬲ָȼλ
+ * @param task_func: ָ롣
+ * @param rate_ms: ִڣλ룩
+ * @param priority: ȼSCHEDULER_PRIORITY_xxx
+ * @param phase_ms: һעʱ̵ʱλ룩
+ * @param name: ƣͳַΪNULL
+ * @return bool: ӳɹ trueʧܷ false
+ * @note ֮Ľֹʱ䰴ڹ̶ƽͬͬλ
+ *       ͲͬһtickһС
+ */
+bool scheduler_add_task_ex(void (*task_func)(void), uint32_t rate_ms, uint8_t priority, uint32_t phase_ms,
+                           const char *name);
+
+/**
+ * @brief һЭ
+ * @param pt_func: Э̺
+ * @param pt: Эģ̬䣬Ȱλ
+ * @param rate_ms: ڣλ룩ȴеЭÿڼһΡ
+ * @param priority: ȼSCHEDULER_PRIORITY_xxx
+ * @param phase_ms: һעʱ̵ʱλ룩
+ * @param name: ƣͳΪNULL
+ * @return bool: ӳɹ trueʧܷ false
+ * @note Э̷PT_ENDEDУռõλòա
+ */
+bool scheduler_add_pt_task(scheduler_pt_func_t pt_func, scheduler_pt_t *pt, uint32_t rate_ms,
+                           uint8_t priority, uint32_t phase_ms, const char *name);
+
+/**
+ * @brief Ƿ¼ѡ
+ * @param task_func: עָ롣
+ * @param enable: true=¼ͶʱһΣfalse=ֻС
+ * @return bool: ɹ trueδע᷵ false
+ * @note ѵкһֹʱڲ䣩
+ *       һĵʼͬһﰴȼУ
+ *       ȼȴ¼Ϸ/˵Ŷء
+ */
+bool scheduler_set_event_wakeup(void (*task_func)(void), bool enable);
+
+/**
+ * @brief ֪ͨ¼Ͷݡ
+ * @note event_queue_push()ãжá
+ *       ¼ѵһ֣ǰһֻûеģһ֣У
+ *       ںWFIߣжϷغ
+ */
+void scheduler_notify_event(void);
+
+/**
+ * @brief ֻһ񣨲ûж¼ѣ
+ * @param task_func: עָ롣
+ * @return bool: ɹ trueδע᷵ false
+ * @note жã簴EXTIֻѰ񣬲Ϸ/˵
+ *       һУ¼һһֹʱ
+ */
+bool scheduler_wake_task(void (*task_func)(void));
+
+/**
+ * @brief ȡۼִеCPUڣDWT
+ * @return uint32_t: ۼƣʹζĲֵ
+ * @note ҪȴDWTڼperf_hud_init()
+ */
+uint32_t scheduler_get_busy_cycles(void);
+
+/**
+ * @brief ȡۼƵĿʱ䣨΢룩
+ * @return uint32_t: ۼƿʱ䣬ƣʹζĲֵ
+ * @note scheduler_get_time_us()ͬһʱ
+ *        = ʱ / ʱ
+ */
+uint32_t scheduler_get_idle_us(void);
+
+/**
+ * @brief ȡ΢ʱ
+ * @return uint32_t: ʱ΢룩ơ
+ * @note SysTicktickͼֵɣںʱҲߣ
+ *       ͳƴڵĳӦDWTڼDWTʱֹͣ
+ */
+uint32_t scheduler_get_time_us(void);
+
+#ifdef SCHEDULER_USE_SYSTICK_US
+/**
+ * @brief SysTick΢ʱSCHEDULER_GET_TIME_USĬʵ֣
+ * @return uint32_t: ʱ΢룩
+ */
+uint32_t scheduler_systick_us(void);
+#endif
+
+/**
+ * @brief ȡע
+ * @return uint8_t: 
+ */
+uint8_t scheduler_get_task_count(void);
+
+/**
+ * @brief ȡһͳƿա
+ * @param index: ţע˳򣬴0ʼ
+ * @param stats: ͳϢ
+ * @return bool: ɹ trueЧ false
+ * @note ͳѭ£︴ƳһһµĿա
+ */
+bool scheduler_get_task_stats(uint8_t index, scheduler_task_stats_t *stats);
+
+/**
+ * @brief ȡһռõCPU
+ * @param index: ţע˳򣬴0ʼ
+ * @return uint16_t: ϴͳִʱռʱǧֱȡ
+ */
+uint16_t scheduler_get_task_load_permille(uint8_t index);
+
+/**
+ * @brief ȡϴͳƵʱ䣨΢룩
+ * @return uint32_t: ͳʱ
+ */
+uint32_t scheduler_get_stats_elapsed_us(void);
+
+/**
+ * @brief ͳƣ¿ʼCPU
+ */
+void scheduler_reset_stats(void);
+
 #endif // __SCHEDULER_H__
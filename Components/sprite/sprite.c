@@ -0,0 +1,317 @@
+/**
+ ******************************************************************************
+ * @file    sprite.c
+ * @brief   1bpp精灵图快速绘制组件实现
+ * @author  老王
+ * @note    u8g2_DrawPixel()每个像素都要做一次裁剪、旋转回调和字节地址计算,
+ *          这里按精灵整体裁剪一次,然后直接按字节写帧缓冲
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sprite.h"
+
+/* Private types -------------------------------------------------------------*/
+/**
+ * @brief 写入方式对应的两个掩码
+ * @note  三种方式统一成 dst = (dst & ~(m & clr)) ^ (m & set):
+ *        OR:    clr=0xFF, set=0xFF
+ *        XOR:   clr=0x00, set=0xFF
+ *        CLEAR: clr=0xFF, set=0x00
+ *        内层循环里就不需要按方式分支
+ */
+typedef struct {
+    uint8_t clr;
+    uint8_t set;
+} sprite_op_t;
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t sprite_fast_path_ok(u8g2_t *u8g2);
+static sprite_op_t sprite_make_op(sprite_mode_t mode);
+static void sprite_draw_pixels(u8g2_t *u8g2, int16_t x, int16_t y, const uint8_t *bitmap,
+                               uint8_t w, uint8_t h, sprite_mode_t mode);
+
+/* Private functions (inline) ------------------------------------------------*/
+/**
+ * @brief 按写入方式把掩码写进一个字节
+ */
+static inline void sprite_apply(uint8_t *dst, uint8_t m, sprite_op_t op)
+{
+    *dst = (uint8_t)((*dst & ~(m & op.clr)) ^ (m & op.set));
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 绘制页格式精灵图
+ */
+void sprite_blit(u8g2_t *u8g2, int16_t x, int16_t y, const sprite_t *sprite, sprite_mode_t mode)
+{
+    const uint8_t *data;
+    uint8_t *buf;
+    int16_t buf_w, buf_pages;
+    int16_t c0, c1, page0;
+    uint8_t pages, shift;
+    sprite_op_t op;
+
+    if (sprite == NULL || sprite->data == NULL)
+    {
+        return;
+    }
+
+    buf_w = (int16_t)u8g2_GetBufferTileWidth(u8g2) * 8;
+    buf_pages = u8g2_GetBufferTileHeight(u8g2);
+    pages = (sprite->height + 7) / 8;
+
+    if (!sprite_fast_path_ok(u8g2))
+    {
+        /* 慢速路径:逐像素画,页格式按列取位 */
+        uint8_t color = u8g2_GetDrawColor(u8g2);
+        u8g2_SetDrawColor(u8g2, (mode == SPRITE_MODE_OR) ? 1 : (mode == SPRITE_MODE_XOR) ? 2 : 0);
+        for (uint8_t row = 0; row < sprite->height; row++)
+        {
+            for (uint8_t col = 0; col < sprite->width; col++)
+            {
+                if (sprite->data[(row >> 3) * sprite->width + col] & (1 << (row & 7)))
+                {
+                    u8g2_DrawPixel(u8g2, x + col, y + row);
+                }
+            }
+        }
+        u8g2_SetDrawColor(u8g2, color);
+        return;
+    }
+
+    /* 整个精灵都在屏幕外 */
+    if (x >= buf_w || y >= buf_pages * 8 || x + sprite->width <= 0 || y + sprite->height <= 0)
+    {
+        return;
+    }
+
+    /* 按精灵整体裁剪:可见的列范围[c0, c1) */
+    c0 = (x < 0) ? -x : 0;
+    c1 = (x + sprite->width > buf_w) ? buf_w - x : sprite->width;
+
+    /* y为负数时shift仍是0~7,page0向下取整 */
+    shift = (uint8_t)(y & 7);
+    page0 = (y - shift) / 8;
+    buf = u8g2_GetBufferPtr(u8g2);
+    op = sprite_make_op(mode);
+    data = sprite->data;
+
+    /* 有预移位数据:直接取这个y%8对应的那一份,当作多一页、不移位的精灵画 */
+    if (shift != 0 && sprite->shifted != NULL)
+    {
+        data = sprite->shifted + (uint16_t)(shift - 1) * (pages + 1) * sprite->width;
+        pages++;
+        shift = 0;
+    }
+
+    for (uint8_t sp = 0; sp < pages; sp++)
+    {
+        const uint8_t *src = data + (uint16_t)sp * sprite->width;
+        int16_t tp = page0 + sp;
+        uint8_t lo_ok = (tp >= 0 && tp < buf_pages);
+        uint8_t hi_ok = (shift != 0 && tp + 1 >= 0 && tp + 1 < buf_pages);
+        uint8_t *dst;   /* 这一页的行首:左边裁剪时x为负,不能先把x加进指针 */
+
+        if (lo_ok && (hi_ok || shift == 0))
+        {
+            /* 快速路径:这一页上下两半都在屏幕内 */
+            dst = buf + tp * buf_w;
+            if (shift == 0)
+            {
+                for (int16_t c = c0; c < c1; c++)
+                {
+                    sprite_apply(dst + (x + c), src[c], op);
+                }
+            }
+            else
+            {
+                for (int16_t c = c0; c < c1; c++)
+                {
+                    uint16_t m = (uint16_t)src[c] << shift;
+                    sprite_apply(dst + (x + c), (uint8_t)m, op);
+                    sprite_apply(dst + buf_w + (x + c), (uint8_t)(m >> 8), op);
+                }
+            }
+        }
+        else if (lo_ok)
+        {
+            /* 下半部分落在屏幕底边之外 */
+            dst = buf + tp * buf_w;
+            for (int16_t c = c0; c < c1; c++)
+            {
+                sprite_apply(dst + (x + c), (uint8_t)(src[c] << shift), op);
+            }
+        }
+        else if (hi_ok)
+        {
+            /* 上半部分落在屏幕顶边之外 */
+            dst = buf + (tp + 1) * buf_w;
+            for (int16_t c = c0; c < c1; c++)
+            {
+                sprite_apply(dst + (x + c), (uint8_t)(src[c] >> (8 - shift)), op);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 绘制行优先位图
+ */
+void sprite_blit_bitmap(u8g2_t *u8g2, int16_t x, int16_t y, const uint8_t *bitmap,
+                        uint8_t w, uint8_t h, sprite_mode_t mode)
+{
+    uint8_t *buf;
+    int16_t buf_w, buf_h;
+    int16_t r0, r1, c0, c1;
+    uint8_t bytes_per_row = (w + 7) / 8;
+    uint8_t tail_mask = (uint8_t)(0xFF << (bytes_per_row * 8 - w));   /* 每行最后一个字节的有效位 */
+    sprite_op_t op;
+
+    if (bitmap == NULL)
+    {
+        return;
+    }
+
+    if (!sprite_fast_path_ok(u8g2))
+    {
+        sprite_draw_pixels(u8g2, x, y, bitmap, w, h, mode);
+        return;
+    }
+
+    buf_w = (int16_t)u8g2_GetBufferTileWidth(u8g2) * 8;
+    buf_h = (int16_t)u8g2_GetBufferTileHeight(u8g2) * 8;
+
+    /* 整个位图都在屏幕外 */
+    if (x >= buf_w || y >= buf_h || x + w <= 0 || y + h <= 0)
+    {
+        return;
+    }
+
+    /* 按位图整体裁剪:可见的行范围[r0, r1)和列范围[c0, c1) */
+    r0 = (y < 0) ? -y : 0;
+    r1 = (y + h > buf_h) ? buf_h - y : h;
+    c0 = (x < 0) ? -x : 0;
+    c1 = (x + w > buf_w) ? buf_w - x : w;
+
+    buf = u8g2_GetBufferPtr(u8g2);
+    op = sprite_make_op(mode);
+
+    for (int16_t r = r0; r < r1; r++)
+    {
+        const uint8_t *src = bitmap + r * bytes_per_row;
+        int16_t yy = y + r;
+        uint8_t *dst = buf + (yy >> 3) * buf_w;   /* 行首,同上不先加x */
+        uint8_t bit = (uint8_t)(1 << (yy & 7));
+
+        if (c0 == 0 && c1 == w)
+        {
+            /* 快速路径:整行可见,逐字节处理,字节剩余位为0时提前结束 */
+            for (uint8_t i = 0; i < bytes_per_row; i++)
+            {
+                uint8_t b = (i == bytes_per_row - 1) ? (src[i] & tail_mask) : src[i];
+                uint8_t *d = dst + (x + i * 8);
+
+                while (b != 0)
+                {
+                    if (b & 0x80)
+                    {
+                        sprite_apply(d, bit, op);
+                    }
+                    b <<= 1;
+                    d++;
+                }
+            }
+        }
+        else
+        {
+            for (int16_t c = c0; c < c1; c++)
+            {
+                if (src[c >> 3] & (0x80 >> (c & 7)))
+                {
+                    sprite_apply(dst + (x + c), bit, op);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 把行优先位图转换成页格式
+ */
+void sprite_convert_bitmap(const uint8_t *bitmap, uint8_t w, uint8_t h, uint8_t *out)
+{
+    uint8_t bytes_per_row = (w + 7) / 8;
+
+    for (uint16_t i = 0; i < SPRITE_PAGE_DATA_SIZE(w, h); i++)
+    {
+        out[i] = 0;
+    }
+
+    for (uint8_t row = 0; row < h; row++)
+    {
+        uint8_t *dst = out + (row >> 3) * w;
+        uint8_t bit = (uint8_t)(1 << (row & 7));
+
+        for (uint8_t col = 0; col < w; col++)
+        {
+            if (bitmap[row * bytes_per_row + (col >> 3)] & (0x80 >> (col & 7)))
+            {
+                dst[col] |= bit;
+            }
+        }
+    }
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 判断能否直接写帧缓冲
+ * @note  需要0度旋转、垂直字节格式(bit0在上)、全缓冲
+ */
+static uint8_t sprite_fast_path_ok(u8g2_t *u8g2)
+{
+    return (u8g2->cb == U8G2_R0 &&
+            u8g2->ll_hvline == u8g2_ll_hvline_vertical_top_lsb &&
+            u8g2->tile_buf_height == u8g2_GetU8x8(u8g2)->display_info->tile_height) ? 1 : 0;
+}
+
+/**
+ * @brief 写入方式转换成掩码
+ */
+static sprite_op_t sprite_make_op(sprite_mode_t mode)
+{
+    sprite_op_t op;
+
+    op.clr = (mode == SPRITE_MODE_XOR) ? 0x00 : 0xFF;
+    op.set = (mode == SPRITE_MODE_CLEAR) ? 0x00 : 0xFF;
+    return op;
+}
+
+/**
+ * @brief 慢速路径:逐像素画行优先位图
+ * @note  旋转或分页缓冲模式下使用,写入方式用u8g2的绘制颜色实现
+ */
+static void sprite_draw_pixels(u8g2_t *u8g2, int16_t x, int16_t y, const uint8_t *bitmap,
+                               uint8_t w, uint8_t h, sprite_mode_t mode)
+{
+    uint8_t bytes_per_row = (w + 7) / 8;
+    uint8_t color = u8g2_GetDrawColor(u8g2);
+
+    u8g2_SetDrawColor(u8g2, (mode == SPRITE_MODE_OR) ? 1 : (mode == SPRITE_MODE_XOR) ? 2 : 0);
+
+    for (uint8_t row = 0; row < h; row++)
+    {
+        for (uint8_t col = 0; col < w; col++)
+        {
+            if (bitmap[row * bytes_per_row + (col >> 3)] & (0x80 >> (col & 7)))
+            {
+                u8g2_DrawPixel(u8g2, x + col, y + row);
+            }
+        }
+    }
+
+    u8g2_SetDrawColor(u8g2, color);
+}
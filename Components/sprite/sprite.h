@@ -0,0 +1,105 @@
+/**
+ ******************************************************************************
+ * @file    sprite.h
+ * @brief   1bpp精灵图快速绘制组件头文件
+ * @author  老王
+ * @note    直接把精灵图按字节写进u8g2的帧缓冲,不再逐像素调用u8g2_DrawPixel()
+ *
+ *          - 裁剪按精灵整体计算一次,完全在屏幕内时走不带边界检查的快速路径
+ *          - 支持OR(画)、XOR(反色)、CLEAR(擦除)三种写入方式
+ *          - 只支持0度旋转的全缓冲模式(SSD1306的垂直字节格式),
+ *            其他模式自动退回u8g2_DrawPixel()
+ *          - 不考虑u8g2_SetClipWindow()设置的裁剪窗口
+ ******************************************************************************
+ */
+
+#ifndef __SPRITE_H__
+#define __SPRITE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "u8g2.h"
+
+/* Exported defines ----------------------------------------------------------*/
+/**
+ * @brief 页格式精灵图数据的字节数
+ * @param w 宽度(像素)
+ * @param h 高度(像素)
+ */
+#define SPRITE_PAGE_DATA_SIZE(w, h)   ((uint16_t)(w) * (((h) + 7) / 8))
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 写入方式
+ */
+typedef enum {
+    SPRITE_MODE_OR = 0,     // 点亮精灵图中为1的像素
+    SPRITE_MODE_XOR,        // 翻转精灵图中为1的像素
+    SPRITE_MODE_CLEAR       // 熄灭精灵图中为1的像素(AND-NOT)
+} sprite_mode_t;
+
+/**
+ * @brief 页格式精灵图
+ * @note  和SSD1306的GDRAM排列相同:每8行像素为一页,每页width个字节,
+ *        每个字节是一列8个像素,bit0在最上面
+ *        最后一页高度不足8行时,多出来的位必须为0
+ *
+ *        shifted是可选的预移位数据:y%8为1~7时各一份,每份比data多一页,
+ *        即7 * SPRITE_PAGE_DATA_SIZE(width, height + 8)字节
+ *        有预移位数据时绘制不需要再做移位拼接,用flash换速度,
+ *        适合经常上下移动的精灵;由资源编译器(Tools/asset_compiler)生成
+ */
+typedef struct {
+    uint8_t width;          // 宽度(像素)
+    uint8_t height;         // 高度(像素)
+    const uint8_t *data;    // 页格式数据,SPRITE_PAGE_DATA_SIZE(width, height)字节
+    const uint8_t *shifted; // 预移位数据,NULL表示绘制时移位
+} sprite_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 绘制页格式精灵图
+ * @param u8g2 u8g2实例
+ * @param x 左上角X坐标(可以为负,超出屏幕的部分被裁掉)
+ * @param y 左上角Y坐标(可以为负)
+ * @param sprite 精灵图
+ * @param mode 写入方式
+ * @note  每列数据左移(y%8)位后拆成上下两个字节,一次写入两页
+ */
+void sprite_blit(u8g2_t *u8g2, int16_t x, int16_t y, const sprite_t *sprite, sprite_mode_t mode);
+
+/**
+ * @brief 绘制行优先位图
+ * @param u8g2 u8g2实例
+ * @param x 左上角X坐标(可以为负)
+ * @param y 左上角Y坐标(可以为负)
+ * @param bitmap 行优先位图:每行(w+7)/8字节,高位在左
+ * @param w 宽度(像素)
+ * @param h 高度(像素)
+ * @param mode 写入方式
+ * @note  位图格式和游戏里手写的sprite数组一致,可以直接替换逐像素的draw_bitmap()
+ *        每行对应帧缓冲中同一个bit,只需要按列把这个bit写进去
+ */
+void sprite_blit_bitmap(u8g2_t *u8g2, int16_t x, int16_t y, const uint8_t *bitmap,
+                        uint8_t w, uint8_t h, sprite_mode_t mode);
+
+/**
+ * @brief 把行优先位图转换成页格式
+ * @param bitmap 行优先位图(格式同sprite_blit_bitmap)
+ * @param w 宽度(像素)
+ * @param h 高度(像素)
+ * @param out 输出缓冲,至少SPRITE_PAGE_DATA_SIZE(w, h)字节
+ * @note  运行时生成的图形用;固定的精灵图应该直接写成页格式
+ */
+void sprite_convert_bitmap(const uint8_t *bitmap, uint8_t w, uint8_t h, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPRITE_H__ */
@@ -13,12 +13,127 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "u8g2_stm32_hal.h"
+#include <string.h>
 
 /* Private defines -----------------------------------------------------------*/
-/* 无需私有定义 */
+/**
+ * @brief 单个I2C事务的最大长度(不含从机地址)
+ * @note  1字节控制字节+一整页128字节GDRAM数据
+ *        整页CAD保证每个事务不超过这个长度;fast_i2c每次最多24+1字节,也放得下
+ */
+#define U8G2_TX_MAX_XFER_LEN    (1 + 128)
+
+/**
+ * @brief 一帧全缓冲的大小(128x64单色 = 1024字节)
+ */
+#define U8G2_FRAME_BUF_SIZE     (128 * 64 / 8)
+
+/**
+ * @brief 差分刷新时允许合并的未变化tile数
+ * @note  两段变化区域之间只隔1个tile时,多发8字节比重新发一次
+ *        列/页地址命令(一次I2C START+地址+4字节命令)更划算
+ */
+#define U8G2_DIFF_MAX_GAP       1
+
+/**
+ * @brief SSD1306 I2C控制字节:后续字节为GDRAM数据
+ */
+#define U8G2_SSD1306_CTRL_DATA  0x40
+
+/**
+ * @brief SSD1306 I2C控制字节:后续字节都是命令
+ */
+#define U8G2_SSD1306_CTRL_CMD   0x00
+
+/**
+ * @brief 整页CAD的事务状态:当前没有打开的事务
+ */
+#define U8G2_CAD_NO_XFER        0xFF
+
+/**
+ * @brief 描述符的buf_id取值:数据不属于任何帧缓冲(已复制到字节池)
+ */
+#define U8G2_TX_NO_FRAME_BUF    0xFF
+
+/**
+ * @brief 影子缓冲的帧缓冲编号
+ * @note  差分刷新直接从影子缓冲零拷贝发送,所以影子登记为一块帧缓冲,有自己的栅栏
+ */
+#define U8G2_SHADOW_BUF_ID      0
+
+/**
+ * @brief 登记的帧缓冲数量(只有影子缓冲)
+ * @note  绘制缓冲的数据总是复制进字节池,发送期间可以随意改写,不需要登记
+ */
+#define U8G2_FRAME_BUF_COUNT    1
+
+/* Private types -------------------------------------------------------------*/
+#if U8G2_I2C_USE_DMA
+/**
+ * @brief 发送队列中的一个I2C事务描述符
+ */
+typedef struct {
+    const uint8_t *data; /*!< 事务数据(字节池内的副本,或直接指向帧缓冲) */
+    uint16_t len;        /*!< 事务数据长度 */
+    uint8_t ctrl;        /*!< 零拷贝事务的SSD1306控制字节(0x40) */
+    uint8_t buf_id;      /*!< 引用的帧缓冲编号,U8G2_TX_NO_FRAME_BUF表示数据已复制 */
+} u8g2_tx_desc_t;
+#endif
 
 /* Private variables ---------------------------------------------------------*/
-/* 无需私有变量 */
+#if U8G2_I2C_USE_DMA
+/*
+ * DMA发送队列
+ * u8g2每次START/END之间的数据被复制到字节池,作为一个事务入队
+ * DMA发送完一个事务后,在完成中断里自动启动下一个事务
+ * 队列排空后才把字节池和描述符表复位(线性使用,无需处理回绕)
+ */
+static uint8_t s_tx_pool[U8G2_TX_POOL_SIZE];              /* 事务字节池 */
+static u8g2_tx_desc_t s_tx_desc[U8G2_TX_MAX_TRANSFERS];   /* 事务描述符表 */
+static volatile uint16_t s_tx_head = 0;                   /* 正在发送的事务(中断推进) */
+static volatile uint16_t s_tx_tail = 0;                   /* 下一个入队位置(主循环推进) */
+static uint16_t s_tx_pool_used = 0;                       /* 字节池已使用长度 */
+static volatile uint8_t s_tx_dma_busy = 0;                /* DMA是否正在传输 */
+static volatile uint8_t s_tx_ctrl_sent = 0;               /* 零拷贝事务的控制字节已发出,等待发送数据段 */
+
+static uint16_t s_cur_offset = 0;                         /* 正在组装的事务起始位置 */
+static uint16_t s_cur_len = 0;                            /* 正在组装的事务长度 */
+static const uint8_t *s_cur_ref = NULL;                   /* 正在组装的零拷贝数据指针 */
+static uint16_t s_cur_ref_len = 0;                        /* 零拷贝数据长度 */
+static uint8_t s_cur_ref_buf = U8G2_TX_NO_FRAME_BUF;      /* 零拷贝数据所属的帧缓冲 */
+
+static void (*s_flush_done_cb)(void) = NULL;              /* 刷新完成回调(中断上下文) */
+static volatile uint32_t s_flush_done_count = 0;          /* 已完成的刷新次数 */
+static volatile uint32_t s_tx_error_count = 0;            /* I2C传输错误次数 */
+
+/*
+ * 零拷贝发送的帧缓冲
+ * 目前只有差分刷新的影子缓冲,差分刷新从它零拷贝发送
+ * s_buf_pending记录每块缓冲还有多少个事务在发送中,作为写入栅栏(fence)
+ */
+static uint8_t *s_frame_buf[U8G2_FRAME_BUF_COUNT] = { NULL };
+static volatile uint8_t s_buf_pending[U8G2_FRAME_BUF_COUNT] = { 0 };
+static uint8_t s_zero_copy = 0;                           /* 差分发送期间置1,帧缓冲数据按引用入队 */
+#endif
+
+#if U8G2_I2C_FULL_PAGE
+/* 整页CAD当前打开的事务:控制字节(0x00命令/0x40数据),U8G2_CAD_NO_XFER表示没有 */
+static uint8_t s_cad_ctrl = U8G2_CAD_NO_XFER;
+static uint16_t s_cad_len = 0;                            /* 当前事务已写入的字节数(含控制字节) */
+#endif
+
+static u8g2_tx_stats_t s_tx_stats;                        /* I2C事务统计 */
+
+/*
+ * 差分刷新
+ * s_shadow_buf保存最后一次发送到屏幕的画面,只有差分刷新会维护它
+ * 任何其他途径写了GDRAM(SendBuffer、ClearDisplay)都会让影子失效,
+ * 下一次差分刷新自动退化为整帧发送
+ */
+static uint8_t s_shadow_buf[U8G2_FRAME_BUF_SIZE];
+static uint8_t s_shadow_valid = 0;
+static uint8_t s_diff_flushing = 0;                       /* 差分刷新进行中 */
+static uint16_t s_diff_last_bytes = 0;                    /* 上一次差分刷新发送的数据字节数 */
 
 /* Exported variables --------------------------------------------------------*/
 /**
@@ -28,10 +143,85 @@
 u8g2_t g_u8g2;
 
 /* Private function prototypes -----------------------------------------------*/
-/* 无需私有函数 */
+#if U8G2_I2C_USE_DMA
+static void u8g2_tx_reserve(void);
+static void u8g2_tx_append(const uint8_t *data, uint8_t len);
+static void u8g2_tx_commit(void);
+static void u8g2_tx_start_next(void);
+static void u8g2_tx_drop_all(void);
+static uint8_t u8g2_frame_buf_of(const uint8_t *ptr);
+static void u8g2_buf_fence(uint8_t buf_id);
+static void u8g2_tx_done(I2C_HandleTypeDef *hi2c);
+#endif
+#if U8G2_I2C_FULL_PAGE
+static void u8g2_cad_begin(u8x8_t *u8x8, uint8_t ctrl, uint8_t len);
+static void u8g2_cad_end(u8x8_t *u8x8);
+#endif
+static void u8g2_tx_count(const uint8_t *xfer, uint16_t len, uint16_t ref_len);
 
 /* Exported functions --------------------------------------------------------*/
 
+#if U8G2_I2C_USE_DMA
+/**
+ * @brief u8g2的I2C硬件通信回调函数(DMA非阻塞版本)
+ * @note  START/END之间的数据组装成一个事务放入发送队列,由DMA在后台发送
+ *        函数立即返回,u8g2_SendBuffer()不再等待I2C总线
+ *        只有在队列放不下时才会等待上一帧发完(反压)
+ */
+uint8_t u8x8_byte_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    uint8_t *data;
+
+    switch(msg)
+    {
+        case U8X8_MSG_BYTE_INIT:
+            /* I2C和DMA已经由CubeMX初始化,不需要额外操作 */
+            break;
+
+        case U8X8_MSG_BYTE_SET_DC:
+            /* I2C模式不需要DC引脚 */
+            break;
+
+        case U8X8_MSG_BYTE_START_TRANSFER:
+            /* 开始传输:在字节池中预留一个事务的空间 */
+            u8g2_tx_reserve();
+            break;
+
+        case U8X8_MSG_BYTE_SEND:
+            data = (uint8_t *)arg_ptr;
+
+            /*
+             * 零拷贝:差分发送时,控制字节后面紧跟的帧缓冲数据只记录指针
+             * DMA发送时分两段:先发控制字节(不产生STOP),再在同一个事务里发帧缓冲数据
+             */
+            if(s_zero_copy && s_cur_ref == NULL && s_cur_len == 1)
+            {
+                uint8_t buf_id = u8g2_frame_buf_of(data);
+                if(buf_id != U8G2_TX_NO_FRAME_BUF)
+                {
+                    s_cur_ref = data;
+                    s_cur_ref_len = arg_int;
+                    s_cur_ref_buf = buf_id;
+                    break;
+                }
+            }
+
+            /* 将数据复制到当前事务 */
+            u8g2_tx_append(data, arg_int);
+            break;
+
+        case U8X8_MSG_BYTE_END_TRANSFER:
+            /* 结束传输:事务入队,如果DMA空闲则立即启动 */
+            u8g2_tx_commit();
+            break;
+
+        default:
+            return 0;
+    }
+
+    return 1;
+}
+#else
 /**
  * @brief u8g2的I2C硬件通信回调函数
  * @note  这个函数处理u8g2库的所有I2C通信请求
@@ -39,8 +229,8 @@ u8g2_t g_u8g2;
  */
 uint8_t u8x8_byte_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
-    /* 静态缓冲区:u8g2最多发送32字节 */
-    static uint8_t buffer[32];
+    /* 静态缓冲区:一个事务最多是控制字节+一整页数据 */
+    static uint8_t buffer[U8G2_TX_MAX_XFER_LEN];
     static uint8_t buf_idx;
     uint8_t *data;
 
@@ -62,7 +252,7 @@ uint8_t u8x8_byte_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
         case U8X8_MSG_BYTE_SEND:
             /* 将数据存入缓冲区,而不是立即发送 */
             data = (uint8_t *)arg_ptr;
-            while(arg_int > 0)
+            while(arg_int > 0 && buf_idx < U8G2_TX_MAX_XFER_LEN)
             {
                 buffer[buf_idx++] = *data;
                 data++;
@@ -71,6 +261,14 @@ uint8_t u8x8_byte_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
             break;
 
         case U8X8_MSG_BYTE_END_TRANSFER:
+            /* 不是差分刷新发出的GDRAM数据,影子缓冲不再可信 */
+            if(!s_diff_flushing && buf_idx > 0 && buffer[0] == U8G2_SSD1306_CTRL_DATA)
+            {
+                s_shadow_valid = 0;
+            }
+
+            u8g2_tx_count(buffer, buf_idx, 0);
+
             /* 结束传输:一次性发送缓冲区的所有数据 */
             if(HAL_I2C_Master_Transmit(&U8G2_I2C_HANDLE,
                                        u8x8_GetI2CAddress(u8x8),
@@ -88,6 +286,66 @@ uint8_t u8x8_byte_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
 
     return 1;
 }
+#endif /* U8G2_I2C_USE_DMA */
+
+#if U8G2_I2C_FULL_PAGE
+/**
+ * @brief SSD1306的整页I2C命令/数据层(CAD)回调函数
+ * @note  u8g2自带的fast_i2c为了迁就Arduino Wire的32字节缓冲,
+ *        每个命令单独一个事务,数据按24字节切块,一页要4个事务+2个命令事务
+ *        这里的发送队列/阻塞缓冲都能容纳一整页,所以按控制字节类型合并:
+ *        命令类型不变就一直写在同一个事务里,数据同理,类型切换或放不下时才重新START
+ */
+uint8_t u8x8_cad_ssd13xx_page_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    uint8_t *data;
+    uint8_t len;
+
+    switch(msg)
+    {
+        case U8X8_MSG_CAD_SEND_CMD:
+        case U8X8_MSG_CAD_SEND_ARG:
+            /* 命令和参数对SSD1306来说都是命令字节,写在同一个命令事务里 */
+            u8g2_cad_begin(u8x8, U8G2_SSD1306_CTRL_CMD, 1);
+            u8x8_byte_SendByte(u8x8, arg_int);
+            break;
+
+        case U8X8_MSG_CAD_SEND_DATA:
+            /* 一次最多写满一个事务,超出部分开新事务(128宽的屏一页正好一个事务) */
+            data = (uint8_t *)arg_ptr;
+            while(arg_int > 0)
+            {
+                len = (arg_int > U8G2_TX_MAX_XFER_LEN - 1) ? (U8G2_TX_MAX_XFER_LEN - 1) : arg_int;
+                u8g2_cad_begin(u8x8, U8G2_SSD1306_CTRL_DATA, len);
+                u8x8_byte_SendBytes(u8x8, len, data);
+                data += len;
+                arg_int -= len;
+            }
+            break;
+
+        case U8X8_MSG_CAD_INIT:
+            /* 和fast_i2c一样:没有设置地址时使用默认地址 */
+            if(u8x8->i2c_address == 255)
+            {
+                u8x8->i2c_address = 0x078;
+            }
+            return u8x8->byte_cb(u8x8, msg, arg_int, arg_ptr);
+
+        case U8X8_MSG_CAD_START_TRANSFER:
+            s_cad_ctrl = U8G2_CAD_NO_XFER;
+            break;
+
+        case U8X8_MSG_CAD_END_TRANSFER:
+            u8g2_cad_end(u8x8);
+            break;
+
+        default:
+            return 0;
+    }
+
+    return 1;
+}
+#endif /* U8G2_I2C_FULL_PAGE */
 
 /**
  * @brief u8g2的GPIO和延迟回调函数
@@ -98,6 +356,17 @@ uint8_t u8x8_byte_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
  */
 uint8_t u8g2_gpio_and_delay_stm32(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
 {
+#if U8G2_I2C_USE_DMA
+    /*
+     * DMA模式下命令是异步发出的,延迟必须从命令真正发完之后开始计算
+     * (比如初始化序列里的上电等待),所以先等待发送队列排空
+     */
+    if(msg == U8X8_MSG_DELAY_MILLI || msg == U8X8_MSG_DELAY_10MICRO)
+    {
+        u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+    }
+#endif
+
     switch(msg)
     {
         case U8X8_MSG_DELAY_MILLI:
@@ -243,6 +512,22 @@ int u8g2_component_init(void)
                                            u8x8_byte_hw_i2c,
                                            u8g2_gpio_and_delay_stm32);
 
+#if U8G2_I2C_FULL_PAGE
+    /*
+     * 换用整页CAD:Setup里选的是fast_i2c,必须在InitDisplay之前替换
+     * 每页只需要1个命令事务+1个数据事务
+     */
+    g_u8g2.u8x8.cad_cb = u8x8_cad_ssd13xx_page_i2c;
+#endif
+
+#if U8G2_I2C_USE_DMA
+    /*
+     * 步骤1.5: 登记零拷贝帧缓冲
+     * 影子缓冲登记为帧缓冲,差分刷新从它零拷贝发送
+     */
+    s_frame_buf[U8G2_SHADOW_BUF_ID] = s_shadow_buf;
+#endif
+
     /*
      * 步骤2: InitDisplay - 初始化显示屏硬件
      * 这个函数会发送SSD1306的初始化命令序列到OLED
@@ -303,8 +588,531 @@ void u8g2_set_display_on(uint8_t on)
     u8g2_SetPowerSave(&g_u8g2, on ? 0 : 1);
 }
 
+/**
+ * @brief 差分刷新:只发送和上一帧相比有变化的tile
+ * @note  以8x8像素的tile为单位比较帧缓冲和影子缓冲,
+ *        每页(8行像素)中连续变化的tile合并成一段,用u8g2_UpdateDisplayArea()
+ *        通过页/列寻址只发送这一段
+ *
+ *        变化的段先复制进影子缓冲,再把tile_buf_ptr临时指向影子缓冲发送,
+ *        DMA直接从影子缓冲取数据(零拷贝),绘制缓冲发送期间可以随意改写
+ */
+uint16_t u8g2_send_buffer_diff(u8g2_t *u8g2)
+{
+    uint8_t *buf = u8g2_GetBufferPtr(u8g2);
+    uint8_t tile_w = u8g2_GetU8x8(u8g2)->display_info->tile_width;
+    uint8_t tile_h = u8g2_GetU8x8(u8g2)->display_info->tile_height;
+    uint16_t page_size = (uint16_t)tile_w * 8;
+    uint16_t bytes = 0;
+
+    /* 只支持全缓冲模式,且尺寸不能超过影子缓冲 */
+    if(u8g2->tile_buf_height != tile_h || page_size * tile_h > U8G2_FRAME_BUF_SIZE)
+    {
+        u8g2_SendBuffer(u8g2);
+        return page_size * u8g2->tile_buf_height;
+    }
+
+    s_diff_flushing = 1;
+
+#if U8G2_I2C_USE_DMA
+    /* 栅栏:影子缓冲还被上一次差分刷新的DMA引用时不能改写 */
+    u8g2_buf_fence(U8G2_SHADOW_BUF_ID);
+    s_zero_copy = 1;
+#endif
+    u8g2->tile_buf_ptr = s_shadow_buf;
+
+    /* 影子无效(刚上电或被其他途径刷新过):建立影子并整帧发送 */
+    if(!s_shadow_valid)
+    {
+        memcpy(s_shadow_buf, buf, page_size * tile_h);
+        u8g2_SendBuffer(u8g2);
+        u8g2->tile_buf_ptr = buf;
+#if U8G2_I2C_USE_DMA
+        s_zero_copy = 0;
+#endif
+        s_shadow_valid = 1;
+        s_diff_flushing = 0;
+        s_diff_last_bytes = page_size * tile_h;
+        return s_diff_last_bytes;
+    }
+
+    for(uint8_t ty = 0; ty < tile_h; ty++)
+    {
+        uint8_t *row = buf + ty * page_size;
+        uint8_t *shadow_row = s_shadow_buf + ty * page_size;
+        uint8_t tx = 0;
+
+        while(tx < tile_w)
+        {
+            uint8_t start, end;
+
+            /* 跳过没有变化的tile */
+            if(memcmp(row + tx * 8, shadow_row + tx * 8, 8) == 0)
+            {
+                tx++;
+                continue;
+            }
+
+            /* 向右扩展这一段,中间隔着不超过U8G2_DIFF_MAX_GAP个未变化tile也合并 */
+            start = tx;
+            end = tx + 1;
+            for(uint8_t t = tx + 1; t < tile_w; t++)
+            {
+                if(memcmp(row + t * 8, shadow_row + t * 8, 8) != 0)
+                {
+                    end = t + 1;
+                }
+                else if(t + 1 - end > U8G2_DIFF_MAX_GAP)
+                {
+                    break;
+                }
+            }
+
+            memcpy(shadow_row + start * 8, row + start * 8, (end - start) * 8);
+            u8g2_UpdateDisplayArea(u8g2, start, ty, end - start, 1);
+            bytes += (end - start) * 8;
+            tx = end;
+        }
+    }
+
+    u8g2->tile_buf_ptr = buf;
+#if U8G2_I2C_USE_DMA
+    s_zero_copy = 0;
+#endif
+    s_diff_flushing = 0;
+    s_diff_last_bytes = bytes;
+    return bytes;
+}
+
+/**
+ * @brief 让影子缓冲失效,下一次差分刷新整帧发送
+ */
+void u8g2_invalidate_diff_shadow(void)
+{
+    s_shadow_valid = 0;
+}
+
+/**
+ * @brief 获取上一次差分刷新发送的数据字节数
+ */
+uint16_t u8g2_get_diff_bytes(void)
+{
+    return s_diff_last_bytes;
+}
+
+/* ========== 异步刷新(DMA)接口实现 ========== */
+
+/**
+ * @brief 查询是否有帧正在通过I2C发送
+ */
+uint8_t u8g2_flush_is_busy(void)
+{
+#if U8G2_I2C_USE_DMA
+    return (s_tx_dma_busy || s_tx_head != s_tx_tail) ? 1 : 0;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief 等待发送队列排空
+ * @note  超时说明I2C总线卡死,丢弃队列中剩余的事务,避免整个系统卡住
+ */
+int u8g2_flush_wait(uint32_t timeout_ms)
+{
+#if U8G2_I2C_USE_DMA
+    uint32_t start = HAL_GetTick();
+
+    while(u8g2_flush_is_busy())
+    {
+        if(HAL_GetTick() - start >= timeout_ms)
+        {
+            /* 总线卡死:终止DMA并丢弃剩余事务 */
+            HAL_I2C_Master_Abort_IT(&U8G2_I2C_HANDLE, u8x8_GetI2CAddress(u8g2_GetU8x8(&g_u8g2)));
+            __disable_irq();
+            u8g2_tx_drop_all();
+            s_tx_dma_busy = 0;
+            __enable_irq();
+            s_tx_error_count++;
+            return -1;
+        }
+    }
+#else
+    (void)timeout_ms;
+#endif
+    return 0;
+}
+
+/**
+ * @brief 设置刷新完成回调
+ */
+void u8g2_set_flush_done_callback(void (*callback)(void))
+{
+#if U8G2_I2C_USE_DMA
+    s_flush_done_cb = callback;
+#else
+    (void)callback;
+#endif
+}
+
+/**
+ * @brief 获取已完成的刷新次数
+ */
+uint32_t u8g2_get_flush_count(void)
+{
+#if U8G2_I2C_USE_DMA
+    return s_flush_done_count;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief 获取I2C事务统计
+ */
+void u8g2_get_tx_stats(u8g2_tx_stats_t *stats)
+{
+    if(stats != NULL)
+    {
+        *stats = s_tx_stats;
+    }
+}
+
+/**
+ * @brief 清零I2C事务统计
+ */
+void u8g2_reset_tx_stats(void)
+{
+    memset(&s_tx_stats, 0, sizeof(s_tx_stats));
+}
+
 /* Private functions ---------------------------------------------------------*/
-/* 无私有函数 */
+/**
+ * @brief 统计一个I2C事务
+ * @param xfer: 事务数据(第一个字节是SSD1306控制字节)
+ * @param len: 事务数据长度
+ * @param ref_len: 零拷贝引用的数据长度(紧跟在xfer后面发送),没有时为0
+ */
+static void u8g2_tx_count(const uint8_t *xfer, uint16_t len, uint16_t ref_len)
+{
+    if(len == 0)
+    {
+        return;
+    }
+
+    s_tx_stats.transactions++;
+    s_tx_stats.wire_bytes += 1 + len + ref_len;   /* 从机地址+控制字节+数据 */
+    if(xfer[0] == U8G2_SSD1306_CTRL_DATA)
+    {
+        s_tx_stats.data_bytes += len - 1 + ref_len;
+    }
+}
+
+#if U8G2_I2C_FULL_PAGE
+/**
+ * @brief 保证当前打开的是指定类型的事务,并且还能写入len字节
+ * @note  类型不同或放不下时结束当前事务,START新事务并写入控制字节
+ */
+static void u8g2_cad_begin(u8x8_t *u8x8, uint8_t ctrl, uint8_t len)
+{
+    if(s_cad_ctrl != ctrl || s_cad_len + len > U8G2_TX_MAX_XFER_LEN)
+    {
+        u8g2_cad_end(u8x8);
+        u8x8_byte_StartTransfer(u8x8);
+        u8x8_byte_SendByte(u8x8, ctrl);
+        s_cad_ctrl = ctrl;
+        s_cad_len = 1;
+    }
+    s_cad_len += len;
+}
+
+/**
+ * @brief 结束当前打开的事务(没有打开的事务时什么都不做)
+ */
+static void u8g2_cad_end(u8x8_t *u8x8)
+{
+    if(s_cad_ctrl != U8G2_CAD_NO_XFER)
+    {
+        u8x8_byte_EndTransfer(u8x8);
+        s_cad_ctrl = U8G2_CAD_NO_XFER;
+    }
+}
+#endif /* U8G2_I2C_FULL_PAGE */
+
+#if U8G2_I2C_USE_DMA
+/**
+ * @brief 为一个新事务预留字节池空间
+ * @note  队列已空时复位字节池;空间不足时等待上一批事务发完(反压)
+ */
+static void u8g2_tx_reserve(void)
+{
+    /* 队列已经排空,字节池和描述符表可以从头开始使用 */
+    if(!u8g2_flush_is_busy())
+    {
+        s_tx_pool_used = 0;
+        s_tx_head = 0;
+        s_tx_tail = 0;
+    }
+
+    /* 空间不足:等待DMA把队列发完,然后复位 */
+    if(s_tx_pool_used + U8G2_TX_MAX_XFER_LEN > U8G2_TX_POOL_SIZE ||
+       s_tx_tail >= U8G2_TX_MAX_TRANSFERS)
+    {
+        u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+        s_tx_pool_used = 0;
+        s_tx_head = 0;
+        s_tx_tail = 0;
+    }
+
+    s_cur_offset = s_tx_pool_used;
+    s_cur_len = 0;
+    s_cur_ref = NULL;
+    s_cur_ref_len = 0;
+    s_cur_ref_buf = U8G2_TX_NO_FRAME_BUF;
+}
+
+/**
+ * @brief 向当前事务复制数据
+ * @note  如果当前事务已经引用了帧缓冲,先把引用的数据复制进来,
+ *        保证事务数据在字节池中是连续的
+ */
+static void u8g2_tx_append(const uint8_t *data, uint8_t len)
+{
+    if(s_cur_ref != NULL)
+    {
+        const uint8_t *ref = s_cur_ref;
+        uint16_t ref_len = s_cur_ref_len;
+
+        s_cur_ref = NULL;
+        s_cur_ref_len = 0;
+        s_cur_ref_buf = U8G2_TX_NO_FRAME_BUF;
+        u8g2_tx_append(ref, (uint8_t)ref_len);
+    }
+
+    while(len > 0 && s_cur_len < U8G2_TX_MAX_XFER_LEN)
+    {
+        s_tx_pool[s_cur_offset + s_cur_len] = *data;
+        s_cur_len++;
+        data++;
+        len--;
+    }
+}
+
+/**
+ * @brief 把组装好的事务放入队列,DMA空闲时立即启动发送
+ */
+static void u8g2_tx_commit(void)
+{
+    u8g2_tx_desc_t *desc = &s_tx_desc[s_tx_tail];
+
+    /* 不是差分刷新发出的GDRAM数据,影子缓冲不再可信 */
+    if(!s_diff_flushing && s_cur_len > 0 && s_tx_pool[s_cur_offset] == U8G2_SSD1306_CTRL_DATA)
+    {
+        s_shadow_valid = 0;
+    }
+
+    if(s_cur_ref != NULL)
+    {
+        /* 零拷贝事务:控制字节 + 帧缓冲中的数据 */
+        desc->data = s_cur_ref;
+        desc->len = s_cur_ref_len;
+        desc->ctrl = s_tx_pool[s_cur_offset];
+        desc->buf_id = s_cur_ref_buf;
+    }
+    else if(s_cur_len > 0)
+    {
+        desc->data = &s_tx_pool[s_cur_offset];
+        desc->len = s_cur_len;
+        desc->ctrl = 0;
+        desc->buf_id = U8G2_TX_NO_FRAME_BUF;
+        s_tx_pool_used += s_cur_len;
+    }
+    else
+    {
+        return;
+    }
+
+    u8g2_tx_count(&s_tx_pool[s_cur_offset], s_cur_len, (s_cur_ref != NULL) ? s_cur_ref_len : 0);
+
+    /* 入队和"是否需要启动DMA"的判断必须是原子的,否则可能和完成中断竞争 */
+    __disable_irq();
+    if(desc->buf_id != U8G2_TX_NO_FRAME_BUF)
+    {
+        s_buf_pending[desc->buf_id]++;
+    }
+    s_tx_tail++;
+    if(!s_tx_dma_busy)
+    {
+        u8g2_tx_start_next();
+    }
+    __enable_irq();
+
+    s_cur_ref = NULL;
+    s_cur_len = 0;
+}
+
+/**
+ * @brief 启动队列头部事务的DMA发送
+ * @note  在完成中断或关中断的临界区内调用
+ *        这里只能用地址阶段由中断推进的HAL函数:HAL_I2C_Mem_Write_DMA等会在调用里
+ *        轮询SB/ADDR标志,超时靠HAL_GetTick,而SysTick优先级低于I2C中断,
+ *        在完成中断里总线一旦卡住就永远等不到超时
+ */
+static void u8g2_tx_start_next(void)
+{
+    uint16_t addr = u8x8_GetI2CAddress(u8g2_GetU8x8(&g_u8g2));
+
+    while(s_tx_head != s_tx_tail)
+    {
+        const u8g2_tx_desc_t *desc = &s_tx_desc[s_tx_head];
+        HAL_StatusTypeDef status;
+
+        s_tx_ctrl_sent = 0;
+        if(desc->buf_id != U8G2_TX_NO_FRAME_BUF)
+        {
+            /* 零拷贝事务第一段:只发控制字节,不产生STOP,完成中断里接着发帧缓冲数据 */
+            status = HAL_I2C_Master_Seq_Transmit_DMA(&U8G2_I2C_HANDLE, addr,
+                                                     (uint8_t *)&desc->ctrl, 1, I2C_FIRST_FRAME);
+        }
+        else
+        {
+            status = HAL_I2C_Master_Transmit_DMA(&U8G2_I2C_HANDLE, addr,
+                                                 (uint8_t *)desc->data, desc->len);
+        }
+
+        if(status == HAL_OK)
+        {
+            s_tx_dma_busy = 1;
+            return;
+        }
+
+        /* 启动失败:丢弃这个事务,继续尝试下一个 */
+        s_tx_error_count++;
+        if(desc->buf_id != U8G2_TX_NO_FRAME_BUF)
+        {
+            s_buf_pending[desc->buf_id]--;
+        }
+        s_tx_head++;
+    }
+
+    /* 队列已排空,一帧刷新完成 */
+    s_tx_dma_busy = 0;
+    s_flush_done_count++;
+    if(s_flush_done_cb != NULL)
+    {
+        s_flush_done_cb();
+    }
+}
+
+/**
+ * @brief 丢弃队列中所有未发送的事务
+ * @note  在中断上下文或关中断的临界区内调用
+ */
+static void u8g2_tx_drop_all(void)
+{
+    s_tx_head = s_tx_tail;
+    s_tx_ctrl_sent = 0;
+    memset((void *)s_buf_pending, 0, sizeof(s_buf_pending));
+
+    /* 丢掉的事务里可能有差分数据,屏幕内容和影子已经对不上 */
+    s_shadow_valid = 0;
+}
+
+/**
+ * @brief 判断指针是否指向某块帧缓冲
+ * @return 帧缓冲编号,不属于帧缓冲时返回U8G2_TX_NO_FRAME_BUF
+ */
+static uint8_t u8g2_frame_buf_of(const uint8_t *ptr)
+{
+    for(uint8_t i = 0; i < U8G2_FRAME_BUF_COUNT; i++)
+    {
+        if(s_frame_buf[i] != NULL &&
+           ptr >= s_frame_buf[i] && ptr < s_frame_buf[i] + U8G2_FRAME_BUF_SIZE)
+        {
+            return i;
+        }
+    }
+    return U8G2_TX_NO_FRAME_BUF;
+}
+
+/**
+ * @brief 栅栏:等待某块帧缓冲不再被DMA引用
+ * @note  超时说明总线卡死,立即丢弃剩余事务,保证函数返回后缓冲可以写
+ */
+static void u8g2_buf_fence(uint8_t buf_id)
+{
+    uint32_t start = HAL_GetTick();
+
+    while(s_buf_pending[buf_id] > 0)
+    {
+        if(HAL_GetTick() - start >= U8G2_FLUSH_TIMEOUT_MS)
+        {
+            u8g2_flush_wait(0);  /* 总线卡死:立即超时并丢弃剩余事务 */
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 一个事务发送完成(DMA完成中断上下文)
+ */
+static void u8g2_tx_done(I2C_HandleTypeDef *hi2c)
+{
+    const u8g2_tx_desc_t *desc;
+
+    if(hi2c->Instance != U8G2_I2C_HANDLE.Instance || s_tx_head == s_tx_tail)
+    {
+        return;
+    }
+
+    desc = &s_tx_desc[s_tx_head];
+    if(desc->buf_id != U8G2_TX_NO_FRAME_BUF && !s_tx_ctrl_sent)
+    {
+        /* 零拷贝事务第二段:控制字节已发出,在同一个事务里发帧缓冲数据并产生STOP */
+        s_tx_ctrl_sent = 1;
+        if(HAL_I2C_Master_Seq_Transmit_DMA(&U8G2_I2C_HANDLE, u8x8_GetI2CAddress(u8g2_GetU8x8(&g_u8g2)),
+                                           (uint8_t *)desc->data, desc->len, I2C_LAST_FRAME) == HAL_OK)
+        {
+            return;
+        }
+
+        /* 数据段启动失败:控制字节后面还没有STOP,手动结束这个事务再丢弃它 */
+        SET_BIT(hi2c->Instance->CR1, I2C_CR1_STOP);
+        s_tx_error_count++;
+    }
+    if(desc->buf_id != U8G2_TX_NO_FRAME_BUF && s_buf_pending[desc->buf_id] > 0)
+    {
+        s_buf_pending[desc->buf_id]--;
+    }
+    s_tx_head++;
+    u8g2_tx_start_next();
+}
+
+/**
+ * @brief I2C主机发送完成回调(HAL库弱函数重写)
+ * @note  复制方式的事务发完一次回调;零拷贝事务的控制字节段和数据段各回调一次
+ */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    u8g2_tx_done(hi2c);
+}
+
+/**
+ * @brief I2C错误回调(HAL库弱函数重写)
+ * @note  出错时丢弃当前帧剩余的事务,下一帧会重新完整发送
+ */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if(hi2c->Instance != U8G2_I2C_HANDLE.Instance)
+    {
+        return;
+    }
+
+    s_tx_error_count++;
+    u8g2_tx_drop_all();
+    u8g2_tx_start_next();
+}
+#endif /* U8G2_I2C_USE_DMA */
 
 /**
  * ============================================================================
@@ -316,8 +1124,20 @@ void u8g2_set_display_on(uint8_t on)
  *
  * 2. 这两个函数是u8g2库与STM32硬件之间的桥梁,缺一不可
  *
- * 3. I2C通信使用STM32 HAL库的HAL_I2C_Master_Transmit()函数
- *    这个函数会自动处理I2C的START、地址、数据、STOP信号
+ * 3. I2C通信默认使用HAL_I2C_Master_Transmit_DMA()(U8G2_I2C_USE_DMA=1)
+ *    u8g2_SendBuffer()只负责把事务放进发送队列,DMA在后台发送
+ *    完成中断(HAL_I2C_MasterTxCpltCallback)自动衔接下一个事务
+ *    需要同步等待时调用u8g2_flush_wait(),查询状态用u8g2_flush_is_busy()
+ *    U8G2_I2C_USE_DMA=0时退回阻塞的HAL_I2C_Master_Transmit()
+ *
+ *    差分刷新:u8g2_send_buffer_diff()对比影子缓冲,只发送变化的tile段,
+ *    数据直接从影子缓冲零拷贝发送;s_buf_pending是影子缓冲的写入栅栏
+ *    零拷贝事务用HAL_I2C_Master_Seq_Transmit_DMA分两段发(控制字节+数据),
+ *    完成中断里不能调用会轮询标志的HAL函数(如HAL_I2C_Mem_Write_DMA)
+ *
+ *    整页事务(U8G2_I2C_FULL_PAGE=1):用u8x8_cad_ssd13xx_page_i2c代替fast_i2c,
+ *    一页128字节数据一个事务,一帧从约64个事务降到16个
+ *    u8g2_get_tx_stats()统计事务数和总线字节数,可以对比两种方式的开销
  *
  * 4. 延迟功能使用HAL_Delay()和空循环实现
  *    如果需要精确的微秒延迟,建议使用DWT或定时器
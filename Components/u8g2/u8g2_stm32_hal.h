@@ -35,8 +35,52 @@ extern "C" {
  */
 #define U8G2_I2C_ADDRESS    (0x3C << 1)
 
+/**
+ * @brief 是否使用DMA非阻塞方式发送I2C数据
+ * @note  1: u8g2_SendBuffer()只把数据放入发送队列立即返回,DMA在后台发送
+ *           (需要CubeMX中为I2C1_TX配置DMA1_Stream6并使能I2C1事件/错误中断)
+ *        0: 使用HAL_I2C_Master_Transmit()阻塞发送(一帧约25ms)
+ */
+#define U8G2_I2C_USE_DMA            1
+
+/**
+ * @brief 是否按整页组织I2C事务
+ * @note  1: 使用u8x8_cad_ssd13xx_page_i2c,每页只有1个命令事务+1个数据事务
+ *           (控制字节+128字节GDRAM数据),一帧16个事务
+ *        0: 使用u8g2自带的u8x8_cad_ssd13xx_fast_i2c,数据按24字节分块,
+ *           每个命令也单独一个事务,一帧约64个事务
+ */
+#define U8G2_I2C_FULL_PAGE          1
+
+/**
+ * @brief DMA发送队列的字节池大小
+ * @note  一整帧(8页,每页1个5字节的命令事务+1个129字节的数据事务)约1.1KB,
+ *        留一些余量;按24字节分块时约1.2KB
+ */
+#define U8G2_TX_POOL_SIZE           1536
+
+/**
+ * @brief DMA发送队列最多容纳的I2C事务数
+ */
+#define U8G2_TX_MAX_TRANSFERS       96
+
+/**
+ * @brief 等待发送队列排空的超时时间(毫秒)
+ * @note  超时说明I2C总线异常,剩余事务会被丢弃
+ */
+#define U8G2_FLUSH_TIMEOUT_MS       100
+
 /* Exported types ------------------------------------------------------------*/
-/* 无需导出类型 */
+/**
+ * @brief I2C事务统计
+ * @note  用来对比不同事务组织方式的协议开销
+ *        每个事务在总线上还有START/STOP和每字节的ACK位,这里只统计字节
+ */
+typedef struct {
+    uint32_t transactions;   /*!< I2C事务数(START...STOP) */
+    uint32_t wire_bytes;     /*!< 总线上的字节数:从机地址+控制字节+命令/数据 */
+    uint32_t data_bytes;     /*!< 其中的GDRAM数据字节数 */
+} u8g2_tx_stats_t;
 
 /* Exported variables --------------------------------------------------------*/
 /**
@@ -78,6 +122,21 @@ uint8_t u8x8_byte_hw_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_p
  */
 uint8_t u8g2_gpio_and_delay_stm32(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
 
+/**
+ * @brief SSD1306的整页I2C命令/数据层(CAD)回调函数
+ * @param u8x8: u8x8结构体指针
+ * @param msg: 消息类型(发送命令、参数、数据等)
+ * @param arg_int: 整数参数(命令字节或数据长度)
+ * @param arg_ptr: 指针参数(数据缓冲区指针)
+ * @return 1表示成功,0表示不支持的消息
+ *
+ * @note 代替u8x8_cad_ssd13xx_fast_i2c:
+ *       - 连续的命令和参数合并成一个事务(控制字节0x00)
+ *       - 连续的数据合并成一个事务(控制字节0x40),一整页128字节一次发完
+ *       u8g2_component_init()在U8G2_I2C_FULL_PAGE=1时自动使用它
+ */
+uint8_t u8x8_cad_ssd13xx_page_i2c(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+
 /* ========== 高层封装接口 ========== */
 
 /**
@@ -111,6 +170,82 @@ u8g2_t* u8g2_get_instance(void);
  */
 void u8g2_clear_screen(void);
 
+/**
+ * @brief 差分刷新:只发送和上一次差分刷新相比有变化的tile
+ * @param u8g2: u8g2实例指针(必须是全缓冲模式)
+ * @return 本帧发送的GDRAM数据字节数,画面没有变化时返回0
+ *
+ * @note 可以直接替换u8g2_SendBuffer(),屏幕上的结果与整帧刷新完全一致
+ *       适合每帧只有少量区域变化的画面(贪吃蛇、推箱子、扫雷、菜单等)
+ *
+ *       内部维护一份"屏幕上当前内容"的影子缓冲(1KB),
+ *       如果屏幕被其他方式刷新过,下一次差分刷新会自动整帧发送
+ */
+uint16_t u8g2_send_buffer_diff(u8g2_t *u8g2);
+
+/**
+ * @brief 让差分刷新的影子缓冲失效
+ *
+ * @note 屏幕内容被u8g2以外的途径改变时调用(比如屏幕掉电重新初始化),
+ *       下一次u8g2_send_buffer_diff()会整帧发送
+ *       经过本适配层发送的整帧刷新会自动失效影子,不需要手动调用
+ */
+void u8g2_invalidate_diff_shadow(void);
+
+/**
+ * @brief 获取上一次差分刷新发送的数据字节数
+ * @return 数据字节数(不含I2C地址、控制字节和寻址命令)
+ */
+uint16_t u8g2_get_diff_bytes(void);
+
+/* ========== 异步刷新(DMA)接口 ========== */
+
+/**
+ * @brief 查询是否有帧正在发送(flush in flight)
+ * @return 1=DMA正在发送或队列中还有事务, 0=空闲
+ *
+ * @note 刷新进行中时u8g2的RAM缓冲区可以立即被修改,
+ *       数据已经复制到发送队列,不会影响正在发送的帧
+ */
+uint8_t u8g2_flush_is_busy(void);
+
+/**
+ * @brief 等待当前帧发送完成
+ * @param timeout_ms: 超时时间(毫秒)
+ * @return 0=发送完成, -1=超时(剩余事务已丢弃)
+ *
+ * @note 需要同步语义的地方调用(比如测试代码、进入低功耗前)
+ */
+int u8g2_flush_wait(uint32_t timeout_ms);
+
+/**
+ * @brief 设置刷新完成回调
+ * @param callback: 回调函数,NULL表示不需要回调
+ *
+ * @note 回调在DMA完成中断上下文中执行,只能做置标志之类的轻量操作
+ */
+void u8g2_set_flush_done_callback(void (*callback)(void));
+
+/**
+ * @brief 获取已完成的刷新次数
+ * @return 发送队列排空的累计次数
+ */
+uint32_t u8g2_get_flush_count(void);
+
+/**
+ * @brief 获取I2C事务统计
+ * @param stats: 输出统计信息
+ *
+ * @note DMA模式下事务入队时就计入统计,不等发送完成
+ *       测量一帧的开销:u8g2_reset_tx_stats() + 发送一帧 + u8g2_get_tx_stats()
+ */
+void u8g2_get_tx_stats(u8g2_tx_stats_t *stats);
+
+/**
+ * @brief 清零I2C事务统计
+ */
+void u8g2_reset_tx_stats(void);
+
 /**
  * @brief 设置显示开关
  * @param on: 1=开启显示, 0=关闭显示(省电模式)
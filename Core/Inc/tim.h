@@ -34,11 +34,14 @@ extern "C" {
 
 extern TIM_HandleTypeDef htim3;
 
+extern TIM_HandleTypeDef htim8;
+
 /* USER CODE BEGIN Private defines */
 
 /* USER CODE END Private defines */
 
 void MX_TIM3_Init(void);
+void MX_TIM8_Init(void);
 
 /* USER CODE BEGIN Prototypes */
 
@@ -100,6 +100,7 @@ int main(void)
   MX_ADC1_Init();
   MX_ADC2_Init();
   MX_TIM3_Init();
+  MX_TIM8_Init();
   MX_I2C1_Init();
   MX_RNG_Init();
   MX_SPI1_Init();
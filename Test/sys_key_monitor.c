@@ -117,6 +117,7 @@ void app_key_event_handler(uint16_t key_id, ebtn_evt_t evt)
     new_event.source_id = key_id;
     new_event.event_type = (uint8_t)evt;
     new_event.data = 0;
+    new_event.timestamp_us = scheduler_get_time_us();
 
     // 2. 推送到 Event Queue
     event_queue_push(new_event);
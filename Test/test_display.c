@@ -0,0 +1,907 @@
+/**
+ ******************************************************************************
+ * @file    test_display.c
+ * @brief   显示刷新链路测试代码实现
+ * @author  老王
+ * @note    这个文件实现OLED刷新链路的测试功能
+ *          所有测试都直接在板子上运行,结果通过串口打印
+ ******************************************************************************
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "test_display.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define TEST_SEND_RETURN_MAX_MS   5    /* SendBuffer()允许的最长返回时间 */
+#define SIM_GRAM_SIZE             (128 * 64 / 8)
+#define SIM_XFER_MAX              160  /* 模拟屏一次I2C事务的最大长度(控制字节+一整页) */
+#define TEST_BENCH_GAME           "Snake"
+#define TEST_BENCH_MS             1500 /* 每种模式运行的时长(贪吃蛇2秒后会撞墙) */
+#define TEST_BLIT_ROUNDS          100  /* 精灵图基准测试的轮数 */
+#define TEST_LAYER_ROUNDS         50   /* 背景层基准测试的帧数 */
+#define TEST_MAZE_W               16   /* 背景层测试迷宫的列数(8x8像素一格) */
+#define TEST_MAZE_H               8    /* 背景层测试迷宫的行数 */
+
+/* Private variables ---------------------------------------------------------*/
+/*
+ * 模拟SSD1306
+ * 独立的u8g2实例,字节回调不走I2C,而是解析SSD1306命令/数据流写入模拟GDRAM
+ */
+static u8g2_t s_sim_u8g2;
+static uint8_t s_sim_buf[SIM_GRAM_SIZE];         /* 模拟实例的帧缓冲 */
+static uint8_t s_sim_gram[SIM_GRAM_SIZE];        /* 模拟屏的GDRAM */
+static uint8_t s_sim_xfer[SIM_XFER_MAX];
+static uint16_t s_sim_xfer_len = 0;
+static uint8_t s_sim_page = 0;
+static uint8_t s_sim_col = 0;
+
+/*
+ * 精灵图测试用的行优先位图(格式同游戏里的sprite数组)
+ * 一个16x16的Boss和一个宽度不是8的倍数的7x6敌机
+ */
+static const uint8_t s_blit_boss[] = {
+    0x03, 0xC0, 0x0F, 0xF0, 0x1F, 0xF8, 0x3D, 0xBC,
+    0x79, 0x9E, 0x7F, 0xFE, 0xFF, 0xFF, 0xE7, 0xE7,
+    0xE7, 0xE7, 0xFF, 0xFF, 0x7F, 0xFE, 0x7B, 0xDE,
+    0x3C, 0x3C, 0x1F, 0xF8, 0x0F, 0xF0, 0x03, 0xC0,
+};
+static const uint8_t s_blit_small[] = {
+    0x38, 0x7C, 0xD6, 0xFE, 0x44, 0x82,
+};
+
+/**
+ * @brief 精灵图测试的绘制位置,包含四条边和四个角上被裁剪的情况
+ */
+static const int16_t s_blit_pos[][2] = {
+    { 10, 10 }, { 57, 21 }, { 100, 40 }, { 3, 47 },
+    { -5, 20 }, { 120, 30 }, { 60, -6 }, { 40, 58 },
+    { -9, -9 }, { 124, 60 }, { -3, 61 }, { 125, -2 },
+};
+
+/**
+ * @brief 跳帧对比测试中一种模式的统计
+ */
+typedef struct {
+    uint64_t task_cycles;       /* game_manager_task_all()累计CPU周期 */
+    uint32_t task_calls;        /* game_manager_task_all()调用次数 */
+    game_render_stats_t render; /* 渲染/跳过的帧数 */
+    uint32_t bytes_sent;        /* 显示服务发送的字节数 */
+} redraw_bench_t;
+
+/* Private function prototypes -----------------------------------------------*/
+static void print_test_result(const char *test_name, display_test_result_t result);
+static void draw_test_pattern(u8g2_t *u8g2, uint8_t seed);
+static uint8_t sim_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+static uint8_t sim_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr);
+static void sim_parse_xfer(void);
+static void run_redraw_bench(uint8_t force_redraw, redraw_bench_t *bench);
+static void sim_setup(void);
+static void ref_draw_bitmap(u8g2_t *u8g2, int16_t x, int16_t y, const uint8_t *bitmap,
+                            uint8_t w, uint8_t h);
+static void make_shifted(const uint8_t *page, uint8_t w, uint8_t h, uint8_t *out);
+static void draw_test_maze(u8g2_t *u8g2, const uint16_t *eaten);
+static void draw_test_maze_cell(u8g2_t *u8g2, uint8_t x, uint8_t y, const uint16_t *eaten);
+#if U8G2_I2C_FULL_PAGE
+static uint32_t measure_frame_tx(u8x8_msg_cb cad_cb, u8g2_tx_stats_t *stats);
+#endif
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 运行所有显示测试
+ */
+void test_display_run_all(void)
+{
+    my_printf(&huart1, "\r\n");
+    my_printf(&huart1, "======== Display Test Suite ========\r\n");
+    my_printf(&huart1, "\r\n");
+
+    print_test_result("Async Flush", test_display_async_flush());
+    print_test_result("Page Transfer", test_display_page_transfer());
+    print_test_result("Redraw Skip", test_display_redraw_skip());
+    print_test_result("Sprite Blit", test_display_sprite_blit());
+    print_test_result("Layer Cache", test_display_layer_cache());
+    print_test_result("Perf HUD", test_display_perf_hud());
+
+    my_printf(&huart1, "\r\n");
+    my_printf(&huart1, "======== Display Tests Complete ========\r\n");
+    my_printf(&huart1, "\r\n");
+}
+
+/**
+ * @brief 异步刷新测试
+ */
+display_test_result_t test_display_async_flush(void)
+{
+    u8g2_t *u8g2 = u8g2_get_instance();
+    uint32_t t_start, t_return, t_done;
+    uint32_t last_tick, ticks_seen = 0;
+
+    my_printf(&huart1, "[TEST] Async flush while CPU keeps running...\r\n");
+
+#if !U8G2_I2C_USE_DMA
+    my_printf(&huart1, "       U8G2_I2C_USE_DMA=0, skipped\r\n");
+    return DISPLAY_TEST_SKIP;
+#else
+    /* 确保从空闲状态开始 */
+    u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+
+    draw_test_pattern(u8g2, 0);
+
+    t_start = HAL_GetTick();
+    u8g2_SendBuffer(u8g2);
+    t_return = HAL_GetTick() - t_start;
+
+    /*
+     * 探针:刷新进行期间每个1ms节拍都应该能执行到这里
+     * 相当于调度器在刷新期间照常运行ebtn/rocker等任务
+     */
+    last_tick = HAL_GetTick();
+    while (u8g2_flush_is_busy())
+    {
+        uint32_t now = HAL_GetTick();
+        if (now != last_tick)
+        {
+            ticks_seen++;
+            last_tick = now;
+        }
+    }
+    t_done = HAL_GetTick() - t_start;
+
+    my_printf(&huart1, "       SendBuffer returned after %lums\r\n", t_return);
+    my_printf(&huart1, "       Frame on the wire after %lums\r\n", t_done);
+    my_printf(&huart1, "       CPU ticks available during flush: %lu\r\n", ticks_seen);
+
+    if (t_return > TEST_SEND_RETURN_MAX_MS)
+    {
+        my_printf(&huart1, "       -> ERROR: SendBuffer blocked on the bus\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    if (t_done > t_return + 1 && ticks_seen + 1 < t_done - t_return)
+    {
+        my_printf(&huart1, "       -> ERROR: CPU was starved during flush\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    return DISPLAY_TEST_PASS;
+#endif
+}
+
+/**
+ * @brief 整页I2C事务对比测试
+ */
+display_test_result_t test_display_page_transfer(void)
+{
+#if U8G2_I2C_FULL_PAGE
+    u8g2_tx_stats_t chunked, paged;
+    uint32_t t_chunked, t_paged;
+
+    my_printf(&huart1, "[TEST] Full-page I2C transfers vs 24-byte chunks...\r\n");
+
+    draw_test_pattern(u8g2_get_instance(), 0);
+    t_chunked = measure_frame_tx(u8x8_cad_ssd13xx_fast_i2c, &chunked);
+    t_paged = measure_frame_tx(u8x8_cad_ssd13xx_page_i2c, &paged);
+
+    my_printf(&huart1, "       24-byte chunks: %lu xfers, %lu wire bytes, %lums\r\n",
+              chunked.transactions, chunked.wire_bytes, t_chunked);
+    my_printf(&huart1, "       Full pages:     %lu xfers, %lu wire bytes, %lums\r\n",
+              paged.transactions, paged.wire_bytes, t_paged);
+
+    /* 两种方式发送的GDRAM数据必须一样多,整页方式的事务数和总线字节数必须更少 */
+    if (paged.data_bytes != chunked.data_bytes)
+    {
+        my_printf(&huart1, "       -> ERROR: data bytes differ (%lu vs %lu)\r\n",
+                  paged.data_bytes, chunked.data_bytes);
+        return DISPLAY_TEST_FAIL;
+    }
+    if (paged.transactions >= chunked.transactions || paged.wire_bytes >= chunked.wire_bytes)
+    {
+        my_printf(&huart1, "       -> ERROR: full pages saved no overhead\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    return DISPLAY_TEST_PASS;
+#else
+    my_printf(&huart1, "[TEST] Full-page I2C transfers vs 24-byte chunks...\r\n");
+    my_printf(&huart1, "       U8G2_I2C_FULL_PAGE=0, skipped\r\n");
+    return DISPLAY_TEST_SKIP;
+#endif
+}
+
+/**
+ * @brief 跳帧收益对比测试
+ */
+display_test_result_t test_display_redraw_skip(void)
+{
+    redraw_bench_t always, skip;
+
+    my_printf(&huart1, "[TEST] Redraw on change vs every tick (%s, %ums)...\r\n",
+              TEST_BENCH_GAME, TEST_BENCH_MS);
+
+    /* 使能DWT周期计数器 */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    run_redraw_bench(1, &always);
+    run_redraw_bench(0, &skip);
+
+    if (always.task_calls == 0 || skip.task_calls == 0)
+    {
+        my_printf(&huart1, "       -> ERROR: game \"%s\" not registered\r\n", TEST_BENCH_GAME);
+        return DISPLAY_TEST_FAIL;
+    }
+
+    my_printf(&huart1, "       Every tick: %lu frames, %lu cycles/tick, %lu bytes\r\n",
+              always.render.rendered_frames,
+              (uint32_t)(always.task_cycles / always.task_calls), always.bytes_sent);
+    my_printf(&huart1, "       On change:  %lu frames (%lu skipped), %lu cycles/tick, %lu bytes\r\n",
+              skip.render.rendered_frames, skip.render.skipped_frames,
+              (uint32_t)(skip.task_cycles / skip.task_calls), skip.bytes_sent);
+
+    /* 跳帧模式下渲染的帧数和CPU周期都不应该比每帧渲染多 */
+    if (skip.render.rendered_frames >= always.render.rendered_frames ||
+        skip.task_cycles >= always.task_cycles)
+    {
+        my_printf(&huart1, "       -> ERROR: skipping frames saved nothing\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    return DISPLAY_TEST_PASS;
+}
+
+/**
+ * @brief 精灵图绘制一致性和速度测试
+ */
+display_test_result_t test_display_sprite_blit(void)
+{
+    static uint8_t expect[SIM_GRAM_SIZE];
+    static uint8_t boss_shifted[7 * SPRITE_PAGE_DATA_SIZE(16, 16 + 8)];
+    static uint8_t small_shifted[7 * SPRITE_PAGE_DATA_SIZE(7, 6 + 8)];
+    uint8_t boss_page[SPRITE_PAGE_DATA_SIZE(16, 16)];
+    uint8_t small_page[SPRITE_PAGE_DATA_SIZE(7, 6)];
+    sprite_t boss = { 16, 16, boss_page, NULL };
+    sprite_t small = { 7, 6, small_page, NULL };
+    sprite_t boss_pre = { 16, 16, boss_page, boss_shifted };
+    sprite_t small_pre = { 7, 6, small_page, small_shifted };
+    uint8_t pos_count = sizeof(s_blit_pos) / sizeof(s_blit_pos[0]);
+    uint32_t start, cycles_ref, cycles_bitmap, cycles_page;
+    uint32_t sprites = (uint32_t)TEST_BLIT_ROUNDS * pos_count * 2;
+
+    my_printf(&huart1, "[TEST] Sprite blit vs per-pixel draw_bitmap...\r\n");
+
+    /* 模拟实例的缓冲不会被发送,这里只用它做绘制目标 */
+    sim_setup();
+    sprite_convert_bitmap(s_blit_boss, 16, 16, boss_page);
+    sprite_convert_bitmap(s_blit_small, 7, 6, small_page);
+    make_shifted(boss_page, 16, 16, boss_shifted);
+    make_shifted(small_page, 7, 6, small_shifted);
+
+    /* 1. 一致性:三种写入方式、每个位置,结果必须和逐像素绘制完全相同 */
+    for (uint8_t mode = SPRITE_MODE_OR; mode <= SPRITE_MODE_CLEAR; mode++)
+    {
+        for (uint8_t i = 0; i < pos_count; i++)
+        {
+            int16_t x = s_blit_pos[i][0];
+            int16_t y = s_blit_pos[i][1];
+
+            /* 底图用测试图案,CLEAR和XOR才有东西可擦/可翻 */
+            draw_test_pattern(&s_sim_u8g2, i);
+            u8g2_SetDrawColor(&s_sim_u8g2, (mode == SPRITE_MODE_OR) ? 1 : (mode == SPRITE_MODE_XOR) ? 2 : 0);
+            ref_draw_bitmap(&s_sim_u8g2, x, y, s_blit_boss, 16, 16);
+            ref_draw_bitmap(&s_sim_u8g2, x + 3, y + 5, s_blit_small, 7, 6);
+            u8g2_SetDrawColor(&s_sim_u8g2, 1);
+            memcpy(expect, s_sim_buf, SIM_GRAM_SIZE);
+
+            draw_test_pattern(&s_sim_u8g2, i);
+            sprite_blit_bitmap(&s_sim_u8g2, x, y, s_blit_boss, 16, 16, (sprite_mode_t)mode);
+            sprite_blit_bitmap(&s_sim_u8g2, x + 3, y + 5, s_blit_small, 7, 6, (sprite_mode_t)mode);
+            if (memcmp(expect, s_sim_buf, SIM_GRAM_SIZE) != 0)
+            {
+                my_printf(&huart1, "       -> ERROR: bitmap blit differs at (%d,%d) mode %u\r\n", x, y, mode);
+                return DISPLAY_TEST_FAIL;
+            }
+
+            draw_test_pattern(&s_sim_u8g2, i);
+            sprite_blit(&s_sim_u8g2, x, y, &boss, (sprite_mode_t)mode);
+            sprite_blit(&s_sim_u8g2, x + 3, y + 5, &small, (sprite_mode_t)mode);
+            if (memcmp(expect, s_sim_buf, SIM_GRAM_SIZE) != 0)
+            {
+                my_printf(&huart1, "       -> ERROR: page blit differs at (%d,%d) mode %u\r\n", x, y, mode);
+                return DISPLAY_TEST_FAIL;
+            }
+
+            /* 预移位数据(资源编译器生成的格式)画出来也必须一样 */
+            draw_test_pattern(&s_sim_u8g2, i);
+            sprite_blit(&s_sim_u8g2, x, y, &boss_pre, (sprite_mode_t)mode);
+            sprite_blit(&s_sim_u8g2, x + 3, y + 5, &small_pre, (sprite_mode_t)mode);
+            if (memcmp(expect, s_sim_buf, SIM_GRAM_SIZE) != 0)
+            {
+                my_printf(&huart1, "       -> ERROR: pre-shifted blit differs at (%d,%d) mode %u\r\n", x, y, mode);
+                return DISPLAY_TEST_FAIL;
+            }
+        }
+    }
+
+    /* 2. 速度:同样的精灵和位置各画TEST_BLIT_ROUNDS轮,比较CPU周期 */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    start = DWT->CYCCNT;
+    for (uint16_t round = 0; round < TEST_BLIT_ROUNDS; round++)
+    {
+        for (uint8_t i = 0; i < pos_count; i++)
+        {
+            ref_draw_bitmap(&s_sim_u8g2, s_blit_pos[i][0], s_blit_pos[i][1], s_blit_boss, 16, 16);
+            ref_draw_bitmap(&s_sim_u8g2, s_blit_pos[i][0], s_blit_pos[i][1], s_blit_small, 7, 6);
+        }
+    }
+    cycles_ref = DWT->CYCCNT - start;
+
+    start = DWT->CYCCNT;
+    for (uint16_t round = 0; round < TEST_BLIT_ROUNDS; round++)
+    {
+        for (uint8_t i = 0; i < pos_count; i++)
+        {
+            sprite_blit_bitmap(&s_sim_u8g2, s_blit_pos[i][0], s_blit_pos[i][1], s_blit_boss, 16, 16, SPRITE_MODE_OR);
+            sprite_blit_bitmap(&s_sim_u8g2, s_blit_pos[i][0], s_blit_pos[i][1], s_blit_small, 7, 6, SPRITE_MODE_OR);
+        }
+    }
+    cycles_bitmap = DWT->CYCCNT - start;
+
+    start = DWT->CYCCNT;
+    for (uint16_t round = 0; round < TEST_BLIT_ROUNDS; round++)
+    {
+        for (uint8_t i = 0; i < pos_count; i++)
+        {
+            sprite_blit(&s_sim_u8g2, s_blit_pos[i][0], s_blit_pos[i][1], &boss, SPRITE_MODE_OR);
+            sprite_blit(&s_sim_u8g2, s_blit_pos[i][0], s_blit_pos[i][1], &small, SPRITE_MODE_OR);
+        }
+    }
+    cycles_page = DWT->CYCCNT - start;
+
+    my_printf(&huart1, "       Per-pixel:    %lu cycles/sprite\r\n", cycles_ref / sprites);
+    my_printf(&huart1, "       Bitmap blit:  %lu cycles/sprite\r\n", cycles_bitmap / sprites);
+    my_printf(&huart1, "       Page blit:    %lu cycles/sprite\r\n", cycles_page / sprites);
+
+    if (cycles_bitmap >= cycles_ref || cycles_page >= cycles_bitmap)
+    {
+        my_printf(&huart1, "       -> ERROR: blitter is not faster\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    return DISPLAY_TEST_PASS;
+}
+
+/**
+ * @brief 背景层缓存一致性和速度测试
+ */
+display_test_result_t test_display_layer_cache(void)
+{
+    static uint8_t expect[SIM_GRAM_SIZE];
+    static uint8_t owner_a;
+    static uint8_t owner_b;
+    static const uint8_t eat_pos[][2] = { {1, 1}, {14, 1}, {5, 3}, {6, 3}, {12, 6} };
+    uint16_t eaten[TEST_MAZE_H];
+    uint8_t *draw_buf;
+    layer_stats_t stats;
+    uint32_t start, cycles_full, cycles_layer;
+
+    my_printf(&huart1, "[TEST] Background layer cache vs full redraw...\r\n");
+
+    sim_setup();
+    draw_buf = u8g2_GetBufferPtr(&s_sim_u8g2);
+    memset(eaten, 0, sizeof(eaten));
+    layer_invalidate();
+
+    /* 1. 缓存无效时不能复制 */
+    if (layer_blit(&s_sim_u8g2, &owner_a))
+    {
+        my_printf(&huart1, "       -> ERROR: blit from an invalid cache\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    /* 2. 重建后"复制背景+画角色"必须和"清屏+整图+画角色"完全相同 */
+    draw_test_maze(&s_sim_u8g2, eaten);
+    u8g2_DrawDisc(&s_sim_u8g2, 28, 20, 3, U8G2_DRAW_ALL);
+    memcpy(expect, draw_buf, SIM_GRAM_SIZE);
+
+    layer_begin_rebuild(&s_sim_u8g2, &owner_a);
+    draw_test_maze(&s_sim_u8g2, eaten);
+    layer_end(&s_sim_u8g2);
+    if (u8g2_GetBufferPtr(&s_sim_u8g2) != draw_buf)
+    {
+        my_printf(&huart1, "       -> ERROR: draw buffer not restored\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    memset(draw_buf, 0x5A, SIM_GRAM_SIZE);   /* 上一帧的残留必须被整块覆盖 */
+    if (!layer_blit(&s_sim_u8g2, &owner_a))
+    {
+        my_printf(&huart1, "       -> ERROR: blit after rebuild failed\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+    u8g2_DrawDisc(&s_sim_u8g2, 28, 20, 3, U8G2_DRAW_ALL);
+    if (memcmp(expect, draw_buf, SIM_GRAM_SIZE) != 0)
+    {
+        my_printf(&huart1, "       -> ERROR: cached frame differs from full redraw\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    /* 3. 逐格局部更新(吃豆子)后,缓存必须和整图重画的结果相同 */
+    for (uint8_t i = 0; i < sizeof(eat_pos) / sizeof(eat_pos[0]); i++)
+    {
+        uint8_t x = eat_pos[i][0];
+        uint8_t y = eat_pos[i][1];
+
+        eaten[y] |= (uint16_t)(1 << x);
+        if (!layer_begin_update(&s_sim_u8g2, &owner_a))
+        {
+            my_printf(&huart1, "       -> ERROR: update rejected by owner\r\n");
+            return DISPLAY_TEST_FAIL;
+        }
+        u8g2_SetDrawColor(&s_sim_u8g2, 0);
+        u8g2_DrawBox(&s_sim_u8g2, x * 8, y * 8, 8, 8);
+        u8g2_SetDrawColor(&s_sim_u8g2, 1);
+        draw_test_maze_cell(&s_sim_u8g2, x, y, eaten);
+        layer_end(&s_sim_u8g2);
+
+        draw_test_maze(&s_sim_u8g2, eaten);
+        memcpy(expect, draw_buf, SIM_GRAM_SIZE);
+        memset(draw_buf, 0, SIM_GRAM_SIZE);
+        layer_blit(&s_sim_u8g2, &owner_a);
+        if (memcmp(expect, draw_buf, SIM_GRAM_SIZE) != 0)
+        {
+            my_printf(&huart1, "       -> ERROR: cell update at (%u,%u) differs\r\n", x, y);
+            return DISPLAY_TEST_FAIL;
+        }
+    }
+
+    /* 4. 别的持有者不能使用缓存,作废之后也不能 */
+    if (layer_blit(&s_sim_u8g2, &owner_b) || layer_begin_update(&s_sim_u8g2, &owner_b))
+    {
+        my_printf(&huart1, "       -> ERROR: cache shared between owners\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+    layer_invalidate();
+    if (layer_blit(&s_sim_u8g2, &owner_a))
+    {
+        my_printf(&huart1, "       -> ERROR: blit after invalidate\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    /* 5. 速度:每帧整图重画 vs 每帧复制缓存 */
+    layer_begin_rebuild(&s_sim_u8g2, &owner_a);
+    draw_test_maze(&s_sim_u8g2, eaten);
+    layer_end(&s_sim_u8g2);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    start = DWT->CYCCNT;
+    for (uint16_t round = 0; round < TEST_LAYER_ROUNDS; round++)
+    {
+        draw_test_maze(&s_sim_u8g2, eaten);
+    }
+    cycles_full = DWT->CYCCNT - start;
+
+    start = DWT->CYCCNT;
+    for (uint16_t round = 0; round < TEST_LAYER_ROUNDS; round++)
+    {
+        layer_blit(&s_sim_u8g2, &owner_a);
+    }
+    cycles_layer = DWT->CYCCNT - start;
+
+    layer_invalidate();
+    layer_get_stats(&stats);
+
+    my_printf(&huart1, "       Full redraw:  %lu cycles/frame\r\n", cycles_full / TEST_LAYER_ROUNDS);
+    my_printf(&huart1, "       Layer blit:   %lu cycles/frame\r\n", cycles_layer / TEST_LAYER_ROUNDS);
+    my_printf(&huart1, "       Rebuilds %lu, cell updates %lu, blits %lu\r\n",
+              stats.rebuilds, stats.updates, stats.blits);
+
+    if (cycles_layer >= cycles_full)
+    {
+        my_printf(&huart1, "       -> ERROR: layer blit is not faster\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    return DISPLAY_TEST_PASS;
+}
+
+/**
+ * @brief 性能浮层叠加/恢复测试
+ */
+display_test_result_t test_display_perf_hud(void)
+{
+    static uint8_t expect[SIM_GRAM_SIZE];
+    uint8_t *draw_buf;
+    uint8_t was_enabled = perf_hud_is_enabled();
+    uint8_t page_changed = 0;
+    uint32_t start, cycles;
+
+    my_printf(&huart1, "[TEST] Perf HUD overlay save/restore...\r\n");
+
+    sim_setup();
+    draw_buf = u8g2_GetBufferPtr(&s_sim_u8g2);
+    for (uint16_t i = 0; i < SIM_GRAM_SIZE; i++)
+    {
+        draw_buf[i] = (uint8_t)(i * 37 + 11);
+    }
+    memcpy(expect, draw_buf, SIM_GRAM_SIZE);
+
+    /* 1. 关闭时不能碰绘制缓冲 */
+    perf_hud_set_enabled(0);
+    perf_hud_overlay_begin(&s_sim_u8g2);
+    perf_hud_overlay_end(&s_sim_u8g2);
+    if (memcmp(expect, draw_buf, SIM_GRAM_SIZE) != 0)
+    {
+        my_printf(&huart1, "       -> ERROR: disabled overlay touched the buffer\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    /* 2. 打开后只改浮层所在的一页,结束后完全恢复 */
+    perf_hud_set_enabled(1);
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    start = DWT->CYCCNT;
+    perf_hud_overlay_begin(&s_sim_u8g2);
+    cycles = DWT->CYCCNT - start;
+
+    for (uint16_t i = 0; i < SIM_GRAM_SIZE; i++)
+    {
+        uint8_t in_page = (i / 128 == PERF_HUD_PAGE);
+
+        if (!in_page && draw_buf[i] != expect[i])
+        {
+            perf_hud_overlay_end(&s_sim_u8g2);
+            perf_hud_set_enabled(was_enabled);
+            my_printf(&huart1, "       -> ERROR: overlay wrote outside its page at %u\r\n", i);
+            return DISPLAY_TEST_FAIL;
+        }
+        if (in_page && draw_buf[i] != expect[i])
+        {
+            page_changed = 1;
+        }
+    }
+
+    start = DWT->CYCCNT;
+    perf_hud_overlay_end(&s_sim_u8g2);
+    cycles += DWT->CYCCNT - start;
+    perf_hud_set_enabled(was_enabled);
+
+    my_printf(&huart1, "       Overlay begin+end: %lu cycles/frame\r\n", cycles);
+
+    if (!page_changed)
+    {
+        my_printf(&huart1, "       -> ERROR: overlay not drawn\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+    if (memcmp(expect, draw_buf, SIM_GRAM_SIZE) != 0)
+    {
+        my_printf(&huart1, "       -> ERROR: draw buffer not restored\r\n");
+        return DISPLAY_TEST_FAIL;
+    }
+
+    return DISPLAY_TEST_PASS;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+ * @brief 打印测试结果
+ */
+static void print_test_result(const char *test_name, display_test_result_t result)
+{
+    const char *result_str;
+
+    switch (result) {
+        case DISPLAY_TEST_PASS:
+            result_str = "[PASS]";
+            break;
+        case DISPLAY_TEST_FAIL:
+            result_str = "[FAIL]";
+            break;
+        case DISPLAY_TEST_SKIP:
+            result_str = "[SKIP]";
+            break;
+        default:
+            result_str = "[????]";
+            break;
+    }
+
+    my_printf(&huart1, "%s %-20s\r\n", result_str, test_name);
+}
+
+/**
+ * @brief 绘制测试图案(每个seed得到不同的画面)
+ */
+static void draw_test_pattern(u8g2_t *u8g2, uint8_t seed)
+{
+    u8g2_ClearBuffer(u8g2);
+    u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+    u8g2_DrawBox(u8g2, (seed * 7) % 112, 8, 16, 16);
+    u8g2_DrawCircle(u8g2, 64, 40, 12 + (seed % 8), U8G2_DRAW_ALL);
+    u8g2_SetFont(u8g2, u8g2_font_6x10_tf);
+    u8g2_DrawStr(u8g2, 4, 60, "Display Test");
+}
+
+/**
+ * @brief 建立模拟SSD1306的u8g2实例
+ * @note  模拟实例使用自己的帧缓冲,不能占用g_u8g2的缓冲
+ */
+static void sim_setup(void)
+{
+    u8g2_SetupDisplay(&s_sim_u8g2, u8x8_d_ssd1306_128x64_noname,
+                      u8x8_cad_ssd13xx_page_i2c, sim_byte_cb, sim_gpio_and_delay_cb);
+    u8g2_SetupBuffer(&s_sim_u8g2, s_sim_buf, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+}
+
+/**
+ * @brief 逐像素绘制位图(游戏里原来的draw_bitmap实现,作为对照)
+ */
+static void ref_draw_bitmap(u8g2_t *u8g2, int16_t x, int16_t y, const uint8_t *bitmap,
+                            uint8_t w, uint8_t h)
+{
+    uint8_t bytes_per_row = (w + 7) / 8;
+
+    for (uint8_t row = 0; row < h; row++)
+    {
+        for (uint8_t col = 0; col < w; col++)
+        {
+            uint8_t byte_index = row * bytes_per_row + (col / 8);
+            uint8_t bit_index = 7 - (col % 8);
+
+            /* u8g2_uint_t是8位的,负坐标会回绕到屏幕另一侧,这里先裁掉 */
+            if (x + col < 0 || y + row < 0)
+            {
+                continue;
+            }
+
+            if (bitmap[byte_index] & (1 << bit_index))
+            {
+                u8g2_DrawPixel(u8g2, x + col, y + row);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 生成预移位数据(和Tools/asset_compiler输出的格式相同)
+ * @note  y%8为1~7各一份,每份比原数据多一页
+ */
+static void make_shifted(const uint8_t *page, uint8_t w, uint8_t h, uint8_t *out)
+{
+    uint8_t pages = (h + 7) / 8;
+
+    for (uint8_t shift = 1; shift < 8; shift++)
+    {
+        for (uint8_t col = 0; col < w; col++)
+        {
+            uint16_t carry = 0;
+
+            for (uint8_t p = 0; p <= pages; p++)
+            {
+                uint16_t v = (p < pages) ? ((uint16_t)page[p * w + col] << shift) : 0;
+
+                out[p * w + col] = (uint8_t)(v | carry);
+                carry = v >> 8;
+            }
+        }
+        out += (pages + 1) * w;
+    }
+}
+
+/**
+ * @brief 画背景层测试用的迷宫(清屏后逐格画,和吃豆人的render_maze一样)
+ * @param eaten 每行一个位图,置位的格子豆子已被吃掉
+ */
+static void draw_test_maze(u8g2_t *u8g2, const uint16_t *eaten)
+{
+    u8g2_ClearBuffer(u8g2);
+    for (uint8_t y = 0; y < TEST_MAZE_H; y++)
+    {
+        for (uint8_t x = 0; x < TEST_MAZE_W; x++)
+        {
+            draw_test_maze_cell(u8g2, x, y, eaten);
+        }
+    }
+}
+
+/**
+ * @brief 画测试迷宫中的一格:边上和固定位置是墙,其余是豆子
+ */
+static void draw_test_maze_cell(u8g2_t *u8g2, uint8_t x, uint8_t y, const uint16_t *eaten)
+{
+    if (x == 0 || y == 0 || x == TEST_MAZE_W - 1 || y == TEST_MAZE_H - 1 || ((x * 3 + y) % 5) == 0)
+    {
+        u8g2_DrawBox(u8g2, x * 8, y * 8, 8, 8);
+    }
+    else if (!(eaten[y] & (1 << x)))
+    {
+        if ((x + y) % 6 == 0)
+        {
+            u8g2_DrawDisc(u8g2, x * 8 + 4, y * 8 + 4, 2, U8G2_DRAW_ALL);
+        }
+        else
+        {
+            u8g2_DrawPixel(u8g2, x * 8 + 4, y * 8 + 4);
+        }
+    }
+}
+
+/**
+ * @brief 模拟屏字节回调:收集一次I2C事务,结束时解析
+ */
+static uint8_t sim_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    uint8_t *data = (uint8_t *)arg_ptr;
+
+    switch (msg)
+    {
+        case U8X8_MSG_BYTE_START_TRANSFER:
+            s_sim_xfer_len = 0;
+            break;
+
+        case U8X8_MSG_BYTE_SEND:
+            while (arg_int > 0 && s_sim_xfer_len < SIM_XFER_MAX)
+            {
+                s_sim_xfer[s_sim_xfer_len++] = *data++;
+                arg_int--;
+            }
+            break;
+
+        case U8X8_MSG_BYTE_END_TRANSFER:
+            sim_parse_xfer();
+            break;
+
+        default:
+            break;
+    }
+
+    return 1;
+}
+
+/**
+ * @brief 模拟屏GPIO/延迟回调:什么都不用做
+ */
+static uint8_t sim_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    return 1;
+}
+
+/**
+ * @brief 解析一次I2C事务(页寻址模式)
+ * @note  控制字节0x00:后面全是命令; 0x40:后面全是GDRAM数据
+ */
+static void sim_parse_xfer(void)
+{
+    if (s_sim_xfer_len == 0)
+    {
+        return;
+    }
+
+    if (s_sim_xfer[0] == 0x40)
+    {
+        /* GDRAM数据:写入当前页,列地址自动递增 */
+        for (uint16_t i = 1; i < s_sim_xfer_len; i++)
+        {
+            if (s_sim_col < 128)
+            {
+                s_sim_gram[s_sim_page * 128 + s_sim_col] = s_sim_xfer[i];
+            }
+            s_sim_col++;
+        }
+        return;
+    }
+
+    for (uint16_t i = 1; i < s_sim_xfer_len; i++)
+    {
+        uint8_t c = s_sim_xfer[i];
+
+        if (c >= 0xB0 && c <= 0xB7)
+        {
+            s_sim_page = c & 0x07;                                 /* 页地址 */
+        }
+        else if (c <= 0x0F)
+        {
+            s_sim_col = (s_sim_col & 0xF0) | (c & 0x0F);           /* 列地址低4位 */
+        }
+        else if (c >= 0x10 && c <= 0x1F)
+        {
+            s_sim_col = (s_sim_col & 0x0F) | ((c & 0x0F) << 4);    /* 列地址高4位 */
+        }
+        else if (c == 0x21 || c == 0x22)
+        {
+            i += 2;                                                /* 带2个参数的命令 */
+        }
+        else if (c == 0x20 || c == 0x81 || c == 0x8D || c == 0xA8 || c == 0xD3 ||
+                 c == 0xD5 || c == 0xD9 || c == 0xDA || c == 0xDB)
+        {
+            i += 1;                                                /* 带1个参数的命令 */
+        }
+    }
+}
+
+#if U8G2_I2C_FULL_PAGE
+/**
+ * @brief 用指定的CAD整帧发送一次g_u8g2的缓冲,统计事务开销
+ * @param cad_cb 临时使用的CAD回调
+ * @param stats 输出这一帧的事务统计
+ * @return 从开始发送到发送完成的时间(ms)
+ */
+static uint32_t measure_frame_tx(u8x8_msg_cb cad_cb, u8g2_tx_stats_t *stats)
+{
+    u8g2_t *u8g2 = u8g2_get_instance();
+    u8x8_msg_cb saved_cad = u8g2->u8x8.cad_cb;
+    uint32_t start;
+
+    u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+    u8g2->u8x8.cad_cb = cad_cb;
+
+    u8g2_reset_tx_stats();
+    start = HAL_GetTick();
+    u8g2_SendBuffer(u8g2);
+    u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+    u8g2_get_tx_stats(stats);
+
+    u8g2->u8x8.cad_cb = saved_cad;
+    return HAL_GetTick() - start;
+}
+#endif
+
+/**
+ * @brief 按调度器的节拍运行一段时间游戏,统计CPU周期和I2C字节数
+ * @param force_redraw 1=每帧都渲染,0=画面变化才渲染
+ * @param bench 输出统计
+ */
+static void run_redraw_bench(uint8_t force_redraw, redraw_bench_t *bench)
+{
+    uint32_t start, last_game = 0, last_display = 0;
+    display_service_stats_t display_stats;
+
+    memset(bench, 0, sizeof(*bench));
+
+    if (game_manager_start_game(TEST_BENCH_GAME) != 0)
+    {
+        return;
+    }
+
+    game_manager_set_force_redraw(force_redraw);
+    game_manager_reset_render_stats();
+    display_service_reset_stats();
+
+    start = HAL_GetTick();
+    while (HAL_GetTick() - start < TEST_BENCH_MS)
+    {
+        uint32_t now = HAL_GetTick();
+
+        /* 游戏任务10ms一次,显示服务按自己的周期 */
+        if (now - last_game >= 10)
+        {
+            uint32_t cycles = DWT->CYCCNT;
+
+            last_game = now;
+            game_manager_task_all();
+            bench->task_cycles += DWT->CYCCNT - cycles;
+            bench->task_calls++;
+        }
+
+        if (now - last_display >= DISPLAY_SERVICE_TASK_PERIOD_MS)
+        {
+            last_display = now;
+            display_service_task();
+        }
+    }
+
+    game_manager_get_render_stats(TEST_BENCH_GAME, &bench->render);
+    display_service_get_stats(&display_stats);
+    bench->bytes_sent = display_stats.bytes_sent;
+
+    game_manager_set_force_redraw(0);
+    game_manager_exit_current_game();
+}
+
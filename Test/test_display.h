@@ -0,0 +1,97 @@
+/**
+ ******************************************************************************
+ * @file    test_display.h
+ * @brief   显示刷新链路测试代码头文件
+ * @author  老王
+ * @note    这个文件提供OLED刷新链路(u8g2适配层)的测试函数
+ *          测试结果通过串口(USART1)打印
+ ******************************************************************************
+ */
+
+#ifndef __TEST_DISPLAY_H__
+#define __TEST_DISPLAY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "mydefine.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 显示测试结果枚举
+ */
+typedef enum {
+    DISPLAY_TEST_PASS = 0,    // 测试通过
+    DISPLAY_TEST_FAIL,        // 测试失败
+    DISPLAY_TEST_SKIP         // 测试跳过
+} display_test_result_t;
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+ * @brief 运行所有显示测试
+ * @note  必须在u8g2_component_init()之后调用
+ */
+void test_display_run_all(void);
+
+/* ========== 各种测试函数 ========== */
+
+/**
+ * @brief 异步刷新测试
+ * @note  验证u8g2_SendBuffer()立即返回,并且在一帧发送期间
+ *        CPU可以继续执行其他任务(每个1ms节拍都能跑到探针代码)
+ * @return 测试结果
+ */
+display_test_result_t test_display_async_flush(void);
+
+/**
+ * @brief 整页I2C事务对比测试
+ * @note  同一帧分别用fast_i2c(24字节分块)和整页CAD发送到真实屏幕,
+ *        打印两种方式的事务数、总线字节数和耗时,整页方式的开销必须更小
+ * @return 测试结果
+ */
+display_test_result_t test_display_page_transfer(void);
+
+/**
+ * @brief 跳帧收益对比测试
+ * @note  用贪吃蛇分别在"每帧都渲染"和"画面变化才渲染"两种模式下运行同样时长,
+ *        对比游戏任务的CPU周期数(DWT)和显示服务发送的I2C字节数
+ *        会启动和退出游戏,必须在system_assembly_init()之后调用
+ * @return 测试结果
+ */
+display_test_result_t test_display_redraw_skip(void);
+
+/**
+ * @brief 精灵图绘制一致性和速度测试
+ * @note  在模拟实例的帧缓冲上,用逐像素的draw_bitmap、sprite_blit_bitmap和
+ *        sprite_blit(不带/带预移位数据)分别绘制同一组精灵(含四边裁剪、三种写入方式),
+ *        结果必须完全相同;
+ *        再用DWT比较三种方式每个精灵的CPU周期
+ * @return 测试结果
+ */
+display_test_result_t test_display_sprite_blit(void);
+
+/**
+ * @brief 背景层缓存测试
+ * @note  在模拟实例上验证:重建后复制的背景和每帧整图重画完全相同,
+ *        逐格局部更新后仍然相同,换持有者和作废后缓存不能再用;
+ *        再用DWT比较整图重画和复制缓存每帧的CPU周期
+ * @return 测试结果
+ */
+display_test_result_t test_display_layer_cache(void);
+
+/**
+ * @brief 性能浮层测试
+ * @note  在模拟实例上验证:浮层关闭时不碰绘制缓冲,打开时只改浮层所在的一页,
+ *        发送结束后被盖住的内容完全恢复;并输出每帧叠加/恢复的CPU周期
+ * @return 测试结果
+ */
+display_test_result_t test_display_perf_hud(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TEST_DISPLAY_H__ */
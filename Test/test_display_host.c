@@ -0,0 +1,726 @@
+// =============================================================================
+// OLED 异步刷新 主机测试（在PC上运行，不加入Keil工程）
+// =============================================================================
+//
+// 编译运行（在仓库根目录）：
+//   gcc -O2 -IApp/sys -IComponents/scheduler -IComponents/u8g2 -ICore/Inc Test/test_display_host.c $(ls Components/u8g2/u8*.c | grep -v stm32_hal) -o /tmp/test_display
+//   /tmp/test_display
+//
+// 真实的 u8g2 库 + u8g2_stm32_hal.c 的 DMA 发送队列 + 调度器，跑在虚拟时钟上：
+// - HAL_I2C_Master_Transmit_DMA / HAL_I2C_Master_Seq_Transmit_DMA 只记录传输，按 400kHz 算出发送耗时；
+// - 到时刻后在“中断”里调用 HAL 的发送完成回调，驱动程序在回调里启动下一个事务；
+// - DMA 在完成时才从内存取数据，写进模拟的 SSD1306 GDRAM（页寻址）；发送期间数据被改写算撕裂；
+// - HAL_GetTick 每调用一次过去 1us：驱动程序只有忙等时才会调用它，忙等就表现为时间流逝。
+// 1. u8g2_SendBuffer 入队就返回，不等总线，整帧在后台发完后 GDRAM 和缓冲一致；
+// 2. 调度器照常运行：30 帧/秒刷新的同时，1ms 任务一个节拍都不少，刷新期间也在运行；
+// 3. 差分刷新：随机改动的画面经 DMA 零拷贝发送后，模拟屏的 GDRAM 和另一块屏整帧刷新的结果相同，
+//    上一帧还在总线上时就画下一帧也一样（影子缓冲的栅栏）；
+// 4. 总线故障：地址阶段一直完不成（中断永远不来）或者地址没有应答，u8g2_flush_wait 超时终止 /
+//    错误中断丢弃这一帧，下一帧完整重发；完成中断里从不忙等 HAL_GetTick。
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 跳过 mydefine.h 和 CubeMX 的 main.h/i2c.h（HAL 头文件在主机上不可用）
+#define __MYDEFINE_H__
+#define __MAIN_H
+#define __I2C_H__
+
+// ---------------------------------------------------------------------------
+// 虚拟时钟和调度器移植层
+// ---------------------------------------------------------------------------
+static uint32_t s_now_us;
+static void sim_wfi(void);
+
+#define SystemCoreClock                 168000000u
+#define SCHEDULER_GET_TICK()            (s_now_us / 1000)
+#define SCHEDULER_GET_TIME_US()         (s_now_us)
+#define SCHEDULER_GET_CYCLES()          (s_now_us * 168u)
+#define SCHEDULER_DISABLE_IRQ()         ((void)0)
+#define SCHEDULER_ENABLE_IRQ()          ((void)0)
+#define SCHEDULER_WAIT_FOR_INTERRUPT()  sim_wfi()
+#define __DMB()                         ((void)0)
+
+#include "../Components/scheduler/scheduler.c"
+
+// ---------------------------------------------------------------------------
+// HAL 桩：I2C + DMA
+// ---------------------------------------------------------------------------
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+    volatile uint32_t CR1;
+} I2C_TypeDef;
+
+typedef struct
+{
+    I2C_TypeDef *Instance;
+} I2C_HandleTypeDef;
+
+static I2C_TypeDef s_i2c1_regs;
+I2C_HandleTypeDef hi2c1 = {&s_i2c1_regs};
+
+#define I2C_FIRST_FRAME          0x00000001u
+#define I2C_FIRST_AND_LAST_FRAME 0x00000008u
+#define I2C_LAST_FRAME           0x00000020u
+#define I2C_CR1_STOP             (1u << 9)
+#define SET_BIT(REG, BIT)        ((REG) |= (BIT))
+#define HAL_MAX_DELAY            0xFFFFFFFFu
+#define __disable_irq()          ((void)0)
+#define __enable_irq()           ((void)0)
+#define __NOP()                  ((void)0)
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+#define SIM_GRAM_SIZE (128 * 64 / 8)
+
+// 注入的总线故障：第 s_sim_fault_after 个之后的下一个带 START 的传输出故障（只出一次）
+typedef enum
+{
+    SIM_FAULT_NONE = 0,
+    SIM_FAULT_STUCK,   // 地址阶段一直完不成，完成中断永远不来
+    SIM_FAULT_NACK     // 从机地址没有应答，HAL 发 STOP 后进错误中断
+} sim_fault_t;
+
+static sim_fault_t s_sim_fault;
+static uint32_t s_sim_fault_after;
+
+// 正在发送的传输：完成时 DMA 才从这些指针取数据
+static bool s_dma_busy;
+static uint8_t s_dma_snapshot[256]; // 启动时的数据，完成时不一样说明发送期间被改写
+static bool s_dma_start;           // 先发 START + 地址（新事务）
+static bool s_dma_stop;            // 发完产生 STOP（事务结束）
+static bool s_dma_hung;            // 地址阶段卡住，不会完成
+static bool s_dma_nack;            // 地址没有应答，完成时进错误中断
+static uint32_t s_dma_done_at;
+static const uint8_t *s_dma_data;
+static uint16_t s_dma_len;
+
+// 总线上打开的事务：零拷贝事务的控制字节和数据分两次传输
+static bool s_xfer_open;
+static bool s_xfer_has_ctrl;
+static uint8_t s_xfer_ctrl;
+
+static uint32_t s_dma_starts;      // 启动的传输数
+static uint32_t s_dma_irqs;        // 完成中断次数
+static uint32_t s_dma_overlaps;    // 上一个传输没发完又启动（驱动程序的错误）
+static uint32_t s_dma_torn;        // 发送期间数据被改写的传输（屏上会是新旧混合的数据）
+static uint32_t s_bus_errors;      // 没有打开的事务却续发数据段（驱动程序的错误）
+static uint32_t s_tick_calls;      // HAL_GetTick 调用次数（忙等）
+static uint32_t s_irq_depth;       // 正在执行的中断层数
+static uint32_t s_irq_tick_calls;  // 中断里调用 HAL_GetTick：总线卡住时在中断里永远等不到超时
+
+// 模拟 SSD1306（页寻址）
+typedef struct
+{
+    uint8_t gram[SIM_GRAM_SIZE];
+    uint8_t page;
+    uint8_t col;
+} sim_panel_t;
+
+static sim_panel_t s_panel;        // 接在 DMA 上的屏
+static sim_panel_t s_ref_panel;    // 对照：整帧刷新的屏
+
+// 400kHz，每字节 9 位：22.5us；新事务还要多发一个地址字节
+static uint32_t sim_i2c_us(uint16_t bytes)
+{
+    return ((uint32_t)bytes * 45u + 1u) / 2u;
+}
+
+static void sim_gram_cmds(sim_panel_t *panel, const uint8_t *cmd, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint8_t c = cmd[i];
+
+        if (c >= 0xB0 && c <= 0xB7)
+        {
+            panel->page = c & 0x07;                                /* 页地址 */
+        }
+        else if (c <= 0x0F)
+        {
+            panel->col = (panel->col & 0xF0) | (c & 0x0F);         /* 列地址低4位 */
+        }
+        else if (c >= 0x10 && c <= 0x1F)
+        {
+            panel->col = (panel->col & 0x0F) | ((c & 0x0F) << 4);  /* 列地址高4位 */
+        }
+        else if (c == 0x21 || c == 0x22)
+        {
+            i += 2;                                                /* 带2个参数的命令 */
+        }
+        else if (c == 0x20 || c == 0x81 || c == 0x8D || c == 0xA8 || c == 0xD3 ||
+                 c == 0xD5 || c == 0xD9 || c == 0xDA || c == 0xDB)
+        {
+            i += 1;                                                /* 带1个参数的命令 */
+        }
+    }
+}
+
+static void sim_gram_data(sim_panel_t *panel, const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        if (panel->col < 128)
+        {
+            panel->gram[panel->page * 128 + panel->col] = data[i];
+        }
+        panel->col++;
+    }
+}
+
+// 一个事务到达屏幕：第一个字节是控制字节（0x00 命令，0x40 GDRAM 数据）
+static void sim_gram_xfer(sim_panel_t *panel, uint8_t ctrl, const uint8_t *data, uint16_t len)
+{
+    if (ctrl == 0x40)
+    {
+        sim_gram_data(panel, data, len);
+    }
+    else
+    {
+        sim_gram_cmds(panel, data, len);
+    }
+}
+
+// 一次传输的字节到达屏幕：新事务的第一个字节是控制字节，续发的数据段沿用它
+static void sim_bus_deliver(const uint8_t *data, uint16_t len)
+{
+    if (s_dma_start && len > 0)
+    {
+        s_xfer_ctrl = data[0];
+        s_xfer_has_ctrl = true;
+        data++;
+        len--;
+    }
+    if (s_xfer_has_ctrl && len > 0)
+    {
+        sim_gram_xfer(&s_panel, s_xfer_ctrl, data, len);
+    }
+}
+
+static HAL_StatusTypeDef sim_dma_start(const uint8_t *data, uint16_t len, bool start, bool stop)
+{
+    if (s_dma_busy)
+    {
+        s_dma_overlaps++;
+        return HAL_BUSY;
+    }
+
+    // 驱动程序手动发的 STOP
+    if (s_i2c1_regs.CR1 & I2C_CR1_STOP)
+    {
+        s_i2c1_regs.CR1 &= ~I2C_CR1_STOP;
+        s_xfer_open = false;
+    }
+    if (!start && !s_xfer_open)
+    {
+        s_bus_errors++;
+        return HAL_ERROR;
+    }
+
+    s_dma_busy = true;
+    s_dma_start = start;
+    s_dma_stop = stop;
+    s_dma_hung = false;
+    s_dma_nack = false;
+    s_dma_data = data;
+    s_dma_len = len;
+    memcpy(s_dma_snapshot, data, len);
+    s_dma_done_at = s_now_us + sim_i2c_us((uint16_t)(len + (start ? 1 : 0)));
+    s_dma_starts++;
+
+    if (start)
+    {
+        s_xfer_open = true;
+        s_xfer_has_ctrl = false;
+        if (s_sim_fault != SIM_FAULT_NONE && s_sim_fault_after-- == 0)
+        {
+            s_dma_hung = s_sim_fault == SIM_FAULT_STUCK;
+            s_dma_nack = s_sim_fault == SIM_FAULT_NACK;
+            s_dma_done_at = s_now_us + sim_i2c_us(1);
+            s_sim_fault = SIM_FAULT_NONE;
+        }
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t len)
+{
+    (void)hi2c;
+    (void)addr;
+    return sim_dma_start(data, len, true, true);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t len,
+                                                  uint32_t options)
+{
+    (void)hi2c;
+    (void)addr;
+    return sim_dma_start(data, len, options == I2C_FIRST_FRAME || options == I2C_FIRST_AND_LAST_FRAME,
+                         options == I2C_LAST_FRAME || options == I2C_FIRST_AND_LAST_FRAME);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Abort_IT(I2C_HandleTypeDef *hi2c, uint16_t addr)
+{
+    (void)hi2c;
+    (void)addr;
+    s_dma_busy = false;
+    s_dma_hung = false;
+    s_xfer_open = false;
+    return HAL_OK;
+}
+
+// 卡住的传输不会产生中断
+static bool sim_dma_pending(void)
+{
+    return s_dma_busy && !s_dma_hung;
+}
+
+// 到期的 DMA 完成中断；回调里启动的下一个传输从这一刻开始计时
+static void sim_fire_irqs(void)
+{
+    uint32_t now = s_now_us;
+
+    while (sim_dma_pending() && (int32_t)(now - s_dma_done_at) >= 0)
+    {
+        s_now_us = s_dma_done_at;
+        s_dma_busy = false;
+        s_dma_irqs++;
+        s_irq_depth++;
+        if (s_dma_nack)
+        {
+            s_xfer_open = false;
+            HAL_I2C_ErrorCallback(&hi2c1);
+        }
+        else
+        {
+            s_dma_torn += memcmp(s_dma_snapshot, s_dma_data, s_dma_len) != 0;
+            sim_bus_deliver(s_dma_data, s_dma_len);
+            s_xfer_open = !s_dma_stop;
+            HAL_I2C_MasterTxCpltCallback(&hi2c1);
+        }
+        s_irq_depth--;
+    }
+    s_now_us = now;
+}
+
+// 忙等一次：过去 1us
+uint32_t HAL_GetTick(void)
+{
+    s_tick_calls++;
+    s_irq_tick_calls += s_irq_depth > 0;
+    s_now_us++;
+    sim_fire_irqs();
+    return s_now_us / 1000;
+}
+
+void HAL_Delay(uint32_t ms)
+{
+    uint32_t start = HAL_GetTick();
+
+    while (HAL_GetTick() - start < ms)
+    {
+    }
+}
+
+// 休眠到下一个中断：SysTick（下一毫秒）或者 DMA 完成
+static void sim_wfi(void)
+{
+    uint32_t next = (s_now_us / 1000 + 1) * 1000;
+
+    if (sim_dma_pending() && (int32_t)(s_dma_done_at - next) < 0)
+    {
+        next = s_dma_done_at;
+    }
+    s_now_us = next;
+    sim_fire_irqs();
+}
+
+// 任务占用 CPU us 微秒，期间到期的中断在到期时刻发生
+static void sim_advance(uint32_t us)
+{
+    uint32_t target = s_now_us + us;
+
+    while (sim_dma_pending() && (int32_t)(target - s_dma_done_at) >= 0)
+    {
+        s_now_us = s_dma_done_at;
+        sim_fire_irqs();
+    }
+    s_now_us = target;
+}
+
+#include "../Components/u8g2/u8g2_stm32_hal.c"
+
+// ---------------------------------------------------------------------------
+// 测试
+// ---------------------------------------------------------------------------
+#define SIM_FRAMES_MS  1000u   // 调度测试的时长
+#define SIM_FRAME_MS   33u     // 30 帧/秒
+#define SIM_DIFF_FRAMES 2000u  // 差分刷新测试的随机帧数
+
+// 仓库里没有 u8g2_fonts.c（字库只在 Keil 工程里），图案里不画字
+static void draw_test_pattern(u8g2_t *u8g2, uint8_t seed)
+{
+    u8g2_ClearBuffer(u8g2);
+    u8g2_DrawFrame(u8g2, 0, 0, 128, 64);
+    u8g2_DrawBox(u8g2, (seed * 7) % 112, 8, 16, 16);
+    u8g2_DrawCircle(u8g2, 64, 40, 12 + (seed % 8), U8G2_DRAW_ALL);
+    u8g2_DrawLine(u8g2, 4, 60, 4 + (seed * 13) % 120, 50);
+}
+
+// 1. SendBuffer 入队就返回；整帧在中断里一个接一个发完
+static uint32_t test_send_returns(uint32_t *queued_us, uint32_t *wire_us)
+{
+    u8g2_t *u8g2 = u8g2_get_instance();
+    uint32_t errors = 0;
+    uint32_t t_start, tick_calls, starts;
+
+    u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+    draw_test_pattern(u8g2, 0);
+
+    t_start = s_now_us;
+    tick_calls = s_tick_calls;
+    starts = s_dma_starts;
+    u8g2_SendBuffer(u8g2);
+    *queued_us = s_now_us - t_start;
+
+    // 没有忙等、只启动了第一个事务，后面的都还在队列里
+    errors += s_tick_calls != tick_calls;
+    errors += s_dma_starts != starts + 1;
+    errors += !u8g2_flush_is_busy();
+
+    // 没有任何人等待，总线在“中断”里自己发完
+    while (u8g2_flush_is_busy())
+    {
+        sim_wfi();
+    }
+    *wire_us = s_now_us - t_start;
+
+    errors += s_dma_irqs != s_dma_starts;
+    errors += memcmp(s_panel.gram, u8g2_GetBufferPtr(u8g2), SIM_GRAM_SIZE) != 0;
+    return errors;
+}
+
+// 2. 调度器照常运行：1ms 探针任务 + 30 帧/秒的绘制任务（总线忙就不发）
+static uint32_t s_probe_runs;
+static uint32_t s_probe_busy_runs;
+static uint32_t s_frames_sent;
+static uint32_t s_frame_send_us;
+
+static void probe_task(void)
+{
+    s_probe_runs++;
+    if (u8g2_flush_is_busy())
+    {
+        s_probe_busy_runs++;
+    }
+}
+
+static void frame_task(void)
+{
+    u8g2_t *u8g2 = u8g2_get_instance();
+    uint32_t t_start;
+
+    if (u8g2_flush_is_busy())
+    {
+        return;
+    }
+    draw_test_pattern(u8g2, (uint8_t)s_frames_sent);
+    t_start = s_now_us;
+    u8g2_SendBuffer(u8g2);
+    s_frame_send_us += s_now_us - t_start;
+    s_frames_sent++;
+}
+
+static uint32_t test_tasks_run(uint32_t *busy_ms)
+{
+    scheduler_task_stats_t stats;
+    uint32_t errors = 0;
+    uint32_t t_end;
+
+    u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+    s_now_us = (s_now_us / 1000 + 1) * 1000;
+    s_probe_runs = 0;
+    s_probe_busy_runs = 0;
+    s_frames_sent = 0;
+    s_frame_send_us = 0;
+
+    scheduler_init();
+    scheduler_add_task_ex(probe_task, 1, SCHEDULER_PRIORITY_HIGH, 0, "probe");
+    scheduler_add_task_ex(frame_task, SIM_FRAME_MS, SCHEDULER_PRIORITY_NORMAL, 0, "frame");
+
+    t_end = s_now_us + SIM_FRAMES_MS * 1000u;
+    while (s_now_us < t_end)
+    {
+        scheduler_run();
+    }
+    *busy_ms = s_probe_busy_runs;
+
+    // 探针一个节拍都没有错过，一半以上的节拍是在总线忙的时候跑的
+    scheduler_get_task_stats(0, &stats);
+    errors += s_probe_runs < SIM_FRAMES_MS - 1;
+    errors += stats.missed != 0;
+    errors += s_probe_busy_runs * 2 < s_probe_runs;
+
+    // 每帧都发出去了，发送没有占用任务的时间
+    errors += s_frames_sent < SIM_FRAMES_MS / SIM_FRAME_MS;
+    errors += s_frame_send_us != 0;
+    errors += s_dma_overlaps != 0;
+    return errors;
+}
+
+// 3. 差分刷新和整帧刷新对照
+// 对照屏用独立的 u8g2 实例，字节回调直接把 I2C 流喂给模拟屏（不经过 DMA 队列）
+static u8g2_t s_ref_u8g2;
+static uint8_t s_ref_buf[SIM_GRAM_SIZE];
+static uint8_t s_ref_xfer[160];
+static uint16_t s_ref_xfer_len;
+
+static uint8_t ref_byte_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    uint8_t *data = (uint8_t *)arg_ptr;
+
+    (void)u8x8;
+    switch (msg)
+    {
+        case U8X8_MSG_BYTE_START_TRANSFER:
+            s_ref_xfer_len = 0;
+            break;
+
+        case U8X8_MSG_BYTE_SEND:
+            while (arg_int > 0 && s_ref_xfer_len < sizeof(s_ref_xfer))
+            {
+                s_ref_xfer[s_ref_xfer_len++] = *data++;
+                arg_int--;
+            }
+            break;
+
+        case U8X8_MSG_BYTE_END_TRANSFER:
+            if (s_ref_xfer_len > 0)
+            {
+                sim_gram_xfer(&s_ref_panel, s_ref_xfer[0], s_ref_xfer + 1, (uint16_t)(s_ref_xfer_len - 1));
+            }
+            break;
+
+        default:
+            break;
+    }
+    return 1;
+}
+
+static uint8_t ref_gpio_and_delay_cb(u8x8_t *u8x8, uint8_t msg, uint8_t arg_int, void *arg_ptr)
+{
+    (void)u8x8;
+    (void)msg;
+    (void)arg_int;
+    (void)arg_ptr;
+    return 1;
+}
+
+// 在上一帧的基础上随机改几处：小块、单点、线、整页反色，偶尔整屏重画，也有不变的帧
+static void draw_random_changes(u8g2_t *u8g2)
+{
+    uint32_t n = (uint32_t)rand() % 6;
+
+    if (rand() % 50 == 0)
+    {
+        u8g2_ClearBuffer(u8g2);
+        n = 40;
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        u8g2_uint_t x = (u8g2_uint_t)(rand() % 128);
+        u8g2_uint_t y = (u8g2_uint_t)(rand() % 64);
+
+        u8g2_SetDrawColor(u8g2, (uint8_t)(rand() % 3));   // 0 清除，1 置位，2 异或
+        switch (rand() % 4)
+        {
+            case 0:
+                u8g2_DrawBox(u8g2, x, y, (u8g2_uint_t)(1 + rand() % 24), (u8g2_uint_t)(1 + rand() % 16));
+                break;
+            case 1:
+                u8g2_DrawPixel(u8g2, x, y);
+                break;
+            case 2:
+                u8g2_DrawLine(u8g2, x, y, (u8g2_uint_t)(rand() % 128), (u8g2_uint_t)(rand() % 64));
+                break;
+            default:
+                u8g2_DrawBox(u8g2, 0, (u8g2_uint_t)(y & ~7u), 128, 8);
+                break;
+        }
+    }
+    u8g2_SetDrawColor(u8g2, 1);
+}
+
+static uint32_t test_diff_flush(uint32_t *avg_bytes, uint32_t *max_bytes, uint32_t *unchanged)
+{
+    u8g2_t *u8g2 = u8g2_get_instance();
+    uint32_t errors = 0;
+    uint32_t total = 0;
+
+    u8g2_SetupDisplay(&s_ref_u8g2, u8x8_d_ssd1306_128x64_noname, u8x8_cad_ssd13xx_page_i2c, ref_byte_cb,
+                      ref_gpio_and_delay_cb);
+    u8g2_SetupBuffer(&s_ref_u8g2, s_ref_buf, 8, u8g2_ll_hvline_vertical_top_lsb, U8G2_R0);
+
+    // 两块屏里是不同的垃圾数据，每个字节都必须被正确写过
+    u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+    memset(s_panel.gram, 0xAA, SIM_GRAM_SIZE);
+    memset(s_ref_panel.gram, 0x55, SIM_GRAM_SIZE);
+    u8g2_invalidate_diff_shadow();
+    u8g2_ClearBuffer(u8g2);
+
+    srand(3);
+    *max_bytes = 0;
+    *unchanged = 0;
+    for (uint32_t frame = 0; frame < SIM_DIFF_FRAMES; frame++)
+    {
+        uint16_t bytes;
+
+        draw_random_changes(u8g2);
+        bytes = u8g2_send_buffer_diff(u8g2);
+
+        // 第 0 帧必然整帧发送，不计入统计
+        if (frame > 0)
+        {
+            total += bytes;
+            *unchanged += bytes == 0;
+            if (bytes > *max_bytes)
+            {
+                *max_bytes = bytes;
+            }
+        }
+
+        // 对照：同一帧整帧刷新到另一块屏
+        memcpy(s_ref_buf, u8g2_GetBufferPtr(u8g2), SIM_GRAM_SIZE);
+        u8g2_SendBuffer(&s_ref_u8g2);
+
+        // 一半的帧在发送期间乱画绘制缓冲（再恢复成这一帧），DMA 读的是影子缓冲，不受影响
+        if (rand() % 2 == 0)
+        {
+            u8g2_ClearBuffer(u8g2);
+            draw_random_changes(u8g2);
+            memcpy(u8g2_GetBufferPtr(u8g2), s_ref_buf, SIM_GRAM_SIZE);
+        }
+
+        // 三分之一的帧不等发完，过一会儿就刷新下一帧：要先在影子缓冲的栅栏上等，
+        // 不能改写正在发送的数据
+        if (rand() % 3 == 0 && frame + 1 < SIM_DIFF_FRAMES)
+        {
+            sim_advance((uint32_t)rand() % 3000);
+            continue;
+        }
+        u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+        errors += memcmp(s_panel.gram, s_ref_panel.gram, SIM_GRAM_SIZE) != 0;
+
+    }
+    *avg_bytes = total / (SIM_DIFF_FRAMES - 1);
+
+    errors += s_dma_overlaps != 0;
+    errors += s_dma_torn != 0;
+    errors += *unchanged == 0;
+    return errors;
+}
+
+// 4. 总线故障后恢复：故障放在第 6 个事务上，它是在完成中断里启动的
+static uint32_t test_bus_fault(uint32_t *stuck_ms)
+{
+    u8g2_t *u8g2 = u8g2_get_instance();
+    uint32_t errors = 0;
+    uint32_t tx_errors, t_start;
+
+    u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+    u8g2_invalidate_diff_shadow();
+
+    // 地址阶段一直完不成：中断里什么都不做，主循环的 u8g2_flush_wait 超时后终止传输、丢弃剩余事务
+    tx_errors = s_tx_error_count;
+    s_sim_fault = SIM_FAULT_STUCK;
+    s_sim_fault_after = 5;
+    draw_test_pattern(u8g2, 1);
+    u8g2_send_buffer_diff(u8g2);
+    t_start = s_now_us;
+    errors += u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS) != -1;
+    *stuck_ms = (s_now_us - t_start) / 1000;
+    errors += s_sim_fault != SIM_FAULT_NONE;
+    errors += s_tx_error_count == tx_errors;
+    errors += u8g2_flush_is_busy();
+
+    // 画面不变的下一帧也要完整重发，不能按影子缓冲只发差异
+    draw_test_pattern(u8g2, 1);
+    u8g2_send_buffer_diff(u8g2);
+    errors += u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS) != 0;
+    errors += memcmp(s_panel.gram, u8g2_GetBufferPtr(u8g2), SIM_GRAM_SIZE) != 0;
+
+    // 地址没有应答：错误中断丢弃这一帧剩余的事务，不用等超时
+    tx_errors = s_tx_error_count;
+    s_sim_fault = SIM_FAULT_NACK;
+    s_sim_fault_after = 5;
+    draw_test_pattern(u8g2, 3);
+    u8g2_send_buffer_diff(u8g2);
+    errors += u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS) != 0;
+    errors += s_sim_fault != SIM_FAULT_NONE;
+    errors += s_tx_error_count == tx_errors;
+
+    draw_test_pattern(u8g2, 3);
+    u8g2_send_buffer_diff(u8g2);
+    errors += u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS) != 0;
+    errors += memcmp(s_panel.gram, u8g2_GetBufferPtr(u8g2), SIM_GRAM_SIZE) != 0;
+
+    // 整个测试过程中完成中断里都没有忙等，零拷贝事务的两段都在同一个事务里
+    errors += s_irq_tick_calls != 0;
+    errors += s_bus_errors != 0;
+    errors += s_dma_overlaps != 0;
+    return errors;
+}
+
+int main(void)
+{
+    uint32_t errors, failed = 0;
+    uint32_t queued_us, wire_us, busy_ms;
+    uint32_t avg_bytes, max_bytes, unchanged;
+    uint32_t stuck_ms;
+
+    printf("========= OLED 异步刷新主机测试 =========\n");
+
+    s_now_us = 0;
+    failed += u8g2_component_init() != 0;
+
+    errors = test_send_returns(&queued_us, &wire_us);
+    printf("[1] SendBuffer 入队即返回，整帧在中断里发完: %s\n", errors ? "失败" : "成功");
+    printf("    返回耗时 %lu us，上屏耗时 %lu us，事务 %lu 个\n", (unsigned long)queued_us,
+           (unsigned long)wire_us, (unsigned long)s_dma_starts);
+    failed += errors;
+
+    errors = test_tasks_run(&busy_ms);
+    printf("[2] 30 帧/秒刷新时 1ms 任务照常运行: %s\n", errors ? "失败" : "成功");
+    printf("    %lu ms 内探针运行 %lu 次（其中总线忙时 %lu 次），发送 %lu 帧\n", (unsigned long)SIM_FRAMES_MS,
+           (unsigned long)s_probe_runs, (unsigned long)busy_ms, (unsigned long)s_frames_sent);
+    failed += errors;
+
+    errors = test_diff_flush(&avg_bytes, &max_bytes, &unchanged);
+    printf("[3] 差分刷新 %lu 帧随机画面，和整帧刷新的 GDRAM 相同: %s\n", (unsigned long)SIM_DIFF_FRAMES,
+           errors ? "失败" : "成功");
+    printf("    整帧 %u 字节/帧，差分平均 %lu、最多 %lu 字节/帧，%lu 帧没有变化\n", SIM_GRAM_SIZE,
+           (unsigned long)avg_bytes, (unsigned long)max_bytes, (unsigned long)unchanged);
+    failed += errors;
+
+    errors = test_bus_fault(&stuck_ms);
+    printf("[4] 地址阶段卡死 / 无应答后下一帧完整重发: %s\n", errors ? "失败" : "成功");
+    printf("    卡死 %lu ms 后超时恢复，中断里忙等 HAL_GetTick %lu 次\n", (unsigned long)stuck_ms,
+           (unsigned long)s_irq_tick_calls);
+    failed += errors;
+
+    printf("==================================\n");
+    printf(failed ? ">>> 测试失败! <<<\n" : ">>> 所有测试通过! <<<\n");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,259 @@
+// =============================================================================
+// 事件总线 主机测试（在PC上运行，不加入Keil工程）
+// =============================================================================
+//
+// 编译运行（在仓库根目录）：
+//   gcc -O2 -pthread -IApp/sys -IComponents/event_queue -IComponents/event_bus -IComponents/rocker Test/test_event_bus_host.c -o /tmp/test_event_bus
+//   /tmp/test_event_bus
+//
+// 1. 没人订阅的主题发布时丢弃；
+// 2. 多个订阅者各自的游标互不影响，按主题过滤，skip_all 只影响自己；
+// 3. event_queue 推入的事件同时出现在总线上，event_queue_clear 不影响总线订阅者；
+// 4. 读得慢的订阅者被覆盖时 lost 计数正确；
+// 5. 一个发布线程 + 两个读线程（一快一慢）：每个读者看到的序号严格递增、没有撕裂，
+//    读到的 + 丢掉的 = 发布的。
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// 跳过 mydefine.h（HAL 头文件在主机上不可用），只提供用到的东西
+#define __MYDEFINE_H__
+#include "rocker.h"
+
+static inline void scheduler_notify_event(void)
+{
+}
+
+#define EVENT_QUEUE_LOAD_ACQUIRE(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define EVENT_QUEUE_STORE_RELEASE(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define EVENT_BUS_LOAD_ACQUIRE(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define EVENT_BUS_STORE_RELEASE(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define __DMB()                          __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#include "../Components/event_queue/event_queue.c"
+#include "../Components/event_bus/event_bus.c"
+
+#define STRESS_EVENTS 2000000u
+
+static app_event_t make_event(uint16_t source_id, uint32_t seq)
+{
+    app_event_t evt;
+
+    evt.source_id = source_id;
+    evt.event_type = (uint8_t)(seq ^ (seq >> 8));
+    evt.data = seq;
+    evt.timestamp_us = ~seq;
+    return evt;
+}
+
+static bool event_ok(const app_event_t *evt)
+{
+    return evt->event_type == (uint8_t)(evt->data ^ (evt->data >> 8)) && evt->timestamp_us == ~evt->data;
+}
+
+static uint32_t test_topics(void)
+{
+    event_bus_sub_t input, telemetry, storage;
+    app_event_t evt;
+    event_topic_t topic;
+    uint32_t published, filtered;
+    uint32_t errors = 0;
+
+    event_bus_init();
+    event_queue_init();
+
+    // 1. 没人订阅：不写入
+    errors += event_bus_publish(EVENT_TOPIC_BUTTON, make_event(0, 1));
+    event_bus_get_stats(&published, &filtered);
+    errors += published != 0 || filtered != 1;
+
+    // 2. 三个订阅者，主题各不相同
+    errors += !event_bus_subscribe(&input, EVENT_TOPIC_MASK_INPUT, "input");
+    errors += !event_bus_subscribe(&telemetry, EVENT_TOPIC_MASK_ALL, "telemetry");
+    errors += !event_bus_subscribe(&storage, EVENT_TOPIC_MASK(EVENT_TOPIC_STORAGE), "storage");
+
+    errors += !event_bus_publish(EVENT_TOPIC_BUTTON, make_event(0, 10));
+    errors += !event_bus_publish(EVENT_TOPIC_SYSTEM, make_event(EVENT_SOURCE_SYSTEM, 11));
+    errors += !event_bus_publish(EVENT_TOPIC_STORAGE, make_event(EVENT_SOURCE_STORAGE, 12));
+    errors += !event_bus_publish(EVENT_TOPIC_ROCKER, make_event(ROCKER_SOURCE_ID, 13));
+
+    errors += !event_bus_read(&input, &evt, &topic) || evt.data != 10 || topic != EVENT_TOPIC_BUTTON;
+    errors += !event_bus_read(&input, &evt, &topic) || evt.data != 13 || topic != EVENT_TOPIC_ROCKER;
+    errors += event_bus_read(&input, &evt, NULL);
+
+    errors += !event_bus_read(&storage, &evt, NULL) || evt.data != 12;
+    errors += event_bus_read(&storage, &evt, NULL);
+
+    for (uint32_t seq = 10; seq <= 13; seq++)
+    {
+        errors += !event_bus_read(&telemetry, &evt, NULL) || evt.data != seq;
+    }
+    errors += event_bus_read(&telemetry, &evt, NULL);
+
+    // skip_all 只影响自己
+    event_bus_publish(EVENT_TOPIC_BUTTON, make_event(0, 20));
+    event_bus_skip_all(&input);
+    errors += event_bus_read(&input, &evt, NULL);
+    errors += !event_bus_read(&telemetry, &evt, NULL) || evt.data != 20;
+
+    // 3. event_queue 推入的按键/摇杆事件同时发布到总线；前台清空不影响总线
+    event_queue_push(make_event(0, 30));
+    event_queue_push_repeat(make_event(ROCKER_SOURCE_ID, 31));
+    event_queue_clear();
+    errors += event_queue_pop(&evt);
+    errors += !event_bus_read(&input, &evt, &topic) || evt.data != 30 || topic != EVENT_TOPIC_BUTTON;
+    errors += !event_bus_read(&input, &evt, &topic) || evt.data != 31 || topic != EVENT_TOPIC_ROCKER;
+
+    // 取消订阅后，这个主题没人要了就在发布时丢弃
+    event_bus_unsubscribe(&storage);
+    event_bus_unsubscribe(&telemetry);
+    errors += event_bus_publish(EVENT_TOPIC_STORAGE, make_event(EVENT_SOURCE_STORAGE, 40));
+    return errors;
+}
+
+// 4. 慢订阅者被覆盖
+static uint32_t test_overrun(void)
+{
+    event_bus_sub_t fast, slow;
+    app_event_t evt;
+    uint32_t errors = 0;
+    uint32_t expect = 0;
+
+    event_bus_init();
+    event_bus_subscribe(&fast, EVENT_TOPIC_MASK_ALL, "fast");
+    event_bus_subscribe(&slow, EVENT_TOPIC_MASK_ALL, "slow");
+
+    for (uint32_t seq = 0; seq < 100; seq++)
+    {
+        event_bus_publish(EVENT_TOPIC_BUTTON, make_event(0, seq));
+        errors += !event_bus_read(&fast, &evt, NULL) || evt.data != seq;
+    }
+
+    // 只剩最新的 CAPACITY-1 个可读
+    expect = 100 - (EVENT_BUS_CAPACITY_SLOTS - 1);
+    while (event_bus_read(&slow, &evt, NULL))
+    {
+        errors += evt.data != expect++;
+    }
+    errors += expect != 100 || slow.lost != 100 - (EVENT_BUS_CAPACITY_SLOTS - 1) || fast.lost != 0;
+    return errors;
+}
+
+// 5. 多线程
+typedef struct
+{
+    event_bus_sub_t sub;
+    uint32_t received;
+    uint32_t errors;
+    uint32_t spin_every;   // 每读这么多个事件让出一次，模拟慢订阅者
+} reader_ctx_t;
+
+static atomic_bool s_publisher_done;
+
+static void *publisher_thread(void *arg)
+{
+    (void)arg;
+    for (uint32_t seq = 0; seq < STRESS_EVENTS; seq++)
+    {
+        event_bus_publish(EVENT_TOPIC_BUTTON, make_event(0, seq));
+        if ((seq & 63) == 0)
+        {
+            sched_yield(); // 单核主机上给读线程运行的机会
+        }
+    }
+    atomic_store(&s_publisher_done, true);
+    return NULL;
+}
+
+static void *reader_thread(void *arg)
+{
+    reader_ctx_t *ctx = (reader_ctx_t *)arg;
+    app_event_t evt;
+    uint32_t last = 0;
+    bool first = true;
+
+    for (;;)
+    {
+        bool done = atomic_load(&s_publisher_done);
+
+        while (event_bus_read(&ctx->sub, &evt, NULL))
+        {
+            if (!event_ok(&evt) || (!first && evt.data <= last))
+            {
+                ctx->errors++;
+            }
+            first = false;
+            last = evt.data;
+            ctx->received++;
+            if (ctx->spin_every && ctx->received % ctx->spin_every == 0)
+            {
+                sched_yield();
+            }
+        }
+        if (done)
+        {
+            break;
+        }
+        sched_yield();
+    }
+    return NULL;
+}
+
+static uint32_t test_threads(reader_ctx_t *fast, reader_ctx_t *slow)
+{
+    pthread_t tp, tf, ts;
+    uint32_t errors = 0;
+
+    event_bus_init();
+    memset(fast, 0, sizeof(*fast));
+    memset(slow, 0, sizeof(*slow));
+    slow->spin_every = 4;
+    event_bus_subscribe(&fast->sub, EVENT_TOPIC_MASK_ALL, "fast");
+    event_bus_subscribe(&slow->sub, EVENT_TOPIC_MASK_ALL, "slow");
+    atomic_store(&s_publisher_done, false);
+
+    pthread_create(&tf, NULL, reader_thread, fast);
+    pthread_create(&ts, NULL, reader_thread, slow);
+    pthread_create(&tp, NULL, publisher_thread, NULL);
+    pthread_join(tp, NULL);
+    pthread_join(tf, NULL);
+    pthread_join(ts, NULL);
+
+    errors += fast->errors + slow->errors;
+    errors += fast->received + fast->sub.lost != STRESS_EVENTS;
+    errors += slow->received + slow->sub.lost != STRESS_EVENTS;
+    return errors;
+}
+
+int main(void)
+{
+    reader_ctx_t fast, slow;
+    uint32_t errors, failed = 0;
+
+    printf("========= 事件总线主机测试 (slots=%u) =========\n", (unsigned)EVENT_BUS_CAPACITY_SLOTS);
+
+    errors = test_topics();
+    printf("[1] 发布时过滤/多订阅者/skip_all/event_queue联动: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    errors = test_overrun();
+    printf("[2] 慢订阅者被覆盖计数: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    errors = test_threads(&fast, &slow);
+    printf("[3] 1发布+2读线程 %u 事件: %s (快: 读到=%u 丢=%u, 慢: 读到=%u 丢=%u)\n",
+           (unsigned)STRESS_EVENTS, errors ? "失败" : "成功",
+           (unsigned)fast.received, (unsigned)fast.sub.lost,
+           (unsigned)slow.received, (unsigned)slow.sub.lost);
+    failed += errors;
+
+    printf("==================================\n");
+    printf(failed ? ">>> 测试失败! <<<\n" : ">>> 所有测试通过! <<<\n");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,452 @@
+// =============================================================================
+// 事件队列 主机压力测试 + 吞吐对比（在PC上运行，不加入Keil工程）
+// =============================================================================
+//
+// 编译运行（在仓库根目录）：
+//   gcc -O2 -pthread -IApp/sys -IComponents/event_queue -IComponents/event_bus -IComponents/rocker -IComponents/ringbuffer Test/test_event_queue_host.c -o /tmp/test_event_queue
+//   /tmp/test_event_queue
+//
+// 1. 压力测试：生产者线程和消费者线程同时跑 SPSC 队列，检查事件不丢、不重、不乱序，
+//    每个事件的字段完整（没有读到写了一半的槽）；
+// 2. 吞吐对比：同样的推入/取出，和原来“关中断 + rt_ringbuffer 按字节拷贝”的实现比较。
+//    主机上没有关中断，旧实现用自旋锁代替 __disable_irq()/__enable_irq()。
+//    两种实现交替各跑 BENCH_ROUNDS 轮，输出最小/中位/最大值和每轮比值的范围：
+//    双线程的结果主要取决于主机怎么调度两个线程（单核上每次满/空都要切换），波动很大，只作参考；
+//    单线程推入+取出才是队列本身的开销，和 MCU 主循环里的用法接近。
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// 跳过 mydefine.h（HAL 头文件在主机上不可用），只提供事件队列用到的东西
+#define __MYDEFINE_H__
+#include "ringbuffer.h"
+#include "rocker.h"
+
+static atomic_uint s_notify_count;
+static inline void scheduler_notify_event(void)
+{
+    atomic_fetch_add_explicit(&s_notify_count, 1, memory_order_relaxed);
+}
+
+#define EVENT_QUEUE_LOAD_ACQUIRE(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define EVENT_QUEUE_STORE_RELEASE(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define __DMB()                          __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#include "../Components/event_queue/event_queue.c"
+#include "../Components/event_bus/event_bus.c"
+#include "../Components/ringbuffer/ringbuffer.c"
+
+// -----------------------------------------------------------------------------
+// 原来的实现（关中断 + 按字节拷贝），用于吞吐对比
+// -----------------------------------------------------------------------------
+static rt_uint8_t legacy_buffer[EVENT_QUEUE_CAPACITY_SLOTS * sizeof(app_event_t)];
+static struct rt_ringbuffer legacy_rb;
+static atomic_flag legacy_lock = ATOMIC_FLAG_INIT;
+
+static inline void legacy_disable_irq(void)
+{
+    while (atomic_flag_test_and_set_explicit(&legacy_lock, memory_order_acquire))
+    {
+        sched_yield();
+    }
+}
+
+static inline void legacy_enable_irq(void)
+{
+    atomic_flag_clear_explicit(&legacy_lock, memory_order_release);
+}
+
+static void legacy_init(void)
+{
+    rt_ringbuffer_init(&legacy_rb, legacy_buffer, sizeof(legacy_buffer));
+}
+
+static bool legacy_push(app_event_t evt)
+{
+    rt_size_t put_len;
+
+    legacy_disable_irq();
+    put_len = rt_ringbuffer_put(&legacy_rb, (const rt_uint8_t *)&evt, sizeof(app_event_t));
+    legacy_enable_irq();
+
+    if (put_len != sizeof(app_event_t))
+    {
+        return false;
+    }
+    scheduler_notify_event();
+    return true;
+}
+
+static bool legacy_pop(app_event_t *evt_out)
+{
+    rt_size_t get_len;
+
+    legacy_disable_irq();
+    if (rt_ringbuffer_data_len(&legacy_rb) < sizeof(app_event_t))
+    {
+        legacy_enable_irq();
+        return false;
+    }
+    get_len = rt_ringbuffer_get(&legacy_rb, (rt_uint8_t *)evt_out, sizeof(app_event_t));
+    legacy_enable_irq();
+
+    return get_len == sizeof(app_event_t);
+}
+
+// -----------------------------------------------------------------------------
+// 测试框架
+// -----------------------------------------------------------------------------
+#define STRESS_EVENTS    2000000u
+#define BENCH_EVENTS     10000000u
+#define BENCH_ROUNDS     5u
+
+typedef struct
+{
+    const char *name;
+    void (*init)(void);
+    bool (*push)(app_event_t evt);
+    bool (*pop)(app_event_t *evt_out);
+} queue_impl_t;
+
+typedef struct
+{
+    const queue_impl_t *impl;
+    uint32_t count;
+    uint32_t errors;
+    uint32_t full_spins;
+    uint32_t empty_spins;
+} stress_ctx_t;
+
+static void spsc_init(void)
+{
+    event_queue_init();
+}
+
+static const queue_impl_t s_spsc = {"spsc", spsc_init, event_queue_push, event_queue_pop};
+static const queue_impl_t s_legacy = {"legacy", legacy_init, legacy_push, legacy_pop};
+
+// 事件的每个字段都由序号推出来，消费者能发现被撕裂的槽
+static app_event_t make_event(uint32_t seq)
+{
+    app_event_t evt;
+
+    evt.source_id = (uint16_t)(seq * 7u);
+    evt.event_type = (uint8_t)(seq ^ (seq >> 8));
+    evt.data = seq;
+    evt.timestamp_us = seq;
+    return evt;
+}
+
+static bool check_event(const app_event_t *evt, uint32_t seq)
+{
+    app_event_t want = make_event(seq);
+
+    return evt->data == want.data && evt->source_id == want.source_id &&
+           evt->event_type == want.event_type;
+}
+
+static double now_sec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void *producer_thread(void *arg)
+{
+    stress_ctx_t *ctx = (stress_ctx_t *)arg;
+
+    for (uint32_t seq = 0; seq < ctx->count; seq++)
+    {
+        while (!ctx->impl->push(make_event(seq)))
+        {
+            ctx->full_spins++;
+            sched_yield(); // 单核主机上让对方线程运行
+        }
+    }
+    return NULL;
+}
+
+static void *consumer_thread(void *arg)
+{
+    stress_ctx_t *ctx = (stress_ctx_t *)arg;
+    app_event_t evt;
+
+    for (uint32_t seq = 0; seq < ctx->count; seq++)
+    {
+        while (!ctx->impl->pop(&evt))
+        {
+            ctx->empty_spins++;
+            sched_yield();
+        }
+        if (!check_event(&evt, seq))
+        {
+            if (ctx->errors++ < 5)
+            {
+                printf("  [ERR] seq=%u got data=%u src=%u type=%u\n", (unsigned)seq,
+                       (unsigned)evt.data, evt.source_id, evt.event_type);
+            }
+        }
+    }
+    return NULL;
+}
+
+// 两个线程同时跑，返回每秒事件数；errors 非零表示丢失、重复、乱序或撕裂
+static double run_threaded(const queue_impl_t *impl, uint32_t count, stress_ctx_t *prod, stress_ctx_t *cons)
+{
+    pthread_t tp, tc;
+    double t0, t1;
+
+    impl->init();
+    memset(prod, 0, sizeof(*prod));
+    memset(cons, 0, sizeof(*cons));
+    prod->impl = cons->impl = impl;
+    prod->count = cons->count = count;
+
+    t0 = now_sec();
+    pthread_create(&tc, NULL, consumer_thread, cons);
+    pthread_create(&tp, NULL, producer_thread, prod);
+    pthread_join(tp, NULL);
+    pthread_join(tc, NULL);
+    t1 = now_sec();
+
+    return (double)count / (t1 - t0);
+}
+
+// 单线程：推满半个队列再取空，测一次推入+取出本身的开销（接近MCU上主循环的用法）
+static double run_single(const queue_impl_t *impl, uint32_t count, uint32_t *errors)
+{
+    const uint32_t batch = EVENT_QUEUE_CAPACITY_SLOTS / 2;
+    app_event_t evt;
+    uint32_t seq_in = 0, seq_out = 0;
+    double t0, t1;
+
+    impl->init();
+    *errors = 0;
+
+    t0 = now_sec();
+    while (seq_out < count)
+    {
+        for (uint32_t i = 0; i < batch; i++)
+        {
+            if (!impl->push(make_event(seq_in++)))
+            {
+                (*errors)++;
+            }
+        }
+        while (impl->pop(&evt))
+        {
+            if (!check_event(&evt, seq_out++))
+            {
+                (*errors)++;
+            }
+        }
+    }
+    t1 = now_sec();
+
+    return (double)count / (t1 - t0);
+}
+
+// 多轮测量的统计：最小/中位/最大
+typedef struct
+{
+    double min;
+    double median;
+    double max;
+} bench_stats_t;
+
+static bench_stats_t bench_stats(const double *v, uint32_t n)
+{
+    double s[BENCH_ROUNDS];
+    bench_stats_t st;
+
+    memcpy(s, v, n * sizeof(double));
+    for (uint32_t i = 1; i < n; i++)
+    {
+        for (uint32_t j = i; j > 0 && s[j - 1] > s[j]; j--)
+        {
+            double t = s[j];
+
+            s[j] = s[j - 1];
+            s[j - 1] = t;
+        }
+    }
+    st.min = s[0];
+    st.median = s[n / 2];
+    st.max = s[n - 1];
+    return st;
+}
+
+typedef struct
+{
+    bench_stats_t spsc;            // 吞吐（事件/秒）
+    bench_stats_t legacy;
+    bench_stats_t ratio;           // 每轮 spsc/legacy
+} bench_result_t;
+
+// 两种实现交替跑 BENCH_ROUNDS 轮；errors 非零表示某一轮的事件不对
+static uint32_t bench_compare(bool threaded, bench_result_t *res)
+{
+    double spsc[BENCH_ROUNDS], legacy[BENCH_ROUNDS], ratio[BENCH_ROUNDS];
+    stress_ctx_t prod, cons;
+    uint32_t errors = 0, e;
+
+    for (uint32_t i = 0; i < BENCH_ROUNDS; i++)
+    {
+        if (threaded)
+        {
+            spsc[i] = run_threaded(&s_spsc, STRESS_EVENTS, &prod, &cons);
+            errors += cons.errors;
+            legacy[i] = run_threaded(&s_legacy, STRESS_EVENTS, &prod, &cons);
+            errors += cons.errors;
+        }
+        else
+        {
+            spsc[i] = run_single(&s_spsc, BENCH_EVENTS, &e);
+            errors += e;
+            legacy[i] = run_single(&s_legacy, BENCH_EVENTS, &e);
+            errors += e;
+        }
+        ratio[i] = spsc[i] / legacy[i];
+    }
+
+    res->spsc = bench_stats(spsc, BENCH_ROUNDS);
+    res->legacy = bench_stats(legacy, BENCH_ROUNDS);
+    res->ratio = bench_stats(ratio, BENCH_ROUNDS);
+    return errors;
+}
+
+// 吞吐（最小/中位/最大 M 事件/秒，中位换算成每个事件的耗时）和比值范围
+static void bench_print(const bench_result_t *res)
+{
+    printf("    spsc   %.1f / %.1f / %.1f M/s（中位 %.1f ns/事件）\n", res->spsc.min / 1e6,
+           res->spsc.median / 1e6, res->spsc.max / 1e6, 1e9 / res->spsc.median);
+    printf("    legacy %.1f / %.1f / %.1f M/s（中位 %.1f ns/事件）\n", res->legacy.min / 1e6,
+           res->legacy.median / 1e6, res->legacy.max / 1e6, 1e9 / res->legacy.median);
+    printf("    每轮 spsc/legacy %.2fx ~ %.2fx，中位 %.2fx\n", res->ratio.min, res->ratio.max,
+           res->ratio.median);
+}
+
+// 满/空边界：容量正好是 EVENT_QUEUE_CAPACITY_SLOTS，clear 之后为空
+static uint32_t test_boundaries(void)
+{
+    app_event_t evt;
+    uint32_t errors = 0;
+
+    event_queue_init();
+    for (uint32_t i = 0; i < EVENT_QUEUE_CAPACITY_SLOTS; i++)
+    {
+        errors += !event_queue_push(make_event(i));
+    }
+    errors += event_queue_push(make_event(99)); // 满了，应该失败
+    errors += !event_queue_pop(&evt) || !check_event(&evt, 0);
+    errors += !event_queue_push(make_event(EVENT_QUEUE_CAPACITY_SLOTS));
+    event_queue_clear();
+    errors += event_queue_pop(&evt); // 清空后应该为空
+    errors += !event_queue_push(make_event(7));
+    errors += !event_queue_pop(&evt) || !check_event(&evt, 7);
+
+    // 下标接近 32 位回绕时仍然正确
+    event_queue_head = event_queue_tail = 0xFFFFFFF8u;
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        errors += !event_queue_push(make_event(i));
+        errors += !event_queue_pop(&evt) || !check_event(&evt, i);
+    }
+    return errors;
+}
+
+// 重复事件合并：同来源同类型的未取走事件只更新 data；边沿事件之后不合并；保留槽留给边沿事件
+static uint32_t test_coalesce(void)
+{
+    app_event_t hold = {.source_id = 100, .event_type = 3, .data = 1};
+    app_event_t edge = {.source_id = 100, .event_type = 1, .data = 0};
+    app_event_t other = {.source_id = 5, .event_type = 3, .data = 0};
+    app_event_t evt;
+    event_queue_stats_t st;
+    uint32_t errors = 0;
+
+    event_queue_init();
+    errors += !event_queue_push_repeat(hold);
+    errors += !event_queue_push(other);          // 中间夹着别的来源，不影响合并
+    hold.data = 2;
+    errors += !event_queue_push_repeat(hold);    // 合并进第一个 HOLD
+    errors += !event_queue_push(edge);
+    hold.data = 3;
+    errors += !event_queue_push_repeat(hold);    // 最近的是边沿事件，占新槽
+    event_queue_get_stats(&st);
+    errors += st.pushed != 4 || st.coalesced != 1 || st.high_water != 4;
+
+    errors += !event_queue_pop(&evt) || evt.event_type != 3 || evt.data != 2;
+    errors += !event_queue_pop(&evt) || evt.source_id != 5;
+    errors += !event_queue_pop(&evt) || evt.event_type != 1;
+    errors += !event_queue_pop(&evt) || evt.event_type != 3 || evt.data != 3;
+    errors += event_queue_pop(&evt);
+
+    // 不同来源的重复事件填到保留槽为止，剩下的槽边沿事件仍然能用
+    event_queue_init();
+    for (uint16_t src = 0; src < EVENT_QUEUE_CAPACITY_SLOTS; src++)
+    {
+        other.source_id = src;
+        event_queue_push_repeat(other);
+    }
+    for (uint32_t i = 0; i < EVENT_QUEUE_EDGE_RESERVE; i++)
+    {
+        errors += !event_queue_push(edge);
+    }
+    errors += event_queue_push(edge);            // 真的满了
+    event_queue_get_stats(&st);
+    errors += st.dropped_repeat != EVENT_QUEUE_EDGE_RESERVE || st.dropped != 1 ||
+              st.high_water != EVENT_QUEUE_CAPACITY_SLOTS;
+    return errors;
+}
+
+int main(void)
+{
+    stress_ctx_t prod, cons;
+    bench_result_t bench;
+    uint32_t errors, failed = 0;
+
+    printf("========= 事件队列主机测试 (slots=%u, event=%u bytes) =========\n",
+           (unsigned)EVENT_QUEUE_CAPACITY_SLOTS, (unsigned)sizeof(app_event_t));
+
+    errors = test_boundaries();
+    printf("[1] 满/空/clear/下标回绕: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    errors = test_coalesce();
+    printf("[2] 重复事件合并/保留槽/统计: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    run_threaded(&s_spsc, STRESS_EVENTS, &prod, &cons);
+    printf("[3] SPSC 双线程压力 %u 事件: %s (满等待=%u, 空等待=%u)\n", (unsigned)STRESS_EVENTS,
+           cons.errors ? "失败" : "成功", (unsigned)prod.full_spins, (unsigned)cons.empty_spins);
+    failed += cons.errors;
+
+    run_threaded(&s_legacy, STRESS_EVENTS, &prod, &cons);
+    printf("[4] 旧实现双线程 %u 事件: %s\n", (unsigned)STRESS_EVENTS, cons.errors ? "失败" : "成功");
+    failed += cons.errors;
+
+    errors = bench_compare(false, &bench);
+    printf("[5] 单线程推入+取出 %u 轮（最小/中位/最大）: %s\n", (unsigned)BENCH_ROUNDS, errors ? "失败" : "成功");
+    bench_print(&bench);
+    failed += errors;
+
+    errors = bench_compare(true, &bench);
+    printf("[6] 双线程吞吐 %u 轮（取决于主机调度，仅供参考）: %s\n", (unsigned)BENCH_ROUNDS,
+           errors ? "失败" : "成功");
+    bench_print(&bench);
+    failed += errors;
+
+    printf("==================================\n");
+    printf(failed ? ">>> 测试失败! <<<\n" : ">>> 所有测试通过! <<<\n");
+    return failed ? 1 : 0;
+}
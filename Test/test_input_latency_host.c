@@ -0,0 +1,323 @@
+// =============================================================================
+// 输入到屏幕延迟 主机仿真（在PC上运行，不加入Keil工程）
+// =============================================================================
+//
+// 编译运行（在仓库根目录）：
+//   gcc -O2 -IApp/sys -IComponents/scheduler -IComponents/event_queue -IComponents/event_bus -IComponents/input_manager -IComponents/input_replay -IComponents/ebtn -IComponents/rocker -IBsp/key Test/test_input_latency_host.c -o /tmp/test_input_latency
+//   /tmp/test_input_latency
+//
+// 用虚拟时钟跑真实的调度器、事件队列和输入管理器：
+// - 按键任务模拟 ebtn：按脚本按下/松开，推入带时间戳的事件（和 ebtn_driver 一样）；
+// - 游戏任务模拟逻辑+绘制耗时，画面只在有输入时变化（菜单）或者每帧都变（动画游戏）；
+// - 显示任务照抄 display_service_task 的限速/忙等逻辑，DMA 发送按固定耗时在“中断”里完成。
+// 输出平均/最大延迟，最大延迟超过理论上限则失败，可以作为回归基准。
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 跳过 mydefine.h（HAL 头文件在主机上不可用）
+#define __MYDEFINE_H__
+
+// ---------------------------------------------------------------------------
+// 虚拟时钟和调度器移植层
+// ---------------------------------------------------------------------------
+static uint32_t s_now_us;
+static void sim_wfi(void);
+
+#define SystemCoreClock                 168000000u
+#define SCHEDULER_GET_TICK()            (s_now_us / 1000)
+#define SCHEDULER_GET_TIME_US()         (s_now_us)
+#define SCHEDULER_GET_CYCLES()          (s_now_us * 168u)
+#define SCHEDULER_DISABLE_IRQ()         ((void)0)
+#define SCHEDULER_ENABLE_IRQ()          ((void)0)
+#define SCHEDULER_WAIT_FOR_INTERRUPT()  sim_wfi()
+#define __DMB()                         ((void)0)
+
+#include "../Components/scheduler/scheduler.c"
+#include "../Components/event_queue/event_queue.c"
+
+// 录制回放不参与延迟仿真：钩子给空实现
+#include "input_replay.h"
+
+uint8_t input_replay_is_playing(void)
+{
+    return 0;
+}
+
+void input_replay_record_event(const app_event_t *evt)
+{
+    (void)evt;
+}
+
+void input_replay_record_batch(uint8_t had_edges)
+{
+    (void)had_edges;
+}
+
+#include "../Components/input_manager/input_manager.c"
+#include "../Components/event_bus/event_bus.c"
+
+// ---------------------------------------------------------------------------
+// 仿真参数
+// ---------------------------------------------------------------------------
+#define SIM_LOGIC_RENDER_US   1500u    // 游戏逻辑+绘制耗时
+#define SIM_FLUSH_US          12000u   // 一帧 I2C DMA 发送耗时
+#define SIM_FRAME_PERIOD_MS   (1000u / 30u) // 和 DISPLAY_SERVICE_DEFAULT_FPS 一致
+#define SIM_PRESSES           200u
+#define SIM_HOLD_MS           120u
+
+// 理论上限：等到按键任务的下一个周期之后（事件唤醒让后面的任务同一轮运行），
+// 最多再等一个帧周期，加一帧发送和一次逻辑绘制
+#define SIM_LATENCY_BOUND_US  (SIM_FRAME_PERIOD_MS * 1000u + SIM_FLUSH_US + SIM_LOGIC_RENDER_US + 1000u)
+
+// ---------------------------------------------------------------------------
+// 仿真的“硬件”：DMA 发送完成中断
+// ---------------------------------------------------------------------------
+static bool s_dma_busy;
+static uint32_t s_dma_done_at;
+
+// 显示服务的发送完成回调（同 display_service_on_flush_done）
+static volatile uint8_t s_flush_done;
+static volatile uint32_t s_flush_done_us;
+
+static void sim_fire_irqs(void)
+{
+    if (s_dma_busy && (int32_t)(s_now_us - s_dma_done_at) >= 0)
+    {
+        s_dma_busy = false;
+        s_flush_done_us = s_dma_done_at;
+        s_flush_done = 1;
+    }
+}
+
+// 任务占用 CPU us 微秒，期间到期的中断在到期时刻发生
+static void sim_advance(uint32_t us)
+{
+    uint32_t target = s_now_us + us;
+
+    if (s_dma_busy && (int32_t)(target - s_dma_done_at) >= 0)
+    {
+        s_now_us = s_dma_done_at;
+        sim_fire_irqs();
+    }
+    s_now_us = target;
+}
+
+// 休眠到下一个中断：SysTick（下一毫秒）或者 DMA 完成
+static void sim_wfi(void)
+{
+    uint32_t next = (s_now_us / 1000 + 1) * 1000;
+
+    if (s_dma_busy && (int32_t)(s_dma_done_at - next) < 0)
+    {
+        next = s_dma_done_at;
+    }
+    s_now_us = next;
+    sim_fire_irqs();
+}
+
+// ---------------------------------------------------------------------------
+// 仿真任务
+// ---------------------------------------------------------------------------
+static uint32_t s_press_at_ms[SIM_PRESSES];
+static uint32_t s_press_idx;
+static bool s_btn_down;
+static bool s_animated;        // true=每帧画面都变（动画游戏），false=只在输入时变（菜单）
+static bool s_frame_changed;
+static bool s_frame_ready;
+static uint32_t s_last_flush_ms;
+static uint32_t s_edges;
+
+// 按键：10ms 轮询一次（和 ebtn_process_task 一样），检测到边沿推入带时间戳的事件
+static void sim_button_task(void)
+{
+    uint32_t now_ms = s_now_us / 1000;
+    app_event_t evt;
+    bool want;
+
+    if (s_press_idx >= SIM_PRESSES)
+    {
+        return;
+    }
+
+    want = now_ms >= s_press_at_ms[s_press_idx] && now_ms < s_press_at_ms[s_press_idx] + SIM_HOLD_MS;
+    if (want == s_btn_down)
+    {
+        return;
+    }
+
+    s_btn_down = want;
+    evt.source_id = BTN_SW3;
+    evt.event_type = want ? EBTN_EVT_ONPRESS : EBTN_EVT_ONRELEASE;
+    evt.data = 0;
+    evt.timestamp_us = scheduler_get_time_us();
+    event_queue_push(evt);
+    s_edges++;
+
+    if (!want)
+    {
+        s_press_idx++;
+    }
+}
+
+// 游戏/菜单：读边沿，逻辑+绘制，标记一帧就绪
+static void sim_game_task(void)
+{
+    if (input_is_just_pressed(INPUT_BTN_A) || input_is_just_released(INPUT_BTN_A) || s_animated)
+    {
+        s_frame_changed = true;
+    }
+    sim_advance(SIM_LOGIC_RENDER_US);
+    s_frame_ready = true;
+}
+
+static void sim_report_presented(void)
+{
+    if (s_flush_done)
+    {
+        s_flush_done = 0;
+        input_manager_frame_presented(s_flush_done_us);
+    }
+}
+
+// 显示服务：和 display_service_task 相同的顺序
+static void sim_display_task(void)
+{
+    uint32_t now_ms = s_now_us / 1000;
+    uint16_t bytes;
+
+    sim_report_presented();
+
+    if (!s_frame_ready)
+    {
+        return;
+    }
+    if (now_ms - s_last_flush_ms < SIM_FRAME_PERIOD_MS)
+    {
+        return;
+    }
+    if (s_dma_busy)
+    {
+        return;
+    }
+    sim_report_presented();
+
+    bytes = s_frame_changed ? 1024 : 0;
+    if (bytes)
+    {
+        s_dma_busy = true;
+        s_dma_done_at = s_now_us + SIM_FLUSH_US;
+    }
+    s_frame_changed = false;
+    s_frame_ready = false;
+    s_last_flush_ms = now_ms;
+
+    input_manager_frame_sent(bytes != 0);
+}
+
+// ---------------------------------------------------------------------------
+// 测试
+// ---------------------------------------------------------------------------
+
+// 最早未处理事件的等待时间
+static uint32_t test_oldest_age(void)
+{
+    app_event_t evt = {BTN_SW3, EBTN_EVT_ONPRESS, 0, 0};
+    uint32_t errors = 0;
+
+    s_now_us = 5000;
+    event_queue_init();
+    errors += input_manager_get_oldest_event_age_us() != 0;
+    evt.timestamp_us = scheduler_get_time_us();
+    event_queue_push(evt);
+    s_now_us += 3250;
+    evt.timestamp_us = scheduler_get_time_us();
+    event_queue_push(evt);
+    s_now_us += 1000;
+    errors += input_manager_get_oldest_event_age_us() != 4250;
+    event_queue_pop(&evt);
+    errors += input_manager_get_oldest_event_age_us() != 1000;
+    event_queue_clear();
+    errors += input_manager_get_oldest_event_age_us() != 0;
+    return errors;
+}
+
+// 跑一遍完整流水线，返回延迟统计
+static void run_pipeline(bool animated, input_latency_stats_t *lat)
+{
+    uint32_t t = 500;
+
+    s_now_us = 0;
+    s_animated = animated;
+    s_press_idx = 0;
+    s_btn_down = false;
+    s_frame_changed = true;
+    s_frame_ready = false;
+    s_last_flush_ms = 0;
+    s_dma_busy = false;
+    s_flush_done = 0;
+    s_edges = 0;
+
+    // 按下时刻随机，相对10ms轮询和帧周期的相位都覆盖到
+    srand(animated ? 7 : 3);
+    for (uint32_t i = 0; i < SIM_PRESSES; i++)
+    {
+        t += SIM_HOLD_MS + 50 + (uint32_t)rand() % 300;
+        s_press_at_ms[i] = t;
+    }
+
+    scheduler_init();
+    event_queue_init();
+    input_manager_init();
+
+    // 和 system_assembly_register_tasks 一样的周期、优先级、相位和事件唤醒
+    scheduler_add_task_ex(sim_button_task, 10, SCHEDULER_PRIORITY_HIGH, 0, "ebtn");
+    scheduler_add_task_ex(input_manager_task, 10, SCHEDULER_PRIORITY_HIGH, 0, "input");
+    scheduler_add_task_ex(sim_game_task, 10, SCHEDULER_PRIORITY_NORMAL, 2, "game");
+    scheduler_add_task_ex(sim_display_task, 5, SCHEDULER_PRIORITY_LOW, 2, "display");
+    scheduler_set_event_wakeup(input_manager_task, true);
+    scheduler_set_event_wakeup(sim_game_task, true);
+    scheduler_set_event_wakeup(sim_display_task, true);
+
+    while (s_now_us < (t + 1000) * 1000u)
+    {
+        scheduler_run();
+    }
+
+    input_manager_get_latency_stats(lat);
+}
+
+int main(void)
+{
+    input_latency_stats_t lat;
+    uint32_t errors, failed = 0;
+
+    printf("========= 输入到屏幕延迟仿真 =========\n");
+    printf("参数: 逻辑+绘制 %u us, 发送 %u us, 帧周期 %u ms, 上限 %u us\n",
+           SIM_LOGIC_RENDER_US, SIM_FLUSH_US, SIM_FRAME_PERIOD_MS, SIM_LATENCY_BOUND_US);
+
+    errors = test_oldest_age();
+    printf("[1] 最早未处理事件的等待时间: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    run_pipeline(false, &lat);
+    errors = (lat.count + lat.unchanged != s_edges) || lat.unchanged != 0 || lat.max_us > SIM_LATENCY_BOUND_US;
+    printf("[2] 菜单（只在输入时重画）: %s 边沿=%lu 测到=%lu 平均=%lu us 最大=%lu us\n",
+           errors ? "失败" : "成功", (unsigned long)s_edges, (unsigned long)lat.count,
+           (unsigned long)lat.avg_us, (unsigned long)lat.max_us);
+    failed += errors;
+
+    run_pipeline(true, &lat);
+    errors = (lat.count + lat.unchanged != s_edges) || lat.max_us > SIM_LATENCY_BOUND_US;
+    printf("[3] 动画游戏（每帧都重画）: %s 边沿=%lu 测到=%lu 平均=%lu us 最大=%lu us\n",
+           errors ? "失败" : "成功", (unsigned long)s_edges, (unsigned long)lat.count,
+           (unsigned long)lat.avg_us, (unsigned long)lat.max_us);
+    failed += errors;
+
+    printf("==================================\n");
+    printf(failed ? ">>> 测试失败! <<<\n" : ">>> 所有测试通过! <<<\n");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,428 @@
+// =============================================================================
+// 输入录制回放 主机测试（在PC上运行，不加入Keil工程）
+// =============================================================================
+//
+// 编译运行（在仓库根目录）：
+//   gcc -O2 -IApp/sys -IApp/game -IApp/assets -IComponents/scheduler -IComponents/event_queue -IComponents/event_bus -IComponents/input_manager -IComponents/input_replay -IComponents/ebtn -IComponents/rocker -IComponents/u8g2 -IComponents/layer -IBsp/key -IBsp/rng -ICore/Inc Test/test_input_replay_host.c Components/layer/layer.c $(ls Components/u8g2/u8*.c | grep -v stm32_hal) -o /tmp/test_input_replay
+//   /tmp/test_input_replay
+//
+// 用虚拟时钟跑真实的调度器、事件队列、输入管理器、游戏管理器和游戏（贪吃蛇、俄罗斯方块），
+// u8g2 画到内存缓冲区，HAL 只留 HAL_GetTick 和硬件随机数两个桩：
+// 1. 录一局：脚本随机推动摇杆、按键（带摇杆 HOLD 重复事件），最后按 B 退出；
+// 2. 回放：换一个开机时刻、换一个硬件随机数序列，同时脚本继续乱按（回放时必须被忽略），
+//    每一帧的画面和游戏状态的哈希都要和录制时完全相同，并且在同一帧退出；
+// 3. 录制写满：长时间快速乱按把缓冲区写满，回放时截断之前的每一帧都相同，之后游戏继续接受实时输入。
+// 每次运行前游戏实例清零，和开机后第一次进入游戏一样。
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 跳过 mydefine.h 和 CubeMX 的 rng.h（HAL 头文件在主机上不可用）
+#define __MYDEFINE_H__
+#define __RNG_H__
+
+// ---------------------------------------------------------------------------
+// 虚拟时钟和调度器移植层
+// ---------------------------------------------------------------------------
+static uint32_t s_now_us;
+
+#define SystemCoreClock                 168000000u
+#define SCHEDULER_GET_TICK()            (s_now_us / 1000)
+#define SCHEDULER_GET_TIME_US()         (s_now_us)
+#define SCHEDULER_GET_CYCLES()          (s_now_us * 168u)
+#define SCHEDULER_DISABLE_IRQ()         ((void)0)
+#define SCHEDULER_ENABLE_IRQ()          ((void)0)
+#define SCHEDULER_WAIT_FOR_INTERRUPT()  (s_now_us = (s_now_us / 1000 + 1) * 1000)
+#define __DMB()                         ((void)0)
+
+static uint32_t HAL_GetTick(void)
+{
+    return s_now_us / 1000;
+}
+
+// ---------------------------------------------------------------------------
+// 硬件随机数桩：每次运行用不同的序列，回放必须不依赖它
+// ---------------------------------------------------------------------------
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+    void *Instance;
+} RNG_HandleTypeDef;
+
+#define RNG ((void *)1)
+static RNG_HandleTypeDef hrng = {RNG};
+static uint32_t s_hw_rng;
+
+static HAL_StatusTypeDef HAL_RNG_GenerateRandomNumber(RNG_HandleTypeDef *h, uint32_t *random)
+{
+    (void)h;
+    s_hw_rng = s_hw_rng * 1664525u + 1013904223u;
+    *random = s_hw_rng;
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------
+// 显示、菜单、性能浮层桩
+// ---------------------------------------------------------------------------
+#include "u8g2.h"
+#include "layer.h"
+
+static u8g2_t s_u8g2;
+
+// 仓库里没有 u8g2_fonts.c（字库只在 Keil 工程里），给游戏用到的字体一个空字库：
+// 没有字形，文字不画，画面哈希仍然包含所有图形
+const uint8_t u8g2_font_5x7_tf[32] = {0};
+const uint8_t u8g2_font_6x10_tf[32] = {0};
+const uint8_t u8g2_font_7x13_tf[32] = {0};
+
+static u8g2_t *u8g2_get_instance(void)
+{
+    return &s_u8g2;
+}
+
+static void display_service_mark_ready(void)
+{
+}
+
+static void main_menu_activate(void)
+{
+}
+
+static void main_menu_deactivate(void)
+{
+}
+
+typedef enum
+{
+    PERF_PHASE_LOGIC = 0,
+    PERF_PHASE_RENDER,
+} perf_phase_t;
+
+static uint32_t perf_hud_begin(void)
+{
+    return 0;
+}
+
+static void perf_hud_end(perf_phase_t phase, uint32_t start)
+{
+    (void)phase;
+    (void)start;
+}
+
+#include "../Components/scheduler/scheduler.c"
+#include "../Components/event_queue/event_queue.c"
+#include "../Components/input_manager/input_manager.c"
+#include "../Components/event_bus/event_bus.c"
+#include "../Bsp/rng/rng_driver.c"
+#include "../Components/input_replay/input_replay.c"
+#include "../App/game/game_manager.c"
+#include "../App/game/snake_game.c"
+#include "../App/game/tetris_game.c"
+
+static snake_game_t g_snake_game;
+GAME_ADAPTER(snake_game, snake_game_t)
+GAME_DESCRIPTOR(g_snake_game, "Snake", snake_game);
+
+static tetris_game_t g_tetris_game;
+GAME_ADAPTER(tetris_game, tetris_game_t)
+GAME_DESCRIPTOR(g_tetris_game, "Tetris", tetris_game);
+
+// ---------------------------------------------------------------------------
+// 脚本输入：模拟 ebtn 和摇杆任务推入带时间戳的事件
+// ---------------------------------------------------------------------------
+#define SIM_MAX_FRAMES 60000u
+
+static uint32_t s_script;          // 脚本自己的随机数，和游戏用的随机数无关
+static uint32_t s_script_rate;     // 每个 10ms 周期动作的概率（1/rate）
+static uint32_t s_script_end_ms;   // 到这个时刻按 B 退出，0=不退出
+static rocker_direction_t s_held_dir;
+static uint16_t s_held_btn;        // 按着的按键 +1，0=没有
+
+static uint32_t script_rand(void)
+{
+    s_script = s_script * 1103515245u + 12345u;
+    return s_script >> 16;
+}
+
+static void push_event(uint16_t source_id, uint8_t type, uint32_t data)
+{
+    app_event_t evt;
+
+    evt.source_id = source_id;
+    evt.event_type = type;
+    evt.data = data;
+    evt.timestamp_us = scheduler_get_time_us();
+    event_queue_push(evt);
+}
+
+static void sim_input_task(void)
+{
+    static const rocker_direction_t dirs[] = {ROCKER_DIR_UP, ROCKER_DIR_DOWN, ROCKER_DIR_LEFT, ROCKER_DIR_RIGHT};
+    static const uint16_t btns[] = {BTN_SW1, BTN_SW2, BTN_SW3, BTN_SK};
+    app_event_t hold;
+
+    if (s_script_end_ms != 0 && s_now_us / 1000 >= s_script_end_ms)
+    {
+        push_event(BTN_SW4, EBTN_EVT_ONPRESS, 0);
+        s_script_end_ms = 0;
+        return;
+    }
+
+    // 摇杆按住时每个周期一个 HOLD（会被合并，也不会被录制）
+    if (s_held_dir != ROCKER_DIR_CENTER)
+    {
+        hold.source_id = ROCKER_SOURCE_ID;
+        hold.event_type = ROCKER_EVT_DIR_HOLD;
+        hold.data = ROCKER_EVT_PACK_DATA(s_held_dir, 100);
+        hold.timestamp_us = scheduler_get_time_us();
+        event_queue_push_repeat(hold);
+    }
+
+    if (script_rand() % s_script_rate != 0)
+    {
+        return;
+    }
+
+    if (script_rand() % 3 != 0)
+    {
+        if (s_held_dir != ROCKER_DIR_CENTER)
+        {
+            push_event(ROCKER_SOURCE_ID, ROCKER_EVT_DIR_LEAVE, ROCKER_EVT_PACK_DATA(s_held_dir, 0));
+            s_held_dir = ROCKER_DIR_CENTER;
+        }
+        else
+        {
+            s_held_dir = dirs[script_rand() % 4];
+            push_event(ROCKER_SOURCE_ID, ROCKER_EVT_DIR_ENTER, ROCKER_EVT_PACK_DATA(s_held_dir, 100));
+        }
+    }
+    else if (s_held_btn != 0)
+    {
+        push_event(s_held_btn - 1, EBTN_EVT_ONRELEASE, 0);
+        s_held_btn = 0;
+    }
+    else
+    {
+        s_held_btn = btns[script_rand() % 4] + 1;
+        push_event(s_held_btn - 1, EBTN_EVT_ONPRESS, 0);
+        if (script_rand() % 4 == 0)
+        {
+            push_event(s_held_btn - 1, EBTN_EVT_ONCLICK, 2); // 双击
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 每帧哈希：画面缓冲区 + 游戏实例
+// ---------------------------------------------------------------------------
+static uint32_t s_hash[2][SIM_MAX_FRAMES];
+static uint32_t s_frames;
+static uint32_t s_played_frames; // 回放驱动的帧数（回放结束后的帧不算）
+static uint32_t *s_hash_out;
+
+static uint32_t fnv1a(uint32_t h, const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h;
+}
+
+static void sim_game_task(void)
+{
+    const game_descriptor_t *game = game_manager_get_current_game();
+    uint8_t playing = input_replay_is_playing();
+    uint32_t h;
+
+    game_manager_task_all();
+    if (game == NULL || s_frames >= SIM_MAX_FRAMES)
+    {
+        return;
+    }
+
+    h = fnv1a(2166136261u, u8g2_GetBufferPtr(&s_u8g2), 1024);
+    h = fnv1a(h, game->instance, game == &g_snake_game_descriptor ? sizeof(g_snake_game) : sizeof(g_tetris_game));
+    s_hash_out[s_frames++] = h;
+
+    // 这一帧开始时在回放，结束时也还在回放（或者是回放里的退出）才是回放驱动的
+    if (playing && (input_replay_is_playing() || game_manager_get_current_game() == NULL))
+    {
+        s_played_frames++;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 一次运行
+// ---------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t boot_us;      // 开机时刻
+    uint32_t hw_seed;      // 硬件随机数序列
+    uint32_t script_seed;  // 脚本随机数
+    uint32_t script_rate;  // 乱按的频率
+    uint32_t play_ms;      // 多久之后按 B 退出，0=不退出
+    uint32_t limit_ms;     // 最多运行多久
+    bool replay;           // 回放最近一次录制
+    uint32_t *hash_out;
+} sim_run_t;
+
+static void sim_run(const char *game_name, const sim_run_t *run)
+{
+    uint32_t end_us;
+
+    s_now_us = run->boot_us;
+    s_hw_rng = run->hw_seed;
+    s_script = run->script_seed;
+    s_script_rate = run->script_rate;
+    s_script_end_ms = run->play_ms ? run->boot_us / 1000 + run->play_ms : 0;
+    s_held_dir = ROCKER_DIR_CENTER;
+    s_held_btn = 0;
+    s_frames = 0;
+    s_played_frames = 0;
+    s_hash_out = run->hash_out;
+    memset(&g_snake_game, 0, sizeof(g_snake_game));
+    memset(&g_tetris_game, 0, sizeof(g_tetris_game));
+    layer_invalidate();
+
+    scheduler_init();
+    event_queue_init();
+    event_bus_init();
+    input_manager_init();
+    rng_init();
+    game_manager_init();
+    game_manager_register(&g_snake_game_descriptor);
+    game_manager_register(&g_tetris_game_descriptor);
+
+    // 和 system_assembly_register_tasks 一样的周期、优先级和事件唤醒
+    scheduler_add_task_ex(sim_input_task, 10, SCHEDULER_PRIORITY_HIGH, 0, "ebtn");
+    scheduler_add_task_ex(input_manager_task, 10, SCHEDULER_PRIORITY_HIGH, 0, "input");
+    scheduler_add_task_ex(sim_game_task, 10, SCHEDULER_PRIORITY_NORMAL, 2, "game");
+    scheduler_set_event_wakeup(input_manager_task, true);
+    scheduler_set_event_wakeup(sim_game_task, true);
+
+    if (run->replay)
+    {
+        game_manager_start_replay();
+    }
+    else
+    {
+        game_manager_start_game(game_name);
+    }
+
+    end_us = run->boot_us + run->limit_ms * 1000u;
+    while (game_manager_get_current_game() != NULL && (int32_t)(s_now_us - end_us) < 0)
+    {
+        scheduler_run();
+    }
+    if (game_manager_get_current_game() != NULL)
+    {
+        game_manager_exit_current_game();
+    }
+}
+
+// 录一局再回放，比较每一帧
+static uint32_t test_record_replay(const char *game_name, uint32_t seed)
+{
+    input_replay_stats_t rec, play;
+    uint32_t rec_frames;
+    uint32_t errors = 0;
+    sim_run_t run = {1000000u, seed, seed * 7u + 1u, 25, 60000, 120000, false, s_hash[0]};
+
+    input_replay_init();
+    sim_run(game_name, &run);
+    input_replay_get_stats(&rec);
+    rec_frames = s_frames;
+    errors += rec.truncated || rec_frames == 0;
+
+    // 回放：不同的开机时刻和硬件随机数，脚本照样乱按（包括在别的时刻按 B）
+    run.boot_us = 987654321u;
+    run.hw_seed = seed ^ 0xA5A5A5A5u;
+    run.script_seed = seed + 99u;
+    run.script_rate = 10;
+    run.play_ms = 20000;
+    run.replay = true;
+    run.hash_out = s_hash[1];
+    sim_run(game_name, &run);
+    input_replay_get_stats(&play);
+
+    errors += s_frames != rec_frames || s_played_frames != rec_frames;
+    errors += memcmp(s_hash[0], s_hash[1], rec_frames * sizeof(uint32_t)) != 0;
+    errors += play.events != rec.events || play.frames != rec.frames;
+
+    printf("    %s: 帧=%lu 事件=%lu 录制=%lu 字节 (%.1f 字节/秒)\n", game_name,
+           (unsigned long)rec.frames, (unsigned long)rec.events, (unsigned long)rec.bytes,
+           rec.bytes * 1000.0 / (run.play_ms ? 60000 : 1));
+    return errors;
+}
+
+// 写满截断
+static uint32_t test_truncated(void)
+{
+    input_replay_stats_t rec;
+    uint32_t rec_frames, matched = 0;
+    uint32_t errors = 0;
+    sim_run_t run = {5000000u, 11, 12, 3, 0, 300000, false, s_hash[0]};
+
+    input_replay_init();
+    sim_run("Tetris", &run);
+    input_replay_get_stats(&rec);
+    rec_frames = s_frames;
+    errors += !rec.truncated || rec.bytes > INPUT_REPLAY_BUFFER_SIZE;
+
+    run.boot_us = 77777u;
+    run.hw_seed = 3;
+    run.script_seed = 4;
+    run.limit_ms = 300000;
+    run.replay = true;
+    run.hash_out = s_hash[1];
+    sim_run("Tetris", &run);
+
+    while (matched < s_played_frames && s_hash[0][matched] == s_hash[1][matched])
+    {
+        matched++;
+    }
+    errors += s_played_frames == 0 || matched != s_played_frames || s_played_frames >= rec_frames;
+    // 回放结束后游戏继续运行（实时输入）
+    errors += s_frames <= s_played_frames;
+
+    printf("    录制 %lu 帧，写满时录下 %lu 帧 (%lu 字节)，回放逐帧相同 %lu 帧\n",
+           (unsigned long)rec_frames, (unsigned long)s_played_frames,
+           (unsigned long)rec.bytes, (unsigned long)matched);
+    return errors;
+}
+
+int main(void)
+{
+    uint32_t errors, failed = 0;
+
+    u8g2_Setup_ssd1306_i2c_128x64_noname_f(&s_u8g2, U8G2_R0, u8x8_byte_empty, u8x8_dummy_cb);
+
+    printf("========= 输入录制回放主机测试 (缓冲区 %u 字节) =========\n", INPUT_REPLAY_BUFFER_SIZE);
+
+    errors = test_record_replay("Snake", 1) + test_record_replay("Snake", 2);
+    printf("[1] 贪吃蛇 录制/回放逐帧相同: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    errors = test_record_replay("Tetris", 1) + test_record_replay("Tetris", 2);
+    printf("[2] 俄罗斯方块 录制/回放逐帧相同: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    errors = test_truncated();
+    printf("[3] 录制写满截断后回放: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    printf("==================================\n");
+    printf(failed ? ">>> 测试失败! <<<\n" : ">>> 所有测试通过! <<<\n");
+    return failed ? 1 : 0;
+}
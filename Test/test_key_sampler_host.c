@@ -0,0 +1,323 @@
+// =============================================================================
+// 按键 DMA 采样 主机测试（在PC上运行，不加入Keil工程）
+// =============================================================================
+//
+// 编译运行（在仓库根目录）：
+//   gcc -O2 -IApp/sys -IBsp/key -ICore/Inc Test/test_key_sampler_host.c -o /tmp/test_key_sampler
+//   /tmp/test_key_sampler
+//
+// 用虚拟时钟模拟 TIM8 每 1ms 触发一次 DMA 抓拍 IDR（写环形缓冲区、NDTR 递减、计数器计时）：
+// 1. 五个按键各自随机按下/松开，每个边沿带 0~3ms 的抖动：和逐位计数的参考消抖逐点比较
+//    状态和边沿时刻（按位并行的垂直计数器必须和五个独立计数器完全一样）；
+// 2. 10ms 轮询：两次轮询之间按下又松开的 4.5ms 短按报告一次按下、下一次松开，3ms 以内的毛刺不报告；
+// 3. 轮询间隔超过缓冲区：记一次覆盖，状态和边沿时刻仍然正确。
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 跳过 mydefine.h 和 CubeMX 的 tim.h（HAL 头文件在主机上不可用）
+#define __MYDEFINE_H__
+#define __TIM_H__
+
+// ---------------------------------------------------------------------------
+// 虚拟时钟、GPIO 和 TIM8/DMA 桩
+// ---------------------------------------------------------------------------
+#define SW1_Pin 0x0001u
+#define SW2_Pin 0x0002u
+#define SW3_Pin 0x0004u
+#define SW4_Pin 0x0008u
+#define SK_Pin  0x0010u
+
+typedef struct
+{
+    volatile uint32_t IDR;
+} GPIO_TypeDef;
+
+static GPIO_TypeDef s_gpioe = {0xFFFF};
+#define GPIOE (&s_gpioe)
+
+typedef struct
+{
+    void *hdma[7];
+} TIM_HandleTypeDef;
+
+static TIM_HandleTypeDef htim8;
+#define TIM_DMA_ID_UPDATE 0
+#define TIM_DMA_UPDATE    0x0100u
+#define __HAL_TIM_ENABLE_DMA(h, d) ((void)(h), (void)(d))
+#define HAL_TIM_Base_Start(h)      ((void)(h))
+#define HAL_DMA_Start(h, src, dst, len) ((void)(h), (void)(src), (void)(dst), (void)(len))
+
+static uint32_t s_now_us;
+static uint32_t s_update_us;   // 最近一次更新事件（采样）的时刻
+static uint32_t s_remaining;   // 模拟的 NDTR
+
+static uint32_t scheduler_get_time_us(void)
+{
+    return s_now_us;
+}
+
+#define KEY_SAMPLER_DMA_REMAINING() (s_remaining)
+#define KEY_SAMPLER_TIMER_COUNT()   (s_now_us - s_update_us)
+
+#include "../Bsp/key/key_sampler.c"
+
+#define PIN_COUNT 5
+#define SIM_MS    60000u
+
+// ---------------------------------------------------------------------------
+// 按键信号：按下/松开的时刻和抖动
+// ---------------------------------------------------------------------------
+typedef struct
+{
+    uint32_t next_edge_us;  // 下一次切换的时刻
+    uint32_t bounce_end_us; // 抖动结束的时刻
+    bool pressed;           // 抖动结束后的电平
+} pin_signal_t;
+
+static pin_signal_t s_sig[PIN_COUNT];
+
+// 这一时刻引脚的电平（按下=1），抖动期间每 300us 左右随机翻
+static bool signal_level(pin_signal_t *sig, uint32_t t)
+{
+    if ((int32_t)(t - sig->bounce_end_us) < 0)
+    {
+        return (rand() & 1) != 0;
+    }
+    return sig->pressed;
+}
+
+static void signal_step(pin_signal_t *sig, uint32_t t)
+{
+    if ((int32_t)(t - sig->next_edge_us) < 0)
+    {
+        return;
+    }
+    sig->pressed = !sig->pressed;
+    sig->bounce_end_us = t + (uint32_t)(rand() % 3001);
+    sig->next_edge_us = t + 8000u + (uint32_t)(rand() % 120000);
+}
+
+// ---------------------------------------------------------------------------
+// 参考消抖：每个引脚一个计数器，连续4个采样不同才翻转
+// ---------------------------------------------------------------------------
+typedef struct
+{
+    bool state;
+    uint8_t run;
+    uint32_t run_start_us;
+    uint32_t edge_us;
+} ref_pin_t;
+
+static ref_pin_t s_ref[PIN_COUNT];
+
+static void ref_feed(uint8_t pin, bool level, uint32_t t)
+{
+    ref_pin_t *r = &s_ref[pin];
+
+    if (level == r->state)
+    {
+        r->run = 0;
+        return;
+    }
+    if (r->run++ == 0)
+    {
+        r->run_start_us = t;
+    }
+    if (r->run == KEY_SAMPLER_DEBOUNCE_SAMPLES)
+    {
+        r->state = level;
+        r->edge_us = r->run_start_us;
+        r->run = 0;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 时间推进：到每个更新事件 DMA 写一个采样点
+// ---------------------------------------------------------------------------
+static uint32_t s_write;
+static bool s_use_signal; // true=随机信号，false=测试直接写 IDR
+
+static void sim_reset(void)
+{
+    s_now_us = 123456u;
+    s_update_us = s_now_us;
+    s_remaining = KEY_SAMPLER_BUFFER_SIZE;
+    s_write = 0;
+    s_gpioe.IDR = 0xFFFF;
+    memset(s_sig, 0, sizeof(s_sig));
+    memset(s_ref, 0, sizeof(s_ref));
+    key_sampler_init();
+}
+
+static void sim_advance(uint32_t us)
+{
+    uint32_t target = s_now_us + us;
+
+    while ((int32_t)(target - (s_update_us + KEY_SAMPLER_PERIOD_US)) >= 0)
+    {
+        uint32_t t = s_update_us + KEY_SAMPLER_PERIOD_US;
+
+        if (s_use_signal)
+        {
+            uint32_t idr = 0xFFFF;
+
+            for (uint8_t i = 0; i < PIN_COUNT; i++)
+            {
+                signal_step(&s_sig[i], t);
+                if (signal_level(&s_sig[i], t))
+                {
+                    idr &= ~(1u << i);
+                }
+            }
+            s_gpioe.IDR = idr;
+        }
+        for (uint8_t i = 0; i < PIN_COUNT; i++)
+        {
+            ref_feed(i, (s_gpioe.IDR & (1u << i)) == 0, t);
+        }
+
+        s_dma_buf[s_write] = (uint16_t)s_gpioe.IDR;
+        s_write = (s_write + 1) % KEY_SAMPLER_BUFFER_SIZE;
+        s_remaining = KEY_SAMPLER_BUFFER_SIZE - s_write;
+        s_update_us = t;
+    }
+    s_now_us = target;
+}
+
+// ---------------------------------------------------------------------------
+// 测试
+// ---------------------------------------------------------------------------
+
+// 1. 随机抖动信号，和参考消抖逐次比较
+static uint32_t test_reference(uint32_t *edges)
+{
+    key_sampler_stats_t stats;
+    uint16_t prev = 0;
+    uint32_t errors = 0;
+
+    srand(1);
+    sim_reset();
+    s_use_signal = true;
+    for (uint8_t i = 0; i < PIN_COUNT; i++)
+    {
+        s_sig[i].next_edge_us = s_now_us + 5000u + (uint32_t)(rand() % 50000);
+    }
+
+    while (s_now_us < 123456u + SIM_MS * 1000u)
+    {
+        uint16_t pressed;
+
+        // 轮询间隔 1~3ms 随机，相位随机（两次轮询之间不会同时有按下和松开）
+        sim_advance(1000u + (uint32_t)(rand() % 2000));
+        pressed = key_sampler_poll();
+
+        for (uint8_t i = 0; i < PIN_COUNT; i++)
+        {
+            bool p = (pressed >> i) & 1;
+
+            errors += p != s_ref[i].state;
+            if (p != ((prev >> i) & 1))
+            {
+                errors += key_sampler_get_edge_us(1u << i) != s_ref[i].edge_us;
+            }
+        }
+        prev = pressed;
+    }
+
+    key_sampler_get_stats(&stats);
+    *edges = stats.edges;
+    errors += stats.overruns != 0 || stats.edges < 200;
+    return errors;
+}
+
+// 2. 10ms 轮询：短按被锁存一次，毛刺被滤掉
+static uint32_t test_tap(void)
+{
+    uint32_t errors = 0;
+    uint32_t release_us;
+
+    sim_reset();
+    s_use_signal = false;
+
+    sim_advance(10000);
+    errors += key_sampler_poll() != 0;
+
+    // 0.5ms 后按下 SW2，4.5ms 后松开，按下和松开都在下一次轮询之前消抖完
+    sim_advance(500);
+    s_gpioe.IDR &= ~SW2_Pin;
+    sim_advance(4500);
+    release_us = s_now_us;
+    s_gpioe.IDR |= SW2_Pin;
+    sim_advance(5000);
+    errors += key_sampler_poll() != SW2_Pin;
+    errors += s_state != 0; // 消抖后已经松开，只是锁存报告一次
+    errors += key_sampler_get_edge_us(SW2_Pin) - release_us > KEY_SAMPLER_PERIOD_US;
+    sim_advance(10000);
+    errors += key_sampler_poll() != 0;
+
+    // 3ms 的毛刺：不报告
+    s_gpioe.IDR &= ~SK_Pin;
+    sim_advance(3000);
+    s_gpioe.IDR |= SK_Pin;
+    sim_advance(7000);
+    errors += key_sampler_poll() != 0;
+    return errors;
+}
+
+// 3. 轮询间隔超过缓冲区
+static uint32_t test_overrun(void)
+{
+    key_sampler_stats_t stats;
+    uint32_t errors = 0;
+    uint32_t press_us;
+
+    sim_reset();
+    s_use_signal = false;
+
+    sim_advance(100000);
+    press_us = s_now_us;
+    s_gpioe.IDR &= ~SW4_Pin;
+    sim_advance(50000);
+    errors += key_sampler_poll() != SW4_Pin;
+    errors += key_sampler_get_edge_us(SW4_Pin) != s_ref[3].edge_us;
+    errors += key_sampler_get_edge_us(SW4_Pin) - press_us > KEY_SAMPLER_PERIOD_US;
+    key_sampler_get_stats(&stats);
+    errors += stats.overruns != 1;
+
+    // 之后恢复正常
+    s_gpioe.IDR |= SW4_Pin;
+    sim_advance(10000);
+    errors += key_sampler_poll() != 0;
+    key_sampler_get_stats(&stats);
+    errors += stats.overruns != 1;
+    return errors;
+}
+
+int main(void)
+{
+    uint32_t errors, edges, failed = 0;
+
+    printf("========= 按键 DMA 采样主机测试 (%u us 周期, %u 点缓冲) =========\n",
+           KEY_SAMPLER_PERIOD_US, KEY_SAMPLER_BUFFER_SIZE);
+
+    errors = test_reference(&edges);
+    printf("[1] 5键随机抖动 %u 秒，和逐位参考消抖逐点相同: %s (边沿=%lu)\n",
+           SIM_MS / 1000, errors ? "失败" : "成功", (unsigned long)edges);
+    failed += errors;
+
+    errors = test_tap();
+    printf("[2] 10ms 轮询间的短按锁存/毛刺滤除: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    errors = test_overrun();
+    printf("[3] 轮询间隔超过缓冲区: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    printf("==================================\n");
+    printf(failed ? ">>> 测试失败! <<<\n" : ">>> 所有测试通过! <<<\n");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,634 @@
+// =============================================================================
+// 游戏跳过重绘 主机基准测试（在PC上运行，不加入Keil工程）
+// =============================================================================
+//
+// 编译运行（在仓库根目录）：
+//   gcc -O2 -IApp/sys -IApp/game -IApp/assets -IComponents/scheduler -IComponents/event_queue -IComponents/event_bus -IComponents/input_manager -IComponents/input_replay -IComponents/display_service -IComponents/perf_hud -IComponents/ebtn -IComponents/rocker -IComponents/u8g2 -IComponents/layer -IBsp/key -IBsp/rng -ICore/Inc Test/test_redraw_skip_host.c Components/layer/layer.c $(ls Components/u8g2/u8*.c | grep -v stm32_hal) -o /tmp/test_redraw_skip
+//   /tmp/test_redraw_skip
+//
+// 用虚拟时钟跑真实的调度器、输入管理器、游戏管理器、游戏（贪吃蛇、俄罗斯方块）、显示服务
+// 和 u8g2_stm32_hal.c 的 I2C DMA 发送队列（DMA 完成中断和模拟屏同 test_display_host.c），
+// 同一段脚本输入分别在“每帧强制重绘”和“画面有变化才重绘”两种模式下跑一遍：
+// 1. 渲染/跳过的帧数，游戏任务和显示任务的耗时（主机周期，只比较两种模式的相对值）；
+// 2. I2C 字节：整帧刷新（每个就绪帧 1024 字节）时要发送的字节，以及差分刷新实际发送的字节
+//    （画面没变的帧差分刷新本来就不发，两种模式应该一样，省下的只是比较缓冲的时间）；
+// 3. 跳过的每一帧都重画一遍对比：跳过时缓冲里的画面必须和重画的一样（没有漏掉的画面变化），
+//    结束时屏上的 GDRAM 和缓冲一致。
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// 跳过 mydefine.h、CubeMX 的 main.h/i2c.h/rng.h 和 perf_hud.h（HAL 头文件在主机上不可用）
+#define __MYDEFINE_H__
+#define __MAIN_H
+#define __I2C_H__
+#define __RNG_H__
+#define __PERF_HUD_H__
+
+// ---------------------------------------------------------------------------
+// 虚拟时钟和调度器移植层
+// ---------------------------------------------------------------------------
+static uint32_t s_now_us;
+static void sim_wfi(void);
+
+#define SystemCoreClock                 168000000u
+#define SCHEDULER_GET_TICK()            (s_now_us / 1000)
+#define SCHEDULER_GET_TIME_US()         (s_now_us)
+#define SCHEDULER_GET_CYCLES()          (s_now_us * 168u)
+#define SCHEDULER_DISABLE_IRQ()         ((void)0)
+#define SCHEDULER_ENABLE_IRQ()          ((void)0)
+#define SCHEDULER_WAIT_FOR_INTERRUPT()  sim_wfi()
+#define __DMB()                         ((void)0)
+
+#include "../Components/scheduler/scheduler.c"
+
+// 主机的周期计数（x86 用 TSC，其他平台用纳秒）
+static uint32_t host_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000u + ts.tv_nsec);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// HAL 桩：I2C + DMA（同 test_display_host.c）
+// ---------------------------------------------------------------------------
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY
+} HAL_StatusTypeDef;
+
+typedef struct
+{
+    volatile uint32_t CR1;
+} I2C_TypeDef;
+
+typedef struct
+{
+    I2C_TypeDef *Instance;
+} I2C_HandleTypeDef;
+
+static I2C_TypeDef s_i2c1_regs;
+I2C_HandleTypeDef hi2c1 = {&s_i2c1_regs};
+
+#define I2C_FIRST_FRAME          0x00000001u
+#define I2C_FIRST_AND_LAST_FRAME 0x00000008u
+#define I2C_LAST_FRAME           0x00000020u
+#define I2C_CR1_STOP             (1u << 9)
+#define SET_BIT(REG, BIT)        ((REG) |= (BIT))
+#define HAL_MAX_DELAY            0xFFFFFFFFu
+#define __disable_irq()          ((void)0)
+#define __enable_irq()           ((void)0)
+#define __NOP()                  ((void)0)
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+
+#define SIM_GRAM_SIZE (128 * 64 / 8)
+
+// 正在发送的传输：完成时 DMA 才从这些指针取数据
+static bool s_dma_busy;
+static bool s_dma_start;           // 先发 START + 地址，第一个字节是控制字节
+static uint32_t s_dma_done_at;
+static uint8_t s_dma_ctrl;         // 当前事务的控制字节，零拷贝事务的数据段沿用它
+static const uint8_t *s_dma_data;
+static uint16_t s_dma_len;
+
+// 模拟 SSD1306（页寻址）
+static uint8_t s_gram[SIM_GRAM_SIZE];
+static uint8_t s_gram_page;
+static uint8_t s_gram_col;
+
+// 400kHz，每字节 9 位：22.5us；事务还要多发一个地址字节
+static uint32_t sim_i2c_us(uint16_t bytes)
+{
+    return ((uint32_t)bytes * 45u + 1u) / 2u;
+}
+
+// 一个事务到达屏幕：第一个字节是控制字节（0x00 命令，0x40 GDRAM 数据）
+static void sim_gram_xfer(uint8_t ctrl, const uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        uint8_t c = data[i];
+
+        if (ctrl == 0x40)
+        {
+            if (s_gram_col < 128)
+            {
+                s_gram[s_gram_page * 128 + s_gram_col] = c;
+            }
+            s_gram_col++;
+        }
+        else if (c >= 0xB0 && c <= 0xB7)
+        {
+            s_gram_page = c & 0x07;                                /* 页地址 */
+        }
+        else if (c <= 0x0F)
+        {
+            s_gram_col = (s_gram_col & 0xF0) | (c & 0x0F);         /* 列地址低4位 */
+        }
+        else if (c >= 0x10 && c <= 0x1F)
+        {
+            s_gram_col = (s_gram_col & 0x0F) | ((c & 0x0F) << 4);  /* 列地址高4位 */
+        }
+        else if (c == 0x21 || c == 0x22)
+        {
+            i += 2;                                                /* 带2个参数的命令 */
+        }
+        else if (c == 0x20 || c == 0x81 || c == 0x8D || c == 0xA8 || c == 0xD3 ||
+                 c == 0xD5 || c == 0xD9 || c == 0xDA || c == 0xDB)
+        {
+            i += 1;                                                /* 带1个参数的命令 */
+        }
+    }
+}
+
+static HAL_StatusTypeDef sim_dma_start(bool start, const uint8_t *data, uint16_t len)
+{
+    if (s_dma_busy)
+    {
+        return HAL_BUSY;
+    }
+    s_dma_busy = true;
+    s_dma_start = start;
+    s_dma_data = data;
+    s_dma_len = len;
+    s_dma_done_at = s_now_us + sim_i2c_us((uint16_t)(len + (start ? 1 : 0)));
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t len)
+{
+    (void)hi2c;
+    (void)addr;
+    return sim_dma_start(true, data, len);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Seq_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t addr, uint8_t *data, uint16_t len,
+                                                  uint32_t options)
+{
+    (void)hi2c;
+    (void)addr;
+    return sim_dma_start(options == I2C_FIRST_FRAME || options == I2C_FIRST_AND_LAST_FRAME, data, len);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Abort_IT(I2C_HandleTypeDef *hi2c, uint16_t addr)
+{
+    (void)hi2c;
+    (void)addr;
+    s_dma_busy = false;
+    return HAL_OK;
+}
+
+// 到期的 DMA 完成中断；回调里启动的下一个事务从这一刻开始计时
+static void sim_fire_irqs(void)
+{
+    uint32_t now = s_now_us;
+
+    while (s_dma_busy && (int32_t)(now - s_dma_done_at) >= 0)
+    {
+        s_now_us = s_dma_done_at;
+        s_dma_busy = false;
+        if (s_dma_start)
+        {
+            s_dma_ctrl = s_dma_data[0];
+            sim_gram_xfer(s_dma_ctrl, s_dma_data + 1, (uint16_t)(s_dma_len - 1));
+        }
+        else
+        {
+            sim_gram_xfer(s_dma_ctrl, s_dma_data, s_dma_len);
+        }
+        HAL_I2C_MasterTxCpltCallback(&hi2c1);
+    }
+    s_now_us = now;
+}
+
+// 忙等一次：过去 1us
+uint32_t HAL_GetTick(void)
+{
+    s_now_us++;
+    sim_fire_irqs();
+    return s_now_us / 1000;
+}
+
+void HAL_Delay(uint32_t ms)
+{
+    uint32_t start = HAL_GetTick();
+
+    while (HAL_GetTick() - start < ms)
+    {
+    }
+}
+
+// 休眠到下一个中断：SysTick（下一毫秒）或者 DMA 完成
+static void sim_wfi(void)
+{
+    uint32_t next = (s_now_us / 1000 + 1) * 1000;
+
+    if (s_dma_busy && (int32_t)(s_dma_done_at - next) < 0)
+    {
+        next = s_dma_done_at;
+    }
+    s_now_us = next;
+    sim_fire_irqs();
+}
+
+// ---------------------------------------------------------------------------
+// 硬件随机数桩：两种模式用同一个序列
+// ---------------------------------------------------------------------------
+typedef struct
+{
+    void *Instance;
+} RNG_HandleTypeDef;
+
+#define RNG ((void *)1)
+static RNG_HandleTypeDef hrng = {RNG};
+static uint32_t s_hw_rng;
+
+static HAL_StatusTypeDef HAL_RNG_GenerateRandomNumber(RNG_HandleTypeDef *h, uint32_t *random)
+{
+    (void)h;
+    s_hw_rng = s_hw_rng * 1664525u + 1013904223u;
+    *random = s_hw_rng;
+    return HAL_OK;
+}
+
+// ---------------------------------------------------------------------------
+// 菜单、性能浮层桩
+// ---------------------------------------------------------------------------
+#include "u8g2.h"
+#include "layer.h"
+
+// 仓库里没有 u8g2_fonts.c（字库只在 Keil 工程里），给游戏用到的字体一个空字库：
+// 没有字形，文字不画，其余图形照常画
+const uint8_t u8g2_font_5x7_tf[32] = {0};
+const uint8_t u8g2_font_6x10_tf[32] = {0};
+const uint8_t u8g2_font_7x13_tf[32] = {0};
+
+static void main_menu_activate(void)
+{
+}
+
+static void main_menu_deactivate(void)
+{
+}
+
+typedef enum
+{
+    PERF_PHASE_LOGIC = 0,
+    PERF_PHASE_RENDER,
+    PERF_PHASE_FLUSH,
+} perf_phase_t;
+
+static uint32_t perf_hud_begin(void)
+{
+    return 0;
+}
+
+static void perf_hud_end(perf_phase_t phase, uint32_t start)
+{
+    (void)phase;
+    (void)start;
+}
+
+static void perf_hud_overlay_begin(u8g2_t *u8g2)
+{
+    (void)u8g2;
+}
+
+static void perf_hud_overlay_end(u8g2_t *u8g2)
+{
+    (void)u8g2;
+}
+
+#include "../Components/u8g2/u8g2_stm32_hal.c"
+#include "../Components/event_queue/event_queue.c"
+#include "../Components/input_manager/input_manager.c"
+#include "../Components/event_bus/event_bus.c"
+// display_service.c 和 input_replay.c 的统计变量同名，显示服务的改个名字
+#define s_stats s_display_stats
+#include "../Components/display_service/display_service.c"
+#undef s_stats
+#include "../Bsp/rng/rng_driver.c"
+#include "../Components/input_replay/input_replay.c"
+#include "../App/game/game_manager.c"
+#include "../App/game/snake_game.c"
+#include "../App/game/tetris_game.c"
+
+static snake_game_t g_snake_game;
+GAME_ADAPTER(snake_game, snake_game_t)
+GAME_DESCRIPTOR(g_snake_game, "Snake", snake_game);
+
+static tetris_game_t g_tetris_game;
+GAME_ADAPTER(tetris_game, tetris_game_t)
+GAME_DESCRIPTOR(g_tetris_game, "Tetris", tetris_game);
+
+// ---------------------------------------------------------------------------
+// 脚本输入：模拟 ebtn 和摇杆任务推入带时间戳的事件（不按 B，不会退出）
+// ---------------------------------------------------------------------------
+#define SIM_RUN_MS      20000u  // 每种模式运行的时长
+#define SIM_SCRIPT_RATE 30u     // 每个 10ms 周期动作的概率（1/rate），约每 300ms 一次输入
+
+static uint32_t s_script;
+static rocker_direction_t s_held_dir;
+static uint16_t s_held_btn;        // 按着的按键 +1，0=没有
+
+static uint32_t script_rand(void)
+{
+    s_script = s_script * 1103515245u + 12345u;
+    return s_script >> 16;
+}
+
+static void push_event(uint16_t source_id, uint8_t type, uint32_t data)
+{
+    app_event_t evt;
+
+    evt.source_id = source_id;
+    evt.event_type = type;
+    evt.data = data;
+    evt.timestamp_us = scheduler_get_time_us();
+    event_queue_push(evt);
+}
+
+static bool sim_game_running(void)
+{
+    const game_descriptor_t *game = game_manager_get_current_game();
+
+    if (game == &g_snake_game_descriptor)
+    {
+        return g_snake_game.game_state == GAME_STATE_RUNNING;
+    }
+    return g_tetris_game.game_state == TETRIS_STATE_RUNNING;
+}
+
+static void sim_input_task(void)
+{
+    static const rocker_direction_t dirs[] = {ROCKER_DIR_UP, ROCKER_DIR_DOWN, ROCKER_DIR_LEFT, ROCKER_DIR_RIGHT};
+    static const uint16_t btns[] = {BTN_SW1, BTN_SW2, BTN_SW3};
+
+    // 准备/结束画面上按 START 开始新的一局，一直在玩
+    if (!sim_game_running() && s_held_btn == 0)
+    {
+        s_held_btn = BTN_SK + 1;
+        push_event(BTN_SK, EBTN_EVT_ONPRESS, 0);
+        return;
+    }
+
+    if (script_rand() % SIM_SCRIPT_RATE != 0)
+    {
+        return;
+    }
+
+    if (script_rand() % 3 != 0)
+    {
+        if (s_held_dir != ROCKER_DIR_CENTER)
+        {
+            push_event(ROCKER_SOURCE_ID, ROCKER_EVT_DIR_LEAVE, ROCKER_EVT_PACK_DATA(s_held_dir, 0));
+            s_held_dir = ROCKER_DIR_CENTER;
+        }
+        else
+        {
+            s_held_dir = dirs[script_rand() % 4];
+            push_event(ROCKER_SOURCE_ID, ROCKER_EVT_DIR_ENTER, ROCKER_EVT_PACK_DATA(s_held_dir, 100));
+        }
+    }
+    else if (s_held_btn != 0)
+    {
+        push_event(s_held_btn - 1, EBTN_EVT_ONRELEASE, 0);
+        s_held_btn = 0;
+    }
+    else
+    {
+        s_held_btn = btns[script_rand() % 3] + 1;
+        push_event(s_held_btn - 1, EBTN_EVT_ONPRESS, 0);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 计时的游戏任务和显示任务；跳过的帧重画一遍检查
+// ---------------------------------------------------------------------------
+static uint64_t s_game_cycles;
+static uint64_t s_display_cycles;
+static uint32_t s_game_runs;
+static uint32_t s_display_runs;
+static uint32_t s_skipped_seen;
+static uint32_t s_stale_frames;    // 跳过时缓冲里的画面和重画的不一样
+
+static uint8_t s_saved_buf[SIM_GRAM_SIZE];
+
+static void sim_check_skipped(const char *game_name)
+{
+    const game_descriptor_t *game = game_manager_get_current_game();
+    u8g2_t *u8g2 = u8g2_get_instance();
+    game_render_stats_t stats;
+    uint32_t ready = s_ready_count;
+    display_service_stats_t ds = s_display_stats;
+
+    if (game == NULL || game_manager_get_render_stats(game_name, &stats) != 0)
+    {
+        return;
+    }
+    if (stats.skipped_frames == s_skipped_seen)
+    {
+        s_skipped_seen = stats.skipped_frames;
+        return;
+    }
+    s_skipped_seen = stats.skipped_frames;
+
+    // 重画会标记一帧就绪，显示服务的计数恢复原样，不影响测量
+    memcpy(s_saved_buf, u8g2_GetBufferPtr(u8g2), SIM_GRAM_SIZE);
+    game->interface.render(game->instance);
+    s_stale_frames += memcmp(s_saved_buf, u8g2_GetBufferPtr(u8g2), SIM_GRAM_SIZE) != 0;
+    s_ready_count = ready;
+    s_display_stats = ds;
+}
+
+static const char *s_game_name;
+
+static void sim_game_task(void)
+{
+    uint32_t start = host_cycles();
+
+    game_manager_task_all();
+    s_game_cycles += (uint32_t)(host_cycles() - start);
+    s_game_runs++;
+    sim_check_skipped(s_game_name);
+}
+
+static void sim_display_task(void)
+{
+    uint32_t start = host_cycles();
+
+    display_service_task();
+    s_display_cycles += (uint32_t)(host_cycles() - start);
+    s_display_runs++;
+}
+
+// ---------------------------------------------------------------------------
+// 一次运行
+// ---------------------------------------------------------------------------
+typedef struct
+{
+    game_render_stats_t render;
+    display_service_stats_t display;
+    u8g2_tx_stats_t tx;
+    uint64_t game_cycles;
+    uint64_t display_cycles;
+    uint32_t game_runs;
+    uint32_t display_runs;
+    uint32_t stale_frames;
+    uint32_t gram_mismatch;        // 结束时屏上的 GDRAM 和缓冲不一致
+} sim_result_t;
+
+static void sim_run(const char *game_name, uint8_t force_redraw, sim_result_t *res)
+{
+    uint32_t end_us;
+
+    s_now_us = 1000000u;
+    s_hw_rng = 12345u;
+    s_script = 2024u;
+    s_held_dir = ROCKER_DIR_CENTER;
+    s_held_btn = 0;
+    s_game_name = game_name;
+    s_game_cycles = 0;
+    s_display_cycles = 0;
+    s_game_runs = 0;
+    s_display_runs = 0;
+    s_skipped_seen = 0;
+    s_stale_frames = 0;
+    memset(&g_snake_game, 0, sizeof(g_snake_game));
+    memset(&g_tetris_game, 0, sizeof(g_tetris_game));
+    layer_invalidate();
+
+    scheduler_init();
+    event_queue_init();
+    event_bus_init();
+    input_manager_init();
+    rng_init();
+    display_service_init(u8g2_get_instance());
+    game_manager_init();
+    game_manager_register(&g_snake_game_descriptor);
+    game_manager_register(&g_tetris_game_descriptor);
+    game_manager_set_force_redraw(force_redraw);
+    game_manager_reset_render_stats();
+    u8g2_reset_tx_stats();
+
+    // 和 system_assembly_register_tasks 一样的周期、优先级、相位和事件唤醒
+    scheduler_add_task_ex(sim_input_task, 10, SCHEDULER_PRIORITY_HIGH, 0, "ebtn");
+    scheduler_add_task_ex(input_manager_task, 10, SCHEDULER_PRIORITY_HIGH, 0, "input");
+    scheduler_add_task_ex(sim_game_task, 10, SCHEDULER_PRIORITY_NORMAL, 2, "game");
+    scheduler_add_task_ex(sim_display_task, DISPLAY_SERVICE_TASK_PERIOD_MS, SCHEDULER_PRIORITY_LOW, 2, "display");
+    scheduler_set_event_wakeup(input_manager_task, true);
+    scheduler_set_event_wakeup(sim_game_task, true);
+    scheduler_set_event_wakeup(sim_display_task, true);
+
+    game_manager_start_game(game_name);
+
+    end_us = s_now_us + SIM_RUN_MS * 1000u;
+    while ((int32_t)(s_now_us - end_us) < 0)
+    {
+        scheduler_run();
+    }
+
+    // 不限速把最后一帧发完，屏上应该就是缓冲里的画面
+    u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+    display_service_set_target_fps(0);
+    display_service_task();
+    u8g2_flush_wait(U8G2_FLUSH_TIMEOUT_MS);
+    res->gram_mismatch = memcmp(s_gram, u8g2_GetBufferPtr(u8g2_get_instance()), SIM_GRAM_SIZE) != 0;
+
+    game_manager_get_render_stats(game_name, &res->render);
+    display_service_get_stats(&res->display);
+    u8g2_get_tx_stats(&res->tx);
+    res->game_cycles = s_game_cycles;
+    res->display_cycles = s_display_cycles;
+    res->game_runs = s_game_runs;
+    res->display_runs = s_display_runs;
+    res->stale_frames = s_stale_frames;
+
+    game_manager_set_force_redraw(0);
+    game_manager_exit_current_game();
+}
+
+// 整帧刷新（没有差分）时每个发送的就绪帧都是 1024 字节
+static uint32_t full_frame_bytes(const sim_result_t *r)
+{
+    return (r->display.frames_flushed + r->display.frames_unchanged) * SIM_GRAM_SIZE;
+}
+
+static void print_result(const char *mode, const sim_result_t *r)
+{
+    printf("    %s: 渲染 %lu 帧，跳过 %lu 帧；游戏任务 %lu 周期/次，显示任务 %lu 周期/次\n", mode,
+           (unsigned long)r->render.rendered_frames, (unsigned long)r->render.skipped_frames,
+           (unsigned long)(r->game_cycles / (r->game_runs ? r->game_runs : 1)),
+           (unsigned long)(r->display_cycles / (r->display_runs ? r->display_runs : 1)));
+    printf("        差分刷新发送 %lu 帧、%lu 字节（总线 %lu 字节），%lu 帧没有变化；整帧刷新要 %lu 字节\n",
+           (unsigned long)r->display.frames_flushed, (unsigned long)r->display.bytes_sent,
+           (unsigned long)r->tx.wire_bytes, (unsigned long)r->display.frames_unchanged,
+           (unsigned long)full_frame_bytes(r));
+}
+
+// 同一段输入跑两种模式：跳过重绘要少渲染、少耗时、整帧刷新时少发字节，
+// 差分刷新下发送的字节不能比强制重绘多（画面一样），并且不能漏画
+static uint32_t test_redraw_skip(const char *game_name)
+{
+    sim_result_t force, skip;
+    uint32_t errors = 0;
+
+    sim_run(game_name, 1, &force);
+    sim_run(game_name, 0, &skip);
+
+    print_result("强制重绘", &force);
+    print_result("跳过重绘", &skip);
+    printf("        游戏任务耗时 %.1f%%，整帧刷新字节 %.1f%%，差分刷新字节 %.1f%%（相对强制重绘）\n",
+           100.0 * (double)skip.game_cycles / (double)force.game_cycles,
+           100.0 * full_frame_bytes(&skip) / full_frame_bytes(&force),
+           100.0 * skip.display.bytes_sent / force.display.bytes_sent);
+
+    errors += force.render.skipped_frames != 0;
+    errors += skip.render.rendered_frames == 0;
+    errors += skip.render.rendered_frames * 2 > force.render.rendered_frames;
+    errors += skip.game_cycles >= force.game_cycles;
+    errors += full_frame_bytes(&skip) >= full_frame_bytes(&force);
+    errors += skip.display.bytes_sent > force.display.bytes_sent;
+    errors += skip.stale_frames + force.stale_frames;
+    errors += skip.gram_mismatch + force.gram_mismatch;
+    return errors;
+}
+
+int main(void)
+{
+    uint32_t errors, failed = 0;
+
+    printf("========= 游戏跳过重绘主机基准测试（%lu ms，每种模式同一段输入） =========\n",
+           (unsigned long)SIM_RUN_MS);
+
+    s_now_us = 0;
+    failed += u8g2_component_init() != 0;
+
+    errors = test_redraw_skip("Snake");
+    printf("[1] 贪吃蛇: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    errors = test_redraw_skip("Tetris");
+    printf("[2] 俄罗斯方块: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    printf("==================================\n");
+    printf(failed ? ">>> 测试失败! <<<\n" : ">>> 所有测试通过! <<<\n");
+    return failed ? 1 : 0;
+}
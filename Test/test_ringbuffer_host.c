@@ -0,0 +1,198 @@
+// =============================================================================
+// 环形缓冲区 零拷贝接口 主机测试（在PC上运行，不加入Keil工程）
+// =============================================================================
+//
+// 编译运行（在仓库根目录）：
+//   gcc -O2 -IComponents/ringbuffer Test/test_ringbuffer_host.c Components/ringbuffer/ringbuffer.c -o /tmp/test_ringbuffer
+//   /tmp/test_ringbuffer
+//
+// 1. reserve/commit、span/consume 在回绕处给出两段连续区域，长度和位置正确；
+// 2. 随机混用 put/get 和 reserve/commit/span/consume，内容和一个简单的字节模型一致；
+// 3. 超过 32KiB 的缓冲区（原来 15 位下标的上限）能正常使用。
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ringbuffer.h"
+
+#define BIG_POOL_SIZE   (100u * 1024u)
+
+static rt_uint8_t s_big_pool[BIG_POOL_SIZE];
+
+// 字节模型：按顺序写入的流，记录已写和已读的位置
+static uint32_t s_written;
+static uint32_t s_read;
+
+static rt_uint8_t stream_byte(uint32_t pos)
+{
+    return (rt_uint8_t)(pos * 31u + (pos >> 9));
+}
+
+// 回绕处的两段区域
+static uint32_t test_wrap_spans(void)
+{
+    rt_uint8_t pool[16];
+    rt_uint8_t buf[16];
+    struct rt_ringbuffer rb;
+    struct rt_ringbuffer_span span;
+    uint32_t errors = 0;
+
+    rt_ringbuffer_init(&rb, pool, sizeof(pool));
+
+    // 写 12 读 10：读下标 10，写下标 12
+    errors += rt_ringbuffer_put(&rb, (const rt_uint8_t *)"0123456789AB", 12) != 12;
+    errors += rt_ringbuffer_get(&rb, buf, 10) != 10;
+
+    // 空闲 14 字节：[12,16) 4 字节 + [0,10) 10 字节
+    errors += rt_ringbuffer_reserve(&rb, &span) != 14;
+    errors += span.ptr[0] != &pool[12] || span.len[0] != 4;
+    errors += span.ptr[1] != &pool[0] || span.len[1] != 10;
+
+    memcpy(span.ptr[0], "cdef", 4);
+    memcpy(span.ptr[1], "gh", 2);
+    rt_ringbuffer_commit(&rb, 6);
+    errors += rt_ringbuffer_data_len(&rb) != 8;
+
+    // 数据 8 字节："AB" 在 [10,12)，"cdef" 在 [12,16)，"gh" 在 [0,2)
+    errors += rt_ringbuffer_span(&rb, &span) != 8;
+    errors += span.ptr[0] != &pool[10] || span.len[0] != 6 || memcmp(span.ptr[0], "ABcdef", 6) != 0;
+    errors += span.ptr[1] != &pool[0] || span.len[1] != 2 || memcmp(span.ptr[1], "gh", 2) != 0;
+
+    // 正好消费到池末尾，读下标回到 0
+    rt_ringbuffer_consume(&rb, 6);
+    errors += rt_ringbuffer_span(&rb, &span) != 2 || span.ptr[0] != &pool[0] || span.len[1] != 0;
+    rt_ringbuffer_consume(&rb, 2);
+    errors += rt_ringbuffer_data_len(&rb) != 0;
+
+    // 写满：commit 整个空间后 data_len 等于容量，reserve 返回 0
+    rt_ringbuffer_reserve(&rb, &span);
+    rt_ringbuffer_commit(&rb, span.len[0] + span.len[1]);
+    errors += rt_ringbuffer_data_len(&rb) != sizeof(pool);
+    errors += rt_ringbuffer_reserve(&rb, &span) != 0 || span.len[0] != 0 || span.len[1] != 0;
+
+    return errors;
+}
+
+// 把 n 个流字节写进区域，返回实际写入数
+static uint32_t fill_span(struct rt_ringbuffer_span *span, uint32_t n)
+{
+    uint32_t done = 0;
+
+    for (int i = 0; i < 2 && done < n; i++)
+    {
+        uint32_t len = span->len[i] < n - done ? span->len[i] : n - done;
+
+        for (uint32_t k = 0; k < len; k++)
+        {
+            span->ptr[i][k] = stream_byte(s_written + done + k);
+        }
+        done += len;
+    }
+    return done;
+}
+
+// 检查区域里前 n 个字节是否是流里接下来的内容
+static uint32_t check_span(const struct rt_ringbuffer_span *span, uint32_t n)
+{
+    uint32_t done = 0, errors = 0;
+
+    for (int i = 0; i < 2 && done < n; i++)
+    {
+        uint32_t len = span->len[i] < n - done ? span->len[i] : n - done;
+
+        for (uint32_t k = 0; k < len; k++)
+        {
+            errors += span->ptr[i][k] != stream_byte(s_read + done + k);
+        }
+        done += len;
+    }
+    return errors;
+}
+
+// 随机混用拷贝接口和零拷贝接口
+static uint32_t test_random_mix(rt_uint8_t *pool, uint32_t pool_size, uint32_t rounds)
+{
+    static rt_uint8_t tmp[BIG_POOL_SIZE];
+    struct rt_ringbuffer rb;
+    struct rt_ringbuffer_span span;
+    uint32_t errors = 0;
+
+    rt_ringbuffer_init(&rb, pool, (rt_int32_t)pool_size);
+    s_written = s_read = 0;
+    srand(1234);
+
+    for (uint32_t r = 0; r < rounds; r++)
+    {
+        uint32_t n = (uint32_t)rand() % (pool_size / 2 + 1);
+        uint32_t space, data;
+
+        switch (rand() % 4)
+        {
+        case 0: // put
+            for (uint32_t k = 0; k < n; k++)
+            {
+                tmp[k] = stream_byte(s_written + k);
+            }
+            space = rt_ringbuffer_space_len(&rb);
+            n = rt_ringbuffer_put(&rb, tmp, n);
+            errors += n > space;
+            s_written += n;
+            break;
+
+        case 1: // reserve/commit
+            space = rt_ringbuffer_reserve(&rb, &span);
+            errors += space != span.len[0] + span.len[1] || space != rt_ringbuffer_space_len(&rb);
+            n = fill_span(&span, n);
+            rt_ringbuffer_commit(&rb, n);
+            s_written += n;
+            break;
+
+        case 2: // get
+            n = rt_ringbuffer_get(&rb, tmp, n);
+            for (uint32_t k = 0; k < n; k++)
+            {
+                errors += tmp[k] != stream_byte(s_read + k);
+            }
+            s_read += n;
+            break;
+
+        default: // span/consume
+            data = rt_ringbuffer_span(&rb, &span);
+            errors += data != span.len[0] + span.len[1] || data != rt_ringbuffer_data_len(&rb);
+            n = n < data ? n : data;
+            errors += check_span(&span, n);
+            rt_ringbuffer_consume(&rb, n);
+            s_read += n;
+            break;
+        }
+
+        errors += rt_ringbuffer_data_len(&rb) != s_written - s_read;
+    }
+    return errors;
+}
+
+int main(void)
+{
+    static rt_uint8_t small_pool[64];
+    uint32_t errors, failed = 0;
+
+    printf("========= 环形缓冲区零拷贝接口测试 =========\n");
+
+    errors = test_wrap_spans();
+    printf("[1] 回绕两段区域/写满: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    errors = test_random_mix(small_pool, sizeof(small_pool), 200000);
+    printf("[2] 64 字节缓冲区随机混用: %s\n", errors ? "失败" : "成功");
+    failed += errors;
+
+    errors = test_random_mix(s_big_pool, sizeof(s_big_pool), 20000);
+    printf("[3] %u 字节缓冲区（超过 32KiB）随机混用: %s (流 %lu 字节)\n", (unsigned)sizeof(s_big_pool),
+           errors ? "失败" : "成功", (unsigned long)s_written);
+    failed += errors;
+
+    printf("==================================\n");
+    printf(failed ? ">>> 测试失败! <<<\n" : ">>> 所有测试通过! <<<\n");
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,305 @@
+// =============================================================================
+// 摇杆 ADC 过采样抽取 主机测试（在PC上运行，不加入Keil工程）
+// =============================================================================
+//
+// 编译运行（在仓库根目录）：
+//   gcc -O2 -IApp/sys -IBsp/adc -ICore/Inc Test/test_rocker_adc_host.c -o /tmp/test_rocker_adc -lm
+//   /tmp/test_rocker_adc
+//
+// 模拟 TIM3 每 100us 触发一次双 ADC 转换，DMA 把 (Y<<16)|X 写进 128 字的循环缓冲区，
+// 写满一半/全部时调用 HAL 的半满/全满回调：
+// 1. 每一块的结果和逐点求平均的参考值完全相同，64 个采样点出一个值；
+// 2. 静止摇杆 + 高斯噪声：10ms 任务读到的值和真值的均方根误差，
+//    原来的“最新一个采样点”、再加组件里 4 点滑动平均、现在的过采样，三者对比；
+// 3. 小噪声下的直流值：过采样值的平均能分辨到 1/8 LSB，12 位读数做不到；
+// 4. 每块的处理耗时（主机周期，仅供参考）。
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// 跳过 mydefine.h 和 CubeMX 的 tim.h/adc.h（HAL 头文件在主机上不可用）
+#define __MYDEFINE_H__
+#define __TIM_H__
+#define __ADC_H__
+
+// ---------------------------------------------------------------------------
+// HAL 桩
+// ---------------------------------------------------------------------------
+typedef struct
+{
+    int dummy;
+} TIM_HandleTypeDef;
+
+typedef struct
+{
+    void *Instance;
+} ADC_HandleTypeDef;
+
+static int s_adc1_regs;
+static int s_adc2_regs;
+#define ADC1 ((void *)&s_adc1_regs)
+#define ADC2 ((void *)&s_adc2_regs)
+
+TIM_HandleTypeDef htim3;
+ADC_HandleTypeDef hadc1 = {ADC1};
+ADC_HandleTypeDef hadc2 = {ADC2};
+
+static uint32_t *s_dma_dst;
+static uint32_t s_dma_len;
+
+#define HAL_TIM_Base_Start(h) ((void)(h))
+#define HAL_ADC_Start(h)      ((void)(h))
+
+static void HAL_ADCEx_MultiModeStart_DMA(ADC_HandleTypeDef *hadc, uint32_t *dst, uint32_t len)
+{
+    (void)hadc;
+    s_dma_dst = dst;
+    s_dma_len = len;
+}
+
+// 主机的周期计数（x86 用 TSC，其他平台用纳秒）
+static uint32_t host_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000000u + ts.tv_nsec);
+#endif
+}
+
+#define SCHEDULER_GET_CYCLES() host_cycles()
+
+#include "../Bsp/adc/rocker_adc_driver.c"
+
+// ---------------------------------------------------------------------------
+// 仿真：ADC 采样 + DMA
+// ---------------------------------------------------------------------------
+#define SAMPLE_US   100u   // TIM3：84MHz / 840 / 10
+#define TASK_MS     10u    // rocker_process_task 周期
+
+static uint32_t s_dma_idx;
+static uint32_t s_blocks_expected;
+
+// 参考：当前这一块逐点求和
+static uint32_t s_ref_sum_x;
+static uint32_t s_ref_sum_y;
+static uint32_t s_ref_errors;
+
+static double gauss(void)
+{
+    double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+
+    return sqrt(-2.0 * log(u1)) * cos(2.0 * 3.14159265358979 * u2);
+}
+
+static uint16_t adc_quantize(double v)
+{
+    long q = lround(v);
+
+    return (uint16_t)(q < 0 ? 0 : q > 4095 ? 4095 : q);
+}
+
+// 一次转换：DMA 写一个字，写满一半/全部时进回调
+static void sim_sample(uint16_t x, uint16_t y)
+{
+    s_dma_dst[s_dma_idx] = (uint32_t)x | ((uint32_t)y << 16);
+    s_ref_sum_x += x;
+    s_ref_sum_y += y;
+    s_dma_idx++;
+
+    if (s_dma_idx == ROCKER_ADC_BLOCK_SIZE || s_dma_idx == s_dma_len)
+    {
+        rocker_data_t hires, raw;
+        uint32_t want_x = (s_ref_sum_x + 4) / 8;
+        uint32_t want_y = (s_ref_sum_y + 4) / 8;
+
+        if (s_dma_idx == s_dma_len)
+        {
+            HAL_ADC_ConvCpltCallback(&hadc1);
+            s_dma_idx = 0;
+        }
+        else
+        {
+            HAL_ADC_ConvHalfCpltCallback(&hadc1);
+        }
+        s_blocks_expected++;
+
+        hires = rocker_adc_get_hires_value();
+        raw = rocker_adc_get_raw_value();
+        s_ref_errors += hires.x_raw_value != want_x || hires.y_raw_value != want_y;
+        s_ref_errors += raw.x_raw_value != (want_x + 4) / 8 || raw.y_raw_value != (want_y + 4) / 8;
+        s_ref_sum_x = 0;
+        s_ref_sum_y = 0;
+    }
+}
+
+static void sim_reset(void)
+{
+    rocker_adc_driver_init();
+    s_dma_idx = 0;
+    s_blocks_expected = 0;
+    s_ref_sum_x = 0;
+    s_ref_sum_y = 0;
+    s_ref_errors = 0;
+}
+
+// ---------------------------------------------------------------------------
+// 测试
+// ---------------------------------------------------------------------------
+
+// 1. 满量程随机数据（含 0 和 4095），每块和逐点平均相同，ADC2 的回调不处理
+static uint32_t test_exact(void)
+{
+    rocker_adc_stats_t stats;
+    uint32_t errors = 0;
+
+    srand(1);
+    sim_reset();
+    errors += s_dma_dst != s_rocker_dma_buffer || s_dma_len != ROCKER_DMA_BUFFER_SIZE;
+
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        uint16_t x = (i % 977 == 0) ? 4095 : (uint16_t)(rand() % 4096);
+        uint16_t y = (i % 1013 == 0) ? 0 : (uint16_t)(rand() % 4096);
+
+        sim_sample(x, y);
+    }
+
+    // 全是 4095：每组 16 个点打包累加到 65520，不能进位到 Y
+    for (uint32_t i = 0; i < ROCKER_DMA_BUFFER_SIZE; i++)
+    {
+        sim_sample(4095, 0);
+    }
+    errors += rocker_adc_get_hires_value().x_raw_value != ROCKER_ADC_HIRES_MAX;
+    errors += rocker_adc_get_hires_value().y_raw_value != 0;
+
+    HAL_ADC_ConvCpltCallback(&hadc2);
+    rocker_adc_get_stats(&stats);
+    errors += stats.blocks != s_blocks_expected;
+    errors += s_ref_errors;
+    return errors;
+}
+
+// 2. 静止摇杆 + 噪声：10ms 任务读到的值的均方根误差
+static uint32_t test_noise(double *rms_latest, double *rms_filter4, double *rms_block)
+{
+    const double truth_x = 2051.3;
+    const double truth_y = 1987.6;
+    const double sigma = 20.0;
+    double hist[4] = {0};
+    double se_latest = 0, se_filter4 = 0, se_block = 0;
+    uint32_t ticks = 0;
+
+    srand(2);
+    sim_reset();
+
+    for (uint32_t us = SAMPLE_US; us <= 60u * 1000000u; us += SAMPLE_US)
+    {
+        uint16_t x = adc_quantize(truth_x + sigma * gauss());
+        uint16_t y = adc_quantize(truth_y + sigma * gauss());
+
+        sim_sample(x, y);
+
+        // 10ms 任务：原来读最新一个采样点，组件再做 4 点滑动平均；现在读过采样值
+        if (us % (TASK_MS * 1000u) == 0 && us > 100000u)
+        {
+            double hx = rocker_adc_get_hires_value().x_raw_value / (double)(1u << ROCKER_ADC_OVERSAMPLE_BITS);
+            double avg = 0;
+
+            hist[ticks % 4] = x;
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                avg += hist[i] / 4.0;
+            }
+            ticks++;
+            if (ticks < 4)
+            {
+                continue;
+            }
+
+            se_latest += (x - truth_x) * (x - truth_x);
+            se_filter4 += (avg - truth_x) * (avg - truth_x);
+            se_block += (hx - truth_x) * (hx - truth_x);
+        }
+    }
+
+    ticks -= 3;
+    *rms_latest = sqrt(se_latest / ticks);
+    *rms_filter4 = sqrt(se_filter4 / ticks);
+    *rms_block = sqrt(se_block / ticks);
+
+    // 64 点平均理论上降到 1/8，至少要降到 1/6；也要比原来的 4 点滑动平均好 3 倍
+    return (*rms_block * 6 > *rms_latest) + (*rms_block * 3 > *rms_filter4) + s_ref_errors;
+}
+
+// 3. 直流 1000.375 + 1 LSB 噪声（自然抖动）：过采样值能看到 1/8 LSB
+static uint32_t test_resolution(double *mean_hires, double *mean_raw)
+{
+    const double truth = 1000.375;
+    double sum_hires = 0, sum_raw = 0;
+    uint32_t n = 0;
+
+    srand(3);
+    sim_reset();
+
+    for (uint32_t i = 0; i < 200 * ROCKER_ADC_BLOCK_SIZE; i++)
+    {
+        sim_sample(adc_quantize(truth + gauss()), 2048);
+        if (s_dma_idx % ROCKER_ADC_BLOCK_SIZE == 0)
+        {
+            sum_hires += rocker_adc_get_hires_value().x_raw_value;
+            sum_raw += rocker_adc_get_raw_value().x_raw_value;
+            n++;
+        }
+    }
+
+    *mean_hires = sum_hires / n / (1u << ROCKER_ADC_OVERSAMPLE_BITS);
+    *mean_raw = sum_raw / n;
+    return (fabs(*mean_hires - truth) > 0.05) + s_ref_errors;
+}
+
+int main(void)
+{
+    uint32_t errors, failed = 0;
+    double rms_latest, rms_filter4, rms_block, mean_hires, mean_raw;
+    rocker_adc_stats_t stats;
+
+    printf("========= 摇杆 ADC 过采样主机测试 (%u 点/块, %u us/块, +%u 位) =========\n",
+           ROCKER_ADC_BLOCK_SIZE, ROCKER_ADC_BLOCK_SIZE * SAMPLE_US, ROCKER_ADC_OVERSAMPLE_BITS);
+
+    errors = test_exact();
+    printf("[1] 每块结果和逐点平均相同（满量程、半满/全满交替）: %s (块=%lu)\n", errors ? "失败" : "成功",
+           (unsigned long)s_blocks_expected);
+    failed += errors;
+
+    errors = test_noise(&rms_latest, &rms_filter4, &rms_block);
+    printf("[2] 静止摇杆 sigma=20 LSB 噪声，10ms 读数的均方根误差: %s\n", errors ? "失败" : "成功");
+    printf("    最新采样点 %.2f LSB，加 4 点滑动平均 %.2f LSB，过采样 %.2f LSB（降低 %.1f dB）\n", rms_latest,
+           rms_filter4, rms_block, 20.0 * log10(rms_latest / rms_block));
+    failed += errors;
+
+    errors = test_resolution(&mean_hires, &mean_raw);
+    printf("[3] 直流 1000.375 LSB: 过采样平均 %.3f，12 位读数平均 %.3f: %s\n", mean_hires, mean_raw,
+           errors ? "失败" : "成功");
+    failed += errors;
+
+    rocker_adc_get_stats(&stats);
+    printf("[4] 每块处理耗时（主机周期）：最近 %lu，最长 %lu\n", (unsigned long)stats.last_cycles,
+           (unsigned long)stats.max_cycles);
+
+    printf("==================================\n");
+    printf(failed ? ">>> 测试失败! <<<\n" : ">>> 所有测试通过! <<<\n");
+    return failed ? 1 : 0;
+}
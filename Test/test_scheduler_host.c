@@ -0,0 +1,366 @@
+// =============================================================================
+// 调度器 主机测试（在PC上运行，不加入Keil工程）
+// =============================================================================
+//
+// 编译运行（在仓库根目录）：
+//   gcc -O2 -IApp/sys -IComponents/scheduler Test/test_scheduler_host.c -o /tmp/test_scheduler
+//   /tmp/test_scheduler
+//
+// 用虚拟时钟跑真实的调度器：毫秒 tick 和微秒时基分开计数，都从快要回绕的值开始；
+// 任务运行时按设定的耗时推进时钟，WFI 推进到下一个 SysTick 或者下一个模拟中断。
+// 1. tick 回绕：多个周期/相位的任务跨过 0xFFFFFFFF，每次都在自己的截止时间准时运行，间隔不变；
+// 2. 空闲统计：空闲时间 = 总时长 - 任务耗时，一微秒不差（微秒时基也跨过回绕）；
+//    中断唤醒的任务在中断那一刻运行，不会多睡到下一个 SysTick；
+// 3. 错过截止时间：一个任务超时 35ms，两个任务的 missed / max_late_ms 和手算的一致，
+//    之后截止时间仍然按原来的相位对齐。
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 跳过 mydefine.h（HAL 头文件在主机上不可用）
+#define __MYDEFINE_H__
+
+// ---------------------------------------------------------------------------
+// 虚拟时钟和调度器移植层
+// ---------------------------------------------------------------------------
+static uint32_t s_tick_ms;         // HAL 的毫秒 tick
+static uint32_t s_now_us;          // 微秒时基（和 tick 一起走，起点不同）
+static uint32_t s_sub_us;          // 这一毫秒里已经过去的微秒
+static uint32_t s_wfi_count;
+static void sim_wfi(void);
+
+#define SystemCoreClock                 168000000u
+#define SCHEDULER_GET_TICK()            (s_tick_ms)
+#define SCHEDULER_GET_TIME_US()         (s_now_us)
+#define SCHEDULER_GET_CYCLES()          (s_now_us * 168u)
+#define SCHEDULER_DISABLE_IRQ()         ((void)0)
+#define SCHEDULER_ENABLE_IRQ()          ((void)0)
+#define SCHEDULER_WAIT_FOR_INTERRUPT()  sim_wfi()
+
+#include "../Components/scheduler/scheduler.c"
+
+// 模拟的外部中断：到时刻时唤醒一个任务（同按键 EXTI 唤醒 ebtn 任务）
+static bool s_irq_armed;
+static uint32_t s_irq_at_us;
+static void (*s_irq_wake)(void);
+
+static void sim_set_clock(uint32_t tick_ms, uint32_t now_us)
+{
+    s_tick_ms = tick_ms;
+    s_now_us = now_us;
+    s_sub_us = 0;
+    s_wfi_count = 0;
+    s_irq_armed = false;
+}
+
+static void sim_fire_irqs(void)
+{
+    if (s_irq_armed && (int32_t)(s_now_us - s_irq_at_us) >= 0)
+    {
+        s_irq_armed = false;
+        scheduler_wake_task(s_irq_wake);
+    }
+}
+
+// 时钟走 us 微秒（任务运行，或者休眠）
+static void sim_step(uint32_t us)
+{
+    s_now_us += us;
+    s_sub_us += us;
+    s_tick_ms += s_sub_us / 1000;
+    s_sub_us %= 1000;
+}
+
+// 任务占用 CPU us 微秒，期间到期的中断在到期时刻发生
+static void sim_advance(uint32_t us)
+{
+    if (s_irq_armed && us >= s_irq_at_us - s_now_us)
+    {
+        uint32_t head = s_irq_at_us - s_now_us;
+
+        sim_step(head);
+        sim_fire_irqs();
+        us -= head;
+    }
+    sim_step(us);
+}
+
+// 休眠到下一个中断：SysTick（下一毫秒）或者模拟中断
+static void sim_wfi(void)
+{
+    uint32_t sleep = 1000 - s_sub_us;
+
+    if (s_irq_armed && s_irq_at_us - s_now_us < sleep)
+    {
+        sleep = s_irq_at_us - s_now_us;
+    }
+    s_wfi_count++;
+    sim_step(sleep);
+    sim_fire_irqs();
+}
+
+// ---------------------------------------------------------------------------
+// 测试任务：记录运行时刻，按设定耗时推进时钟
+// ---------------------------------------------------------------------------
+#define SIM_TASKS 3
+
+typedef struct
+{
+    uint32_t cost_us;      // 每次运行的耗时
+    uint32_t runs;
+    uint32_t first_tick;   // 第一次运行的 tick
+    uint32_t last_tick;
+    uint32_t last_us;      // 最近一次开始运行的微秒时刻
+    uint32_t bad_gaps;     // 相邻两次运行的间隔不等于周期
+    uint32_t overrun_at;   // 第几次运行超时（从 1 开始，0=不超时）
+    uint32_t overrun_us;   // 超时那次的耗时
+} sim_task_t;
+
+static sim_task_t s_task[SIM_TASKS];
+static uint32_t s_busy_us;         // 所有任务的耗时之和
+static uint32_t s_stuck;           // 时钟不走、跑不下去的次数
+
+static void sim_task_run(uint8_t id, uint32_t rate_ms)
+{
+    sim_task_t *t = &s_task[id];
+    uint32_t cost = t->cost_us;
+
+    if (t->runs == 0)
+    {
+        t->first_tick = s_tick_ms;
+    }
+    else if (s_tick_ms - t->last_tick != rate_ms)
+    {
+        t->bad_gaps++;
+    }
+    t->runs++;
+    t->last_tick = s_tick_ms;
+    t->last_us = s_now_us;
+
+    if (t->runs == t->overrun_at)
+    {
+        cost = t->overrun_us;
+    }
+    s_busy_us += cost;
+    sim_advance(cost);
+}
+
+static void task_a(void)
+{
+    sim_task_run(0, 1);
+}
+
+static void task_b(void)
+{
+    sim_task_run(1, 10);
+}
+
+static void task_c(void)
+{
+    sim_task_run(2, 7);
+}
+
+static void sim_reset(void)
+{
+    memset(s_task, 0, sizeof(s_task));
+    s_busy_us = 0;
+    s_stuck = 0;
+    scheduler_init();
+}
+
+// 跑到 tick 走过 ms 毫秒；调度器不休眠也不运行任务（时钟不走）时放弃，算一个错误
+static void sim_run_ms(uint32_t ms)
+{
+    uint32_t end = s_tick_ms + ms;
+    uint32_t passes = 0;
+
+    while ((int32_t)(s_tick_ms - end) < 0)
+    {
+        if (++passes > ms * 100u)
+        {
+            s_stuck++;
+            s_tick_ms = end;
+            break;
+        }
+        scheduler_run();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// 测试
+// ---------------------------------------------------------------------------
+#define SIM_WRAP_MS 6000u   // 回绕测试的时长，tick 在中间回绕
+
+// 1. tick 从 0xFFFFFFFF - 3000 开始，跨过回绕：每个任务的运行次数、相位、间隔都不变
+static uint32_t test_tick_wrap(void)
+{
+    const uint32_t start = 0xFFFFFFFFu - 3000u;
+    scheduler_task_stats_t stats = {0};
+    uint32_t errors = 0;
+
+    sim_set_clock(start, 0);
+    sim_reset();
+    s_task[0].cost_us = 100;   // 三个任务同一毫秒到期也跑得完
+    s_task[1].cost_us = 600;
+    s_task[2].cost_us = 250;
+    scheduler_add_task_ex(task_a, 1, SCHEDULER_PRIORITY_HIGH, 0, "a");
+    scheduler_add_task_ex(task_b, 10, SCHEDULER_PRIORITY_NORMAL, 2, "b");
+    scheduler_add_task_ex(task_c, 7, SCHEDULER_PRIORITY_LOW, 5, "c");
+
+    sim_run_ms(SIM_WRAP_MS);
+
+    errors += s_tick_ms - start != SIM_WRAP_MS;
+    errors += s_task[0].runs != SIM_WRAP_MS;
+    errors += s_task[1].runs != (SIM_WRAP_MS - 2 + 9) / 10;
+    errors += s_task[2].runs != (SIM_WRAP_MS - 5 + 6) / 7;
+    errors += s_task[0].first_tick != start;
+    errors += s_task[1].first_tick != start + 2;
+    errors += s_task[2].first_tick != start + 5;
+    for (uint8_t i = 0; i < SIM_TASKS; i++)
+    {
+        errors += s_task[i].bad_gaps;
+        scheduler_get_task_stats(i, &stats);
+        errors += stats.missed != 0 || stats.max_late_ms != 0;
+        errors += stats.runs != s_task[i].runs;
+    }
+    return errors + s_stuck;
+}
+
+// 2. 空闲时间：微秒时基从 0xFFFFFFFF - 1.5s 开始，空闲 = 总时长 - 任务耗时；
+//    中断唤醒的任务在中断时刻运行
+static uint32_t test_idle(uint32_t *idle_permille, uint32_t *wake_late_us, uint32_t *wake_now, uint32_t *wfi_per_s)
+{
+    const uint32_t start_us = 0xFFFFFFFFu - 1500000u;
+    uint32_t idle0, t0_us, elapsed, idle;
+    uint32_t errors = 0;
+    uint32_t late_max = 0;
+    uint32_t on_time = 0;
+
+    sim_set_clock(123456u, start_us);
+    sim_reset();
+    s_task[0].cost_us = 200;
+    s_task[1].cost_us = 700;
+    s_task[2].cost_us = 50;
+    scheduler_add_task_ex(task_a, 1, SCHEDULER_PRIORITY_HIGH, 0, "a");
+    scheduler_add_task_ex(task_b, 10, SCHEDULER_PRIORITY_NORMAL, 2, "b");
+    scheduler_add_task_ex(task_c, 1000, SCHEDULER_PRIORITY_LOW, 1000, "c");
+
+    idle0 = scheduler_get_idle_us();
+    t0_us = s_now_us;
+    sim_run_ms(3000);
+    elapsed = s_now_us - t0_us;
+    idle = scheduler_get_idle_us() - idle0;
+
+    errors += idle != elapsed - s_busy_us;
+    errors += scheduler_get_stats_elapsed_us() != elapsed;
+    *idle_permille = (uint32_t)((uint64_t)idle * 1000u / elapsed);
+    *wfi_per_s = s_wfi_count / 3u;
+
+    // 中断在两个 SysTick 之间唤醒 c：c 的截止时间还早，醒来就运行
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        uint32_t runs = s_task[2].runs;
+
+        s_irq_armed = true;
+        s_irq_wake = task_c;
+        s_irq_at_us = s_now_us + 137u + i * 53u;
+        while (s_task[2].runs == runs)
+        {
+            scheduler_run();
+        }
+        if (s_task[2].last_us - s_irq_at_us > late_max)
+        {
+            late_max = s_task[2].last_us - s_irq_at_us;
+        }
+        on_time += s_task[2].last_us == s_irq_at_us;
+    }
+    *wake_late_us = late_max;
+    *wake_now = on_time;
+
+    // a 或 b 正在运行时来的中断要等它们跑完，最多等 a + b
+    // 休眠中来的中断（大部分时间在休眠）醒来立即运行
+    errors += late_max > s_task[1].cost_us + s_task[0].cost_us;
+    errors += on_time < 100;
+    return errors + s_stuck;
+}
+
+// 3. b 第 3 次运行超时 35ms：
+//    a（5ms，相位0）在 +20 运行过，下一个截止时间 +25，在 +56 才运行：迟到 31ms，错过 6 个周期；
+//    b（10ms，相位1）下一个截止时间 +31，在 +56 运行：迟到 25ms，错过 2 个周期。
+//    之后 a 在 +60、b 在 +61 恢复，按原相位继续
+static uint32_t test_missed(scheduler_task_stats_t *sa, scheduler_task_stats_t *sb)
+{
+    const uint32_t start = 0xFFFFFFFFu - 40u; // 超时跨过 tick 回绕
+    uint32_t errors = 0;
+
+    sim_set_clock(start, 1000000u);
+    sim_reset();
+    s_task[0].cost_us = 100;
+    s_task[1].cost_us = 100;
+    s_task[1].overrun_at = 3;
+    s_task[1].overrun_us = 35000;
+    scheduler_add_task_ex(task_a, 5, SCHEDULER_PRIORITY_NORMAL, 0, "a");
+    scheduler_add_task_ex(task_b, 10, SCHEDULER_PRIORITY_NORMAL, 1, "b");
+
+    sim_run_ms(58);
+    errors += s_task[0].last_tick != start + 56;
+    errors += s_task[1].last_tick != start + 56;
+
+    sim_run_ms(1000);
+    scheduler_get_task_stats(0, sa);
+    scheduler_get_task_stats(1, sb);
+
+    errors += sa->missed != 6 || sa->max_late_ms != 31;
+    errors += sb->missed != 2 || sb->max_late_ms != 25;
+    errors += sa->runs != s_task[0].runs || sb->runs != s_task[1].runs;
+
+    // 恢复后的相位：a 在 5 的倍数，b 在 10 的倍数 +1
+    errors += (s_task[0].last_tick - start) % 5 != 0;
+    errors += (s_task[1].last_tick - start) % 10 != 1;
+
+    // 清零统计之后不再有迟到
+    scheduler_reset_stats();
+    sim_run_ms(1000);
+    scheduler_get_task_stats(0, sa + 1);
+    scheduler_get_task_stats(1, sb + 1);
+    errors += sa[1].missed != 0 || sa[1].max_late_ms != 0 || sa[1].runs != 200;
+    errors += sb[1].missed != 0 || sb[1].max_late_ms != 0 || sb[1].runs != 100;
+    return errors + s_stuck;
+}
+
+int main(void)
+{
+    uint32_t errors, failed = 0;
+    uint32_t idle_permille, wake_late_us, wake_now, wfi_per_s;
+    scheduler_task_stats_t sa[2], sb[2];
+
+    printf("========= 调度器主机测试 =========\n");
+
+    errors = test_tick_wrap();
+    printf("[1] tick 跨过 0xFFFFFFFF，%lu ms 内各任务准时运行: %s\n", (unsigned long)SIM_WRAP_MS,
+           errors ? "失败" : "成功");
+    printf("    运行次数 1ms:%lu 10ms:%lu 7ms:%lu\n", (unsigned long)s_task[0].runs, (unsigned long)s_task[1].runs,
+           (unsigned long)s_task[2].runs);
+    failed += errors;
+
+    errors = test_idle(&idle_permille, &wake_late_us, &wake_now, &wfi_per_s);
+    printf("[2] WFI 空闲统计 = 总时长 - 任务耗时（微秒时基跨过回绕）: %s\n", errors ? "失败" : "成功");
+    printf("    空闲 %lu‰，每秒休眠 %lu 次；200 次中断唤醒 %lu 次立即运行，最多等 %lu us\n",
+           (unsigned long)idle_permille, (unsigned long)wfi_per_s, (unsigned long)wake_now,
+           (unsigned long)wake_late_us);
+    failed += errors;
+
+    errors = test_missed(sa, sb);
+    printf("[3] 超时 35ms 的错过统计: %s\n", errors ? "失败" : "成功");
+    printf("    5ms 任务错过 %lu 次、最大迟到 %lu ms；10ms 任务错过 %lu 次、最大迟到 %lu ms\n",
+           (unsigned long)sa[0].missed, (unsigned long)sa[0].max_late_ms, (unsigned long)sb[0].missed,
+           (unsigned long)sb[0].max_late_ms);
+    failed += errors;
+
+    printf("==================================\n");
+    printf(failed ? ">>> 测试失败! <<<\n" : ">>> 所有测试通过! <<<\n");
+    return failed ? 1 : 0;
+}
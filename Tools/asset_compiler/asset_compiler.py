@@ -0,0 +1,410 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+资源编译器:把游戏资源源文件编译成C头文件
+
+源文件放在App/assets/src/,生成的头文件放在App/assets/,文件名为<源文件名>_assets.h
+源文件中';'开头的行是注释
+生成的头文件提交到仓库,Keil工程直接使用,板子上不再做任何格式转换
+
+支持三种源文件(按扩展名区分):
+
+  *.spr  精灵图,输出SSD1306页格式的sprite_t(见Components/sprite/sprite.h)
+         sprite <名字> [shifted]
+         #.......        '#'=点亮,'.'=熄灭,每行长度必须相同
+         ##......
+         (空行结束一个精灵)
+         带shifted时额外生成y%8=1~7的7份预移位数据
+
+  *.lvl  关卡地图,输出RLE压缩的asset_level_t(见App/assets/assets.h)
+         kind <sokoban|pacman>   必须是第一条指令,决定字符到格子值的映射
+         level <名字>
+         ##########       地图字符见下方LEVEL_KINDS
+         (空行结束一个关卡)
+
+  *.shp  4x4方块形状,输出uint16_t位掩码数组,bit(y*4+x)对应第y行第x列
+         shape <名字>
+         ....
+         ####
+
+用法:
+  python Tools/asset_compiler/asset_compiler.py           重新生成所有头文件
+  python Tools/asset_compiler/asset_compiler.py --check   只检查头文件是否是最新的
+"""
+
+import os
+import sys
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", ".."))
+SRC_DIR = os.path.join(ROOT, "App", "assets", "src")
+OUT_DIR = os.path.join(ROOT, "App", "assets")
+
+# 关卡字符映射:字符 -> (格子值, 标记名)
+# 标记名为"start"的字符是起点,其他标记名会生成单独的坐标数组
+LEVEL_KINDS = {
+    # 值与sokoban_game.h中的tile_type_t一致
+    "sokoban": {
+        "-": (0, None),       # TILE_EMPTY 墙外
+        " ": (1, None),       # TILE_FLOOR
+        "#": (2, None),       # TILE_WALL
+        ".": (3, None),       # TILE_TARGET
+        "$": (4, None),       # TILE_BOX
+        "*": (5, None),       # TILE_BOX_ON_TARGET
+        "@": (1, "start"),    # 玩家(站在地板上)
+        "+": (3, "start"),    # 玩家(站在目标点上)
+    },
+    # 值与pacman_game.c迷宫定义一致:0=通道(有豆子),1=墙,2=能量豆
+    "pacman": {
+        ".": (0, None),
+        "#": (1, None),
+        "o": (2, None),
+        "P": (0, "start"),    # 吃豆人起点
+        "G": (0, "ghosts"),   # 幽灵起点(按行优先顺序)
+    },
+}
+
+RLE_MAX_RUN = 16     # 一个RLE字节:高4位=重复次数-1,低4位=格子值
+RLE_MAX_VALUE = 15
+
+
+class AssetError(Exception):
+    pass
+
+
+# ============================================================================
+# 源文件解析
+# ============================================================================
+
+def read_blocks(path):
+    """
+    把源文件切成块:每块以一行指令开头,后面跟若干行图形,空行结束
+    ';'开头的行是注释('#'和空格都是图形字符)
+    返回[(行号, 指令参数列表, 图形行列表)]
+    """
+    blocks = []
+    current = None
+    with open(path, encoding="utf-8") as f:
+        for lineno, raw in enumerate(f, 1):
+            line = raw.rstrip("\r\n")
+            if line.startswith(";"):
+                continue
+            if current is None:
+                if line.strip() == "":
+                    continue
+                current = (lineno, line.split(), [])
+                # kind之类的单行指令没有图形
+                if current[1][0] == "kind":
+                    blocks.append(current)
+                    current = None
+                continue
+            if line.strip() == "":
+                blocks.append(current)
+                current = None
+            else:
+                current[2].append(line)
+    if current is not None:
+        blocks.append(current)
+    return blocks
+
+
+def check_rect(path, lineno, rows, name):
+    if not rows:
+        raise AssetError("%s:%d: %s has no rows" % (path, lineno, name))
+    width = len(rows[0])
+    for i, row in enumerate(rows):
+        if len(row) != width:
+            raise AssetError("%s:%d: %s row %d is %d wide, expected %d"
+                             % (path, lineno + 1 + i, name, len(row), width))
+    return width, len(rows)
+
+
+# ============================================================================
+# 精灵图
+# ============================================================================
+
+def pixels_from_art(path, lineno, name, rows):
+    width, height = check_rect(path, lineno, rows, name)
+    if width > 255 or height > 255:
+        raise AssetError("%s:%d: %s is larger than 255x255" % (path, lineno, name))
+    pixels = []
+    for i, row in enumerate(rows):
+        bits = []
+        for ch in row:
+            if ch == "#":
+                bits.append(1)
+            elif ch == ".":
+                bits.append(0)
+            else:
+                raise AssetError("%s:%d: %s has invalid pixel '%s'" % (path, lineno + 1 + i, name, ch))
+        pixels.append(bits)
+    return width, height, pixels
+
+
+def to_pages(width, height, pixels, shift=0):
+    """转成页格式:每8行一页,每列一个字节,bit0在最上面;shift把整个图下移"""
+    pages = (height + shift + 7) // 8
+    out = [0] * (pages * width)
+    for y in range(height):
+        yy = y + shift
+        for x in range(width):
+            if pixels[y][x]:
+                out[(yy // 8) * width + x] |= 1 << (yy % 8)
+    return out
+
+
+def compile_sprites(path):
+    sprites = []
+    for lineno, args, rows in read_blocks(path):
+        if args[0] != "sprite" or len(args) < 2:
+            raise AssetError("%s:%d: expected 'sprite <name> [shifted]'" % (path, lineno))
+        name = args[1]
+        flags = args[2:]
+        for flag in flags:
+            if flag != "shifted":
+                raise AssetError("%s:%d: unknown flag '%s'" % (path, lineno, flag))
+        width, height, pixels = pixels_from_art(path, lineno, name, rows)
+        data = to_pages(width, height, pixels)
+        shifted = None
+        if "shifted" in flags:
+            # 每份固定(pages+1)页,和sprite_blit()的取法一致
+            pages = (height + 7) // 8
+            shifted = []
+            for s in range(1, 8):
+                variant = to_pages(width, height, pixels, s)
+                variant += [0] * ((pages + 1) * width - len(variant))
+                shifted.append(variant)
+        sprites.append((name, width, height, rows, data, shifted))
+
+    body = ['#include "sprite.h"', ""]
+    total = 0
+    for name, width, height, rows, data, shifted in sprites:
+        body.append("/* %s: %dx%d%s */" % (name, width, height, ", pre-shifted" if shifted else ""))
+        for row in rows:
+            body.append("/*   %s */" % row)
+        body.append(c_array("static const uint8_t", name + "_data", data))
+        total += len(data)
+        shifted_ref = "NULL"
+        if shifted:
+            flat = [b for variant in shifted for b in variant]
+            body.append(c_array("static const uint8_t", name + "_shifted", flat))
+            shifted_ref = name + "_shifted"
+            total += len(flat)
+        body.append("static const sprite_t %s = { %d, %d, %s_data, %s };"
+                    % (name, width, height, name, shifted_ref))
+        body.append("")
+    summary = "%d sprites, %d bytes" % (len(sprites), total)
+    return body, summary
+
+
+# ============================================================================
+# 关卡地图
+# ============================================================================
+
+def rle_encode(values):
+    out = []
+    i = 0
+    while i < len(values):
+        v = values[i]
+        if v > RLE_MAX_VALUE:
+            raise AssetError("tile value %d does not fit in 4 bits" % v)
+        run = 1
+        while i + run < len(values) and values[i + run] == v and run < RLE_MAX_RUN:
+            run += 1
+        out.append(((run - 1) << 4) | v)
+        i += run
+    return out
+
+
+def rle_decode(blob):
+    out = []
+    for b in blob:
+        out += [b & 0x0F] * ((b >> 4) + 1)
+    return out
+
+
+def compile_levels(path):
+    blocks = read_blocks(path)
+    if not blocks or blocks[0][1][0] != "kind" or len(blocks[0][1]) != 2:
+        raise AssetError("%s: first directive must be 'kind <name>'" % path)
+    kind = blocks[0][1][1]
+    if kind not in LEVEL_KINDS:
+        raise AssetError("%s: unknown kind '%s'" % (path, kind))
+    table = LEVEL_KINDS[kind]
+
+    levels = []
+    size = None
+    for lineno, args, rows in blocks[1:]:
+        if args[0] != "level" or len(args) != 2:
+            raise AssetError("%s:%d: expected 'level <name>'" % (path, lineno))
+        name = args[1]
+        width, height = check_rect(path, lineno, rows, name)
+        if size is not None and size != (width, height):
+            raise AssetError("%s:%d: %s is %dx%d, other levels are %dx%d"
+                             % (path, lineno, name, width, height, size[0], size[1]))
+        size = (width, height)
+
+        values = []
+        markers = {}
+        for y, row in enumerate(rows):
+            for x, ch in enumerate(row):
+                if ch not in table:
+                    raise AssetError("%s:%d: %s has invalid tile '%s'" % (path, lineno + 1 + y, name, ch))
+                value, marker = table[ch]
+                values.append(value)
+                if marker:
+                    markers.setdefault(marker, []).append((x, y))
+        if len(markers.get("start", [])) != 1:
+            raise AssetError("%s:%d: %s needs exactly one start marker" % (path, lineno, name))
+
+        blob = rle_encode(values)
+        assert rle_decode(blob) == values
+        levels.append((name, rows, blob, markers))
+
+    prefix = os.path.splitext(os.path.basename(path))[0]
+    upper = prefix.upper()
+    body = ['#include "assets.h"', ""]
+    body.append("#define %s_LEVEL_COUNT %d" % (upper, len(levels)))
+    body.append("#define %s_LEVEL_WIDTH %d" % (upper, size[0]))
+    body.append("#define %s_LEVEL_HEIGHT %d" % (upper, size[1]))
+    body.append("")
+
+    total = 0
+    extra_names = sorted({m for _, _, _, markers in levels for m in markers if m != "start"})
+    for name, rows, blob, markers in levels:
+        body.append("/* %s */" % name)
+        for row in rows:
+            body.append("/*   %s */" % row)
+        body.append(c_array("static const uint8_t", "%s_%s_rle" % (prefix, name), blob))
+        total += len(blob)
+        for marker in extra_names:
+            points = markers.get(marker, [])
+            body.append("#define %s_%s_%s_COUNT %d" % (upper, name.upper(), marker.upper(), len(points)))
+            body.append("static const asset_point_t %s_%s_%s[] = { %s };"
+                        % (prefix, name, marker, ", ".join("{ %d, %d }" % p for p in points)))
+        body.append("")
+
+    body.append("static const asset_level_t %s_levels[%s_LEVEL_COUNT] = {" % (prefix, upper))
+    for name, rows, blob, markers in levels:
+        sx, sy = markers["start"][0]
+        body.append("    { %s_%s_rle, sizeof(%s_%s_rle), { %d, %d } },"
+                    % (prefix, name, prefix, name, sx, sy))
+    body.append("};")
+    body.append("")
+    raw = len(levels) * size[0] * size[1]
+    summary = "%d levels, %d bytes (%d uncompressed)" % (len(levels), total, raw)
+    return body, summary
+
+
+# ============================================================================
+# 方块形状
+# ============================================================================
+
+def compile_shapes(path):
+    shapes = []
+    for lineno, args, rows in read_blocks(path):
+        if args[0] != "shape" or len(args) != 2:
+            raise AssetError("%s:%d: expected 'shape <name>'" % (path, lineno))
+        width, height, pixels = pixels_from_art(path, lineno, args[1], rows)
+        if (width, height) != (4, 4):
+            raise AssetError("%s:%d: %s must be 4x4" % (path, lineno, args[1]))
+        mask = 0
+        for y in range(4):
+            for x in range(4):
+                if pixels[y][x]:
+                    mask |= 1 << (y * 4 + x)
+        shapes.append((args[1], rows, mask))
+
+    prefix = os.path.splitext(os.path.basename(path))[0]
+    body = ["#define %s_SHAPE_COUNT %d" % (prefix.upper(), len(shapes)), ""]
+    for name, rows, mask in shapes:
+        body.append("/* %s: 0x%04X */" % (name, mask))
+        for row in rows:
+            body.append("/*   %s */" % row)
+    body.append("static const uint16_t %s_shapes[%s_SHAPE_COUNT] = {" % (prefix, prefix.upper()))
+    for name, rows, mask in shapes:
+        body.append("    0x%04X,  /* %s */" % (mask, name))
+    body.append("};")
+    body.append("")
+    summary = "%d shapes, %d bytes" % (len(shapes), len(shapes) * 2)
+    return body, summary
+
+
+# ============================================================================
+# 输出
+# ============================================================================
+
+def c_array(decl, name, data):
+    lines = ["%s %s[%d] = {" % (decl, name, len(data))]
+    for i in range(0, len(data), 12):
+        lines.append("    " + " ".join("0x%02X," % b for b in data[i:i + 12]))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+COMPILERS = {
+    ".spr": compile_sprites,
+    ".lvl": compile_levels,
+    ".shp": compile_shapes,
+}
+
+
+def render_header(src_name, out_name, body, summary):
+    guard = "__%s__" % out_name.replace(".", "_").upper()
+    lines = [
+        "/**",
+        " ******************************************************************************",
+        " * @file    %s" % out_name,
+        " * @brief   由资源编译器从src/%s生成,不要手工修改" % src_name,
+        " * @note    %s" % summary,
+        " *          修改源文件后运行: python Tools/asset_compiler/asset_compiler.py",
+        " ******************************************************************************",
+        " */",
+        "",
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        "#include <stdint.h>",
+    ]
+    lines += body
+    lines.append("#endif /* %s */" % guard)
+    return "\r\n".join(lines) + "\r\n"
+
+
+def main(argv):
+    check = "--check" in argv
+    stale = []
+    for src_name in sorted(os.listdir(SRC_DIR)):
+        stem, ext = os.path.splitext(src_name)
+        if ext not in COMPILERS:
+            continue
+        out_name = "%s_assets.h" % stem
+        out_path = os.path.join(OUT_DIR, out_name)
+        try:
+            body, summary = COMPILERS[ext](os.path.join(SRC_DIR, src_name))
+        except AssetError as e:
+            print("error: %s" % e, file=sys.stderr)
+            return 1
+        # 多行的块(数组)里也统一用CRLF
+        text = render_header(src_name, out_name, "\n".join(body).split("\n"), summary)
+
+        old = None
+        if os.path.exists(out_path):
+            with open(out_path, "rb") as f:
+                old = f.read().decode("utf-8")
+        if old == text:
+            continue
+        if check:
+            stale.append(out_name)
+            continue
+        with open(out_path, "wb") as f:
+            f.write(text.encode("utf-8"))
+        print("%s -> %s (%s)" % (src_name, out_name, summary))
+
+    if stale:
+        print("out of date: %s" % ", ".join(stale), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))